@@ -0,0 +1,36 @@
+#!/bin/sh
+# Mesure du temps d'exécution des programmes de TESTS : interpréteur
+# (INTER_PCODE), traduction en C (-native=<exe>) et assembleur x86-64
+# (-asm=<exe>), à -O2, avec la même entrée. Seuls les programmes qui se
+# terminent sans erreur en moins de 10 s sont mesurés.
+# Usage : sh TESTS/benchmark_asm.sh [programme.txt ...]   (depuis la racine du projet)
+
+. TESTS/construire.sh
+
+DIR=${TMPDIR:-/tmp}/benchmark_asm
+mkdir -p "$DIR"
+BIN=$DIR/main.exe
+construire "$BIN" main.c -O2 || exit 1
+
+# Durée (ms) de l'exécution de la commande, entrée 3
+duree() {
+    debut=$(date +%s%N)
+    printf '3\n3\n3\n' | timeout 10 "$@" > "$DIR/sortie" 2>&1 || return 1
+    fin=$(date +%s%N)
+    echo $(( (fin - debut) / 1000000 ))
+}
+
+if [ $# -eq 0 ]; then
+    set -- TESTS/*.txt
+fi
+printf '%-32s %12s %10s %10s\n' "program" "interpreter" "C" "asm"
+for f in "$@"; do
+    "$BIN" -O2 -native="$DIR/prog_c" "$f" > /dev/null 2>&1 || continue
+    "$BIN" -O2 -asm="$DIR/prog_asm" "$f" > /dev/null 2>&1 || continue
+    ti=$(duree "$BIN" -O2 "$f") || continue
+    grep -aq Error "$DIR/sortie" && continue
+    tc=$(duree "$DIR/prog_c") || continue
+    ta=$(duree "$DIR/prog_asm") || continue
+    printf '%-32s %10s ms %7s ms %7s ms\n' "$(basename "$f")" "$ti" "$tc" "$ta"
+done
+rm -rf "$DIR"
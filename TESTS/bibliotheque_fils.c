@@ -0,0 +1,146 @@
+// Test de la bibliothèque (bibliotheque.h) : chaque programme donné en
+// argument est compilé et exécuté par plusieurs fils en même temps, à -O0
+// et -O2, dans tous les modes d'exécution. Tous les fils doivent obtenir la
+// même sortie ; celle du premier (interprété, -O0 puis -O2) est affichée
+// pour être comparée à la ligne de commande (differentiel_bibliotheque.sh).
+// Chaque read reçoit la valeur donnée par -entree=<n> (7 par défaut), 100
+// fois au plus.
+#include <pthread.h>
+#include "../bibliotheque.h"
+
+#define NB_FILS   8
+#define NB_TOURS  2
+#define TAILLE_SORTIE 65536
+#define NB_ENTREES 100  // Valeurs lues avant la fin des entrées, comme "yes n | head -n 100"
+
+typedef struct {
+    char texte[TAILLE_SORTIE];
+    int  n;
+    int  lues;  // Valeurs déjà données à read
+} Sortie;
+
+typedef struct {
+    char **fichiers;
+    int    nFichiers;
+    int    numero;
+    int    echecs;
+} Fil;
+
+static const char *ENTREE = "7";
+
+static void ecrire(void *donnees, const char *texte)
+{
+    Sortie *s = donnees;
+    int n = snprintf(s->texte + s->n, sizeof(s->texte) - (size_t)s->n, "%s", texte);
+    if (n > 0 && s->n + n < (int)sizeof(s->texte))
+        s->n += n;
+}
+
+static int lire(void *donnees, char *mot, int taille)
+{
+    Sortie *s = donnees;
+    if (s->lues++ >= NB_ENTREES)
+        return 0;
+    snprintf(mot, (size_t)taille, "%s", ENTREE);
+    return 1;
+}
+
+static char *lireFichier(const char *nom, size_t *taille)
+{
+    FILE *f = fopen(nom, "rb");
+    if (!f)
+        return NULL;
+    char *texte = malloc(1 << 20);
+    *taille = fread(texte, 1, (1 << 20) - 1, f);
+    fclose(f);
+    return texte;
+}
+
+// Compile puis exécute un programme ; la sortie (ou l'erreur) est dans s
+static void executer(const char *source, size_t taille, int niveau, ModeExecution mode, Sortie *s)
+{
+    char erreur[256];
+    OptionsCompilation options = OPTIONS_PAR_DEFAUT;
+    Rappels rappels = {ecrire, lire, s};
+    options.niveau = niveau;
+    s->n = 0;
+    s->lues = 0;
+    s->texte[0] = '\0';
+    Programme *prog = CompilerTampon(source, taille, &options, erreur, sizeof(erreur));
+    if (!prog) {
+        ecrire(s, erreur);
+        ecrire(s, "\n");
+        return;
+    }
+    if (!ExecuterProgramme(prog, mode, &rappels, erreur, sizeof(erreur))) {
+        ecrire(s, erreur);
+        ecrire(s, "\n");
+    }
+    LibererProgramme(prog);
+}
+
+static void *travailler(void *arg)
+{
+    Fil *fil = arg;
+    static const ModeExecution modes[] = {EXEC_INTERPRETEE, EXEC_JIT, EXEC_PALIERS, EXEC_TRACES};
+    Sortie *ref = malloc(sizeof(Sortie)), *s = malloc(sizeof(Sortie));
+    for (int tour = 0; tour < NB_TOURS; tour++) {
+        for (int k = 0; k < fil->nFichiers; k++) {
+            // Ordre différent dans chaque fil : les programmes se croisent
+            int i = (k + fil->numero + tour) % fil->nFichiers;
+            size_t taille;
+            char *source = lireFichier(fil->fichiers[i], &taille);
+            if (!source)
+                continue;
+            for (int niveau = 0; niveau <= 2; niveau += 2) {
+                executer(source, taille, niveau, EXEC_INTERPRETEE, ref);
+                for (int m = 1; m < 4; m++) {
+                    executer(source, taille, niveau, modes[(m + fil->numero) % 4], s);
+                    if (strcmp(ref->texte, s->texte) != 0) {
+                        fprintf(stderr, "DIFF %s -O%d (thread %d)\n", fil->fichiers[i], niveau, fil->numero);
+                        fil->echecs++;
+                    }
+                }
+            }
+            free(source);
+        }
+    }
+    free(ref);
+    free(s);
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    pthread_t fils[NB_FILS];
+    Fil travail[NB_FILS];
+    int echecs = 0;
+
+    if (argc > 1 && strncmp(argv[1], "-entree=", 8) == 0) {
+        ENTREE = argv[1] + 8;
+        argv++;
+        argc--;
+    }
+    for (int t = 0; t < NB_FILS; t++) {
+        travail[t] = (Fil){argv + 1, argc - 1, t, 0};
+        pthread_create(&fils[t], NULL, travailler, &travail[t]);
+    }
+    for (int t = 0; t < NB_FILS; t++) {
+        pthread_join(fils[t], NULL);
+        echecs += travail[t].echecs;
+    }
+
+    // Sortie de référence, à comparer à la ligne de commande
+    Sortie *s = malloc(sizeof(Sortie));
+    for (int i = 1; i < argc; i++) {
+        size_t taille;
+        char *source = lireFichier(argv[i], &taille);
+        for (int niveau = 0; source && niveau <= 2; niveau += 2) {
+            executer(source, taille, niveau, EXEC_INTERPRETEE, s);
+            printf("== %s -O%d\n%s", argv[i], niveau, s->texte);
+        }
+        free(source);
+    }
+    free(s);
+    return echecs != 0;
+}
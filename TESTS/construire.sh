@@ -0,0 +1,21 @@
+# Construction du compilateur, partagée par les scripts de TESTS, qui
+# l'incluent avec « . TESTS/construire.sh » (depuis la racine du projet).
+# Un nouveau fichier source du compilateur s'ajoute ici seulement.
+
+# Fichiers du compilateur, sans le programme principal (main.c)
+SOURCES_COMPILATEUR="analyse_lexical.c syntaxique.c semantique.c interpreteur.c \
+generation_pcode.c representation_intermediaire.c optimisation.c jit.c generation_c.c \
+generation_asm.c trace.c bibliotheque.c compilation_lot.c"
+
+# construire <exécutable> [programme principal] [options de gcc...]
+# Compile le programme principal (main.c par défaut) avec le compilateur
+construire() {
+    exe=$1
+    shift
+    principal=main.c
+    if [ $# -gt 0 ] && [ "${1%.c}" != "$1" ]; then
+        principal=$1
+        shift
+    fi
+    gcc "$@" -o "$exe" "$principal" $SOURCES_COMPILATEUR -lpthread
+}
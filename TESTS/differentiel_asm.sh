@@ -0,0 +1,40 @@
+#!/bin/sh
+# Test différentiel de la génération d'assembleur : chaque programme de TESTS est
+# exécuté par l'interpréteur, puis traduit en assembleur x86-64 et assemblé (-asm=<exe>),
+# à -O0, à -O2 et à -O2 -memo, avec les mêmes entrées ; les sorties (PRN,
+# erreurs, fin d'exécution, compteurs de mémoïsation) doivent être identiques.
+# Usage : sh TESTS/differentiel_asm.sh   (depuis la racine du projet)
+
+. TESTS/construire.sh
+
+DIR=${TMPDIR:-/tmp}/differentiel_asm
+mkdir -p "$DIR"
+BIN=$DIR/main.exe
+construire "$BIN" || exit 1
+
+echecs=0
+for f in TESTS/*.txt; do
+    for o in "-O0" "-O2" "-O2 -memo"; do
+        if ! "$BIN" $o -asm="$DIR/prog" "$f" > /dev/null 2>&1; then
+            # Programme refusé par le compilateur : il n'y a rien à comparer
+            continue
+        fi
+        for entree in 0 7 12; do
+            # Un programme qui boucle sans fin est comparé sur ses 200 premières lignes
+            ref=$(printf '%s\n%s\n%s\n' $entree $entree $entree | timeout 5 "$BIN" $o "$f" 2>&1 \
+                  | grep -aE 'PRN|Error|End of|Memo' | head -n 200)
+            nat=$(printf '%s\n%s\n%s\n' $entree $entree $entree | timeout 5 "$DIR/prog" 2>&1 \
+                  | grep -aE 'PRN|Error|End of|Memo' | head -n 200)
+            if [ "$ref" != "$nat" ]; then
+                echo "DIFF $f $o (input $entree)"
+                echecs=$((echecs + 1))
+            fi
+        done
+    done
+done
+rm -rf "$DIR"
+if [ $echecs -ne 0 ]; then
+    echo "$echecs difference(s)"
+    exit 1
+fi
+echo "Assembly executables and interpreter agree on every program"
@@ -0,0 +1,51 @@
+#!/bin/sh
+# Test de la bibliothèque : TESTS/bibliotheque_fils.c compile et exécute tous
+# les programmes de TESTS dans 8 fils à la fois (tous les modes d'exécution,
+# -O0 et -O2) et vérifie que les fils obtiennent la même sortie ; celle-ci
+# doit être la sortie de la ligne de commande (PRN, invites de read, erreurs).
+# Les programmes qui ne s'arrêtent pas en 5 secondes sont écartés.
+# Usage : sh TESTS/differentiel_bibliotheque.sh   (depuis la racine du projet)
+
+. TESTS/construire.sh
+
+BIN=${TMPDIR:-/tmp}/differentiel_bibliotheque.exe
+FILS=${TMPDIR:-/tmp}/differentiel_bibliotheque_fils.exe
+SORTIE=${TMPDIR:-/tmp}/differentiel_bibliotheque.out
+construire "$BIN" || exit 1
+construire "$FILS" TESTS/bibliotheque_fils.c || exit 1
+
+# Valeurs affichées puis erreurs : sur la ligne de commande, l'erreur (stderr)
+# peut précéder les dernières lignes de stdout
+extraire() {
+    sortie=$(cat)
+    printf '%s\n' "$sortie" | grep -aoE 'PRN => [^ ]*'
+    printf '%s\n' "$sortie" | grep -aoE 'Error line.*'
+}
+
+echecs=0
+for entree in 0 7; do
+    programmes=""
+    attendu=""
+    for f in TESTS/*.txt; do
+        yes $entree | head -n 100 | timeout 5 "$BIN" "$f" > /dev/null 2>&1
+        [ $? -eq 124 ] && continue
+        programmes="$programmes $f"
+        for o in -O0 -O2; do
+            attendu="$attendu$(echo "== $f $o"; yes $entree | head -n 100 | "$BIN" $o "$f" 2>&1 | extraire)
+"
+        done
+    done
+    # L'erreur termine l'exécution : dans la bibliothèque, elle suit déjà les valeurs
+    "$FILS" -entree=$entree $programmes > "$SORTIE" || { echo "Threads disagree (input $entree)"; echecs=$((echecs + 1)); }
+    obtenu=$(grep -aoE '^== .*|PRN => [^ ]*|Error line.*' "$SORTIE")
+    attendu=$(printf '%s' "$attendu")
+    if [ "$attendu" != "$obtenu" ]; then
+        echo "DIFF with the command line (input $entree)"
+        echecs=$((echecs + 1))
+    fi
+done
+rm -f "$BIN" "$FILS" "$SORTIE"
+if [ $echecs -ne 0 ]; then
+    exit 1
+fi
+echo "Library threads and command line agree on every program"
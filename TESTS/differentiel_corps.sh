@@ -0,0 +1,62 @@
+#!/bin/sh
+# Test de la compilation parallèle des corps de procédures : chaque programme
+# de TESTS, et un programme engendré dont chaque fonction appelle la
+# suivante (appels en avant), est compilé avec -jobs=1 puis -jobs=8, à -O0
+# et -O2. Le P-code, les messages de compilation et la sortie doivent être
+# identiques, quel que soit l'ordre dans lequel les fils finissent.
+# Usage : sh TESTS/differentiel_corps.sh   (depuis la racine du projet)
+
+. TESTS/construire.sh
+
+BIN=${TMPDIR:-/tmp}/differentiel_corps.exe
+DIR=${TMPDIR:-/tmp}/differentiel_corps
+construire "$BIN" || exit 1
+rm -rf "$DIR" && mkdir -p "$DIR"
+
+# F1 appelle F2, qui appelle F3... : chaque appel vise une fonction déclarée plus loin
+N=40
+{
+    echo "program Chaine;"
+    echo "var r : Integer;"
+    i=1
+    while [ $i -lt $N ]; do
+        echo "function F$i(x : Integer) : Integer;"
+        echo "begin F$i := F$((i + 1))(x) + 1 end;"
+        i=$((i + 1))
+    done
+    echo "function F$N(x : Integer) : Integer;"
+    echo "begin F$N := x end;"
+    echo "begin r := F1(2); write(r) end."
+} > "$DIR/chaine.txt"
+if ! "$BIN" "$DIR/chaine.txt" 2>&1 | grep -q "PRN => $((N + 1))$"; then
+    echo "FAIL chaine.txt: wrong result"
+    exit 1
+fi
+
+echecs=0
+for o in -O0 -O2; do
+    for f in TESTS/*.txt TESTS/*.pas "$DIR/chaine.txt"; do
+        infini=0
+        for j in 1 8; do
+            # Même nom de P-code pour les deux compilations : il figure dans la sortie
+            rm -f "$DIR/p.pcode"
+            yes 0 | head -n 100 | timeout 5 "$BIN" $o -jobs=$j "$f" "$DIR/p.pcode" > "$DIR/$j.out" 2>&1
+            [ $? -eq 124 ] && infini=1
+            mv -f "$DIR/p.pcode" "$DIR/$j.pcode" 2>/dev/null
+        done
+        # La sortie d'une exécution qui ne s'arrête pas est coupée n'importe où
+        if [ $infini -eq 1 ]; then
+            cp "$DIR/1.out" "$DIR/8.out"
+        fi
+        if ! cmp -s "$DIR/1.out" "$DIR/8.out" || ! cmp -s "$DIR/1.pcode" "$DIR/8.pcode"; then
+            echo "DIFF $f $o"
+            echecs=$((echecs + 1))
+        fi
+    done
+done
+rm -rf "$BIN" "$DIR"
+if [ $echecs -ne 0 ]; then
+    echo "$echecs difference(s)"
+    exit 1
+fi
+echo "Compilation with 1 and 8 threads agrees on every program"
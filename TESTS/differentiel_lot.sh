@@ -0,0 +1,56 @@
+#!/bin/sh
+# Test de la compilation par lot : tous les programmes de TESTS sont compilés
+# par -batch (4 fils, -O0 et -O2), puis un par un par la ligne de commande.
+# Chaque P-code écrit par le lot doit être identique à celui de la ligne de
+# commande, et chaque erreur de compilation la même.
+# Usage : sh TESTS/differentiel_lot.sh   (depuis la racine du projet)
+
+. TESTS/construire.sh
+
+BIN=${TMPDIR:-/tmp}/differentiel_lot.exe
+DIR=${TMPDIR:-/tmp}/differentiel_lot
+construire "$BIN" || exit 1
+
+echecs=0
+for o in -O0 -O2; do
+    rm -rf "$DIR" && mkdir -p "$DIR"
+    "$BIN" -batch -batch-out="$DIR" -jobs=4 $o TESTS > "$DIR/lot.out"
+    for f in TESTS/*.txt TESTS/*.pas; do
+        nom=$(basename "$f"); nom=${nom%.*}
+        # Le P-code est écrit avant l'exécution, qui peut ne pas s'arrêter
+        rm -f "$DIR/ref.pcode"
+        erreur=$(yes 0 | head -n 100 | timeout 5 "$BIN" $o "$f" "$DIR/ref.pcode" 2>&1 >/dev/null | grep -a 'Error line' | head -n 1)
+        if grep -q "^$f: [0-9]* instructions" "$DIR/lot.out"; then
+            if ! cmp -s "$DIR/ref.pcode" "$DIR/$nom.pcode"; then
+                echo "DIFF $f $o: P-code"
+                echecs=$((echecs + 1))
+            fi
+        elif [ -f "$DIR/ref.pcode" ] || ! grep -qF "$f: $erreur" "$DIR/lot.out"; then
+            echo "DIFF $f $o: diagnostic"
+            echecs=$((echecs + 1))
+        fi
+    done
+done
+
+# Deux sources de même nom dans -batch-out : le second est écarté, sans
+# écraser le P-code du premier ; un chemin absent est un échec
+rm -rf "$DIR" && mkdir -p "$DIR/a" "$DIR/b" "$DIR/out"
+cp TESTS/test1.txt "$DIR/a/x.txt"
+cp TESTS/test2.txt "$DIR/b/x.txt"
+"$BIN" -batch -batch-out="$DIR/out" "$DIR/a" "$DIR/b" > "$DIR/lot.out" 2>/dev/null
+"$BIN" TESTS/test1.txt "$DIR/ref.pcode" > /dev/null 2>&1
+if ! grep -qF "$DIR/b/x.txt: Same P-code file as $DIR/a/x.txt" "$DIR/lot.out" ||
+   ! cmp -s "$DIR/ref.pcode" "$DIR/out/x.pcode"; then
+    echo "DIFF homonymes"
+    echecs=$((echecs + 1))
+fi
+if "$BIN" -batch "$DIR/absent/" > /dev/null 2>&1; then
+    echo "DIFF missing path"
+    echecs=$((echecs + 1))
+fi
+rm -rf "$BIN" "$DIR"
+if [ $echecs -ne 0 ]; then
+    echo "$echecs difference(s)"
+    exit 1
+fi
+echo "Batch and single-file compilation agree on every program"
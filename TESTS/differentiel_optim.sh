@@ -0,0 +1,36 @@
+#!/bin/sh
+# Test différentiel de l'optimiseur : chaque programme de TESTS est exécuté
+# à -O0, -O1 et -O2 avec les mêmes entrées ; les sorties (PRN, erreurs, fin
+# d'exécution) doivent être celles de -O0.
+# Usage : sh TESTS/differentiel_optim.sh   (depuis la racine du projet)
+
+. TESTS/construire.sh
+
+BIN=${TMPDIR:-/tmp}/differentiel_optim.exe
+construire "$BIN" || exit 1
+
+# Sortie du programme $1 au niveau $2 pour l'entrée $3 (200 premières lignes
+# pour un programme qui boucle sans fin)
+sortie() {
+    printf '%s\n%s\n%s\n' $3 $3 $3 | timeout 5 "$BIN" $2 "$1" 2>&1 \
+        | grep -aE 'PRN|Error|End of' | head -n 200
+}
+
+echecs=0
+for f in TESTS/*.txt; do
+    for entree in 0 7 12; do
+        ref=$(sortie "$f" -O0 $entree)
+        for o in -O1 -O2; do
+            if [ "$ref" != "$(sortie "$f" $o $entree)" ]; then
+                echo "DIFF $f $o (input $entree)"
+                echecs=$((echecs + 1))
+            fi
+        done
+    done
+done
+rm -f "$BIN"
+if [ $echecs -ne 0 ]; then
+    echo "$echecs difference(s)"
+    exit 1
+fi
+echo "-O1, -O2 and -O0 agree on every program"
@@ -0,0 +1,37 @@
+#!/bin/sh
+# Test différentiel de l'exécution par paliers : chaque programme de TESTS
+# est exécuté par l'interpréteur puis avec -tier, à -O0 et à -O2, avec les
+# mêmes entrées. Avec des seuils de 1 ou 2, les procédures passent au code
+# machine dès leurs premiers appels ou tours de boucle, au milieu de leur
+# exécution ; les sorties (PRN, erreurs, fin d'exécution) doivent être identiques.
+# Usage : sh TESTS/differentiel_tier.sh   (depuis la racine du projet)
+
+. TESTS/construire.sh
+
+BIN=${TMPDIR:-/tmp}/differentiel_tier.exe
+construire "$BIN" || exit 1
+
+echecs=0
+for f in TESTS/*.txt; do
+    for o in -O0 -O2; do
+        for entree in 0 7 12; do
+            # Un programme qui boucle sans fin est comparé sur ses 200 premières lignes
+            ref=$(printf '%s\n%s\n%s\n' $entree $entree $entree | timeout 5 "$BIN" $o "$f" 2>&1 \
+                  | grep -aE 'PRN|Error|End of' | head -n 200)
+            for seuil in 1 2 50; do
+                tier=$(printf '%s\n%s\n%s\n' $entree $entree $entree | timeout 5 "$BIN" $o -tier-calls=$seuil -tier-loops=$seuil "$f" 2>&1 \
+                      | grep -aE 'PRN|Error|End of' | head -n 200)
+                if [ "$ref" != "$tier" ]; then
+                    echo "DIFF $f $o -tier-calls=$seuil -tier-loops=$seuil (input $entree)"
+                    echecs=$((echecs + 1))
+                fi
+            done
+        done
+    done
+done
+rm -f "$BIN"
+if [ $echecs -ne 0 ]; then
+    echo "$echecs difference(s)"
+    exit 1
+fi
+echo "Tiered execution and interpreter agree on every program"
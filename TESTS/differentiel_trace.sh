@@ -0,0 +1,37 @@
+#!/bin/sh
+# Test différentiel du JIT de traces : chaque programme de TESTS est exécuté
+# par l'interpréteur puis avec -trace, à -O0 et à -O2, avec les mêmes entrées.
+# Un seuil de 1 ou 2 passages fait compiler presque toutes les boucles (et
+# leurs sorties) dès les premiers tours ; les sorties (PRN, erreurs, fin
+# d'exécution) doivent être identiques.
+# Usage : sh TESTS/differentiel_trace.sh   (depuis la racine du projet)
+
+. TESTS/construire.sh
+
+BIN=${TMPDIR:-/tmp}/differentiel_trace.exe
+construire "$BIN" || exit 1
+
+echecs=0
+for f in TESTS/*.txt; do
+    for o in -O0 -O2; do
+        for entree in 0 7 12; do
+            # Un programme qui boucle sans fin est comparé sur ses 200 premières lignes
+            ref=$(printf '%s\n%s\n%s\n' $entree $entree $entree | timeout 5 "$BIN" $o "$f" 2>&1 \
+                  | grep -aE 'PRN|Error|End of' | head -n 200)
+            for seuil in 1 2 50; do
+                trace=$(printf '%s\n%s\n%s\n' $entree $entree $entree | timeout 5 "$BIN" $o -trace=$seuil "$f" 2>&1 \
+                        | grep -aE 'PRN|Error|End of' | head -n 200)
+                if [ "$ref" != "$trace" ]; then
+                    echo "DIFF $f $o -trace=$seuil (input $entree)"
+                    echecs=$((echecs + 1))
+                fi
+            done
+        done
+    done
+done
+rm -f "$BIN"
+if [ $echecs -ne 0 ]; then
+    echo "$echecs difference(s)"
+    exit 1
+fi
+echo "Trace JIT and interpreter agree on every program"
@@ -0,0 +1,189 @@
+#include "bibliotheque.h"
+#include "analyse_lexical.h"
+#include "syntaxique.h"
+#include "semantique.h"
+#include "generation_pcode.h"
+#include "optimisation.h"
+#include "jit.h"
+#include "trace.h"
+
+struct Programme {
+    INSTRUCTION code[TAILLECODE];          // PCODE[0..pc]
+    int         pc;                        // Adresse de la dernière instruction
+    int         pileRequise[TAILLECODE];   // PILE_REQUISE
+    DataType    types[TAILLEMEM];          // MEM_TYPE au début de l'exécution
+    T_IDF       idfs[TAILLEIDFS];          // Table des symboles (noms des procédures)
+    int         nIdfs;
+    int         ligne;                     // line_num et dernier token en fin de
+    TSym_Cour   dernier;                   // compilation (messages d'erreur)
+};
+
+const OptionsCompilation OPTIONS_PAR_DEFAUT = {0, 8, 4, 64, 0, 0};
+
+// Copie le message de la dernière erreur rattrapée
+static void copierErreur(char *erreur, int tailleErreur, const char *message)
+{
+    if (erreur && tailleErreur > 0)
+        snprintf(erreur, (size_t)tailleErreur, "%s", message);
+}
+
+// Garde l'état du fil (P-code, table des symboles, types des globales) dans un Programme
+static Programme *extraire(char *erreur, int tailleErreur)
+{
+    Programme *prog = malloc(sizeof(Programme));
+    if (!prog) {
+        copierErreur(erreur, tailleErreur, "Out of memory");
+        return NULL;
+    }
+    memcpy(prog->code, PCODE, sizeof(PCODE));
+    prog->pc = PC;
+    memcpy(prog->pileRequise, PILE_REQUISE, sizeof(PILE_REQUISE));
+    memcpy(prog->types, MEM_TYPE, sizeof(MEM_TYPE));
+    memcpy(prog->idfs, TAB_IDFS, sizeof(TAB_IDFS));
+    prog->nIdfs = NBR_IDFS;
+    prog->ligne = line_num;
+    prog->dernier = symCour;
+    return prog;
+}
+
+// Remet l'état du fil dans celui de fin de compilation du programme
+static void installer(const Programme *prog)
+{
+    memcpy(PCODE, prog->code, sizeof(PCODE));
+    PC = prog->pc;
+    memcpy(PILE_REQUISE, prog->pileRequise, sizeof(PILE_REQUISE));
+    memset(MEM, 0, sizeof(MEM));
+    memcpy(MEM_TYPE, prog->types, sizeof(MEM_TYPE));
+    memcpy(TAB_IDFS, prog->idfs, sizeof(TAB_IDFS));
+    NBR_IDFS = prog->nIdfs;
+    line_num = prog->ligne;
+    symCour = prog->dernier;
+}
+
+Programme *CompilerTampon(const char *source, size_t taille, const OptionsCompilation *options,
+                          char *erreur, int tailleErreur)
+{
+    jmp_buf reprise;
+    Programme *volatile prog = NULL;  // Modifié après setjmp
+    int informations = INFORMATIONS;
+
+    if (!options)
+        options = &OPTIONS_PAR_DEFAUT;
+    FILE *f = taille > 0 ? fmemopen((void *)source, taille, "r") : NULL;
+    if (!f) {
+        copierErreur(erreur, tailleErreur, "Cannot read the source");
+        return NULL;
+    }
+    NIVEAU_OPTIM = options->niveau;
+    SEUIL_INLINE = options->seuilInline;
+    FACTEUR_DEROULAGE = options->facteurDeroulage;
+    SEUIL_SPECIALISATION = options->seuilSpecialisation;
+    MEMOISATION = options->memoisation;
+    FILS_CORPS = options->filsCorps;
+    AFFICHER_RI = 0;
+    INFORMATIONS = 0;
+    REPRISE_ERREUR = &reprise;
+    if (setjmp(reprise) == 0) {
+        // Mêmes étapes que main : analyse, optimisation, types des globales, pile
+        DebutAnalyse(f);
+        Program();
+        Optimiser();
+        memset(MEM_TYPE, 0, sizeof(MEM_TYPE));
+        for (int i = 0; i < NBR_IDFS; i++) {
+            int adr = TAB_IDFS[i].Adresse;
+            if (TAB_IDFS[i].TIDF == TVAR && adr >= 0 && adr < TAILLEMEM)
+                MEM_TYPE[adr] = TAB_IDFS[i].type;
+        }
+        CalculerPileRequise();
+        prog = extraire(erreur, tailleErreur);
+    } else {
+        // La RI et les corps de procédures ont été libérés avant la reprise ;
+        // le P-code et la table des symboles partiels sont abandonnés
+        copierErreur(erreur, tailleErreur, MESSAGE_ERREUR);
+        PC = -1;
+        NBR_IDFS = 0;
+    }
+    REPRISE_ERREUR = NULL;
+    INFORMATIONS = informations;
+    fsource = NULL;
+    fclose(f);
+    return prog;
+}
+
+Programme *ChargerProgramme(const char *fichier, char *erreur, int tailleErreur)
+{
+    jmp_buf reprise;
+    Programme *volatile prog = NULL;  // Modifié après setjmp
+    int informations = INFORMATIONS;
+
+    INFORMATIONS = 0;
+    REPRISE_ERREUR = &reprise;
+    if (setjmp(reprise) == 0) {
+        NBR_IDFS = 0;
+        line_num = 0;
+        memset(&symCour, 0, sizeof(symCour));
+        memset(MEM_TYPE, 0, sizeof(MEM_TYPE));
+        chargerPCode(fichier);
+        CalculerPileRequise();
+        prog = extraire(erreur, tailleErreur);
+    } else {
+        copierErreur(erreur, tailleErreur, MESSAGE_ERREUR);
+    }
+    REPRISE_ERREUR = NULL;
+    INFORMATIONS = informations;
+    return prog;
+}
+
+int SauvegarderProgramme(const Programme *prog, const char *fichier)
+{
+    FILE *f = fopen(fichier, "w");
+    if (!f)
+        return 0;
+    for (int i = 0; i <= prog->pc; i++)
+        fprintf(f, "%d %d\n", prog->code[i].MNE, prog->code[i].SUITE);
+    return fclose(f) == 0;
+}
+
+int TailleProgramme(const Programme *prog)
+{
+    return prog->pc + 1;
+}
+
+int ExecuterProgramme(const Programme *prog, ModeExecution mode, const Rappels *rappels,
+                      char *erreur, int tailleErreur)
+{
+    jmp_buf reprise;
+    int reussi = 0;
+    int informations = INFORMATIONS;
+    Rappels console = RAPPELS;
+
+    installer(prog);
+    if (rappels)
+        RAPPELS = *rappels;
+    INFORMATIONS = 0;
+    REPRISE_ERREUR = &reprise;
+    if (setjmp(reprise) == 0) {
+        switch (mode) {
+        case EXEC_JIT:     JIT_PCODE(); break;
+        case EXEC_PALIERS: JIT_PAR_PALIERS(); break;
+        case EXEC_TRACES:  TRACE_PCODE(); break;
+        default:           INTER_PCODE(); break;
+        }
+        reussi = 1;
+    } else {
+        // Le code machine et les caches d'une exécution interrompue n'ont pas été libérés
+        JIT_LIBERER();
+        TRACE_LIBERER();
+        INTER_LIBERER();
+        copierErreur(erreur, tailleErreur, MESSAGE_ERREUR);
+    }
+    REPRISE_ERREUR = NULL;
+    INFORMATIONS = informations;
+    RAPPELS = console;
+    return reussi;
+}
+
+void LibererProgramme(Programme *prog)
+{
+    free(prog);
+}
@@ -0,0 +1,78 @@
+#ifndef BIBLIOTHEQUE_H
+#define BIBLIOTHEQUE_H
+
+#include "global.h"        // Définitions globales (INSTRUCTION, DataType, etc.)
+#include "interpreteur.h"  // Rappels d'entrée/sortie du programme exécuté
+
+// ---------------------------------------------------------------------
+// Le compilateur comme bibliothèque
+// ---------------------------------------------------------------------
+// Compile un source en mémoire, charge ou sauvegarde du P-code, exécute un
+// programme avec des rappels pour write et read. Une erreur (de compilation
+// ou d'exécution) n'arrête pas le processus : la fonction retourne un échec
+// et le message habituel ("Error line ...") est copié dans 'erreur'.
+// Les messages d'information (variables déclarées, fin d'exécution...) ne
+// sont pas affichés.
+//
+// Tout l'état du compilateur et de la machine virtuelle est propre au fil
+// d'exécution (ETAT_PAR_FIL) : des fils différents compilent et exécutent
+// des programmes indépendants en même temps, sans verrou. Un Programme ne
+// dépend pas du fil qui l'a produit et peut être exécuté par un autre ;
+// il n'est jamais modifié par l'exécution.
+//
+// Il n'y a pas d'objet contexte : l'état d'un fil est celui de ses variables
+// ETAT_PAR_FIL (environ 220 Ko par fil, les grandes tables de l'exécution
+// sont allouées le temps d'une exécution). Un fil ne traite donc qu'un
+// programme à la fois : un rappel (Rappels) ne doit pas appeler
+// CompilerTampon, ChargerProgramme ni ExecuterProgramme.
+
+// Programme compilé : P-code, types initiaux de la mémoire, table des symboles
+typedef struct Programme Programme;
+
+// Options de compilation (options -O, -inline, -unroll, -clone, -memo, -jobs)
+typedef struct {
+    int niveau;               // Niveau d'optimisation (0, 1 ou 2)
+    int seuilInline;          // Seuil du modèle de coût de l'intégration
+    int facteurDeroulage;     // Facteur de déroulage des boucles for
+    int seuilSpecialisation;  // Croissance maximale due à la spécialisation
+    int memoisation;          // Mémoïsation des fonctions pures récursives
+    int filsCorps;            // Fils qui compilent les corps des procédures (0 : un par cœur)
+} OptionsCompilation;
+
+// Options par défaut, celles de la ligne de commande sans option
+extern const OptionsCompilation OPTIONS_PAR_DEFAUT;
+
+// Exécution : interprétée, JIT, par paliers ou JIT de traces (options -jit,
+// -tier, -trace). Les seuils sont SEUIL_APPELS, SEUIL_BOUCLES et SEUIL_TRACE
+// du fil qui exécute.
+typedef enum {
+    EXEC_INTERPRETEE,
+    EXEC_JIT,
+    EXEC_PALIERS,
+    EXEC_TRACES
+} ModeExecution;
+
+// Compile les 'taille' octets de 'source' (options NULL : OPTIONS_PAR_DEFAUT).
+// Retourne le programme, ou NULL avec le message dans 'erreur'.
+Programme *CompilerTampon(const char *source, size_t taille, const OptionsCompilation *options,
+                          char *erreur, int tailleErreur);
+
+// Charge un fichier de P-code (format de sauvegarderPCode). Le fichier ne
+// contient pas les types : les globales commencent entières.
+Programme *ChargerProgramme(const char *fichier, char *erreur, int tailleErreur);
+
+// Écrit le P-code du programme dans 'fichier'. Retourne 1 si c'est fait.
+int SauvegarderProgramme(const Programme *prog, const char *fichier);
+
+// Nombre d'instructions du programme
+int TailleProgramme(const Programme *prog);
+
+// Exécute le programme, la mémoire remise à zéro (rappels NULL : console).
+// Retourne 1 si l'exécution atteint HLT, 0 avec le message dans 'erreur'.
+int ExecuterProgramme(const Programme *prog, ModeExecution mode, const Rappels *rappels,
+                      char *erreur, int tailleErreur);
+
+// Libère un programme rendu par CompilerTampon ou ChargerProgramme
+void LibererProgramme(Programme *prog);
+
+#endif
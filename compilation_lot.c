@@ -0,0 +1,245 @@
+#include "compilation_lot.h"
+#include <pthread.h>   // pthread_create, pthread_join, pthread_mutex_t
+#include <dirent.h>    // opendir, readdir
+#include <stdio.h>     // perror
+#include <sys/stat.h>  // stat, S_ISDIR
+#include <time.h>      // clock_gettime
+#include <unistd.h>    // sysconf
+
+// Un fichier du lot et son résultat
+typedef struct {
+    char *source;          // Chemin du source
+    char  pcode[1024];     // Chemin du P-code écrit
+    int   reussi;          // 1 : compilé et écrit
+    int   ecarte;          // 1 : pas compilé, le diagnostic est déjà posé
+    int   instructions;    // Taille du P-code
+    char  diagnostic[256]; // Message d'erreur
+} Fichier;
+
+// Fichiers à compiler, partagés par les fils ; 'prochain' est protégé par 'verrou'
+typedef struct {
+    Fichier                  *fichiers;
+    int                       nFichiers;
+    int                       prochain;
+    pthread_mutex_t           verrou;
+    const OptionsCompilation *options;
+} Lot;
+
+// Ajoute un chemin à la liste (tableau agrandi au besoin)
+static void ajouter(Fichier **fichiers, int *n, int *capacite, const char *chemin)
+{
+    if (*n == *capacite) {
+        *capacite = *capacite ? 2 * *capacite : 64;
+        *fichiers = realloc(*fichiers, (size_t)*capacite * sizeof(Fichier));
+        if (!*fichiers)
+            Error("Out of memory (batch)");
+    }
+    memset(&(*fichiers)[*n], 0, sizeof(Fichier));
+    (*fichiers)[*n].source = strdup(chemin);
+    (*n)++;
+}
+
+static int comparerNoms(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+// Ajoute les sources (.txt, .pas) d'un répertoire, dans l'ordre alphabétique.
+// Retourne 0 si le répertoire ne peut pas être lu (message sur stderr).
+static int ajouterRepertoire(Fichier **fichiers, int *n, int *capacite, const char *chemin)
+{
+    DIR *d = opendir(chemin);
+    char **noms = NULL;
+    int nNoms = 0;
+    struct dirent *e;
+    if (!d) {
+        perror(chemin);
+        return 0;
+    }
+    while ((e = readdir(d)) != NULL) {
+        const char *point = strrchr(e->d_name, '.');
+        if (!point || (strcmp(point, ".txt") != 0 && strcmp(point, ".pas") != 0))
+            continue;
+        noms = realloc(noms, (size_t)(nNoms + 1) * sizeof(char *));
+        if (!noms)
+            Error("Out of memory (batch)");
+        noms[nNoms++] = strdup(e->d_name);
+    }
+    closedir(d);
+    qsort(noms, (size_t)nNoms, sizeof(char *), comparerNoms);
+    for (int i = 0; i < nNoms; i++) {
+        char complet[1024];
+        snprintf(complet, sizeof(complet), "%s/%s", chemin, noms[i]);
+        ajouter(fichiers, n, capacite, complet);
+        free(noms[i]);
+    }
+    free(noms);
+    return 1;
+}
+
+// Chemin du P-code : nom du source, extension .pcode, dans 'repertoire' s'il est donné
+static void cheminPcode(Fichier *f, const char *repertoire)
+{
+    const char *nom = strrchr(f->source, '/');
+    nom = nom ? nom + 1 : f->source;
+    if (repertoire)
+        snprintf(f->pcode, sizeof(f->pcode), "%s/%s", repertoire, nom);
+    else
+        snprintf(f->pcode, sizeof(f->pcode), "%s", f->source);
+    char *point = strrchr(f->pcode, '.');
+    char *barre = strrchr(f->pcode, '/');
+    if (point && (!barre || point > barre))
+        *point = '\0';
+    strncat(f->pcode, ".pcode", sizeof(f->pcode) - strlen(f->pcode) - 1);
+}
+
+static int comparerPcode(const void *a, const void *b)
+{
+    const Fichier *f = *(const Fichier *const *)a, *g = *(const Fichier *const *)b;
+    int c = strcmp(f->pcode, g->pcode);
+    return c ? c : (f < g ? -1 : f > g);
+}
+
+// Deux sources qui donneraient le même fichier de P-code (a/x.txt et b/x.txt
+// avec -batch-out, x.txt et x.pas, ou un source donné deux fois) : le
+// premier dans l'ordre des arguments est compilé, les autres sont écartés
+static void ecarterHomonymes(Fichier *fichiers, int n)
+{
+    Fichier **tri = malloc((size_t)n * sizeof(Fichier *));
+    if (!tri)
+        Error("Out of memory (batch)");
+    for (int i = 0; i < n; i++)
+        tri[i] = &fichiers[i];
+    qsort(tri, (size_t)n, sizeof(Fichier *), comparerPcode);
+    int premier = 0;  // Premier de la suite des fichiers de même P-code
+    for (int i = 1; i < n; i++) {
+        if (strcmp(tri[i]->pcode, tri[premier]->pcode) != 0) {
+            premier = i;
+            continue;
+        }
+        tri[i]->ecarte = 1;
+        snprintf(tri[i]->diagnostic, sizeof(tri[i]->diagnostic),
+                 "Same P-code file as %s", tri[premier]->source);
+    }
+    free(tri);
+}
+
+// Compile un fichier avec le compilateur du fil appelant
+static void compilerFichier(Fichier *f, const Lot *lot)
+{
+    if (f->ecarte)
+        return;
+    FILE *src = fopen(f->source, "rb");
+    if (!src) {
+        snprintf(f->diagnostic, sizeof(f->diagnostic), "Cannot open the source file");
+        return;
+    }
+    size_t capacite = 4096, taille = 0, lus;
+    char *texte = malloc(capacite);
+    while (texte && (lus = fread(texte + taille, 1, capacite - taille, src)) > 0) {
+        taille += lus;
+        if (taille == capacite) {
+            capacite *= 2;
+            char *plus = realloc(texte, capacite);
+            if (!plus)
+                free(texte);
+            texte = plus;
+        }
+    }
+    fclose(src);
+    if (!texte) {
+        snprintf(f->diagnostic, sizeof(f->diagnostic), "Out of memory");
+        return;
+    }
+
+    Programme *prog = CompilerTampon(texte, taille, lot->options, f->diagnostic, sizeof(f->diagnostic));
+    free(texte);
+    if (!prog)
+        return;
+    f->instructions = TailleProgramme(prog);
+    if (SauvegarderProgramme(prog, f->pcode))
+        f->reussi = 1;
+    else
+        snprintf(f->diagnostic, sizeof(f->diagnostic), "Cannot write the P-code file");
+    LibererProgramme(prog);
+}
+
+// Boucle d'un fil : prend le prochain fichier du lot jusqu'à épuisement
+static void *travailler(void *arg)
+{
+    Lot *lot = arg;
+    for (;;) {
+        pthread_mutex_lock(&lot->verrou);
+        int i = lot->prochain++;
+        pthread_mutex_unlock(&lot->verrou);
+        if (i >= lot->nFichiers)
+            return NULL;
+        compilerFichier(&lot->fichiers[i], lot);
+    }
+}
+
+int CompilerLot(char *const chemins[], int nChemins, const char *repertoire, int nbFils,
+                const OptionsCompilation *options)
+{
+    Fichier *fichiers = NULL;
+    int n = 0, capacite = 0, echecs = 0, compiles = 0;
+    struct timespec debut, fin;
+
+    // Un répertoire illisible compte comme un échec
+    for (int i = 0; i < nChemins; i++) {
+        struct stat st;
+        if (stat(chemins[i], &st) == 0 && S_ISDIR(st.st_mode)) {
+            if (!ajouterRepertoire(&fichiers, &n, &capacite, chemins[i]))
+                echecs++;
+        } else {
+            ajouter(&fichiers, &n, &capacite, chemins[i]);
+        }
+    }
+    for (int i = 0; i < n; i++)
+        cheminPcode(&fichiers[i], repertoire);
+    if (n > 1)
+        ecarterHomonymes(fichiers, n);
+    if (nbFils <= 0)
+        nbFils = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int total = nbFils;
+    if (nbFils > n)
+        nbFils = n;
+    if (nbFils < 1)
+        nbFils = 1;
+
+    // Les fils restants, s'il y a moins de fichiers que de fils, compilent
+    // les corps des procédures de chaque fichier
+    OptionsCompilation parFichier = options ? *options : OPTIONS_PAR_DEFAUT;
+    parFichier.filsCorps = total > nbFils ? total / nbFils : 1;
+
+    Lot lot = {fichiers, n, 0, PTHREAD_MUTEX_INITIALIZER, &parFichier};
+    pthread_t *fils = malloc((size_t)nbFils * sizeof(pthread_t));
+    int lances = 0;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    for (int t = 0; fils && t < nbFils; t++)
+        if (pthread_create(&fils[t], NULL, travailler, &lot) == 0)
+            lances++;
+    // Sans fil de plus, le fil principal compile tout le lot
+    if (lances == 0)
+        travailler(&lot);
+    for (int t = 0; t < lances; t++)
+        pthread_join(fils[t], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    free(fils);
+
+    for (int i = 0; i < n; i++) {
+        if (fichiers[i].reussi) {
+            printf("%s: %d instructions -> %s\n", fichiers[i].source, fichiers[i].instructions, fichiers[i].pcode);
+            compiles++;
+        } else {
+            printf("%s: %s\n", fichiers[i].source, fichiers[i].diagnostic);
+            echecs++;
+        }
+        free(fichiers[i].source);
+    }
+    free(fichiers);
+    double secondes = (double)(fin.tv_sec - debut.tv_sec) + (double)(fin.tv_nsec - debut.tv_nsec) / 1e9;
+    printf("Batch: %d files, %d compiled, %d failed, %d threads, %.3f s\n",
+           n, compiles, echecs, lances ? lances : 1, secondes);
+    return echecs;
+}
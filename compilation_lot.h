@@ -0,0 +1,25 @@
+#ifndef COMPILATION_LOT_H
+#define COMPILATION_LOT_H
+
+#include "bibliotheque.h"  // CompilerTampon, SauvegarderProgramme, OptionsCompilation
+
+// ---------------------------------------------------------------------
+// Compilation par lot (option -batch)
+// ---------------------------------------------------------------------
+// Compile plusieurs fichiers source dans un seul processus : chaque
+// argument est un fichier, ou un répertoire dont les fichiers .txt et .pas
+// sont pris dans l'ordre alphabétique. Un groupe de 'nbFils' fils se
+// partage les fichiers ; chaque fil a son propre compilateur (état
+// ETAT_PAR_FIL), sans verrou pendant la compilation ; s'il y a moins de
+// fichiers que de fils, ceux qui restent compilent les corps des procédures
+// (options->filsCorps est ignoré). Le P-code de chaque fichier est écrit
+// dans 'repertoire' (NULL : à côté du source), sous le nom du source avec
+// l'extension .pcode ; deux sources qui donneraient le même fichier ne sont
+// pas compilées toutes les deux : seul le premier dans l'ordre des arguments
+// l'est. Un diagnostic par fichier (nombre d'instructions ou message
+// d'erreur) est affiché dans l'ordre des arguments, suivi d'un bilan.
+// Retourne le nombre d'échecs : fichiers non compilés et répertoires illisibles.
+int CompilerLot(char *const chemins[], int nChemins, const char *repertoire, int nbFils,
+                const OptionsCompilation *options);
+
+#endif
@@ -0,0 +1,1439 @@
+#include <stdarg.h>            // va_list (emettre)
+#include "generation_asm.h"
+#include "generation_c.h"      // RepartirProcedures, environnement d'exécution C
+#include "generation_pcode.h"  // PILE_REQUISE, ArgumentsDe, NomMnemonique
+#include "semantique.h"        // TAB_IDFS, getProcFuncAtAddress
+
+// ---------------------------------------------------------------------
+// Cases du cadre et types
+// ---------------------------------------------------------------------
+// Le code d'une procédure manipule les cases MEM[BP + k] : arguments
+// (k < 0), liaisons (k = -1 : adresse de retour, k = 0 : ancien BP),
+// variables locales (1..n, réservées par le ALC d'entrée) puis
+// temporaires de la pile d'évaluation (k > n). La hauteur h = SP - BP est
+// connue en chaque point, donc chaque valeur de la pile a une case fixe.
+//
+// L'analyse des types suit, pour chaque instruction, le type de chaque
+// case : entier, réel ou dynamique (connu seulement à l'exécution, lu
+// dans MEM_TYPE). Elle est refaite sur tout le programme tant que les
+// informations partagées changent : types des arguments reçus, type du
+// résultat de chaque procédure, globales "stables" (toujours du type de
+// leur déclaration, car on n'y range que des valeurs de ce type).
+// ---------------------------------------------------------------------
+
+#define CASE_MIN  (-32)                 // Première case suivie
+#define CASE_MAX  96                    // Cases suivies : CASE_MIN .. CASE_MAX - 1
+#define NB_CASES  (CASE_MAX - CASE_MIN)
+#define IC(k)     ((k) - CASE_MIN)      // Indice de la case k
+
+#define NB_REG_PILE  3                  // Temporaires gardés en registres
+#define NB_REG_LOCAL 3                  // Variables locales gardées en registres
+
+// Type d'une case en un point du programme
+typedef enum {
+    T_INT = TYPE_INT,    // Entier
+    T_REEL = TYPE_REAL,  // Réel
+    T_DYN,               // Connu à l'exécution seulement (MEM_TYPE ou registre de type)
+    T_AUCUN              // Pas encore de valeur (point non atteint)
+} Tag;
+
+typedef struct {
+    int  atteint;
+    int  h;                 // Hauteur SP - BP avant l'instruction
+    char tag[NB_CASES];     // Type de chaque case
+    int  adr[NB_CASES];     // Adresse constante (LDA) contenue par la case, -1 sinon
+} Etat;
+
+static ETAT_PAR_FIL Etat *etats;                        // État avant chaque instruction (TAILLECODE, tas)
+static ETAT_PAR_FIL int  procedureDe[TAILLECODE];       // Entrée de la procédure de chaque instruction
+static ETAT_PAR_FIL char estEntree[TAILLECODE];         // Adresse du programme principal ou d'un CALL
+static ETAT_PAR_FIL int  alcEntree[TAILLECODE];         // Par entrée : adresse de son ALC (-1 sinon)
+static ETAT_PAR_FIL int  nLocales[TAILLECODE];          // Par entrée : taille de son ALC
+static ETAT_PAR_FIL char echappe[TAILLECODE][NB_CASES]; // Par entrée : case dont l'adresse est prise (LLA)
+static ETAT_PAR_FIL char tagsEntree[TAILLECODE][NB_CASES]; // Par entrée : types des cases k < 0 à l'appel
+static ETAT_PAR_FIL char tagRetour[TAILLECODE];         // Par entrée : type de la valeur rendue par RET
+static ETAT_PAR_FIL char stable[TAILLEMEM];             // La globale garde le type de sa déclaration
+static ETAT_PAR_FIL char adressePrise[TAILLEMEM];       // L'adresse de la globale circule (argument...)
+static ETAT_PAR_FIL int  change;                        // Une information partagée a changé
+static ETAT_PAR_FIL const char *echec;                  // Raison de l'abandon, NULL si tout va bien
+
+static char joindre(char a, char b) {
+    if (a == T_AUCUN)
+        return b;
+    if (b == T_AUCUN || a == b)
+        return a;
+    return T_DYN;
+}
+
+// Fusionne s dans d ; retourne 1 si d a changé
+static int joindreEtat(Etat *d, const Etat *s) {
+    if (!d->atteint) {
+        *d = *s;
+        d->atteint = 1;
+        return 1;
+    }
+    if (d->h != s->h) {
+        echec = "stack height differs between two paths";
+        return 0;
+    }
+    int modifie = 0;
+    for (int k = 0; k < NB_CASES; k++) {
+        char t = joindre(d->tag[k], s->tag[k]);
+        if (t != d->tag[k]) {
+            d->tag[k] = t;
+            modifie = 1;
+        }
+        if (d->adr[k] != s->adr[k] && d->adr[k] != -1) {
+            d->adr[k] = -1;
+            modifie = 1;
+        }
+    }
+    return modifie;
+}
+
+static void joindrePartage(char *d, char t) {
+    char n = joindre(*d, t);
+    if (n != *d) {
+        *d = n;
+        change = 1;
+    }
+}
+
+static int estGlobale(int a) { return a >= VAR_BASE && a < TAILLEMEM; }
+
+// Type lu à l'adresse constante a
+static char tagGlobale(int a) {
+    return (estGlobale(a) && stable[a]) ? (char)MEM_TYPE[a] : T_DYN;
+}
+
+// Une valeur de type t est rangée à l'adresse a (-1 : adresse inconnue)
+static void ecritureGlobale(int a, char t) {
+    for (int g = VAR_BASE; g < TAILLEMEM; g++) {
+        if (!stable[g] || (a >= 0 && g != a) || (a < 0 && !adressePrise[g]))
+            continue;
+        if (t != T_AUCUN && t != (char)MEM_TYPE[g]) {
+            stable[g] = 0;
+            change = 1;
+        }
+    }
+}
+
+// Type de la case k dans l'état s de la procédure e
+static char tagCase(const Etat *s, int e, int k) {
+    if (k < CASE_MIN || k >= CASE_MAX) {
+        echec = "frame offset out of range";
+        return T_DYN;
+    }
+    return echappe[e][IC(k)] ? T_DYN : s->tag[IC(k)];
+}
+
+static void ecrireCase(Etat *s, int e, int k, char t) {
+    if (k < CASE_MIN || k >= CASE_MAX) {
+        echec = "frame offset out of range";
+        return;
+    }
+    s->tag[IC(k)] = echappe[e][IC(k)] ? T_DYN : t;
+    s->adr[IC(k)] = -1;
+}
+
+static void empilerTag(Etat *s, int e, char t, int adr) {
+    if (s->h + 1 >= CASE_MAX || s->h + 1 <= nLocales[e]) {
+        echec = "value pushed outside the temporaries";
+        return;
+    }
+    s->h++;
+    s->tag[IC(s->h)] = t;
+    s->adr[IC(s->h)] = adr;
+}
+
+static char depilerTag(Etat *s, int e, int *adr) {
+    if (s->h <= nLocales[e]) {
+        echec = "value popped outside the temporaries";
+        if (adr)
+            *adr = -1;
+        return T_DYN;
+    }
+    char t = s->tag[IC(s->h)];
+    if (adr)
+        *adr = s->adr[IC(s->h)];
+    s->h--;
+    return t;
+}
+
+// Type du résultat d'une opération arithmétique
+static char tagOperation(char a, char b) {
+    if (a == T_AUCUN || b == T_AUCUN)
+        return T_AUCUN;
+    if (a == T_REEL || b == T_REEL)
+        return T_REEL;
+    if (a == T_INT && b == T_INT)
+        return T_INT;
+    return T_DYN;
+}
+
+// Applique l'instruction i de la procédure e à l'état s
+static void transferer(int i, int e, Etat *s) {
+    Mnemoniques m = PCODE[i].MNE;
+    int a = PCODE[i].SUITE, adr;
+    char t, t2;
+    switch (m) {
+    case LDI: case LLA:
+        empilerTag(s, e, T_INT, -1);
+        break;
+    case LDA:
+        empilerTag(s, e, T_INT, (a >= 0 && a < TAILLEMEM) ? a : -1);
+        break;
+    case LDF:
+        empilerTag(s, e, T_REEL, -1);
+        break;
+    case LDV:
+        depilerTag(s, e, &adr);
+        empilerTag(s, e, adr >= 0 ? tagGlobale(adr) : T_DYN, -1);
+        break;
+    case STO:
+        t = depilerTag(s, e, NULL);
+        if (a != -9999)
+            ecritureGlobale(a, t);
+        break;
+    case STO_KEEP:
+        if (s->h <= nLocales[e])
+            echec = "value popped outside the temporaries";
+        ecritureGlobale(a, s->tag[IC(s->h)]);
+        break;
+    case STO_IND:
+        depilerTag(s, e, &adr);
+        t = depilerTag(s, e, NULL);
+        ecritureGlobale(adr, t);
+        break;
+    case LDL:
+        t = tagCase(s, e, a);
+        empilerTag(s, e, t, -1);
+        break;
+    case STL:
+        t = depilerTag(s, e, NULL);
+        ecrireCase(s, e, a, t);
+        break;
+    case ALC:
+        if (i != alcEntree[e] || s->h != 0) {
+            echec = "ALC outside the procedure entry";
+            break;
+        }
+        for (int k = 1; k <= a; k++)
+            ecrireCase(s, e, k, T_INT);
+        s->h = a;
+        break;
+    case SHL: case SHR: case MEMO: case HLT:
+        break;
+    case ADD: case SUB: case MUL: case DIVI: case SUBR: case DIVR:
+        t2 = depilerTag(s, e, NULL);
+        t = depilerTag(s, e, NULL);
+        empilerTag(s, e, tagOperation(t, t2), -1);
+        break;
+    case EQL: case NEQ: case GTR: case LSS: case GEQ: case LEQ:
+        depilerTag(s, e, NULL);
+        depilerTag(s, e, NULL);
+        empilerTag(s, e, T_INT, -1);
+        break;
+    case BEQ: case BNE: case BLT: case BLE: case BGT: case BGE:
+        depilerTag(s, e, NULL);
+        depilerTag(s, e, NULL);
+        break;
+    case BZE: case PRN: case INN:
+        depilerTag(s, e, NULL);
+        break;
+    case BRN:
+        if (EstSautTerminal(i, e)) {
+            // Appel terminal : les arguments rangés par TAILCALL passent à l'appelée
+            for (int k = CASE_MIN; k < 0; k++)
+                joindrePartage(&tagsEntree[a][IC(k)], s->tag[IC(k)]);
+        }
+        break;
+    case CALL: {
+        int n = ArgumentsDe(a);
+        if (s->h - n < nLocales[e]) {
+            echec = "arguments outside the temporaries";
+            break;
+        }
+        for (int k = 0; k < n && -n - 1 + k >= CASE_MIN; k++)
+            joindrePartage(&tagsEntree[a][IC(k - n - 1)], s->tag[IC(s->h - n + 1 + k)]);
+        s->h -= n;
+        empilerTag(s, e, tagRetour[a], -1);
+        break;
+    }
+    case TAILCALL:
+        if (s->h - a < nLocales[e] || -a - 1 < CASE_MIN) {
+            echec = "arguments outside the temporaries";
+            break;
+        }
+        for (int k = 0; k < a; k++)
+            ecrireCase(s, e, k - a - 1, s->tag[IC(s->h - a + 1 + k)]);
+        s->h = 0;
+        break;
+    case RET:
+        joindrePartage(&tagRetour[e], tagCase(s, e, s->h));
+        break;
+    }
+}
+
+// Successeurs de l'instruction i dans sa procédure ; retourne leur nombre
+static int successeurs(int i, int e, int suiv[2]) {
+    Mnemoniques m = PCODE[i].MNE;
+    if (m == RET || m == HLT || EstSautTerminal(i, e))
+        return 0;
+    if (m == BRN) {
+        suiv[0] = PCODE[i].SUITE;
+        return 1;
+    }
+    int n = 0;
+    if (i + 1 <= PC)
+        suiv[n++] = i + 1;
+    if (m == BZE || (m >= BEQ && m <= BGE))
+        suiv[n++] = PCODE[i].SUITE;
+    return n;
+}
+
+// Analyse la procédure d'entrée e avec les informations partagées actuelles
+static void analyserProcedure(int e) {
+    static ETAT_PAR_FIL int file[TAILLECODE];
+    static ETAT_PAR_FIL char enFile[TAILLECODE];
+    int n = 0;
+    for (int i = 0; i <= PC; i++) {
+        if (procedureDe[i] == e)
+            etats[i].atteint = 0;
+    }
+    Etat s;
+    memset(&s, 0, sizeof(s));
+    s.h = 0;
+    for (int k = 0; k < NB_CASES; k++) {
+        s.tag[k] = (k < IC(0)) ? tagsEntree[e][k] : T_AUCUN;
+        s.adr[k] = -1;
+    }
+    s.tag[IC(-1)] = T_INT; // Adresse de retour
+    s.tag[IC(0)] = T_INT;  // Ancien BP
+    joindreEtat(&etats[e], &s);
+    memset(enFile, 0, sizeof(enFile));
+    file[n++] = e;
+    enFile[e] = 1;
+    while (n > 0 && !echec) {
+        int i = file[--n];
+        enFile[i] = 0;
+        s = etats[i];
+        transferer(i, e, &s);
+        int suiv[2];
+        int ns = successeurs(i, e, suiv);
+        for (int k = 0; k < ns; k++) {
+            int j = suiv[k];
+            if (procedureDe[j] != e) {
+                echec = "jump into another procedure";
+                break;
+            }
+            if (joindreEtat(&etats[j], &s) && !enFile[j]) {
+                enFile[j] = 1;
+                file[n++] = j;
+            }
+        }
+    }
+}
+
+// Analyse tout le programme ; retourne 0 (echec renseigné) si la forme du
+// P-code ne permet pas la traduction
+static int analyserProgramme(void) {
+    echec = NULL;
+    if (!RepartirProcedures(procedureDe, estEntree)) {
+        echec = "procedures share code";
+        return 0;
+    }
+    memset(echappe, 0, sizeof(echappe));
+    memset(adressePrise, 0, sizeof(adressePrise));
+    for (int a = 0; a < TAILLEMEM; a++)
+        stable[a] = estGlobale(a);
+    for (int e = 0; e <= PC; e++) {
+        tagRetour[e] = T_AUCUN;
+        memset(tagsEntree[e], T_AUCUN, sizeof(tagsEntree[e]));
+        alcEntree[e] = -1;
+        nLocales[e] = 0;
+        if (!estEntree[e])
+            continue;
+        // ALC suit l'éventuel MEMO, ou le saut qui passe par-dessus les procédures
+        int i = e;
+        if (PCODE[i].MNE == MEMO && i < PC)
+            i++;
+        for (int n = 0; PCODE[i].MNE == BRN && n < 4; n++)
+            i = PCODE[i].SUITE;
+        if (PCODE[i].MNE == ALC) {
+            alcEntree[e] = i;
+            nLocales[e] = PCODE[i].SUITE;
+            if (nLocales[e] >= CASE_MAX - 1) {
+                echec = "too many local variables";
+                return 0;
+            }
+        }
+    }
+    for (int i = 0; i <= PC; i++) {
+        Mnemoniques m = PCODE[i].MNE;
+        int a = PCODE[i].SUITE;
+        if (m == LLA && procedureDe[i] >= 0) {
+            if (a < CASE_MIN || a >= CASE_MAX) {
+                echec = "frame offset out of range";
+                return 0;
+            }
+            echappe[procedureDe[i]][IC(a)] = 1;
+        }
+        // Une adresse chargée par LDA qui n'est pas aussitôt lue circule
+        if (m == LDA && a >= 0 && a < TAILLEMEM &&
+            (i == PC || (PCODE[i + 1].MNE != LDV && PCODE[i + 1].MNE != INN)))
+            adressePrise[a] = 1;
+    }
+    do {
+        change = 0;
+        for (int e = 0; e <= PC && !echec; e++) {
+            if (estEntree[e])
+                analyserProcedure(e);
+        }
+        if (echec)
+            return 0;
+    } while (change);
+    return 1;
+}
+
+// ---------------------------------------------------------------------
+// Génération
+// ---------------------------------------------------------------------
+// Registres : r13 = BP (étendu en 64 bits), r14 = MEM, r15 = MEM_TYPE.
+// Les trois premiers temporaires sont dans ecx, esi, edi, leur type (s'il
+// est dynamique) dans r8d, r9d, r10d ; les suivants dans leur case de MEM.
+// Trois variables locales au plus sont dans ebx, r12d, ebp (sauvegardés à
+// l'entrée) : celles dont l'adresse n'est pas prise et dont le type est
+// connu partout. Un temporaire peut aussi être une constante pas encore
+// écrite. Aux étiquettes, chaque temporaire est à sa place (registre ou
+// case) ; avant un appel, tous sont rangés dans leur case de MEM, où
+// l'appelée lit ses arguments.
+// ---------------------------------------------------------------------
+
+static const char *V32[NB_REG_PILE] = {"ecx", "esi", "edi"};
+static const char *T32[NB_REG_PILE] = {"r8d", "r9d", "r10d"};
+static const char *L32[NB_REG_LOCAL] = {"ebx", "r12d", "ebp"};
+
+typedef enum { EN_CONST, EN_REG, EN_MEM } Lieu;
+
+// Erreurs d'exécution détectées par le code produit (messages de l'interpréteur)
+typedef enum {
+    ERR_LDV, ERR_STO, ERR_STO_KEEP, ERR_STO_IND, ERR_DIV_INT, ERR_DIV_REEL,
+    ERR_RET_BP, ERR_RET_SP, ERR_PILE, NB_ERREURS
+} Erreur;
+
+static const char *MESSAGES[NB_ERREURS] = {
+    "Invalid address LDV", "Invalid address STO", "Invalid address STO_KEEP",
+    "Invalid address STO_IND", "Division by zero (int)", "Division by zero (float)",
+    "Invalid BP in RET", "Stack pointer negative in RET",
+    "Stack overflow: the stack would reach the globals"
+};
+
+static ETAT_PAR_FIL FILE *sortie;
+static ETAT_PAR_FIL int   memoUtilisee;               // Le programme contient MEMO
+static ETAT_PAR_FIL char  aEtiquette[TAILLECODE];
+static ETAT_PAR_FIL int   regLocal[NB_CASES];         // Registre (indice dans L32) de la case k, -1 sinon
+static ETAT_PAR_FIL Lieu  lieu[NB_CASES];             // Place de chaque temporaire
+static ETAT_PAR_FIL int   constante[NB_CASES];        // Valeur d'un temporaire EN_CONST
+static ETAT_PAR_FIL int   entreeCourante, nLoc;       // Procédure en cours
+static ETAT_PAR_FIL const Etat *etat;                 // État avant l'instruction en cours
+static ETAT_PAR_FIL int   nEtiquettes;                // Étiquettes internes .Lx<n>
+static ETAT_PAR_FIL char  tampons[8][64];
+static ETAT_PAR_FIL int   prochainTampon;
+
+static void emettre(const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    fputc('\t', sortie);
+    vfprintf(sortie, fmt, ap);
+    fputc('\n', sortie);
+    va_end(ap);
+}
+
+static char *tampon(void) {
+    return tampons[prochainTampon++ & 7];
+}
+
+static int nouvelleEtiquette(void) { return nEtiquettes++; }
+
+static int estTemporaire(int k) { return k > nLoc; }
+
+// Registre d'un temporaire (indice dans V32), -1 s'il est gardé en mémoire
+static int registreTemp(int k) {
+    int r = k - nLoc - 1;
+    return (r >= 0 && r < NB_REG_PILE) ? r : -1;
+}
+
+static const char *memValeur(int k) {
+    char *b = tampon();
+    snprintf(b, 64, "DWORD PTR [r14+r13*4%+d]", 4 * k);
+    return b;
+}
+
+static const char *memTag(int k) {
+    char *b = tampon();
+    snprintf(b, 64, "DWORD PTR [r15+r13*4%+d]", 4 * k);
+    return b;
+}
+
+static const char *immediat(int v) {
+    char *b = tampon();
+    snprintf(b, 64, "%d", v);
+    return b;
+}
+
+static int estMemoire(const char *op) { return op[0] == 'D'; }
+static int estImmediat(const char *op) { return op[0] == '-' || isdigit((unsigned char)op[0]); }
+
+// Type (statique) de la case k avant l'instruction en cours ; T_AUCUN (code
+// jamais exécuté) est traité comme un entier
+static char tagDe(int k) {
+    char t = echappe[entreeCourante][IC(k)] ? T_DYN : etat->tag[IC(k)];
+    return t == T_AUCUN ? T_INT : t;
+}
+
+// Opérande contenant la valeur de la case k (registre, immédiat ou mémoire)
+static const char *valeur(int k) {
+    if (estTemporaire(k)) {
+        if (lieu[IC(k)] == EN_CONST)
+            return immediat(constante[IC(k)]);
+        if (lieu[IC(k)] == EN_REG)
+            return V32[registreTemp(k)];
+        return memValeur(k);
+    }
+    if (regLocal[IC(k)] >= 0)
+        return L32[regLocal[IC(k)]];
+    return memValeur(k);
+}
+
+// Opérande contenant le type de la case k, de type statique t
+static const char *tagTexte(int k, char t) {
+    if (t != T_DYN)
+        return immediat(t);
+    if (estTemporaire(k) && lieu[IC(k)] == EN_REG)
+        return T32[registreTemp(k)];
+    return memTag(k);
+}
+
+// Range dans le temporaire k la valeur src (registre ou immédiat) de type t.
+// Si t est T_DYN, tsrc donne le type (NULL : déjà en place).
+static void ecrireTemp(int k, const char *src, char t, const char *tsrc) {
+    int r = registreTemp(k);
+    if (r >= 0) {
+        if (strcmp(src, V32[r]) != 0)
+            emettre("mov %s, %s", V32[r], src);
+        if (t == T_DYN && tsrc && strcmp(tsrc, T32[r]) != 0)
+            emettre("mov %s, %s", T32[r], tsrc);
+        lieu[IC(k)] = EN_REG;
+        return;
+    }
+    emettre("mov %s, %s", memValeur(k), src);
+    if (t != T_DYN)
+        emettre("mov %s, %d", memTag(k), t);
+    else if (tsrc) {
+        if (estMemoire(tsrc)) {
+            emettre("mov edx, %s", tsrc);
+            tsrc = "edx";
+        }
+        emettre("mov %s, %s", memTag(k), tsrc);
+    }
+    lieu[IC(k)] = EN_MEM;
+}
+
+// Range le temporaire k dans sa case de MEM, avec son type
+static void ranger(int k) {
+    if (!estTemporaire(k) || lieu[IC(k)] == EN_MEM)
+        return;
+    char t = tagDe(k);
+    const char *v = valeur(k);
+    const char *tt = tagTexte(k, t);
+    emettre("mov %s, %s", memValeur(k), v);
+    emettre("mov %s, %s", memTag(k), tt);
+    lieu[IC(k)] = EN_MEM;
+}
+
+// Range les temporaires jusqu'à la hauteur h (avant un appel)
+static void rangerTout(int h) {
+    for (int k = nLoc + 1; k <= h; k++)
+        ranger(k);
+}
+
+// Met les temporaires jusqu'à la hauteur h à leur place, avec les types
+// attendus par l'instruction j (étiquette)
+static void preparerSaut(int j, int h) {
+    for (int k = nLoc + 1; k <= h; k++) {
+        int r = registreTemp(k);
+        char voulu = etats[j].tag[IC(k)];
+        char t = tagDe(k);
+        if (r < 0) {
+            ranger(k);
+            continue;
+        }
+        if (lieu[IC(k)] == EN_CONST) {
+            emettre("mov %s, %d", V32[r], constante[IC(k)]);
+        } else if (lieu[IC(k)] == EN_MEM) {
+            emettre("mov %s, %s", V32[r], memValeur(k));
+            if (voulu == T_DYN)
+                emettre("mov %s, %s", T32[r], memTag(k));
+            lieu[IC(k)] = EN_REG;
+            continue;
+        }
+        lieu[IC(k)] = EN_REG;
+        if (voulu == T_DYN && t != T_DYN)
+            emettre("mov %s, %d", T32[r], t);
+    }
+}
+
+// Place des temporaires à une étiquette
+static void lieuxCanoniques(void) {
+    for (int k = nLoc + 1; k < CASE_MAX; k++)
+        lieu[IC(k)] = registreTemp(k) >= 0 ? EN_REG : EN_MEM;
+}
+
+// Saute à 'etiquette' si le type de la case k (dynamique) est réel
+static void sautSiReel(int k, const char *cond, int etiquette) {
+    const char *tt = tagTexte(k, T_DYN);
+    if (estMemoire(tt))
+        emettre("cmp %s, 0", tt);
+    else
+        emettre("test %s, %s", tt, tt);
+    emettre("%s .Lx%d", cond, etiquette);
+}
+
+// Charge la valeur de la case k, de type t, en réel dans le registre xmm
+static void chargerReel(int k, char t, const char *xmm) {
+    const char *v = valeur(k);
+    int fin = -1, entier = -1;
+    if (t == T_DYN) {
+        entier = nouvelleEtiquette();
+        fin = nouvelleEtiquette();
+        sautSiReel(k, "je", entier); // Type nul : entier
+    }
+    if (t != T_INT) {
+        if (estImmediat(v)) {
+            emettre("mov eax, %s", v);
+            emettre("movd %s, eax", xmm);
+        } else if (estMemoire(v)) {
+            emettre("movss %s, %s", xmm, v);
+        } else {
+            emettre("movd %s, %s", xmm, v);
+        }
+    }
+    if (t == T_DYN) {
+        emettre("jmp .Lx%d", fin);
+        fprintf(sortie, ".Lx%d:\n", entier);
+    }
+    if (t != T_REEL) {
+        if (estImmediat(v)) {
+            emettre("mov eax, %s", v);
+            emettre("cvtsi2ss %s, eax", xmm);
+        } else {
+            emettre("cvtsi2ss %s, %s", xmm, v);
+        }
+    }
+    if (t == T_DYN)
+        fprintf(sortie, ".Lx%d:\n", fin);
+}
+
+static void sautErreur(const char *cond, Erreur err) {
+    emettre("%s .Lerreur%d", cond, err);
+}
+
+// Instantané des places des temporaires, pour émettre deux chemins
+// (entier et réel) à partir du même état
+typedef struct {
+    Lieu lieu[NB_CASES];
+    int  constante[NB_CASES];
+} Places;
+
+static void sauverPlaces(Places *p) {
+    memcpy(p->lieu, lieu, sizeof(lieu));
+    memcpy(p->constante, constante, sizeof(constante));
+}
+
+static void restaurerPlaces(const Places *p) {
+    memcpy(lieu, p->lieu, sizeof(lieu));
+    memcpy(constante, p->constante, sizeof(constante));
+}
+
+// Opération entière entre les cases ka et kb, résultat dans la case d
+static void operationEntiere(Mnemoniques op, int ka, int kb, int d, char tagRes, const char *tsrc) {
+    const char *b = valeur(kb);
+    int r = registreTemp(d);
+    if (op == DIVI) {
+        emettre("mov eax, %s", valeur(ka));
+        if (estImmediat(b)) {
+            if (atoi(b) == 0) {
+                sautErreur("jmp", ERR_DIV_INT);
+                return;
+            }
+            emettre("mov r11d, %s", b);
+            b = "r11d";
+        } else {
+            if (estMemoire(b)) {
+                emettre("mov r11d, %s", b);
+                b = "r11d";
+            }
+            emettre("test %s, %s", b, b);
+            sautErreur("jz", ERR_DIV_INT);
+        }
+        emettre("cdq");
+        emettre("idiv %s", b);
+        ecrireTemp(d, "eax", tagRes, tsrc);
+        return;
+    }
+    const char *ins = op == ADD ? "add" : op == SUB ? "sub" : "imul";
+    if (ka == d && r >= 0 && lieu[IC(d)] == EN_REG) {
+        // Le premier opérande est déjà dans le registre du résultat
+        if (op == MUL && estImmediat(b))
+            emettre("imul %s, %s, %s", V32[r], V32[r], b);
+        else
+            emettre("%s %s, %s", ins, V32[r], b);
+        if (tagRes == T_DYN && tsrc)
+            emettre("mov %s, %s", T32[r], tsrc);
+        return;
+    }
+    emettre("mov eax, %s", valeur(ka));
+    if (op == MUL && estImmediat(b))
+        emettre("imul eax, eax, %s", b);
+    else
+        emettre("%s eax, %s", ins, b);
+    ecrireTemp(d, "eax", tagRes, tsrc);
+}
+
+// Opération réelle entre les cases ka et kb (types ta, tb), résultat dans d
+static void operationReelle(Mnemoniques op, int ka, char ta, int kb, char tb, int d, char tagRes, const char *tsrc) {
+    chargerReel(ka, ta, "xmm0");
+    chargerReel(kb, tb, "xmm1");
+    if (op == DIVI) {
+        int ok = nouvelleEtiquette();
+        emettre("xorps xmm2, xmm2");
+        emettre("ucomiss xmm1, xmm2");
+        emettre("jp .Lx%d", ok);
+        sautErreur("je", ERR_DIV_REEL);
+        fprintf(sortie, ".Lx%d:\n", ok);
+    }
+    emettre("%s xmm0, xmm1", op == ADD ? "addss" : op == SUB ? "subss" : op == MUL ? "mulss" : "divss");
+    emettre("movd eax, xmm0");
+    ecrireTemp(d, "eax", tagRes, tsrc);
+}
+
+// ADD, SUB, MUL, DIVI, SUBR, DIVR : opérandes dans les cases h-1 et h
+static void emettreArithmetique(Mnemoniques op, int h) {
+    int ka = h - 1, kb = h;
+    if (op == SUBR || op == DIVR) {
+        ka = h;
+        kb = h - 1;
+        op = (op == SUBR) ? SUB : DIVI;
+    }
+    char ta = tagDe(ka), tb = tagDe(kb);
+    if (ta == T_INT && tb == T_INT) {
+        operationEntiere(op, ka, kb, h - 1, T_INT, NULL);
+        return;
+    }
+    if (ta == T_REEL || tb == T_REEL) {
+        operationReelle(op, ka, ta, kb, tb, h - 1, T_REEL, NULL);
+        return;
+    }
+    // Un opérande au moins de type dynamique : deux chemins
+    Places p;
+    sauverPlaces(&p);
+    int reel = nouvelleEtiquette(), fin = nouvelleEtiquette();
+    if (ta == T_DYN && tb == T_DYN) {
+        emettre("mov eax, %s", tagTexte(ka, T_DYN));
+        emettre("or eax, %s", tagTexte(kb, T_DYN));
+        emettre("jnz .Lx%d", reel);
+    } else {
+        sautSiReel(ta == T_DYN ? ka : kb, "jnz", reel);
+    }
+    operationEntiere(op, ka, kb, h - 1, T_DYN, "0");
+    emettre("jmp .Lx%d", fin);
+    fprintf(sortie, ".Lx%d:\n", reel);
+    restaurerPlaces(&p);
+    operationReelle(op, ka, ta, kb, tb, h - 1, T_DYN, "1");
+    fprintf(sortie, ".Lx%d:\n", fin);
+}
+
+// Suffixe de condition x86 d'une relation entière
+static const char *conditionEntiere(Mnemoniques rel) {
+    switch (rel) {
+    case EQL: return "e";
+    case NEQ: return "ne";
+    case GTR: return "g";
+    case LSS: return "l";
+    case GEQ: return "ge";
+    default:  return "le";
+    }
+}
+
+// Relation testée par un branchement BEQ..BGE
+static Mnemoniques relationDe(Mnemoniques br) {
+    static const Mnemoniques R[] = {EQL, NEQ, LSS, LEQ, GTR, GEQ};
+    return R[br - BEQ];
+}
+
+// Compare les cases ka et kb en entiers et positionne les indicateurs
+static void comparerEntiers(int ka, int kb) {
+    const char *a = valeur(ka), *b = valeur(kb);
+    if (estImmediat(a) || (estMemoire(a) && estMemoire(b))) {
+        emettre("mov eax, %s", a);
+        a = "eax";
+    }
+    emettre("cmp %s, %s", a, b);
+}
+
+// Compare les cases ka et kb en réels ; retourne la condition (a, ae, e, ne)
+// à tester, xmm0 et xmm1 étant ordonnés par ucomiss selon la relation
+static const char *comparerReels(Mnemoniques rel, int ka, char ta, int kb, char tb) {
+    chargerReel(ka, ta, "xmm0");
+    chargerReel(kb, tb, "xmm1");
+    switch (rel) {
+    case GTR: emettre("ucomiss xmm0, xmm1"); return "a";
+    case GEQ: emettre("ucomiss xmm0, xmm1"); return "ae";
+    case LSS: emettre("ucomiss xmm1, xmm0"); return "a";
+    case LEQ: emettre("ucomiss xmm1, xmm0"); return "ae";
+    case EQL: emettre("ucomiss xmm0, xmm1"); return "e";
+    default:  emettre("ucomiss xmm0, xmm1"); return "ne";
+    }
+}
+
+// Relation entre les cases h-1 et h : résultat 0/1 dans la case h-1
+// (cible < 0) ou branchement vers cible si elle est vraie
+static void emettreComparaison(Mnemoniques rel, int h, int cible) {
+    int ka = h - 1, kb = h;
+    char ta = tagDe(ka), tb = tagDe(kb);
+    int deuxChemins = (ta == T_DYN || tb == T_DYN) && ta != T_REEL && tb != T_REEL;
+    Places p;
+    int reel = -1, fin = -1;
+    if (cible >= 0)
+        preparerSaut(cible, h - 2);
+    sauverPlaces(&p);
+    if (deuxChemins) {
+        reel = nouvelleEtiquette();
+        fin = nouvelleEtiquette();
+        if (ta == T_DYN && tb == T_DYN) {
+            emettre("mov eax, %s", tagTexte(ka, T_DYN));
+            emettre("or eax, %s", tagTexte(kb, T_DYN));
+            emettre("jnz .Lx%d", reel);
+        } else {
+            sautSiReel(ta == T_DYN ? ka : kb, "jnz", reel);
+        }
+    }
+    if (deuxChemins || (ta == T_INT && tb == T_INT)) {
+        comparerEntiers(ka, kb);
+        if (cible >= 0) {
+            emettre("j%s .L%d", conditionEntiere(rel), cible);
+        } else {
+            emettre("set%s al", conditionEntiere(rel));
+            emettre("movzx eax, al");
+            ecrireTemp(h - 1, "eax", T_INT, NULL);
+        }
+        if (!deuxChemins)
+            return;
+        emettre("jmp .Lx%d", fin);
+        fprintf(sortie, ".Lx%d:\n", reel);
+        restaurerPlaces(&p);
+    }
+    const char *c = comparerReels(rel, ka, deuxChemins ? T_DYN : ta, kb, deuxChemins ? T_DYN : tb);
+    if (cible >= 0) {
+        if (rel == EQL) {
+            int non = nouvelleEtiquette();
+            emettre("jp .Lx%d", non);
+            emettre("je .L%d", cible);
+            fprintf(sortie, ".Lx%d:\n", non);
+        } else if (rel == NEQ) {
+            emettre("jp .L%d", cible);
+            emettre("jne .L%d", cible);
+        } else {
+            emettre("j%s .L%d", c, cible);
+        }
+    } else {
+        if (rel == EQL) {
+            emettre("sete al");
+            emettre("setnp dl");
+            emettre("and al, dl");
+        } else if (rel == NEQ) {
+            emettre("setne al");
+            emettre("setp dl");
+            emettre("or al, dl");
+        } else {
+            emettre("set%s al", c);
+        }
+        emettre("movzx eax, al");
+        ecrireTemp(h - 1, "eax", T_INT, NULL);
+    }
+    if (deuxChemins)
+        fprintf(sortie, ".Lx%d:\n", fin);
+}
+
+// SHL / SHR k sur la case h (le type ne change pas)
+static void emettreDecalage(int gauche, int k, int h) {
+    char t = tagDe(h);
+    const char *v = valeur(h);
+    if (t == T_INT && estImmediat(v)) {
+        int x = atoi(v);
+        constante[IC(h)] = gauche ? (int)((unsigned)x << k) : (x + ((x >> 31) & ((1 << k) - 1))) >> k;
+        return;
+    }
+    Places p;
+    sauverPlaces(&p);
+    int reel = -1, fin = -1;
+    emettre("mov eax, %s", v);
+    if (t == T_DYN) {
+        reel = nouvelleEtiquette();
+        fin = nouvelleEtiquette();
+        sautSiReel(h, "jnz", reel);
+    }
+    if (t != T_REEL) {
+        if (gauche) {
+            emettre("shl eax, %d", k);
+        } else {
+            emettre("mov edx, eax");
+            emettre("sar edx, 31");
+            emettre("and edx, %d", (1 << k) - 1);
+            emettre("add eax, edx");
+            emettre("sar eax, %d", k);
+        }
+        ecrireTemp(h, "eax", t, NULL);
+    }
+    if (t == T_DYN) {
+        emettre("jmp .Lx%d", fin);
+        fprintf(sortie, ".Lx%d:\n", reel);
+        restaurerPlaces(&p);
+    }
+    if (t != T_INT) {
+        float puissance = (float)(1 << k);
+        int bits;
+        memcpy(&bits, &puissance, sizeof(bits));
+        emettre("movd xmm0, eax");
+        emettre("mov eax, %d", bits);
+        emettre("movd xmm1, eax");
+        emettre("%s xmm0, xmm1", gauche ? "mulss" : "divss");
+        emettre("movd eax, xmm0");
+        ecrireTemp(h, "eax", t, NULL);
+    }
+    if (t == T_DYN)
+        fprintf(sortie, ".Lx%d:\n", fin);
+}
+
+// Range la valeur de la case src (type t) dans la case du cadre dest (en mémoire)
+static void copierVersCadre(int src, char t, int dest) {
+    const char *v = valeur(src);
+    if (estMemoire(v)) {
+        emettre("mov eax, %s", v);
+        v = "eax";
+    }
+    emettre("mov %s, %s", memValeur(dest), v);
+    const char *tt = tagTexte(src, t);
+    if (estMemoire(tt)) {
+        emettre("mov edx, %s", tt);
+        tt = "edx";
+    }
+    emettre("mov %s, %s", memTag(dest), tt);
+}
+
+// Fin d'une procédure : restaure les registres sauvegardés à l'entrée
+static void epilogue(void) {
+    emettre("pop r12");
+    emettre("pop rbp");
+    emettre("pop rbx");
+}
+
+// Nombre de cases de passage de la procédure e (voir ReserverCasesDePassage)
+static int casesDePassage(int e) {
+    int idf = (e == 0) ? -1 : getProcFuncAtAddress(e);
+    return idf >= 0 ? TAB_IDFS[idf].Passage : 0;
+}
+
+// Traduit l'instruction i
+static void emettreInstruction(int i) {
+    Mnemoniques m = PCODE[i].MNE;
+    int a = PCODE[i].SUITE;
+    int h = etat->h;
+    Etat apres = *etat;
+    transferer(i, entreeCourante, &apres);
+    char tRes = apres.tag[IC(apres.h)] == T_AUCUN ? T_INT : apres.tag[IC(apres.h)];
+    const char *v, *tt;
+
+    fprintf(sortie, "\t# %d: %s %d\n", i, NomMnemonique(m), a);
+    switch (m) {
+    case LDI: case LDA: case LDF:
+        lieu[IC(h + 1)] = EN_CONST;
+        constante[IC(h + 1)] = a;
+        break;
+    case LLA: {
+        int r = registreTemp(h + 1);
+        if (r >= 0) {
+            emettre("lea %s, [r13%+d]", V32[r], a);
+            lieu[IC(h + 1)] = EN_REG;
+        } else {
+            emettre("lea eax, [r13%+d]", a);
+            ecrireTemp(h + 1, "eax", T_INT, NULL);
+        }
+        break;
+    }
+    case LDV: {
+        v = valeur(h);
+        int r = registreTemp(h);
+        const char *dv = r >= 0 ? V32[r] : "edx";
+        if (estImmediat(v)) {
+            int adr = atoi(v);
+            if (adr < 0 || adr >= TAILLEMEM) {
+                sautErreur("jmp", ERR_LDV);
+                break;
+            }
+            emettre("mov %s, DWORD PTR [r14%+d]", dv, 4 * adr);
+            if (r >= 0) {
+                if (tRes == T_DYN)
+                    emettre("mov %s, DWORD PTR [r15%+d]", T32[r], 4 * adr);
+                lieu[IC(h)] = EN_REG;
+            } else {
+                emettre("mov %s, edx", memValeur(h));
+                emettre("mov edx, DWORD PTR [r15%+d]", 4 * adr);
+                emettre("mov %s, edx", memTag(h));
+                lieu[IC(h)] = EN_MEM;
+            }
+            break;
+        }
+        emettre("mov eax, %s", v);
+        emettre("cmp eax, %d", TAILLEMEM - 1);
+        sautErreur("ja", ERR_LDV);
+        emettre("mov %s, DWORD PTR [r14+rax*4]", dv);
+        if (r >= 0) {
+            if (tRes == T_DYN)
+                emettre("mov %s, DWORD PTR [r15+rax*4]", T32[r]);
+            lieu[IC(h)] = EN_REG;
+        } else {
+            emettre("mov %s, edx", memValeur(h));
+            emettre("mov edx, DWORD PTR [r15+rax*4]");
+            emettre("mov %s, edx", memTag(h));
+            lieu[IC(h)] = EN_MEM;
+        }
+        break;
+    }
+    case STO: case STO_KEEP:
+        if (a == -9999 && m == STO)
+            break;
+        if (a < 0 || a >= TAILLEMEM) {
+            sautErreur("jmp", m == STO ? ERR_STO : ERR_STO_KEEP);
+            break;
+        }
+        v = valeur(h);
+        if (estMemoire(v)) {
+            emettre("mov eax, %s", v);
+            v = "eax";
+        }
+        emettre("mov DWORD PTR [r14%+d], %s", 4 * a, v);
+        if (!(estGlobale(a) && stable[a])) {
+            tt = tagTexte(h, tagDe(h));
+            if (estMemoire(tt)) {
+                emettre("mov edx, %s", tt);
+                tt = "edx";
+            }
+            emettre("mov DWORD PTR [r15%+d], %s", 4 * a, tt);
+        }
+        break;
+    case STO_IND: {
+        const char *adr = valeur(h);
+        v = valeur(h - 1);
+        tt = tagTexte(h - 1, tagDe(h - 1));
+        if (estMemoire(v)) {
+            emettre("mov r11d, %s", v);
+            v = "r11d";
+        }
+        if (estMemoire(tt)) {
+            emettre("mov edx, %s", tt);
+            tt = "edx";
+        }
+        if (estImmediat(adr)) {
+            int c = atoi(adr);
+            if (c < 0 || c >= TAILLEMEM) {
+                sautErreur("jmp", ERR_STO_IND);
+                break;
+            }
+            emettre("mov DWORD PTR [r14%+d], %s", 4 * c, v);
+            emettre("mov DWORD PTR [r15%+d], %s", 4 * c, tt);
+            break;
+        }
+        emettre("mov eax, %s", adr);
+        emettre("cmp eax, %d", TAILLEMEM - 1);
+        sautErreur("ja", ERR_STO_IND);
+        emettre("mov DWORD PTR [r14+rax*4], %s", v);
+        emettre("mov DWORD PTR [r15+rax*4], %s", tt);
+        break;
+    }
+    case LDL: {
+        v = valeur(a);
+        int r = registreTemp(h + 1);
+        if (r >= 0) {
+            emettre("mov %s, %s", V32[r], v);
+            if (tRes == T_DYN)
+                emettre("mov %s, %s", T32[r], memTag(a));
+            lieu[IC(h + 1)] = EN_REG;
+        } else {
+            if (estMemoire(v)) {
+                emettre("mov eax, %s", v);
+                v = "eax";
+            }
+            ecrireTemp(h + 1, v, tRes, tRes == T_DYN ? memTag(a) : NULL);
+        }
+        break;
+    }
+    case STL:
+        if (regLocal[IC(a)] >= 0) {
+            emettre("mov %s, %s", L32[regLocal[IC(a)]], valeur(h));
+            break;
+        }
+        copierVersCadre(h, tagDe(h), a);
+        break;
+    case ALC:
+        // Les cases de passage gardent ce qu'un TAILCALL y a rangé ; à l'entrée
+        // par un CALL, elles ne sont pas lues
+        for (int k = casesDePassage(entreeCourante) + 1; k <= a; k++) {
+            if (regLocal[IC(k)] >= 0) {
+                emettre("xor %s, %s", L32[regLocal[IC(k)]], L32[regLocal[IC(k)]]);
+            } else {
+                emettre("mov %s, 0", memValeur(k));
+                emettre("mov %s, 0", memTag(k));
+            }
+        }
+        break;
+    case SHL: case SHR:
+        emettreDecalage(m == SHL, a, h);
+        break;
+    case ADD: case SUB: case MUL: case DIVI: case SUBR: case DIVR:
+        emettreArithmetique(m, h);
+        break;
+    case EQL: case NEQ: case GTR: case LSS: case GEQ: case LEQ:
+        emettreComparaison(m, h, -1);
+        break;
+    case BEQ: case BNE: case BLT: case BLE: case BGT: case BGE:
+        emettreComparaison(relationDe(m), h, a);
+        break;
+    case BZE:
+        v = valeur(h);
+        preparerSaut(a, h - 1);
+        if (estImmediat(v)) {
+            if (atoi(v) == 0)
+                emettre("jmp .L%d", a);
+            break;
+        }
+        if (estMemoire(v))
+            emettre("cmp %s, 0", v);
+        else
+            emettre("test %s, %s", v, v);
+        emettre("jz .L%d", a);
+        break;
+    case BRN:
+        if (EstSautTerminal(i, entreeCourante)) {
+            epilogue();
+            emettre("jmp proc_%d", a);
+            break;
+        }
+        preparerSaut(a, h);
+        emettre("jmp .L%d", a);
+        break;
+    case PRN:
+        rangerTout(h - 1);
+        emettre("mov edi, %s", valeur(h));
+        emettre("mov esi, %s", tagTexte(h, tagDe(h)));
+        emettre("call rt_prn");
+        break;
+    case INN:
+        rangerTout(h - 1);
+        emettre("mov edi, %s", valeur(h));
+        emettre("call rt_inn");
+        break;
+    case CALL: {
+        int n = ArgumentsDe(a);
+        rangerTout(h);
+        int apresAppel = nouvelleEtiquette();
+        emettre("lea eax, [r13%+d]", h + 2 + PILE_REQUISE[a]);
+        emettre("cmp eax, %d", VAR_BASE);
+        sautErreur("jge", ERR_PILE);
+        if (PCODE[a].MNE == MEMO) {
+            emettre("mov edi, %d", a);
+            emettre("mov esi, %d", PCODE[a].SUITE);
+            emettre("lea edx, [r13%+d]", h);
+            emettre("call rt_consulter_memo");
+            emettre("test eax, eax");
+            emettre("jnz .Lx%d", apresAppel);
+        }
+        emettre("mov %s, %d", memValeur(h + 1), i + 1);
+        emettre("mov %s, 0", memTag(h + 1));
+        emettre("mov %s, r13d", memValeur(h + 2));
+        emettre("mov %s, 0", memTag(h + 2));
+        emettre("add r13, %d", h + 2);
+        emettre("call proc_%d", a);
+        fprintf(sortie, ".Lx%d:\n", apresAppel);
+        lieu[IC(h - n + 1)] = EN_MEM;
+        break;
+    }
+    case TAILCALL:
+        // Les arguments qui désignent une case du cadre passent dans les cases
+        // de passage de l'appelée : l'environnement C fait la copie
+        rangerTout(h);
+        emettre("mov edi, r13d");
+        emettre("lea esi, [r13%+d]", h);
+        emettre("mov edx, %d", a);
+        emettre("call rt_appel_terminal");
+        break;
+    case RET:
+        if (entreeCourante == 0) {
+            sautErreur("jmp", ERR_RET_BP);
+            break;
+        }
+        emettre("cmp r13d, %d", a + 1);
+        sautErreur("jl", ERR_RET_SP);
+        copierVersCadre(h, tagDe(h), -1 - a);
+        if (memoUtilisee) {
+            emettre("mov edi, r13d");
+            emettre("lea esi, [r13%+d]", -1 - a);
+            emettre("call rt_ranger_memo");
+        }
+        emettre("movsxd r13, DWORD PTR [r14+r13*4]");
+        epilogue();
+        emettre("ret");
+        break;
+    case MEMO:
+        break;
+    case HLT:
+        emettre("call rt_terminer");
+        break;
+    }
+}
+
+// Choisit les variables locales de la procédure e gardées en registres
+static void choisirLocales(int e) {
+    int utilisations[NB_CASES];
+    for (int k = 0; k < NB_CASES; k++) {
+        regLocal[k] = -1;
+        utilisations[k] = 0;
+    }
+    for (int k = 1; k <= nLocales[e]; k++) {
+        if (echappe[e][IC(k)])
+            continue;
+        int possible = 1;
+        for (int i = 0; i <= PC && possible; i++) {
+            if (procedureDe[i] != e || !etats[i].atteint || k > etats[i].h)
+                continue;
+            if (etats[i].tag[IC(k)] == T_DYN)
+                possible = 0;
+        }
+        if (!possible)
+            continue;
+        for (int i = 0; i <= PC; i++) {
+            if (procedureDe[i] == e && (PCODE[i].MNE == LDL || PCODE[i].MNE == STL) && PCODE[i].SUITE == k)
+                utilisations[IC(k)]++;
+        }
+    }
+    for (int r = 0; r < NB_REG_LOCAL; r++) {
+        int meilleur = -1;
+        for (int k = 1; k <= nLocales[e]; k++) {
+            if (regLocal[IC(k)] < 0 && utilisations[IC(k)] > 0 &&
+                (meilleur < 0 || utilisations[IC(k)] > utilisations[IC(meilleur)]))
+                meilleur = k;
+        }
+        if (meilleur < 0)
+            break;
+        regLocal[IC(meilleur)] = r;
+    }
+}
+
+static const char *nomProcedure(int e) {
+    if (e == 0)
+        return "programme principal";
+    int idf = getProcFuncAtAddress(e);
+    return idf >= 0 ? TAB_IDFS[idf].Nom : "?";
+}
+
+// Écrit la fonction assembleur de la procédure d'entrée e
+static void emettreProcedure(int e) {
+    entreeCourante = e;
+    nLoc = nLocales[e];
+    choisirLocales(e);
+    fprintf(sortie, "\n# %s\nproc_%d:\n", nomProcedure(e), e);
+    emettre("push rbx");
+    emettre("push rbp");
+    emettre("push r12");
+    int premiere = 1, precedente = -1;
+    for (int i = 0; i <= PC; i++) {
+        if (procedureDe[i] != e || !etats[i].atteint)
+            continue;
+        if (premiere && i != e)
+            emettre("jmp .L%d", e);
+        premiere = 0;
+        if (aEtiquette[i] || i == e) {
+            // La précédente y arrive en séquence : elle met les temporaires en place
+            if (precedente >= 0 && precedente == i - 1) {
+                etat = &etats[precedente];
+                Etat apres = etats[precedente];
+                transferer(precedente, e, &apres);
+                etat = &apres;
+                preparerSaut(i, apres.h);
+            }
+            fprintf(sortie, ".L%d:\n", i);
+            lieuxCanoniques();
+        }
+        etat = &etats[i];
+        emettreInstruction(i);
+        int suiv[2];
+        int ns = successeurs(i, e, suiv);
+        precedente = (ns > 0 && suiv[0] == i + 1 && PCODE[i].MNE != BRN) ? i : -1;
+    }
+    // Fin du code sans HLT ni RET : l'exécution s'arrête comme dans l'interpréteur
+    emettre("call rt_terminer");
+}
+
+// Écrit l'environnement C de l'exécutable (lecture, écriture, erreurs, mémoïsation)
+static int ecrireEnvironnement(const char *fichier) {
+    FILE *f = fopen(fichier, "w");
+    if (!f) {
+        perror("fopen");
+        return 0;
+    }
+    fprintf(f, "// Environnement d'exécution du P-code traduit en assembleur\n");
+    EcrireEnvironnementC(f);
+    fprintf(f, "\nvoid natif_executer(DataValue *mem, int *types);\n");
+    fprintf(f, "\n_Noreturn void rt_erreur(const char *msg) { Error(msg); }\n");
+    fprintf(f, "_Noreturn void rt_terminer(void) { terminer(); }\n");
+    fprintf(f, "\nvoid rt_appel_terminal(int bp, int sp, int n)\n{\n"
+               "    BP = bp;\n"
+               "    SP = sp;\n"
+               "    tailcall(n);\n"
+               "}\n");
+    fprintf(f, "\nvoid rt_prn(int bits, int type)\n{\n"
+               "    DataValue v;\n"
+               "    v.i = bits;\n"
+               "    if (type == TYPE_REAL)\n"
+               "        printf(\"PRN => %%f\\n\", v.f);\n"
+               "    else\n"
+               "        printf(\"PRN => %%d\\n\", v.i);\n"
+               "}\n");
+    // inn dépile l'adresse : elle passe par la case 0, rétablie ensuite
+    fprintf(f, "\nvoid rt_inn(int adr)\n{\n"
+               "    DataValue ancienne = MEM[0];\n"
+               "    SP = 0;\n"
+               "    MEM[0].i = adr;\n"
+               "    inn();\n"
+               "    if (adr != 0)\n"
+               "        MEM[0] = ancienne;\n"
+               "}\n");
+    if (memoUtilisee) {
+        fprintf(f, "\nint rt_consulter_memo(int cible, int n, int sp)\n{\n"
+                   "    SP = sp;\n"
+                   "    return consulterMemo(cible, n, sp + 2);\n"
+                   "}\n");
+        fprintf(f, "\nvoid rt_ranger_memo(int bp, int resultat)\n{\n"
+                   "    BP = bp;\n"
+                   "    rangerMemo(MEM[resultat], MEM_TYPE[resultat]);\n"
+                   "}\n");
+    }
+    fprintf(f, "\nint main(void)\n{\n");
+    EcrireInitialisationC(f);
+    fprintf(f, "    natif_executer(MEM, MEM_TYPE);\n    terminer();\n}\n");
+    fclose(f);
+    return 1;
+}
+
+// Écrit le fichier assembleur ; retourne 0 si la traduction est impossible
+static int ecrireAssembleur(const char *fichier) {
+    if (!analyserProgramme())
+        return 0;
+    memset(aEtiquette, 0, sizeof(aEtiquette));
+    for (int i = 0; i <= PC; i++) {
+        Mnemoniques m = PCODE[i].MNE;
+        if (m == BRN || m == BZE || (m >= BEQ && m <= BGE))
+            aEtiquette[PCODE[i].SUITE] = 1;
+    }
+    sortie = fopen(fichier, "w");
+    if (!sortie) {
+        perror("fopen");
+        return 0;
+    }
+    nEtiquettes = 0;
+    fprintf(sortie, "# Traduction en assembleur x86-64 du P-code (%d instructions)\n", PC + 1);
+    fprintf(sortie, "\t.intel_syntax noprefix\n\t.text\n");
+    // natif_executer(MEM, MEM_TYPE) : exécute le programme principal (BP = -1)
+    fprintf(sortie, "\n\t.globl natif_executer\nnatif_executer:\n");
+    emettre("push rbx");
+    emettre("push rbp");
+    emettre("push r12");
+    emettre("push r13");
+    emettre("push r14");
+    emettre("push r15");
+    emettre("sub rsp, 8");
+    emettre("mov r14, rdi");
+    emettre("mov r15, rsi");
+    emettre("mov r13, -1");
+    emettre("call proc_0");
+    emettre("add rsp, 8");
+    emettre("pop r15");
+    emettre("pop r14");
+    emettre("pop r13");
+    emettre("pop r12");
+    emettre("pop rbp");
+    emettre("pop rbx");
+    emettre("ret");
+    for (int e = 0; e <= PC; e++) {
+        if (estEntree[e] && etats[e].atteint)
+            emettreProcedure(e);
+    }
+    fprintf(sortie, "\n# Erreurs d'exécution\n");
+    for (int k = 0; k < NB_ERREURS; k++) {
+        fprintf(sortie, ".Lerreur%d:\n", k);
+        emettre("lea rdi, [rip+.Lmessage%d]", k);
+        emettre("call rt_erreur");
+    }
+    fprintf(sortie, "\n\t.section .rodata\n");
+    for (int k = 0; k < NB_ERREURS; k++)
+        fprintf(sortie, ".Lmessage%d:\n\t.string \"%s\"\n", k, MESSAGES[k]);
+    fprintf(sortie, "\t.section .note.GNU-stack,\"\",@progbits\n");
+    fclose(sortie);
+    return 1;
+}
+
+// CompilerAssembleur : voir generation_asm.h
+int CompilerAssembleur(const char *executable) {
+    char fichierS[512], fichierC[512];
+    if (PC < 0)
+        return 0;
+#if !defined(__x86_64__)
+    printf("Assembly backend: x86-64 only, using the C backend\n");
+    return CompilerNatif(executable);
+#endif
+    memoUtilisee = 0;
+    for (int i = 0; i <= PC; i++)
+        memoUtilisee |= PCODE[i].MNE == MEMO;
+    if (snprintf(fichierS, sizeof(fichierS), "%s.s", executable) >= (int)sizeof(fichierS) ||
+        snprintf(fichierC, sizeof(fichierC), "%s_rt.c", executable) >= (int)sizeof(fichierC)) {
+        fprintf(stderr, "Executable path too long: %s\n", executable);
+        return 0;
+    }
+    // Les états (plusieurs centaines de Ko) ne vivent que le temps de la traduction
+    etats = calloc(TAILLECODE, sizeof(Etat));
+    if (!etats) {
+        printf("Assembly backend: out of memory, using the C backend\n");
+        return CompilerNatif(executable);
+    }
+    int ecrit = ecrireAssembleur(fichierS);
+    int nProcs = 0;
+    for (int e = 0; ecrit && e <= PC; e++)
+        nProcs += estEntree[e] && etats[e].atteint;
+    free(etats);
+    etats = NULL;
+    if (!ecrit) {
+        printf("Assembly backend: %s, using the C backend\n", echec ? echec : "cannot write the file");
+        return CompilerNatif(executable);
+    }
+    if (!ecrireEnvironnement(fichierC))
+        return 0;
+    printf("Assembly written to %s (%d procedures), runtime in %s\n", fichierS, nProcs, fichierC);
+    const char *sources[] = { fichierS, fichierC };
+    if (!LancerCompilateurC(executable, sources, 2)) {
+        fprintf(stderr, "Assembly failed: %s, %s\n", fichierS, fichierC);
+        return 0;
+    }
+    printf("Native executable: %s\n", executable);
+    return 1;
+}
@@ -0,0 +1,25 @@
+#ifndef GENERATION_ASM_H
+#define GENERATION_ASM_H
+
+#include "global.h"  // Définitions globales (PCODE, PC, MEM_TYPE, etc.)
+
+// ---------------------------------------------------------------------
+// Génération d'assembleur x86-64 (option -asm=<exécutable>)
+// ---------------------------------------------------------------------
+// Chaque procédure devient une fonction assembleur (syntaxe Intel de GNU
+// as). Les temporaires de la pile d'évaluation et les variables locales
+// sont gardés dans des registres, les réels calculés avec SSE. Le type
+// (entier ou réel) de chaque valeur est déduit à la compilation quand il
+// ne dépend pas de l'exécution ; sinon il est lu dans MEM_TYPE et testé,
+// comme le ferait l'interpréteur. Un petit environnement en C (write,
+// read, erreurs, mémoïsation) est compilé avec l'assembleur : l'exécutable
+// affiche exactement ce qu'afficherait INTER_PCODE.
+
+// Écrit '<executable>.s' et '<executable>_rt.c' puis les assemble et les
+// lie avec le compilateur C du système ($CC, sinon cc). Si le P-code n'a
+// pas la forme attendue (code partagé entre procédures, pile trop haute...),
+// l'exécutable est produit par la traduction en C (CompilerNatif).
+// Retourne 1 si l'exécutable a été produit.
+int CompilerAssembleur(const char *executable);
+
+#endif
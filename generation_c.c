@@ -0,0 +1,837 @@
+#include "generation_c.h"
+#include "generation_pcode.h"  // PILE_REQUISE, NomMnemonique
+#include "semantique.h"        // TAB_IDFS, getProcFuncAtAddress
+#include "analyse_lexical.h"   // line_num (repris dans les messages d'erreur)
+#include <errno.h>             // EINTR
+#include <sys/wait.h>          // waitpid
+#include <unistd.h>            // fork, execvp
+
+// ---------------------------------------------------------------------
+// Environnement d'exécution du fichier produit
+// ---------------------------------------------------------------------
+// Les fonctions ci-dessous reprennent les cas de INTER_INST, messages
+// d'erreur compris. Elles sont appelées avec des arguments constants : le
+// compilateur C les intègre et supprime les vérifications inutiles
+// (adresse constante valide, opération connue...).
+static const char *ENTETE[] = {
+    "#include <stdio.h>",
+    "#include <stdlib.h>",
+    "#include <string.h>",
+    "",
+    "#define TAILLEMEM 500",
+    "#define VAR_BASE  200",
+    "",
+    "typedef union { int i; float f; } DataValue;",
+    "enum { TYPE_INT, TYPE_REAL };",
+    "enum { ADD, SUB, MUL, DIVI, SUBR, DIVR, EQL, NEQ, GTR, LSS, GEQ, LEQ };",
+    "",
+    "static DataValue MEM[TAILLEMEM];",
+    "static int       MEM_TYPE[TAILLEMEM];",
+    "static int       SP = -1;",
+    "static int       BP = -1;",
+    "",
+    "static _Noreturn void Error(const char *msg)",
+    "{",
+    "    fflush(stdout); /* Les write déjà faits précèdent le message, comme dans l'interpréteur */",
+    "    fprintf(stderr, \"Error line %d: %s (last token: '%s')\\n\", LIGNE_SOURCE, msg, DERNIER_TOKEN);",
+    "    exit(EXIT_FAILURE);",
+    "}",
+    "",
+    "static inline void empiler(int bits, int type, const char *debordement)",
+    "{",
+    "    SP++;",
+    "    if (SP >= TAILLEMEM) Error(debordement);",
+    "    MEM[SP].i = bits;",
+    "    MEM_TYPE[SP] = type;",
+    "}",
+    "",
+    "static inline void ldv(void)",
+    "{",
+    "    if (SP < 0) Error(\"Stack underflow LDV\");",
+    "    int adr = MEM[SP].i;",
+    "    if (adr < 0 || adr >= TAILLEMEM) Error(\"Invalid address LDV\");",
+    "    MEM[SP] = MEM[adr];",
+    "    MEM_TYPE[SP] = MEM_TYPE[adr];",
+    "}",
+    "",
+    "static inline void depiler(void)",
+    "{",
+    "    if (SP < 0) Error(\"Stack underflow STO\");",
+    "    SP--;",
+    "}",
+    "",
+    "static inline void sto(int adr)",
+    "{",
+    "    if (SP < 0) Error(\"Stack underflow STO\");",
+    "    DataValue v = MEM[SP];",
+    "    int t = MEM_TYPE[SP];",
+    "    SP--;",
+    "    if (adr < 0 || adr >= TAILLEMEM) Error(\"Invalid address STO\");",
+    "    MEM[adr] = v;",
+    "    MEM_TYPE[adr] = t;",
+    "}",
+    "",
+    "static inline void sto_keep(int adr)",
+    "{",
+    "    if (SP < 0) Error(\"Stack underflow STO_KEEP\");",
+    "    if (adr < 0 || adr >= TAILLEMEM) Error(\"Invalid address STO_KEEP\");",
+    "    MEM[adr] = MEM[SP];",
+    "    MEM_TYPE[adr] = MEM_TYPE[SP];",
+    "}",
+    "",
+    "static inline void ldl(int k)",
+    "{",
+    "    int src = BP + k;",
+    "    if (src < 0 || src >= TAILLEMEM) Error(\"LDL invalid address\");",
+    "    SP++;",
+    "    if (SP >= TAILLEMEM) Error(\"Stack overflow LDL\");",
+    "    MEM[SP] = MEM[src];",
+    "    MEM_TYPE[SP] = MEM_TYPE[src];",
+    "}",
+    "",
+    "static inline void stl(int k)",
+    "{",
+    "    if (SP < 0) Error(\"Stack underflow STL\");",
+    "    DataValue v = MEM[SP];",
+    "    int t = MEM_TYPE[SP];",
+    "    SP--;",
+    "    int dest = BP + k;",
+    "    if (dest < 0 || dest >= TAILLEMEM) Error(\"STL invalid address\");",
+    "    MEM[dest] = v;",
+    "    MEM_TYPE[dest] = t;",
+    "}",
+    "",
+    "static inline void alc(int n)",
+    "{",
+    "    if (SP < BP || SP > BP + n) Error(\"ALC outside procedure entry\");",
+    "    if (BP + n >= TAILLEMEM) Error(\"Stack overflow ALC\");",
+    "    while (SP < BP + n)",
+    "    {",
+    "        SP++;",
+    "        MEM[SP].i = 0;",
+    "        MEM_TYPE[SP] = TYPE_INT;",
+    "    }",
+    "}",
+    "",
+    "static inline void decaler(int gauche, int k)",
+    "{",
+    "    if (SP < 0) Error(\"Stack underflow SHIFT\");",
+    "    if (MEM_TYPE[SP] == TYPE_REAL)",
+    "    {",
+    "        float p = (float)(1 << k);",
+    "        MEM[SP].f = gauche ? MEM[SP].f * p : MEM[SP].f / p;",
+    "    }",
+    "    else if (gauche)",
+    "        MEM[SP].i = (int)((unsigned)MEM[SP].i << k);",
+    "    else",
+    "    {",
+    "        int x = MEM[SP].i;",
+    "        MEM[SP].i = (x + ((x >> 31) & ((1 << k) - 1))) >> k;",
+    "    }",
+    "}",
+    "",
+    "static inline void sto_ind(void)",
+    "{",
+    "    if (SP < 1) Error(\"Stack underflow STO_IND\");",
+    "    int adr = MEM[SP].i;",
+    "    if (adr < 0 || adr >= TAILLEMEM) Error(\"Invalid address STO_IND\");",
+    "    DataValue v = MEM[SP - 1];",
+    "    int t = MEM_TYPE[SP - 1];",
+    "    SP -= 2;",
+    "    MEM[adr] = v;",
+    "    MEM_TYPE[adr] = t;",
+    "}",
+    "",
+    "static inline void arith(int op)",
+    "{",
+    "    if (SP < 1) Error(\"Stack underflow OP\");",
+    "    DataValue v2 = MEM[SP];",
+    "    int t2 = MEM_TYPE[SP];",
+    "    SP--;",
+    "    DataValue v1 = MEM[SP];",
+    "    int t1 = MEM_TYPE[SP];",
+    "    if (op == SUBR || op == DIVR)",
+    "    {",
+    "        DataValue v = v1; v1 = v2; v2 = v;",
+    "        int t = t1; t1 = t2; t2 = t;",
+    "        op = (op == SUBR) ? SUB : DIVI;",
+    "    }",
+    "    if (t1 == TYPE_REAL || t2 == TYPE_REAL)",
+    "    {",
+    "        float f1 = (t1 == TYPE_REAL) ? v1.f : (float)v1.i;",
+    "        float f2 = (t2 == TYPE_REAL) ? v2.f : (float)v2.i;",
+    "        float r = 0;",
+    "        switch (op)",
+    "        {",
+    "        case ADD: r = f1 + f2; break;",
+    "        case SUB: r = f1 - f2; break;",
+    "        case MUL: r = f1 * f2; break;",
+    "        default:",
+    "            if (f2 == 0.0f) Error(\"Division by zero (float)\");",
+    "            r = f1 / f2;",
+    "        }",
+    "        MEM[SP].f = r;",
+    "        MEM_TYPE[SP] = TYPE_REAL;",
+    "        return;",
+    "    }",
+    "    int i1 = v1.i, i2 = v2.i, r;",
+    "    switch (op)",
+    "    {",
+    "    case ADD: r = i1 + i2; break;",
+    "    case SUB: r = i1 - i2; break;",
+    "    case MUL: r = i1 * i2; break;",
+    "    default:",
+    "        if (i2 == 0) Error(\"Division by zero (int)\");",
+    "        r = i1 / i2;",
+    "    }",
+    "    MEM[SP].i = r;",
+    "    MEM_TYPE[SP] = TYPE_INT;",
+    "}",
+    "",
+    "static inline int comparer(int rel, DataValue v1, int t1, DataValue v2, int t2)",
+    "{",
+    "    if (t1 == TYPE_REAL || t2 == TYPE_REAL)",
+    "    {",
+    "        float f1 = (t1 == TYPE_REAL) ? v1.f : (float)v1.i;",
+    "        float f2 = (t2 == TYPE_REAL) ? v2.f : (float)v2.i;",
+    "        switch (rel)",
+    "        {",
+    "        case EQL: return f1 == f2;",
+    "        case NEQ: return f1 != f2;",
+    "        case GTR: return f1 >  f2;",
+    "        case LSS: return f1 <  f2;",
+    "        case GEQ: return f1 >= f2;",
+    "        default:  return f1 <= f2;",
+    "        }",
+    "    }",
+    "    switch (rel)",
+    "    {",
+    "    case EQL: return v1.i == v2.i;",
+    "    case NEQ: return v1.i != v2.i;",
+    "    case GTR: return v1.i >  v2.i;",
+    "    case LSS: return v1.i <  v2.i;",
+    "    case GEQ: return v1.i >= v2.i;",
+    "    default:  return v1.i <= v2.i;",
+    "    }",
+    "}",
+    "",
+    "static inline void cmp(int rel)",
+    "{",
+    "    if (SP < 1) Error(\"Stack underflow CMP\");",
+    "    SP--;",
+    "    int r = comparer(rel, MEM[SP], MEM_TYPE[SP], MEM[SP + 1], MEM_TYPE[SP + 1]);",
+    "    MEM[SP].i = r;",
+    "    MEM_TYPE[SP] = TYPE_INT;",
+    "}",
+    "",
+    "static inline int branche(int rel)",
+    "{",
+    "    if (SP < 1) Error(\"Stack underflow CMP-BRANCH\");",
+    "    SP -= 2;",
+    "    return comparer(rel, MEM[SP + 1], MEM_TYPE[SP + 1], MEM[SP + 2], MEM_TYPE[SP + 2]);",
+    "}",
+    "",
+    "static inline int bze(void)",
+    "{",
+    "    if (SP < 0) Error(\"Stack underflow BZE\");",
+    "    SP--;",
+    "    return MEM[SP + 1].i == 0;",
+    "}",
+    "",
+    "static inline void prn(void)",
+    "{",
+    "    if (SP < 0) Error(\"Stack underflow PRN\");",
+    "    if (MEM_TYPE[SP] == TYPE_REAL)",
+    "        printf(\"PRN => %f\\n\", MEM[SP].f);",
+    "    else",
+    "        printf(\"PRN => %d\\n\", MEM[SP].i);",
+    "    SP--;",
+    "}",
+    "",
+    "static inline void inn(void)",
+    "{",
+    "    if (SP < 0) Error(\"Stack underflow INN\");",
+    "    int adr = MEM[SP].i;",
+    "    SP--;",
+    "    if (adr < 0 || adr >= TAILLEMEM) Error(\"Invalid address INN\");",
+    "    if (MEM_TYPE[adr] == TYPE_REAL)",
+    "    {",
+    "        float valf;",
+    "        printf(\"Enter a real: \");",
+    "        if (scanf(\"%f\", &valf) != 1) Error(\"Bad input real\");",
+    "        MEM[adr].f = valf;",
+    "        MEM_TYPE[adr] = TYPE_REAL;",
+    "    }",
+    "    else",
+    "    {",
+    "        int vali;",
+    "        printf(\"Enter an integer: \");",
+    "        if (scanf(\"%d\", &vali) != 1) Error(\"Bad input int\");",
+    "        MEM[adr].i = vali;",
+    "        MEM_TYPE[adr] = TYPE_INT;",
+    "    }",
+    "}",
+    "",
+    "static inline void appel(int retAddr, int pileRequise)",
+    "{",
+    "    if (SP + 2 + pileRequise >= VAR_BASE)",
+    "        Error(\"Stack overflow: the stack would reach the globals\");",
+    "    int oldBP = BP;",
+    "    SP++;",
+    "    if (SP >= TAILLEMEM) Error(\"Stack overflow CALL retAddr\");",
+    "    MEM[SP].i = retAddr;",
+    "    MEM_TYPE[SP] = TYPE_INT;",
+    "    SP++;",
+    "    if (SP >= TAILLEMEM) Error(\"Stack overflow CALL oldBP\");",
+    "    MEM[SP].i = oldBP;",
+    "    MEM_TYPE[SP] = TYPE_INT;",
+    "    BP = SP;",
+    "}",
+    "",
+    "static inline void tailcall(int n)",
+    "{",
+    "    if (SP - n < BP) Error(\"Stack underflow on TAILCALL\");",
+    "    int haut = SP - n, passage = 0;",
+    "    for (int i = 0; i < n; i++)",
+    "    {",
+    "        int pile = SP - n + 1 + i, a = MEM[pile].i;",
+    "        if (MEM_TYPE[pile] == TYPE_INT && a > BP && a <= haut)",
+    "        {",
+    "            MEM[pile] = MEM[a];",
+    "            MEM_TYPE[pile] = MEM_TYPE[a];",
+    "            MEM[BP + i - n - 1].i = BP + n - i;",
+    "            MEM_TYPE[BP + i - n - 1] = TYPE_INT;",
+    "            if (n - i > passage)",
+    "                passage = n - i;",
+    "            continue;",
+    "        }",
+    "        MEM[BP + i - n - 1]      = MEM[pile];",
+    "        MEM_TYPE[BP + i - n - 1] = MEM_TYPE[pile];",
+    "    }",
+    "    for (int i = 0; i < n; i++)",
+    "    {",
+    "        if (MEM_TYPE[BP + i - n - 1] == TYPE_INT && MEM[BP + i - n - 1].i == BP + n - i)",
+    "        {",
+    "            MEM[BP + n - i]      = MEM[SP - n + 1 + i];",
+    "            MEM_TYPE[BP + n - i] = MEM_TYPE[SP - n + 1 + i];",
+    "        }",
+    "    }",
+    "    SP = BP + passage;",
+    "}",
+    NULL
+};
+
+// Mémoïsation (seulement si le programme contient MEMO) : même cache que
+// l'interpréteur, pour que les compteurs affichés à la fin soient identiques
+static const char *ENTETE_MEMO[] = {
+    "",
+    "#define MEMO_FONCTIONS 16",
+    "#define MEMO_ENTREES   256",
+    "#define MEMO_ARGS      8",
+    "",
+    "typedef struct {",
+    "    int       occupee;",
+    "    DataValue args[MEMO_ARGS];",
+    "    int       types[MEMO_ARGS];",
+    "    DataValue resultat;",
+    "    int       typeResultat;",
+    "} EntreeMemo;",
+    "",
+    "typedef struct {",
+    "    int        adresse;",
+    "    long       succes, echecs;",
+    "    EntreeMemo entrees[MEMO_ENTREES];",
+    "} CacheMemo;",
+    "",
+    "typedef struct {",
+    "    int         bp;",
+    "    EntreeMemo *entree;",
+    "    EntreeMemo  cle;",
+    "} AttenteMemo;",
+    "",
+    "static CacheMemo   caches[MEMO_FONCTIONS];",
+    "static int         nCaches = 0;",
+    "static AttenteMemo attentes[TAILLEMEM];",
+    "static int         nAttentes = 0;",
+    "",
+    "static CacheMemo *cacheDe(int adr)",
+    "{",
+    "    for (int i = 0; i < nCaches; i++)",
+    "        if (caches[i].adresse == adr)",
+    "            return &caches[i];",
+    "    if (nCaches >= MEMO_FONCTIONS)",
+    "        return NULL;",
+    "    CacheMemo *c = &caches[nCaches++];",
+    "    memset(c, 0, sizeof(*c));",
+    "    c->adresse = adr;",
+    "    return c;",
+    "}",
+    "",
+    "static unsigned melangerMemo(unsigned h, unsigned x)",
+    "{",
+    "    for (int k = 0; k < 4; k++, x >>= 8)",
+    "        h = (h ^ (x & 0xFF)) * 16777619u;",
+    "    return h;",
+    "}",
+    "",
+    "static int consulterMemo(int cible, int n, int nouveauBP)",
+    "{",
+    "    if (n - 1 > MEMO_ARGS || n < 1 || SP - n + 1 < 0)",
+    "        return 0;",
+    "    CacheMemo *c = cacheDe(cible);",
+    "    if (!c)",
+    "        return 0;",
+    "    EntreeMemo cle;",
+    "    memset(&cle, 0, sizeof(cle));",
+    "    unsigned h = 2166136261u;",
+    "    for (int a = 1; a < n; a++)",
+    "    {",
+    "        int adr = MEM[SP - n + 1 + a].i;",
+    "        if (adr < 0 || adr >= TAILLEMEM)",
+    "            return 0;",
+    "        cle.args[a - 1] = MEM[adr];",
+    "        cle.types[a - 1] = MEM_TYPE[adr];",
+    "        h = melangerMemo(h, (unsigned)MEM[adr].i);",
+    "        h = melangerMemo(h, (unsigned)MEM_TYPE[adr]);",
+    "    }",
+    "    EntreeMemo *e = &c->entrees[h & (MEMO_ENTREES - 1)];",
+    "    int pareil = e->occupee;",
+    "    for (int a = 0; a < n - 1 && pareil; a++)",
+    "        pareil = e->types[a] == cle.types[a] && e->args[a].i == cle.args[a].i;",
+    "    if (pareil)",
+    "    {",
+    "        c->succes++;",
+    "        SP -= n;",
+    "        SP++;",
+    "        MEM[SP] = e->resultat;",
+    "        MEM_TYPE[SP] = e->typeResultat;",
+    "        return 1;",
+    "    }",
+    "    c->echecs++;",
+    "    if (nAttentes < TAILLEMEM)",
+    "    {",
+    "        attentes[nAttentes].bp = nouveauBP;",
+    "        attentes[nAttentes].entree = e;",
+    "        attentes[nAttentes].cle = cle;",
+    "        nAttentes++;",
+    "    }",
+    "    return 0;",
+    "}",
+    "",
+    "static void rangerMemo(DataValue v, int t)",
+    "{",
+    "    if (nAttentes > 0 && attentes[nAttentes - 1].bp == BP)",
+    "    {",
+    "        nAttentes--;",
+    "        EntreeMemo *e = attentes[nAttentes].entree;",
+    "        *e = attentes[nAttentes].cle;",
+    "        e->occupee = 1;",
+    "        e->resultat = v;",
+    "        e->typeResultat = t;",
+    "    }",
+    "}",
+    NULL
+};
+
+// RET et fin d'exécution, avec ou sans mémoïsation
+static const char *ENTETE_RET[] = {
+    "",
+    "static inline int ret(int n)",
+    "{",
+    "    if (BP < 1) Error(\"Invalid BP in RET\");",
+    "    int retAddr = MEM[BP - 1].i;",
+    "    int oldBP = MEM[BP].i;",
+    "    DataValue v = MEM[SP];",
+    "    int t = MEM_TYPE[SP];",
+    "    SP = BP - 2 - n;",
+    "    if (SP < -1) Error(\"Stack pointer negative in RET\");",
+    "    SP++;",
+    "    MEM[SP] = v;",
+    "    MEM_TYPE[SP] = t;",
+    "    RANGER_MEMO(v, t);",
+    "    BP = oldBP;",
+    "    return retAddr;",
+    "}",
+    "",
+    "static _Noreturn void terminer(void)",
+    "{",
+    "    printf(\"End of execution (HLT).\\n\");",
+    "    AFFICHER_MEMO();",
+    "    exit(0);",
+    "}",
+    NULL
+};
+
+static ETAT_PAR_FIL FILE *sortie;        // Fichier C en cours d'écriture
+static ETAT_PAR_FIL char  aEtiquette[TAILLECODE]; // L'instruction i commence par l'étiquette L<i>
+static ETAT_PAR_FIL int   procedureDe[TAILLECODE]; // Entrée de la procédure qui contient i (-1 : code mort)
+static ETAT_PAR_FIL char  estEntree[TAILLECODE];  // i est l'adresse du programme principal ou d'un CALL
+static ETAT_PAR_FIL int   enFonctions;   // 1 : une fonction C par procédure ; 0 : une seule fonction
+
+static void ecrireLignes(const char **lignes) {
+    for (int i = 0; lignes[i]; i++)
+        fprintf(sortie, "%s\n", lignes[i]);
+}
+
+// EstSautTerminal : voir generation_c.h
+int EstSautTerminal(int i, int entree) {
+    return PCODE[i].MNE == BRN && i > 0 && PCODE[i - 1].MNE == TAILCALL &&
+           estEntree[PCODE[i].SUITE] && PCODE[i].SUITE != entree;
+}
+
+// Parcourt le code de la procédure qui commence en 'entree' et l'attribue à
+// cette procédure. Retourne 0 si une instruction appartient déjà à une autre.
+static int attribuer(int entree) {
+    int pile[TAILLECODE], n = 0;
+    if (procedureDe[entree] >= 0)
+        return procedureDe[entree] == entree;
+    procedureDe[entree] = entree;
+    pile[n++] = entree;
+    while (n > 0) {
+        int i = pile[--n];
+        Mnemoniques m = PCODE[i].MNE;
+        if (m == RET || m == HLT || EstSautTerminal(i, entree))
+            continue;
+        int suivants[2] = {-1, -1};
+        if (m == BRN)
+            suivants[0] = PCODE[i].SUITE;
+        else {
+            suivants[0] = i + 1;
+            if (m == BZE || (m >= BEQ && m <= BGE))
+                suivants[1] = PCODE[i].SUITE;
+        }
+        for (int s = 0; s < 2; s++) {
+            int j = suivants[s];
+            if (j < 0 || j > PC)
+                continue;
+            if (procedureDe[j] == entree)
+                continue;
+            if (procedureDe[j] >= 0 || estEntree[j])
+                return 0; // Code partagé avec une autre procédure
+            procedureDe[j] = entree;
+            pile[n++] = j;
+        }
+    }
+    return 1;
+}
+
+// RepartirProcedures : voir generation_c.h
+int RepartirProcedures(int procedure[TAILLECODE], char entree[TAILLECODE]) {
+    memset(estEntree, 0, sizeof(estEntree));
+    estEntree[0] = 1;
+    for (int i = 0; i <= PC; i++) {
+        Mnemoniques m = PCODE[i].MNE;
+        int a = PCODE[i].SUITE;
+        if ((m == BRN || m == BZE || (m >= BEQ && m <= BGE) || m == CALL) && (a < 0 || a > PC))
+            Error("C backend: jump outside the program");
+        if (m == CALL)
+            estEntree[a] = 1;
+    }
+    for (int i = 0; i < TAILLECODE; i++)
+        procedureDe[i] = -1;
+    int separees = 1;
+    for (int e = 0; e <= PC && separees; e++) {
+        if (estEntree[e] && !attribuer(e))
+            separees = 0;
+    }
+    if (procedure)
+        memcpy(procedure, procedureDe, sizeof(procedureDe));
+    if (entree)
+        memcpy(entree, estEntree, sizeof(estEntree));
+    return separees;
+}
+
+// Repère les étiquettes et choisit la forme du fichier : une fonction C par
+// procédure si chacune a son propre code
+static void analyserCode(void) {
+    memset(aEtiquette, 0, sizeof(aEtiquette));
+    enFonctions = RepartirProcedures(NULL, NULL);
+    for (int i = 0; i <= PC; i++) {
+        Mnemoniques m = PCODE[i].MNE;
+        if (m == BRN || m == BZE || (m >= BEQ && m <= BGE) || m == CALL)
+            aEtiquette[PCODE[i].SUITE] = 1;
+    }
+    if (!enFonctions) {
+        // Une seule fonction : RET revient par le switch des adresses de retour
+        for (int i = 0; i <= PC; i++) {
+            if (PCODE[i].MNE == CALL && i + 1 <= PC)
+                aEtiquette[i + 1] = 1;
+        }
+        return;
+    }
+    // Une procédure dont l'entrée n'est pas sa première instruction y saute
+    for (int e = 0; e <= PC; e++) {
+        if (!estEntree[e])
+            continue;
+        for (int i = 0; i < e; i++) {
+            if (procedureDe[i] == e) {
+                aEtiquette[e] = 1;
+                break;
+            }
+        }
+    }
+}
+
+// Écrit un appel de la procédure 'cible' depuis l'instruction i
+static void ecrireAppel(int i, int cible) {
+    const char *indent = "    ";
+    if (PCODE[cible].MNE == MEMO) {
+        fprintf(sortie, "    if (!consulterMemo(%d, %d, SP + 2)) {\n", cible, PCODE[cible].SUITE);
+        indent = "        ";
+    }
+    fprintf(sortie, "%sappel(%d, %d);\n", indent, i + 1, PILE_REQUISE[cible]);
+    if (enFonctions)
+        fprintf(sortie, "%sproc_%d();\n", indent, cible);
+    else
+        fprintf(sortie, "%sgoto L%d;\n", indent, cible);
+    if (PCODE[cible].MNE == MEMO)
+        fprintf(sortie, "    }\n");
+}
+
+// Écrit la traduction de l'instruction i de la procédure 'entree'
+static void ecrireInstruction(int i, int entree) {
+    static const char *ARITH[] = {"ADD", "SUB", "MUL", "DIVI"};
+    static const char *RELATION[] = {"EQL", "NEQ", "LSS", "LEQ", "GTR", "GEQ"}; // BEQ..BGE
+    Mnemoniques m = PCODE[i].MNE;
+    int a = PCODE[i].SUITE;
+    if (aEtiquette[i])
+        fprintf(sortie, "L%d:\n", i);
+    switch (m) {
+    case LDI: fprintf(sortie, "    empiler(%d, TYPE_INT, \"Stack overflow LDI\");\n", a); break;
+    case LDA: fprintf(sortie, "    empiler(%d, TYPE_INT, \"Stack overflow LDA\");\n", a); break;
+    case LDF: fprintf(sortie, "    empiler(%d, TYPE_REAL, \"Stack overflow LDF\");\n", a); break;
+    case LLA: fprintf(sortie, "    empiler(BP + %d, TYPE_INT, \"Stack overflow LLA\");\n", a); break;
+    case LDV: fprintf(sortie, "    ldv();\n"); break;
+    case STO:
+        if (a == -9999)
+            fprintf(sortie, "    depiler();\n");
+        else
+            fprintf(sortie, "    sto(%d);\n", a);
+        break;
+    case STO_KEEP: fprintf(sortie, "    sto_keep(%d);\n", a); break;
+    case STO_IND:  fprintf(sortie, "    sto_ind();\n"); break;
+    case LDL:      fprintf(sortie, "    ldl(%d);\n", a); break;
+    case STL:      fprintf(sortie, "    stl(%d);\n", a); break;
+    case ALC:      fprintf(sortie, "    alc(%d);\n", a); break;
+    case SHL:      fprintf(sortie, "    decaler(1, %d);\n", a); break;
+    case SHR:      fprintf(sortie, "    decaler(0, %d);\n", a); break;
+    case ADD: case SUB: case MUL: case DIVI:
+        fprintf(sortie, "    arith(%s);\n", ARITH[m - ADD]);
+        break;
+    case SUBR:     fprintf(sortie, "    arith(SUBR);\n"); break;
+    case DIVR:     fprintf(sortie, "    arith(DIVR);\n"); break;
+    case EQL: case NEQ: case GTR: case LSS: case GEQ: case LEQ:
+        fprintf(sortie, "    cmp(%s);\n", NomMnemonique(m));
+        break;
+    case BEQ: case BNE: case BLT: case BLE: case BGT: case BGE:
+        fprintf(sortie, "    if (branche(%s)) goto L%d;\n", RELATION[m - BEQ], a);
+        break;
+    case BZE:      fprintf(sortie, "    if (bze()) goto L%d;\n", a); break;
+    case BRN:
+        if (enFonctions && EstSautTerminal(i, entree))
+            fprintf(sortie, "    proc_%d();\n    return;\n", a);
+        else
+            fprintf(sortie, "    goto L%d;\n", a);
+        break;
+    case PRN:      fprintf(sortie, "    prn();\n"); break;
+    case INN:      fprintf(sortie, "    inn();\n"); break;
+    case CALL:     ecrireAppel(i, a); break;
+    case TAILCALL: fprintf(sortie, "    tailcall(%d);\n", a); break;
+    case RET:
+        if (enFonctions)
+            fprintf(sortie, "    ret(%d);\n    return;\n", a);
+        else
+            fprintf(sortie, "    PCi = ret(%d);\n    goto aiguillage;\n", a);
+        break;
+    case MEMO:     fprintf(sortie, "    ;\n"); break;
+    case HLT:      fprintf(sortie, "    terminer();\n"); break;
+    }
+}
+
+// Nom de la procédure d'entrée e, pour les commentaires et la mémoïsation
+static const char *nomDe(int e) {
+    if (e == 0)
+        return "programme principal";
+    int idf = getProcFuncAtAddress(e);
+    return idf >= 0 ? TAB_IDFS[idf].Nom : "?";
+}
+
+// EcrireEnvironnementC : voir generation_c.h
+void EcrireEnvironnementC(FILE *f) {
+    sortie = f;
+    int memo = 0;
+    for (int i = 0; i <= PC; i++)
+        memo |= PCODE[i].MNE == MEMO;
+
+    // Les erreurs d'exécution citent la dernière ligne et le dernier symbole lus
+    fprintf(sortie, "#define LIGNE_SOURCE  %d\n", line_num);
+    fprintf(sortie, "#define DERNIER_TOKEN \"");
+    for (const char *c = symCour.nom; *c; c++) {
+        if (*c == '"' || *c == '\\')
+            fputc('\\', sortie);
+        if (isprint((unsigned char)*c))
+            fputc(*c, sortie);
+    }
+    fprintf(sortie, "\"\n");
+    ecrireLignes(ENTETE);
+    if (memo) {
+        ecrireLignes(ENTETE_MEMO);
+        fprintf(sortie, "\nstatic void afficherMemo(void)\n{\n");
+        fprintf(sortie, "    for (int i = 0; i < nCaches; i++)\n    {\n");
+        fprintf(sortie, "        const char *nom = \"?\";\n");
+        fprintf(sortie, "        switch (caches[i].adresse)\n        {\n");
+        for (int i = 0; i <= PC; i++) {
+            if (PCODE[i].MNE == MEMO)
+                fprintf(sortie, "        case %d: nom = \"%s\"; break;\n", i, nomDe(i));
+        }
+        fprintf(sortie, "        }\n");
+        fprintf(sortie, "        printf(\"Memo %%s: %%ld hits, %%ld misses\\n\", nom, caches[i].succes, caches[i].echecs);\n");
+        fprintf(sortie, "    }\n}\n");
+        fprintf(sortie, "#define RANGER_MEMO(v, t) rangerMemo(v, t)\n#define AFFICHER_MEMO() afficherMemo()\n");
+    } else {
+        fprintf(sortie, "#define RANGER_MEMO(v, t) ((void)(v), (void)(t))\n#define AFFICHER_MEMO() ((void)0)\n");
+    }
+    ecrireLignes(ENTETE_RET);
+}
+
+// EcrireInitialisationC : voir generation_c.h
+void EcrireInitialisationC(FILE *f) {
+    for (int a = 0; a < TAILLEMEM; a++) {
+        if (MEM_TYPE[a] != TYPE_INT)
+            fprintf(f, "    MEM_TYPE[%d] = %d;\n", a, MEM_TYPE[a]);
+    }
+    if (PILE_REQUISE[0] >= VAR_BASE)
+        fprintf(f, "    Error(\"Stack overflow: the main program's stack would reach the globals\");\n");
+}
+
+// GenererC : écrit le fichier C (voir generation_c.h)
+int GenererC(const char *fichierC) {
+    if (PC < 0)
+        return 0;
+    analyserCode();
+    FILE *f = fopen(fichierC, "w");
+    if (!f) {
+        perror("fopen");
+        return 0;
+    }
+    fprintf(f, "// Traduction en C du P-code (%d instructions)\n", PC + 1);
+    EcrireEnvironnementC(f);
+
+    if (enFonctions) {
+        fprintf(sortie, "\n");
+        for (int e = 1; e <= PC; e++) {
+            if (estEntree[e])
+                fprintf(sortie, "static void proc_%d(void);\n", e);
+        }
+        // Chaque procédure, ses instructions dans l'ordre des adresses
+        for (int e = 0; e <= PC; e++) {
+            if (!estEntree[e])
+                continue;
+            fprintf(sortie, "\n// %s\nstatic void proc_%d(void)\n{\n", nomDe(e), e);
+            int premiere = 1;
+            for (int i = 0; i <= PC; i++) {
+                if (procedureDe[i] != e)
+                    continue;
+                if (premiere && i != e)
+                    fprintf(sortie, "    goto L%d;\n", e);
+                premiere = 0;
+                ecrireInstruction(i, e);
+            }
+            fprintf(sortie, "}\n");
+        }
+    }
+
+    fprintf(sortie, "\nint main(void)\n{\n");
+    EcrireInitialisationC(sortie);
+    if (enFonctions) {
+        fprintf(sortie, "    proc_0();\n");
+    } else {
+        fprintf(sortie, "    int PCi;\n");
+        for (int i = 0; i <= PC; i++)
+            ecrireInstruction(i, 0);
+        fprintf(sortie, "    terminer();\naiguillage:\n    switch (PCi)\n    {\n");
+        for (int i = 0; i <= PC; i++) {
+            if (PCODE[i].MNE == CALL && i + 1 <= PC)
+                fprintf(sortie, "    case %d: goto L%d;\n", i + 1, i + 1);
+        }
+        fprintf(sortie, "    }\n");
+    }
+    fprintf(sortie, "    terminer();\n}\n");
+    fclose(sortie);
+
+    int n = 0;
+    for (int e = 0; e <= PC; e++)
+        n += estEntree[e];
+    if (enFonctions)
+        printf("C code written to %s (%d C functions)\n", fichierC, n);
+    else
+        printf("C code written to %s (one C function: procedures share code)\n", fichierC);
+    return 1;
+}
+
+// LancerCompilateurC : voir generation_c.h. Les chemins sont passés tels
+// quels au compilateur : guillemets, espaces et $ n'y ont aucun sens.
+int LancerCompilateurC(const char *executable, const char *sources[], int nSources) {
+    const char *cc = getenv("CC");
+    char mots[256];
+    if (snprintf(mots, sizeof(mots), "%s", cc && *cc ? cc : "cc") >= (int)sizeof(mots)) {
+        fprintf(stderr, "CC is too long\n");
+        return 0;
+    }
+    char *argv[40];
+    int argc = 0;
+    char *reste;
+    for (char *m = strtok_r(mots, " \t", &reste); m; m = strtok_r(NULL, " \t", &reste)) {
+        if (argc + 3 + nSources + 1 > (int)(sizeof(argv) / sizeof(argv[0]))) {
+            fprintf(stderr, "CC has too many words\n");
+            return 0;
+        }
+        argv[argc++] = m;
+    }
+    if (argc == 0)
+        argv[argc++] = "cc";
+    argv[argc++] = "-O2";
+    argv[argc++] = "-o";
+    argv[argc++] = (char *)executable;
+    for (int k = 0; k < nSources; k++)
+        argv[argc++] = (char *)sources[k];
+    argv[argc] = NULL;
+
+    fflush(NULL); // Nos messages avant ceux du compilateur
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return 0;
+    }
+    if (pid == 0) {
+        execvp(argv[0], argv);
+        perror(argv[0]);
+        _exit(127);
+    }
+    int statut;
+    while (waitpid(pid, &statut, 0) < 0) {
+        if (errno != EINTR) {
+            perror("waitpid");
+            return 0;
+        }
+    }
+    return WIFEXITED(statut) && WEXITSTATUS(statut) == 0;
+}
+
+// CompilerNatif : produit l'exécutable (voir generation_c.h)
+int CompilerNatif(const char *executable) {
+    char fichierC[512];
+    if (snprintf(fichierC, sizeof(fichierC), "%s.c", executable) >= (int)sizeof(fichierC)) {
+        fprintf(stderr, "Executable path too long: %s\n", executable);
+        return 0;
+    }
+    if (!GenererC(fichierC))
+        return 0;
+    const char *sources[] = { fichierC };
+    if (!LancerCompilateurC(executable, sources, 1)) {
+        fprintf(stderr, "C compilation failed: %s\n", fichierC);
+        return 0;
+    }
+    printf("Native executable: %s\n", executable);
+    return 1;
+}
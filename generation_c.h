@@ -0,0 +1,51 @@
+#ifndef GENERATION_C_H
+#define GENERATION_C_H
+
+#include "global.h"  // Définitions globales (PCODE, PC, MEM_TYPE, etc.)
+
+// ---------------------------------------------------------------------
+// Traduction du P-code en C (option -native=<exécutable>)
+// ---------------------------------------------------------------------
+// Le P-code final est traduit en un fichier C autonome qui affiche
+// exactement ce qu'afficherait INTER_PCODE : chaque instruction devient
+// l'appel d'une petite fonction du même fichier (reprise de l'interpréteur,
+// argument constant), chaque cible de branchement une étiquette, la mémoire
+// un tableau statique. Si chaque procédure a son propre code (pas de saut
+// vers le code d'une autre, sauf appel terminal), elle devient une fonction
+// C ; sinon tout le programme est une seule fonction et RET saute à
+// l'adresse de retour par un switch.
+
+// Écrit la traduction de PCODE[0..PC] dans le fichier 'fichierC'.
+// Retourne 1 si le fichier a été écrit, 0 sinon.
+int GenererC(const char *fichierC);
+
+// Écrit '<executable>.c' puis le compile avec le compilateur C du système
+// ($CC, sinon cc) en -O2. Retourne 1 si l'exécutable a été produit.
+int CompilerNatif(const char *executable);
+
+// ---------------------------------------------------------------------
+// Éléments partagés avec la génération d'assembleur (generation_asm.c)
+// ---------------------------------------------------------------------
+
+// Repère les entrées (adresse 0 et cibles des CALL) et attribue à chaque
+// instruction accessible l'entrée de sa procédure (-1 : code mort), en
+// suivant les branchements mais pas les appels terminaux. Les tableaux
+// peuvent être NULL. Retourne 1 si chaque procédure a son propre code.
+int RepartirProcedures(int procedure[TAILLECODE], char entree[TAILLECODE]);
+
+// Indique si l'instruction i de la procédure 'entree' est le BRN qui suit un
+// TAILCALL vers une autre procédure (après RepartirProcedures)
+int EstSautTerminal(int i, int entree);
+
+// Écrit l'environnement d'exécution C : mémoire, Error, fonctions reprises de
+// l'interpréteur, mémoïsation si le programme contient MEMO, ret et terminer
+void EcrireEnvironnementC(FILE *f);
+
+// Écrit le début de main : types des globales réelles, vérification de la pile
+void EcrireInitialisationC(FILE *f);
+
+// Lance "$CC -O2 -o executable sources..." ($CC, sinon cc, découpé aux
+// espaces) sans passer par le shell. Retourne 1 si la commande a réussi.
+int LancerCompilateurC(const char *executable, const char *sources[], int nSources);
+
+#endif
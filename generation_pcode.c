@@ -1,92 +1,442 @@
-#include "generation_pcode.h"
-#include "semantique.h"
-
-// Tableau global de P-code qui va stocker toutes les instructions générées
-INSTRUCTION PCODE[TAILLECODE];
-// PC (Program Counter) : index de la dernière instruction écrite dans PCODE
-// Initialisé à -1 car aucune instruction n'a encore été écrite
-int PC = -1;
-
-// ---------------------------------------------------------------------
-// Ecrire1 : Écrit une instruction sans argument dans le tableau PCODE
-// ---------------------------------------------------------------------
-// Paramètre M : le mnémonique (instruction) à ajouter
-void Ecrire1(Mnemoniques M) {
-    // Vérifie qu'on n'a pas dépassé la taille maximale du tableau
-    if (PC >= TAILLECODE - 1)
-        Error("Too many instructions");
-    PC++;                   // Incrémente le compteur de programme
-    PCODE[PC].MNE = M;      // Stocke le mnémonique dans l'instruction courante
-    PCODE[PC].SUITE = 0;    // Aucun argument n'est nécessaire, on met 0
-}
-
-// ---------------------------------------------------------------------
-// Ecrire2 : Écrit une instruction avec un argument entier dans PCODE
-// ---------------------------------------------------------------------
-// Paramètre M   : le mnémonique (instruction) à ajouter
-// Paramètre arg : l'argument entier associé à l'instruction
-void Ecrire2(Mnemoniques M, int arg) {
-    // Vérifie qu'on n'a pas dépassé la capacité du tableau
-    if (PC >= TAILLECODE - 1)
-        Error("Too many instructions");
-    PC++;                   // Passe à la prochaine position
-    PCODE[PC].MNE = M;      // Assigne le mnémonique
-    PCODE[PC].SUITE = arg;  // Stocke l'argument associé à l'instruction
-}
-
-// ---------------------------------------------------------------------
-// afficherPCode : Affiche toutes les instructions du P-code
-// ---------------------------------------------------------------------
-// Parcourt le tableau PCODE et imprime pour chaque instruction son index,
-// le mnémonique et l'argument
-void afficherPCode() {
-    for (int i = 0; i <= PC; i++) {
-        printf("%3d : (%d, %d)\n", i, PCODE[i].MNE, PCODE[i].SUITE);
-    }
-}
-
-// ---------------------------------------------------------------------
-// sauvegarderPCode : Sauvegarde le P-code dans un fichier
-// ---------------------------------------------------------------------
-// Paramètre filename : le nom du fichier où le P-code sera sauvegardé
-// Ouvre le fichier, écrit chaque instruction et ferme le fichier.
-void sauvegarderPCode(const char* filename) {
-    FILE* f = fopen(filename, "w");
-    if (!f) {
-        perror("fopen");
-        return;
-    }
-    for (int i = 0; i <= PC; i++) {
-        // Écrit le mnémonique et l'argument de chaque instruction sur une ligne
-        fprintf(f, "%d %d\n", PCODE[i].MNE, PCODE[i].SUITE);
-    }
-    fclose(f);
-    printf("P-code saved in %s\n", filename);
-}
-
-// ---------------------------------------------------------------------
-// chargerPCode : Charge le P-code à partir d'un fichier
-// ---------------------------------------------------------------------
-// Paramètre filename : le nom du fichier d'où charger le P-code
-// Lit chaque instruction du fichier et les stocke dans PCODE, puis ferme le fichier.
-void chargerPCode(const char* filename) {
-    FILE* f = fopen(filename, "r");
-    if (!f) {
-        perror("fopen");
-        exit(EXIT_FAILURE);
-    }
-    PC = -1;  // Réinitialise le compteur de programme
-    while (!feof(f)) {
-        int m, s;
-        // Lit un mnémonique et son argument depuis le fichier
-        if (fscanf(f, "%d %d", &m, &s) == 2) {
-            PC++;
-            if (PC >= TAILLECODE)
-                Error("P-code too large");
-            PCODE[PC].MNE = (Mnemoniques)m; // Convertit en type Mnemoniques
-            PCODE[PC].SUITE = s;
-        }
-    }
-    fclose(f);
-    printf("P-code loaded from %s (PC=%d)\n", filename, PC);
-}
+#include "generation_pcode.h"
+#include "semantique.h"
+
+// Tableau global de P-code qui va stocker toutes les instructions générées
+ETAT_PAR_FIL INSTRUCTION PCODE[TAILLECODE];
+// PC (Program Counter) : index de la dernière instruction écrite dans PCODE
+// Initialisé à -1 car aucune instruction n'a encore été écrite
+ETAT_PAR_FIL int PC = -1;
+
+// ---------------------------------------------------------------------
+// Ecrire1 : Écrit une instruction sans argument dans le tableau PCODE
+// ---------------------------------------------------------------------
+// Paramètre M : le mnémonique (instruction) à ajouter
+void Ecrire1(Mnemoniques M) {
+    // Vérifie qu'on n'a pas dépassé la taille maximale du tableau
+    if (PC >= TAILLECODE - 1)
+        Error("Too many instructions");
+    PC++;                   // Incrémente le compteur de programme
+    PCODE[PC].MNE = M;      // Stocke le mnémonique dans l'instruction courante
+    PCODE[PC].SUITE = 0;    // Aucun argument n'est nécessaire, on met 0
+}
+
+// ---------------------------------------------------------------------
+// Ecrire2 : Écrit une instruction avec un argument entier dans PCODE
+// ---------------------------------------------------------------------
+// Paramètre M   : le mnémonique (instruction) à ajouter
+// Paramètre arg : l'argument entier associé à l'instruction
+void Ecrire2(Mnemoniques M, int arg) {
+    // Vérifie qu'on n'a pas dépassé la capacité du tableau
+    if (PC >= TAILLECODE - 1)
+        Error("Too many instructions");
+    PC++;                   // Passe à la prochaine position
+    PCODE[PC].MNE = M;      // Assigne le mnémonique
+    PCODE[PC].SUITE = arg;  // Stocke l'argument associé à l'instruction
+}
+
+// ---------------------------------------------------------------------
+// argumentsHorsCadre : remonte depuis le CALL en position 'appel' jusqu'au
+// début du code de ses n arguments (effet de chaque instruction sur la pile)
+// et vérifie qu'aucun n'empile l'adresse d'une case du cadre (LLA k, k >= 1)
+// ni, si transmis vaut 0, ne transmet un paramètre reçu (LDL k, k < 0).
+// Retourne 0 dans le doute (instruction inattendue, début non trouvé).
+// ---------------------------------------------------------------------
+static int argumentsHorsCadre(int appel, int n, int debut, int transmis) {
+    int manquants = n; // Valeurs qu'il reste à trouver en remontant
+    for (int j = appel - 1; j >= debut && manquants > 0; j--) {
+        switch (PCODE[j].MNE) {
+        case LLA:
+            if (PCODE[j].SUITE >= 1)
+                return 0;
+            manquants--;
+            break;
+        case LDL:
+            if (PCODE[j].SUITE < 0 && !transmis)
+                return 0;
+            manquants--;
+            break;
+        case LDI: case LDA: case LDF:
+            manquants--;
+            break;
+        case LDV: case STO_KEEP: case SHL: case SHR:
+            break;
+        case ADD: case SUB: case MUL: case DIVI: case SUBR: case DIVR:
+        case EQL: case NEQ: case GTR: case LSS: case GEQ: case LEQ:
+        case STO: case STL: case PRN: case INN:
+            manquants++;
+            break;
+        case STO_IND:
+            manquants += 2;
+            break;
+        case CALL: {
+            int q = getProcFuncAtAddress(PCODE[j].SUITE);
+            if (q < 0)
+                return 0;
+            manquants += getArgCount(q) - 1;
+            break;
+        }
+        default:
+            return 0;
+        }
+    }
+    return manquants == 0;
+}
+
+// ---------------------------------------------------------------------
+// AppelEnPositionTerminale : position du CALL terminal du corps code[debut..ret]
+// ---------------------------------------------------------------------
+// Un CALL est terminal si, après lui, il ne reste avant le RET que :
+//   - rien (le résultat de l'appel est rendu tel quel),
+//   - STO -9999 (appel de procédure dont le résultat est ignoré),
+//   - STL r ; LDL r avec r la case du résultat (fonction dont le résultat
+//     est celui de l'appel).
+// Retourne -1 s'il n'y en a pas.
+int AppelEnPositionTerminale(const INSTRUCTION *code, int ret, int debut) {
+    int r = CASE_ARGUMENT(0, code[ret].SUITE);
+    int i = ret - 1;
+    if (i >= debut && code[i].MNE == STO && code[i].SUITE == -9999)
+        i--;
+    else if (i - 1 >= debut && code[i].MNE == LDL && code[i].SUITE == r &&
+             code[i - 1].MNE == STL && code[i - 1].SUITE == r)
+        i -= 2;
+    return (i >= debut && code[i].MNE == CALL) ? i : -1;
+}
+
+// ---------------------------------------------------------------------
+// MarquerAppelTerminal : Transforme un CALL en position terminale en TAILCALL
+// ---------------------------------------------------------------------
+// À appeler juste après avoir écrit le RET d'une procédure ou fonction.
+// L'appel devient "TAILCALL n ; BRN adresse", qui occupe la case suivant
+// le CALL : elle ne doit pas être la cible d'un saut. Les arguments sont
+// recopiés sur ceux du cadre courant, il faut donc que l'appelée en prenne
+// autant que l'appelante (n, argument du RET).
+// Un argument passé par valeur désigne une case du cadre courant (LLA k) :
+// TAILCALL recopie sa valeur dans les cases de passage de l'appelée (voir
+// ReserverCasesDePassage). Une appelée qui n'en a pas ne reçoit que des
+// adresses hors du cadre : globales, et paramètres reçus par une appelante
+// qui n'a pas non plus de cases de passage.
+// Paramètre ret   : position du RET
+// Paramètre debut : première instruction du corps (on ne remonte pas avant)
+void MarquerAppelTerminal(int ret, int debut) {
+    int n = PCODE[ret].SUITE;
+    int i = AppelEnPositionTerminale(PCODE, ret, debut);
+    if (i < 0)
+        return;
+
+    // L'appelée doit prendre exactement n arguments
+    int appelee = getProcFuncAtAddress(PCODE[i].SUITE);
+    if (appelee < 0 || getArgCount(appelee) != n)
+        return;
+
+    // Sans cases de passage, aucun argument ne doit être une case du cadre
+    // courant (appelante inconnue : debut ne désigne pas son entrée)
+    if (TAB_IDFS[appelee].Passage < TAB_IDFS[appelee].Value) {
+        int appelante = getProcFuncAtAddress(debut);
+        int transmis = appelante >= 0 && TAB_IDFS[appelante].Passage == 0;
+        if (!argumentsHorsCadre(i, n, debut, transmis))
+            return;
+    }
+
+    // La case écrasée par le BRN ne doit pas être la cible d'un saut
+    for (int j = debut; j <= PC; j++) {
+        Mnemoniques m = PCODE[j].MNE;
+        if ((m == BRN || m == BZE || (m >= BEQ && m <= BGE)) && PCODE[j].SUITE == i + 1)
+            return;
+    }
+
+    int adresse = PCODE[i].SUITE;
+    PCODE[i].MNE = TAILCALL;
+    PCODE[i].SUITE = n;
+    PCODE[i + 1].MNE = BRN;
+    PCODE[i + 1].SUITE = adresse;
+}
+
+// ---------------------------------------------------------------------
+// Allocation des cases du cadre
+// ---------------------------------------------------------------------
+// Les variables locales d'une procédure et les temporaires du compilateur
+// (limite d'un "for", valeur d'un "case") occupent les cases BP+1, BP+2...
+// du cadre. Une variable locale garde sa case jusqu'à la fin de la
+// procédure ; un temporaire la rend à la fin de sa construction, et les
+// constructions disjointes réutilisent ainsi les mêmes cases.
+static ETAT_PAR_FIL char caseOccupee[MAX_CASES_CADRE + 1]; // caseOccupee[k] : case BP+k prise
+static ETAT_PAR_FIL int  tailleCadre = 0;                  // Nombre de cases réservées par ALC
+static ETAT_PAR_FIL int  posALC = -1;                      // Position du ALC à compléter
+
+// DebutCadre : écrit "ALC 0" à l'entrée du code d'une procédure (ou du
+// programme principal) ; sa taille est fixée par FinCadre
+void DebutCadre(void) {
+    memset(caseOccupee, 0, sizeof(caseOccupee));
+    tailleCadre = 0;
+    Ecrire2(ALC, 0);
+    posALC = PC;
+}
+
+// AllouerCase : retourne la première case libre du cadre
+int AllouerCase(void) {
+    for (int k = 1; k <= MAX_CASES_CADRE; k++) {
+        if (!caseOccupee[k]) {
+            caseOccupee[k] = 1;
+            if (k > tailleCadre)
+                tailleCadre = k;
+            return k;
+        }
+    }
+    Error("Too many local variables");
+    return -1;
+}
+
+// LibererCase : rend une case de temporaire
+void LibererCase(int k) {
+    caseOccupee[k] = 0;
+}
+
+// ReserverCasesDePassage : un argument calculé est une case du cadre de
+// l'appelant (LLA k) ; sur un appel terminal, ce cadre devient celui de
+// l'appelée. TAILCALL range alors la valeur de l'argument a (sur n) dans la
+// case BP + n - a de l'appelée, symétrique de celle de l'argument par
+// rapport à BP. Les cases du corps code[0..taille-1] (compilé seul, sauts
+// relatifs au corps) remontent donc de p, pour que ses p premières ne
+// servent qu'à cela. Un corps sans ALC en reçoit un, et son code descend
+// d'une case : le tableau doit en avoir une de plus. Retourne la taille.
+// L'appelant vérifie que le cadre ne dépasse pas MAX_CASES_CADRE.
+int ReserverCasesDePassage(INSTRUCTION *code, int taille, int p) {
+    if (taille == 0 || code[0].MNE != ALC) {
+        memmove(code + 1, code, (size_t)taille * sizeof(INSTRUCTION));
+        code[0].MNE = ALC;
+        code[0].SUITE = 0;
+        taille++;
+        for (int i = 1; i < taille; i++) {
+            Mnemoniques m = code[i].MNE;
+            if (m == BRN || m == BZE || (m >= BEQ && m <= BGE))
+                code[i].SUITE++;
+        }
+    }
+    for (int i = 1; i < taille; i++) {
+        Mnemoniques m = code[i].MNE;
+        if ((m == LDL || m == STL || m == LLA) && code[i].SUITE >= 1)
+            code[i].SUITE += p;
+    }
+    code[0].SUITE += p;
+    return taille;
+}
+
+// FinCadre : fixe la taille du cadre. Un cadre vide n'a pas besoin de ALC :
+// l'instruction est retirée et le code qui la suit remonte d'une case.
+void FinCadre(void) {
+    if (tailleCadre > 0) {
+        PCODE[posALC].SUITE = tailleCadre;
+        return;
+    }
+    for (int i = posALC; i < PC; i++)
+        PCODE[i] = PCODE[i + 1];
+    PC--;
+    // Seuls les sauts internes au code qui suit visent au-delà du ALC
+    for (int i = posALC; i <= PC; i++) {
+        Mnemoniques m = PCODE[i].MNE;
+        if ((m == BRN || m == BZE || (m >= BEQ && m <= BGE)) && PCODE[i].SUITE > posALC)
+            PCODE[i].SUITE--;
+    }
+    posALC = -1;
+}
+
+// ---------------------------------------------------------------------
+// Pile requise par chaque procédure
+// ---------------------------------------------------------------------
+// La hauteur h = SP - BP est propagée le long du flot de contrôle depuis
+// l'entrée (h = 0 juste après le CALL, comme au début du programme). Un CALL
+// dépile les n arguments de l'appelée et empile son résultat ; les deux
+// cases de liaison et le cadre de l'appelée comptent pour l'appelée.
+ETAT_PAR_FIL int PILE_REQUISE[TAILLECODE];
+
+// Variation de h après l'instruction i (n : arguments de l'appelée d'un CALL)
+static int effetPile(int i, int n) {
+    switch (PCODE[i].MNE) {
+    case LDI: case LDA: case LDL: case LDF: case LLA:
+        return 1;
+    case ADD: case SUB: case MUL: case DIVI: case SUBR: case DIVR:
+    case EQL: case NEQ: case GTR: case LSS: case GEQ: case LEQ:
+    case STO: case STL: case PRN: case INN: case BZE:
+        return -1;
+    case STO_IND: case BEQ: case BNE: case BLT: case BLE: case BGT: case BGE:
+        return -2;
+    case ALC:
+        return PCODE[i].SUITE;
+    case CALL:
+        return 1 - n;
+    default: // LDV, STO_KEEP, SHL, SHR, MEMO, BRN
+        return 0;
+    }
+}
+
+// ArgumentsDe : nombre d'arguments de la procédure qui commence en 'entree' :
+// celui de son premier RET (0 si elle ne revient jamais)
+int ArgumentsDe(int entree) {
+    static ETAT_PAR_FIL char vu[TAILLECODE];
+    int pile[TAILLECODE], n = 0, resultat = 0;
+    memset(vu, 0, sizeof(vu));
+    pile[n++] = entree;
+    vu[entree] = 1;
+    while (n > 0) {
+        int i = pile[--n];
+        Mnemoniques m = PCODE[i].MNE;
+        if (m == RET) {
+            resultat = PCODE[i].SUITE;
+            break;
+        }
+        if (m == HLT)
+            continue;
+        int suivants[2] = {-1, -1};
+        if (m == BRN)
+            suivants[0] = PCODE[i].SUITE;
+        else {
+            suivants[0] = i + 1;
+            if (m == BZE || (m >= BEQ && m <= BGE))
+                suivants[1] = PCODE[i].SUITE;
+        }
+        for (int s = 0; s < 2; s++) {
+            int j = suivants[s];
+            if (j >= 0 && j <= PC && !vu[j]) {
+                vu[j] = 1;
+                pile[n++] = j;
+            }
+        }
+    }
+    return resultat;
+}
+
+// Hauteur maximale atteinte par le code qui commence en 'entree'
+static int hauteurMaximale(int entree) {
+    static ETAT_PAR_FIL int hauteur[TAILLECODE];
+    int pile[TAILLECODE], n = 0, max = 0;
+    for (int i = 0; i <= PC; i++)
+        hauteur[i] = -1;
+    hauteur[entree] = 0;
+    pile[n++] = entree;
+    while (n > 0) {
+        int i = pile[--n];
+        Mnemoniques m = PCODE[i].MNE;
+        if (m == RET || m == HLT)
+            continue;
+        int args = (m == CALL) ? ArgumentsDe(PCODE[i].SUITE) : 0;
+        int h = hauteur[i] + effetPile(i, args);
+        if (m == TAILCALL)
+            h = 0; // Le BRN qui suit saute à l'appelée, dont le ALC réserve le cadre
+        if (h > max)
+            max = h;
+        int suivants[2] = {-1, -1};
+        if (m == BRN)
+            suivants[0] = PCODE[i].SUITE;
+        else {
+            suivants[0] = i + 1;
+            if (m == BZE || (m >= BEQ && m <= BGE))
+                suivants[1] = PCODE[i].SUITE;
+        }
+        for (int s = 0; s < 2; s++) {
+            int j = suivants[s];
+            if (j < 0 || j > PC)
+                continue;
+            if (hauteur[j] < 0) {
+                hauteur[j] = h;
+                pile[n++] = j;
+            }
+        }
+    }
+    return max;
+}
+
+// CalculerPileRequise : remplit PILE_REQUISE pour le programme principal
+// (adresse 0) et chaque cible d'un CALL, puis affiche le résultat
+void CalculerPileRequise(void) {
+    for (int i = 0; i < TAILLECODE; i++)
+        PILE_REQUISE[i] = -1;
+    if (PC < 0)
+        return;
+    PILE_REQUISE[0] = hauteurMaximale(0);
+    Informer("Stack depth: main %d", PILE_REQUISE[0]);
+    for (int i = 0; i <= PC; i++) {
+        int a = PCODE[i].SUITE;
+        if (PCODE[i].MNE != CALL || a < 0 || a > PC || PILE_REQUISE[a] >= 0)
+            continue;
+        PILE_REQUISE[a] = hauteurMaximale(a);
+        int idf = getProcFuncAtAddress(a);
+        Informer(", %s %d", idf >= 0 ? TAB_IDFS[idf].Nom : "?", PILE_REQUISE[a]);
+    }
+    Informer("\n");
+}
+
+// ---------------------------------------------------------------------
+// NomMnemonique : Retourne le nom d'une instruction P-code
+// ---------------------------------------------------------------------
+// Les noms suivent l'ordre de l'énumération Mnemoniques
+const char *NomMnemonique(Mnemoniques M) {
+    static const char *noms[] = {
+        "ADD", "SUB", "MUL", "DIVI", "EQL", "NEQ", "GTR", "LSS", "GEQ", "LEQ",
+        "PRN", "INN", "LDI", "LDA", "LDV", "STO", "BRN", "BZE", "HLT", "CALL",
+        "RET", "LDL", "STL", "LDF", "STO_IND",
+        "BEQ", "BNE", "BLT", "BLE", "BGT", "BGE", "STO_KEEP",
+        "TAILCALL", "ALC", "LLA", "SHL", "SHR", "MEMO",
+        "SUBR", "DIVR"
+    };
+    if ((int)M < 0 || (int)M >= (int)(sizeof(noms) / sizeof(noms[0])))
+        return "???";
+    return noms[M];
+}
+
+// ---------------------------------------------------------------------
+// afficherPCode : Affiche toutes les instructions du P-code
+// ---------------------------------------------------------------------
+// Parcourt le tableau PCODE et imprime pour chaque instruction son index,
+// le mnémonique et l'argument
+void afficherPCode() {
+    for (int i = 0; i <= PC; i++) {
+        printf("%3d : (%d, %d)\n", i, PCODE[i].MNE, PCODE[i].SUITE);
+    }
+}
+
+// ---------------------------------------------------------------------
+// sauvegarderPCode : Sauvegarde le P-code dans un fichier
+// ---------------------------------------------------------------------
+// Paramètre filename : le nom du fichier où le P-code sera sauvegardé
+// Ouvre le fichier, écrit chaque instruction et ferme le fichier.
+void sauvegarderPCode(const char* filename) {
+    FILE* f = fopen(filename, "w");
+    if (!f) {
+        perror("fopen");
+        return;
+    }
+    for (int i = 0; i <= PC; i++) {
+        // Écrit le mnémonique et l'argument de chaque instruction sur une ligne
+        fprintf(f, "%d %d\n", PCODE[i].MNE, PCODE[i].SUITE);
+    }
+    fclose(f);
+    Informer("P-code saved in %s\n", filename);
+}
+
+// ---------------------------------------------------------------------
+// chargerPCode : Charge le P-code à partir d'un fichier
+// ---------------------------------------------------------------------
+// Paramètre filename : le nom du fichier d'où charger le P-code
+// Lit chaque instruction du fichier et les stocke dans PCODE, puis ferme le fichier.
+void chargerPCode(const char* filename) {
+    FILE* f = fopen(filename, "r");
+    if (!f)
+        Error("Cannot open the P-code file");
+    PC = -1;  // Réinitialise le compteur de programme
+    while (!feof(f)) {
+        int m, s;
+        // Lit un mnémonique et son argument depuis le fichier
+        if (fscanf(f, "%d %d", &m, &s) == 2) {
+            PC++;
+            // Le fichier est fermé avant Error, qui peut revenir à la bibliothèque
+            if (PC >= TAILLECODE || m < ADD || m > DIVR) {
+                fclose(f);
+                Error(PC >= TAILLECODE ? "P-code too large" : "Invalid P-code instruction");
+            }
+            PCODE[PC].MNE = (Mnemoniques)m; // Convertit en type Mnemoniques
+            PCODE[PC].SUITE = s;
+        }
+    }
+    fclose(f);
+    Informer("P-code loaded from %s (PC=%d)\n", filename, PC);
+}
@@ -1,37 +1,90 @@
-#ifndef GENERATION_PCODE_H
-#define GENERATION_PCODE_H
-
-#include "global.h"  // On inclut les définitions globales comme Mnemoniques, PCODE, PC, etc.
-
-// ---------------------------------------------------------------------
-// Ecrire1 : écrit une instruction P-code sans argument
-// ---------------------------------------------------------------------
-// Paramètre M : le mnémonique (instruction) à écrire
-void Ecrire1(Mnemoniques M);
-
-// ---------------------------------------------------------------------
-// Ecrire2 : écrit une instruction P-code avec un argument entier
-// ---------------------------------------------------------------------
-// Paramètre M : le mnémonique (instruction) à écrire
-// Paramètre arg : l'argument entier associé à l'instruction
-void Ecrire2(Mnemoniques M, int arg);
-
-// ---------------------------------------------------------------------
-// afficherPCode : affiche toutes les instructions du P-code
-// ---------------------------------------------------------------------
-// Affiche le contenu du tableau global PCODE pour voir le programme généré
-void afficherPCode();
-
-// ---------------------------------------------------------------------
-// sauvegarderPCode : sauvegarde le P-code dans un fichier
-// ---------------------------------------------------------------------
-// Paramètre filename : le nom du fichier où enregistrer le P-code
-void sauvegarderPCode(const char* filename);
-
-// ---------------------------------------------------------------------
-// chargerPCode : charge le P-code depuis un fichier
-// ---------------------------------------------------------------------
-// Paramètre filename : le nom du fichier à partir duquel charger le P-code
-void chargerPCode(const char* filename);
-
-#endif
+#ifndef GENERATION_PCODE_H
+#define GENERATION_PCODE_H
+
+#include "global.h"  // On inclut les définitions globales comme Mnemoniques, PCODE, PC, etc.
+
+// ---------------------------------------------------------------------
+// Ecrire1 : écrit une instruction P-code sans argument
+// ---------------------------------------------------------------------
+// Paramètre M : le mnémonique (instruction) à écrire
+void Ecrire1(Mnemoniques M);
+
+// ---------------------------------------------------------------------
+// Ecrire2 : écrit une instruction P-code avec un argument entier
+// ---------------------------------------------------------------------
+// Paramètre M : le mnémonique (instruction) à écrire
+// Paramètre arg : l'argument entier associé à l'instruction
+void Ecrire2(Mnemoniques M, int arg);
+
+// ---------------------------------------------------------------------
+// MarquerAppelTerminal : un CALL suivi seulement du retour devient TAILCALL
+// ---------------------------------------------------------------------
+// À appeler après avoir écrit le RET (position ret) ; debut : première instruction du corps
+void MarquerAppelTerminal(int ret, int debut);
+
+// Position du CALL suivi seulement du retour de son résultat jusqu'au RET
+// code[ret] (-1 s'il n'y en a pas)
+int AppelEnPositionTerminale(const INSTRUCTION *code, int ret, int debut);
+
+// ---------------------------------------------------------------------
+// Cases du cadre : variables locales et temporaires (BP+1 à BP+n)
+// ---------------------------------------------------------------------
+#define MAX_CASES_CADRE 100 // Nombre maximal de cases d'un cadre
+
+// Écrit le "ALC" d'entrée d'une procédure et remet l'allocateur à zéro
+void DebutCadre(void);
+
+// Retourne une case libre du cadre
+int AllouerCase(void);
+
+// Rend une case de temporaire, réutilisable par la suite
+void LibererCase(int k);
+
+// Libère les cases BP+1 à BP+p du corps code[0..taille-1], où TAILCALL range
+// les arguments calculés d'un appel terminal vers lui (cases de passage).
+// Le tableau doit avoir une case de plus ; retourne la nouvelle taille
+int ReserverCasesDePassage(INSTRUCTION *code, int taille, int p);
+
+// Fixe la taille du ALC d'entrée (ou le retire si le cadre est vide)
+void FinCadre(void);
+
+// ---------------------------------------------------------------------
+// Pile requise par chaque procédure
+// ---------------------------------------------------------------------
+// PILE_REQUISE[a] : pour la procédure, la fonction ou le programme principal
+// dont le code commence à l'adresse a, nombre maximal de cases occupées
+// au-dessus de BP (cadre du ALC et opérandes, arguments des appels compris).
+// -1 pour les autres adresses.
+extern ETAT_PAR_FIL int PILE_REQUISE[TAILLECODE];
+
+// Calcule PILE_REQUISE à partir de PCODE[0..PC] et l'affiche
+void CalculerPileRequise(void);
+
+// Nombre d'arguments de la procédure qui commence à l'adresse 'entree'
+// (celui de son premier RET, résultat d'une fonction compris)
+int ArgumentsDe(int entree);
+
+// ---------------------------------------------------------------------
+// NomMnemonique : retourne le nom lisible d'une instruction (ex : "LDI")
+// ---------------------------------------------------------------------
+const char *NomMnemonique(Mnemoniques M);
+
+// ---------------------------------------------------------------------
+// afficherPCode : affiche toutes les instructions du P-code
+// ---------------------------------------------------------------------
+// Affiche le contenu du tableau global PCODE pour voir le programme généré
+void afficherPCode();
+
+// ---------------------------------------------------------------------
+// sauvegarderPCode : sauvegarde le P-code dans un fichier
+// ---------------------------------------------------------------------
+// Paramètre filename : le nom du fichier où enregistrer le P-code
+void sauvegarderPCode(const char* filename);
+
+// ---------------------------------------------------------------------
+// chargerPCode : charge le P-code depuis un fichier
+// ---------------------------------------------------------------------
+// Paramètre filename : le nom du fichier à partir duquel charger le P-code
+void chargerPCode(const char* filename);
+
+#endif
@@ -1,400 +1,779 @@
-#include "interpreteur.h"
-#include "semantique.h"
-#include "generation_pcode.h"
-#include "global.h"
-
-// Mémoire globale pour stocker les valeurs
-DataValue MEM[TAILLEMEM];
-// Tableau pour stocker le type de chaque valeur en mémoire (int, real, etc.)
-DataType  MEM_TYPE[TAILLEMEM];
-// SP (Stack Pointer) indique le sommet de la pile et est initialisé à -1 (pile vide)
-int SP = -1;
-// BP (Base Pointer) est le point de base pour les appels de fonctions/procédures, initialisé à 0
-int BP = 0;
-
-// PCi est l'indice de l'instruction courante dans le tableau PCODE utilisé par l'interpréteur
-static int PCi = 0; 
-
-// Convertit un entier en float
-static float toFloat(int i) { return (float)i; }
-
-// INTER_INST traite une instruction P-code donnée par "inst"
-static void INTER_INST(INSTRUCTION inst)
-{
-    DataValue v1, v2;
-    DataType t1, t2;
-    int adr;
-
-    // Selon le mnémonique de l'instruction, on fait différentes actions
-    switch (inst.MNE)
-    {
-    case LDI:
-        // LDI : Pousse une valeur littérale entière sur la pile.
-        SP++;
-        if (SP >= TAILLEMEM) Error("Stack overflow LDI");
-        MEM[SP].i = inst.SUITE;
-        MEM_TYPE[SP] = TYPE_INT;
-        PCi++;
-        break;
-
-    case LDA:
-        // LDA : Pousse une adresse sur la pile.
-        SP++;
-        if (SP >= TAILLEMEM) Error("Stack overflow LDA");
-        MEM[SP].i = inst.SUITE;
-        MEM_TYPE[SP] = TYPE_INT;
-        PCi++;
-        break;
-
-    case LDV:
-        // LDV : Prend l'adresse sur le haut de pile et remplace par la valeur stockée à cette adresse.
-        if (SP < 0) Error("Stack underflow LDV");
-        adr = MEM[SP].i;
-        if (adr < 0 || adr >= TAILLEMEM) Error("Invalid address LDV");
-        MEM[SP] = MEM[adr];
-        MEM_TYPE[SP] = MEM_TYPE[adr];
-        PCi++;
-        break;
-
-    case STO:
-        // STO : Dépile la valeur et la stocke dans l'adresse donnée par inst.SUITE.
-        // Si SUITE vaut -9999, c'est un simple pop.
-        if (SP < 0) Error("Stack underflow STO");
-        if (inst.SUITE == -9999)
-        {
-            SP--;
-            PCi++;
-            break;
-        }
-        v1 = MEM[SP];
-        t1 = MEM_TYPE[SP];
-        SP--;
-        adr = inst.SUITE;
-        if (adr < 0 || adr >= TAILLEMEM) Error("Invalid address STO");
-        MEM[adr] = v1;
-        MEM_TYPE[adr] = t1;
-        PCi++;
-        break;
-
-    case LDL:
-    {
-        // LDL p : Pousse sur la pile la valeur stockée à l'adresse BP + 2 + p
-        int p = inst.SUITE;
-        int src = BP + 2 + p;
-        if (src < 0 || src >= TAILLEMEM) Error("LDL invalid address");
-        SP++;
-        if (SP >= TAILLEMEM) Error("Stack overflow LDL");
-        MEM[SP] = MEM[src];
-        MEM_TYPE[SP] = MEM_TYPE[src];
-        PCi++;
-    }
-    break;
-
-    case STL:
-    {
-        // STL p : Dépile la valeur et la stocke dans MEM[BP + 2 + p]
-        int p = inst.SUITE;
-        if (SP < 0) Error("Stack underflow STL");
-        v1 = MEM[SP];
-        t1 = MEM_TYPE[SP];
-        SP--;
-        int dest = BP + 2 + p;
-        if (dest < 0 || dest >= TAILLEMEM) Error("STL invalid address");
-        MEM[dest] = v1;
-        MEM_TYPE[dest] = t1;
-        PCi++;
-    }
-    break;
-
-    case STO_IND:
-    {
-        // STO_IND : Prend la valeur à la position SP-1 et stocke cette valeur à l'adresse indiquée par la valeur au sommet de pile.
-        if (SP < 1) Error("Stack underflow STO_IND");
-        int addr = MEM[SP].i;
-        if (addr < 0 || addr >= TAILLEMEM) Error("Invalid address STO_IND");
-        DataValue val = MEM[SP - 1];
-        DataType tt = MEM_TYPE[SP - 1];
-        SP -= 2;
-        MEM[addr] = val;
-        MEM_TYPE[addr] = tt;
-        PCi++;
-    }
-    break;
-
-    case ADD:
-    case SUB:
-    case MUL:
-    case DIVI:
-    {
-        // Opérations arithmétiques :
-        // On dépile les deux opérandes, on effectue l'opération, et on pousse le résultat.
-        if (SP < 1) Error("Stack underflow OP");
-        v2 = MEM[SP];
-        t2 = MEM_TYPE[SP];
-        SP--;
-        v1 = MEM[SP];
-        t1 = MEM_TYPE[SP];
-        DataValue res;
-        DataType rt;
-        // Si l'un des opérandes est réel, on effectue l'opération en float.
-        if (t1 == TYPE_REAL || t2 == TYPE_REAL)
-        {
-            float f1 = (t1 == TYPE_REAL) ? v1.f : toFloat(v1.i);
-            float f2 = (t2 == TYPE_REAL) ? v2.f : toFloat(v2.i);
-            rt = TYPE_REAL;
-            switch (inst.MNE)
-            {
-            case ADD:  res.f = f1 + f2; break;
-            case SUB:  res.f = f1 - f2; break;
-            case MUL:  res.f = f1 * f2; break;
-            case DIVI:
-                if (f2 == 0.0f) Error("Division by zero (float)");
-                res.f = f1 / f2;
-                break;
-            default: break;
-            }
-        }
-        else
-        {
-            // Sinon, on effectue l'opération en entier.
-            rt = TYPE_INT;
-            int i1 = v1.i, i2 = v2.i;
-            switch (inst.MNE)
-            {
-            case ADD:  res.i = i1 + i2; break;
-            case SUB:  res.i = i1 - i2; break;
-            case MUL:  res.i = i1 * i2; break;
-            case DIVI:
-                if (i2 == 0) Error("Division by zero (int)");
-                res.i = i1 / i2;
-                break;
-            default: break;
-            }
-        }
-        // Remplace les opérandes par le résultat.
-        MEM[SP] = res;
-        MEM_TYPE[SP] = rt;
-        PCi++;
-    }
-    break;
-
-    case EQL:
-    case NEQ:
-    case GTR:
-    case LSS:
-    case GEQ:
-    case LEQ:
-    {
-        // Opérations de comparaison :
-        // On dépile deux opérandes, on compare, et on pousse le résultat (1 ou 0)
-        if (SP < 1) Error("Stack underflow CMP");
-        v2 = MEM[SP];
-        t2 = MEM_TYPE[SP];
-        SP--;
-        v1 = MEM[SP];
-        t1 = MEM_TYPE[SP];
-        int r = 0;
-        // Si l'un des types est réel, la comparaison est faite en float
-        if (t1 == TYPE_REAL || t2 == TYPE_REAL)
-        {
-            float f1 = (t1 == TYPE_REAL) ? v1.f : toFloat(v1.i);
-            float f2 = (t2 == TYPE_REAL) ? v2.f : toFloat(v2.i);
-            switch (inst.MNE)
-            {
-            case EQL:  r = (f1 == f2); break;
-            case NEQ:  r = (f1 != f2); break;
-            case GTR:  r = (f1 >  f2); break;
-            case LSS:  r = (f1 <  f2); break;
-            case GEQ:  r = (f1 >= f2); break;
-            case LEQ:  r = (f1 <= f2); break;
-            default: break;
-            }
-        }
-        else
-        {
-            // Comparaison en entier.
-            int i1 = v1.i, i2 = v2.i;
-            switch (inst.MNE)
-            {
-            case EQL:  r = (i1 == i2); break;
-            case NEQ:  r = (i1 != i2); break;
-            case GTR:  r = (i1 >  i2); break;
-            case LSS:  r = (i1 <  i2); break;
-            case GEQ:  r = (i1 >= i2); break;
-            case LEQ:  r = (i1 <= i2); break;
-            default: break;
-            }
-        }
-        // Pousse le résultat de la comparaison sur la pile.
-        MEM[SP].i = r;
-        MEM_TYPE[SP] = TYPE_INT;
-        PCi++;
-    }
-    break;
-
-    case PRN:
-        // PRN : Imprime la valeur en haut de la pile.
-        if (SP < 0) Error("Stack underflow PRN");
-        if (MEM_TYPE[SP] == TYPE_REAL)
-            printf("PRN => %f\n", MEM[SP].f);
-        else
-            printf("PRN => %d\n", MEM[SP].i);
-        SP--;
-        PCi++;
-        break;
-
-    case INN:
-    {
-        // INN : Lecture d'une valeur (entrée utilisateur) et stockage à l'adresse spécifiée.
-        if (SP < 0) Error("Stack underflow INN");
-        adr = MEM[SP].i;
-        SP--;
-        if (adr < 0 || adr >= TAILLEMEM) Error("Invalid address INN");
-        if (MEM_TYPE[adr] == TYPE_REAL)
-        {
-            float valf;
-            printf("Enter a real: ");
-            if (scanf("%f", &valf) != 1) Error("Bad input real");
-            MEM[adr].f = valf;
-            MEM_TYPE[adr] = TYPE_REAL;
-        }
-        else
-        {
-            int vali;
-            printf("Enter an integer: ");
-            if (scanf("%d", &vali) != 1) Error("Bad input int");
-            MEM[adr].i = vali;
-            MEM_TYPE[adr] = TYPE_INT;
-        }
-        PCi++;
-    }
-    break;
-
-    case BZE:
-        // BZE : Dépile une condition et branche à l'adresse donnée si la condition vaut 0.
-        if (SP < 0) Error("Stack underflow BZE");
-        {
-            int cond = MEM[SP].i;
-            SP--;
-            if (cond == 0)
-                PCi = inst.SUITE;
-            else
-                PCi++;
-        }
-        break;
-
-    case BRN:
-        // BRN : Branche inconditionnellement à l'adresse donnée.
-        PCi = inst.SUITE;
-        break;
-
-    case PUSH_PARAMS_COUNT:
-    {
-        // PUSH_PARAMS_COUNT : Pousse l'argument (nombre de paramètres) sur la pile.
-        SP++;
-        if (SP >= TAILLEMEM) Error("Stack overflow on PUSH_PARAMS_COUNT");
-        MEM[SP].i = inst.SUITE;
-        MEM_TYPE[SP] = TYPE_INT;
-        PCi++;
-    }
-    break;
-
-    case CALL:
-    {
-        // CALL : Gère l'appel d'une procédure ou fonction.
-        // 1) Dépile le nombre de paramètres.
-        if (SP < 0) Error("Stack underflow on CALL (paramCount)");
-        int nParams = MEM[SP].i;
-        SP--;
-        // 2) Sauvegarde l'adresse de retour.
-        int retAddr = PCi + 1;
-        // 3) Sauvegarde l'ancien BP.
-        int oldBP = BP;
-        // 4) Pousse retAddr sur la pile.
-        SP++;
-        if (SP >= TAILLEMEM) Error("Stack overflow CALL retAddr");
-        MEM[SP].i = retAddr;
-        MEM_TYPE[SP] = TYPE_INT;
-        // 5) Pousse l'ancien BP sur la pile.
-        SP++;
-        if (SP >= TAILLEMEM) Error("Stack overflow CALL oldBP");
-        MEM[SP].i = oldBP;
-        MEM_TYPE[SP] = TYPE_INT;
-        // 6) Met à jour BP pour pointer sur la nouvelle base (les deux valeurs sauvegardées).
-        BP = SP;
-        // Les arguments de la fonction sont ensuite copiés à partir de la pile.
-        int startArg = BP - 1 - nParams; // Position du premier argument.
-        for (int i = 0; i < nParams; i++)
-        {
-            MEM[BP + 2 + i]      = MEM[startArg + i];
-            MEM_TYPE[BP + 2 + i] = MEM_TYPE[startArg + i];
-        }
-        // Ajuste SP pour pointer sur le dernier emplacement des paramètres.
-        SP = BP + 1 + nParams;
-        // Passe à l'adresse de la fonction/procédure appelée.
-        PCi = inst.SUITE;
-    }
-    break;
-
-    case RET:
-    {
-        // RET : Retour d'une procédure ou fonction.
-        // On récupère l'adresse de retour et l'ancien BP, on ajuste la pile et on passe à l'instruction suivante.
-        if (BP < 1) Error("Invalid BP in RET");
-        int retAddr = MEM[BP - 1].i;
-        int oldBP   = MEM[BP].i;
-        int n       = inst.SUITE; // Nombre de paramètres utilisateur à enlever
-        // Sauvegarde la valeur de retour (située en haut de la pile)
-        DataValue retVal = MEM[SP];
-        DataType retType = MEM_TYPE[SP];
-        // Ajuste SP pour sortir des paramètres
-        SP = BP - 2 - n;
-        if (SP < -1) Error("Stack pointer negative in RET");
-        // Pousse la valeur de retour sur la pile
-        SP++;
-        MEM[SP] = retVal;
-        MEM_TYPE[SP] = retType;
-        // Restaure BP et passe à l'adresse de retour
-        BP = oldBP;
-        PCi = retAddr;
-    }
-    break;
-
-    case LDF:
-    {
-        // LDF : Pousse un nombre réel (float) sur la pile à partir d'une représentation en bits.
-        SP++;
-        if (SP >= TAILLEMEM) Error("Stack overflow LDF");
-        float f;
-        memcpy(&f, &inst.SUITE, sizeof(float));
-        MEM[SP].f = f;
-        MEM_TYPE[SP] = TYPE_REAL;
-        PCi++;
-    }
-    break;
-
-    case HLT:
-        // HLT : Arrête l'exécution.
-        PCi++;
-        break;
-    }
-}
-
-// Boucle principale de l'interpréteur qui exécute les instructions du P-code
-void INTER_PCODE()
-{
-    PCi = 0;
-    SP = -1;
-    BP = 0;
-    // Exécute les instructions tant que PCi est valide et que l'instruction n'est pas HLT
-    while (PCi >= 0 && PCi < TAILLECODE && PCODE[PCi].MNE != HLT)
-    {
-        INTER_INST(PCODE[PCi]);
-    }
-    // Si l'instruction HLT est atteinte, on la traite également
-    if (PCi < TAILLECODE && PCODE[PCi].MNE == HLT)
-    {
-        INTER_INST(PCODE[PCi]);
-    }
-    printf("End of execution (HLT).\n");
-}
+#include "interpreteur.h"
+#include "semantique.h"
+#include "generation_pcode.h"
+#include "global.h"
+#include <stdarg.h>
+
+// Mémoire globale pour stocker les valeurs
+ETAT_PAR_FIL DataValue MEM[TAILLEMEM];
+// Tableau pour stocker le type de chaque valeur en mémoire (int, real, etc.)
+ETAT_PAR_FIL DataType  MEM_TYPE[TAILLEMEM];
+// SP (Stack Pointer) indique le sommet de la pile et est initialisé à -1 (pile vide)
+ETAT_PAR_FIL int SP = -1;
+// BP (Base Pointer) est le point de base pour les appels de fonctions/procédures.
+// Il vaut -1 dans le programme principal : ses cases de cadre BP+1... commencent en MEM[0].
+ETAT_PAR_FIL int BP = -1;
+
+// PCi est l'indice de l'instruction courante dans le tableau PCODE utilisé par l'interpréteur
+static ETAT_PAR_FIL int PCi = 0; 
+
+// Entrées/sorties du programme exécuté (console si les rappels sont NULL)
+ETAT_PAR_FIL Rappels RAPPELS = {NULL, NULL, NULL};
+
+// Écrit un texte sur la sortie du programme exécuté
+static void ecrireSortie(const char *format, ...)
+{
+    char texte[128];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(texte, sizeof(texte), format, args);
+    va_end(args);
+    if (RAPPELS.ecrire)
+        RAPPELS.ecrire(RAPPELS.donnees, texte);
+    else
+        fputs(texte, stdout);
+}
+
+// Lit une valeur saisie pour INN (format "%d" ou "%f") ; retourne 1 si elle est valide
+static int lireEntree(const char *format, void *valeur)
+{
+    char mot[64];
+    if (!RAPPELS.lire)
+        return scanf(format, valeur) == 1;
+    if (!RAPPELS.lire(RAPPELS.donnees, mot, sizeof(mot)))
+        return 0;
+    return sscanf(mot, format, valeur) == 1;
+}
+
+// Affiche une valeur comme l'instruction PRN
+void INTER_AFFICHER(DataValue v, DataType type)
+{
+    if (type == TYPE_REAL)
+        ecrireSortie("PRN => %f\n", v.f);
+    else
+        ecrireSortie("PRN => %d\n", v.i);
+}
+
+// ---------------------------------------------------------------------
+// Mémoïsation : une fonction dont le code commence par MEMO n (fonction pure,
+// option -memo) a un cache indexé par la valeur de ses arguments. CALL le
+// consulte avant de construire le cadre : en cas de succès, les arguments
+// sont dépilés et le résultat empilé comme par RET. Sinon l'appel a lieu et
+// son RET range le résultat. Chaque cache a MEMO_ENTREES entrées (une entrée
+// occupée est remplacée en cas de collision).
+// ---------------------------------------------------------------------
+#define MEMO_FONCTIONS 16   // Fonctions mémoïsées suivies
+#define MEMO_ENTREES   256  // Entrées du cache de chaque fonction (puissance de 2)
+#define MEMO_ARGS      8    // Arguments au plus dans la clé (résultat non compris)
+
+typedef struct {
+    int       occupee;
+    DataValue args[MEMO_ARGS];   // Valeurs des arguments 1..n-1
+    DataType  types[MEMO_ARGS];
+    DataValue resultat;
+    DataType  typeResultat;
+} EntreeMemo;
+
+typedef struct {
+    int        adresse;          // Adresse de la fonction (son MEMO)
+    long       succes, echecs;   // Appels servis par le cache / exécutés
+    EntreeMemo entrees[MEMO_ENTREES];
+} CacheMemo;
+
+// Appel exécuté dont le RET doit remplir une entrée
+typedef struct {
+    int         bp;              // BP du cadre de l'appel
+    EntreeMemo *entree;
+    EntreeMemo  cle;             // Arguments relevés au moment du CALL
+} AttenteMemo;
+
+// Alloués au premier MEMO exécuté et libérés en fin d'exécution : la plupart
+// des programmes ne mémoïsent rien
+static ETAT_PAR_FIL CacheMemo   *caches;    // MEMO_FONCTIONS caches
+static ETAT_PAR_FIL int          nCaches = 0;
+static ETAT_PAR_FIL AttenteMemo *attentes;  // TAILLEMEM attentes
+static ETAT_PAR_FIL int          nAttentes = 0;
+
+// Libère les caches de mémoïsation
+void INTER_LIBERER(void)
+{
+    free(caches);
+    free(attentes);
+    caches = NULL;
+    attentes = NULL;
+    nCaches = 0;
+    nAttentes = 0;
+}
+
+// Cache de la fonction d'adresse adr (créé au premier appel), ou NULL
+static CacheMemo *cacheDe(int adr)
+{
+    for (int i = 0; i < nCaches; i++)
+    {
+        if (caches[i].adresse == adr)
+            return &caches[i];
+    }
+    if (nCaches >= MEMO_FONCTIONS)
+        return NULL;
+    if (!caches)
+    {
+        caches = malloc(MEMO_FONCTIONS * sizeof(CacheMemo));
+        attentes = malloc(TAILLEMEM * sizeof(AttenteMemo));
+        if (!caches || !attentes)
+        {
+            // Sans mémoire, la fonction s'exécute sans cache
+            INTER_LIBERER();
+            return NULL;
+        }
+    }
+    CacheMemo *c = &caches[nCaches++];
+    memset(c, 0, sizeof(*c));
+    c->adresse = adr;
+    return c;
+}
+
+// Ajoute les quatre octets de x au hachage FNV-1a h (octet par octet : les bits
+// de poids faible d'un réel sont souvent nuls)
+static unsigned melangerMemo(unsigned h, unsigned x)
+{
+    for (int k = 0; k < 4; k++, x >>= 8)
+        h = (h ^ (x & 0xFF)) * 16777619u;
+    return h;
+}
+
+// Consulte le cache de la fonction 'cible' pour les n arguments au sommet de pile.
+// Retourne 1 si le résultat a remplacé les arguments ; sinon prépare le RET de l'appel
+// (qui aura lieu avec le cadre nouveauBP) et retourne 0.
+static int consulterMemo(int cible, int n, int nouveauBP)
+{
+    if (n - 1 > MEMO_ARGS || n < 1 || SP - n + 1 < 0)
+        return 0;
+    CacheMemo *c = cacheDe(cible);
+    if (!c)
+        return 0;
+    EntreeMemo cle;
+    memset(&cle, 0, sizeof(cle));
+    unsigned h = 2166136261u; // FNV-1a sur les valeurs et les types
+    for (int a = 1; a < n; a++)
+    {
+        int adr = MEM[SP - n + 1 + a].i;
+        if (adr < 0 || adr >= TAILLEMEM)
+            return 0;
+        cle.args[a - 1] = MEM[adr];
+        cle.types[a - 1] = MEM_TYPE[adr];
+        h = melangerMemo(h, (unsigned)MEM[adr].i);
+        h = melangerMemo(h, (unsigned)MEM_TYPE[adr]);
+    }
+    EntreeMemo *e = &c->entrees[h & (MEMO_ENTREES - 1)];
+    int pareil = e->occupee;
+    for (int a = 0; a < n - 1 && pareil; a++)
+        pareil = e->types[a] == cle.types[a] && e->args[a].i == cle.args[a].i;
+    if (pareil)
+    {
+        c->succes++;
+        SP -= n;
+        SP++;
+        MEM[SP] = e->resultat;
+        MEM_TYPE[SP] = e->typeResultat;
+        return 1;
+    }
+    c->echecs++;
+    if (nAttentes < TAILLEMEM)
+    {
+        attentes[nAttentes].bp = nouveauBP;
+        attentes[nAttentes].entree = e;
+        attentes[nAttentes].cle = cle;
+        nAttentes++;
+    }
+    return 0;
+}
+
+// Affiche les compteurs de chaque cache utilisé
+static void afficherMemo()
+{
+    for (int i = 0; i < nCaches; i++)
+    {
+        int idf = getProcFuncAtAddress(caches[i].adresse);
+        Informer("Memo %s: %ld hits, %ld misses\n",
+               idf >= 0 ? TAB_IDFS[idf].Nom : "?", caches[i].succes, caches[i].echecs);
+    }
+}
+
+// Convertit un entier en float
+static float toFloat(int i) { return (float)i; }
+
+// Évalue la relation 'rel' (EQL, NEQ, GTR, LSS, GEQ ou LEQ) entre deux valeurs.
+// Si l'un des types est réel, la comparaison est faite en float. Retourne 1 ou 0.
+static int comparer(Mnemoniques rel, DataValue v1, DataType t1, DataValue v2, DataType t2)
+{
+    if (t1 == TYPE_REAL || t2 == TYPE_REAL)
+    {
+        float f1 = (t1 == TYPE_REAL) ? v1.f : toFloat(v1.i);
+        float f2 = (t2 == TYPE_REAL) ? v2.f : toFloat(v2.i);
+        switch (rel)
+        {
+        case EQL:  return f1 == f2;
+        case NEQ:  return f1 != f2;
+        case GTR:  return f1 >  f2;
+        case LSS:  return f1 <  f2;
+        case GEQ:  return f1 >= f2;
+        case LEQ:  return f1 <= f2;
+        default:   return 0;
+        }
+    }
+    // Comparaison en entier.
+    int i1 = v1.i, i2 = v2.i;
+    switch (rel)
+    {
+    case EQL:  return i1 == i2;
+    case NEQ:  return i1 != i2;
+    case GTR:  return i1 >  i2;
+    case LSS:  return i1 <  i2;
+    case GEQ:  return i1 >= i2;
+    case LEQ:  return i1 <= i2;
+    default:   return 0;
+    }
+}
+
+// Retourne la relation testée par une instruction de comparaison-branchement (BEQ..BGE)
+static Mnemoniques relationDeBranche(Mnemoniques br)
+{
+    switch (br)
+    {
+    case BEQ: return EQL;
+    case BNE: return NEQ;
+    case BLT: return LSS;
+    case BLE: return LEQ;
+    case BGT: return GTR;
+    default:  return GEQ;
+    }
+}
+
+// INTER_INST traite une instruction P-code donnée par "inst"
+static void INTER_INST(INSTRUCTION inst)
+{
+    DataValue v1, v2;
+    DataType t1, t2;
+    int adr;
+
+    // Selon le mnémonique de l'instruction, on fait différentes actions
+    switch (inst.MNE)
+    {
+    case LDI:
+        // LDI : Pousse une valeur littérale entière sur la pile.
+        SP++;
+        if (SP >= TAILLEMEM) Error("Stack overflow LDI");
+        MEM[SP].i = inst.SUITE;
+        MEM_TYPE[SP] = TYPE_INT;
+        PCi++;
+        break;
+
+    case LDA:
+        // LDA : Pousse une adresse sur la pile.
+        SP++;
+        if (SP >= TAILLEMEM) Error("Stack overflow LDA");
+        MEM[SP].i = inst.SUITE;
+        MEM_TYPE[SP] = TYPE_INT;
+        PCi++;
+        break;
+
+    case LDV:
+        // LDV : Prend l'adresse sur le haut de pile et remplace par la valeur stockée à cette adresse.
+        if (SP < 0) Error("Stack underflow LDV");
+        adr = MEM[SP].i;
+        if (adr < 0 || adr >= TAILLEMEM) Error("Invalid address LDV");
+        MEM[SP] = MEM[adr];
+        MEM_TYPE[SP] = MEM_TYPE[adr];
+        PCi++;
+        break;
+
+    case STO:
+        // STO : Dépile la valeur et la stocke dans l'adresse donnée par inst.SUITE.
+        // Si SUITE vaut -9999, c'est un simple pop.
+        if (SP < 0) Error("Stack underflow STO");
+        if (inst.SUITE == -9999)
+        {
+            SP--;
+            PCi++;
+            break;
+        }
+        v1 = MEM[SP];
+        t1 = MEM_TYPE[SP];
+        SP--;
+        adr = inst.SUITE;
+        if (adr < 0 || adr >= TAILLEMEM) Error("Invalid address STO");
+        MEM[adr] = v1;
+        MEM_TYPE[adr] = t1;
+        PCi++;
+        break;
+
+    case STO_KEEP:
+        // STO_KEEP : Copie le sommet de pile à l'adresse inst.SUITE sans le dépiler
+        // (sert à garder un résultat dans un temporaire du compilateur).
+        if (SP < 0) Error("Stack underflow STO_KEEP");
+        adr = inst.SUITE;
+        if (adr < 0 || adr >= TAILLEMEM) Error("Invalid address STO_KEEP");
+        MEM[adr] = MEM[SP];
+        MEM_TYPE[adr] = MEM_TYPE[SP];
+        PCi++;
+        break;
+
+    case LDL:
+    {
+        // LDL k : Pousse sur la pile la valeur de la case MEM[BP + k] du cadre
+        // (k < 0 pour les arguments, voir CASE_ARGUMENT)
+        int src = BP + inst.SUITE;
+        if (src < 0 || src >= TAILLEMEM) Error("LDL invalid address");
+        SP++;
+        if (SP >= TAILLEMEM) Error("Stack overflow LDL");
+        MEM[SP] = MEM[src];
+        MEM_TYPE[SP] = MEM_TYPE[src];
+        PCi++;
+    }
+    break;
+
+    case STL:
+    {
+        // STL k : Dépile la valeur et la stocke dans la case MEM[BP + k] du cadre
+        if (SP < 0) Error("Stack underflow STL");
+        v1 = MEM[SP];
+        t1 = MEM_TYPE[SP];
+        SP--;
+        int dest = BP + inst.SUITE;
+        if (dest < 0 || dest >= TAILLEMEM) Error("STL invalid address");
+        MEM[dest] = v1;
+        MEM_TYPE[dest] = t1;
+        PCi++;
+    }
+    break;
+
+    case ALC:
+    {
+        // ALC n : Réserve les n cases du cadre (BP+1 à BP+n) au-dessus de BP,
+        // pour les variables locales et les temporaires, et les met à 0. Après
+        // un TAILCALL, les premières sont déjà réservées : ce sont les cases de
+        // passage qu'il a remplies, elles gardent leur valeur.
+        if (SP < BP || SP > BP + inst.SUITE) Error("ALC outside procedure entry");
+        if (BP + inst.SUITE >= TAILLEMEM) Error("Stack overflow ALC");
+        while (SP < BP + inst.SUITE)
+        {
+            SP++;
+            MEM[SP].i = 0;
+            MEM_TYPE[SP] = TYPE_INT;
+        }
+        PCi++;
+    }
+    break;
+
+    case LLA:
+        // LLA k : Pousse l'adresse de la case BP + k du cadre (passage d'une
+        // variable locale par référence, lecture dans une variable locale)
+        SP++;
+        if (SP >= TAILLEMEM) Error("Stack overflow LLA");
+        MEM[SP].i = BP + inst.SUITE;
+        MEM_TYPE[SP] = TYPE_INT;
+        PCi++;
+        break;
+
+    case SHL:
+    case SHR:
+    {
+        // SHL k / SHR k : Multiplie / divise le sommet de pile par 2^k. Ils remplacent
+        // MUL et DIVI par une puissance de 2 : un réel est calculé en float comme par
+        // MUL et DIVI, un entier est décalé (SHR arrondit vers zéro, comme DIVI).
+        if (SP < 0) Error("Stack underflow SHIFT");
+        if (MEM_TYPE[SP] == TYPE_REAL)
+        {
+            float p = toFloat(1 << inst.SUITE);
+            MEM[SP].f = (inst.MNE == SHL) ? MEM[SP].f * p : MEM[SP].f / p;
+        }
+        else if (inst.MNE == SHL)
+        {
+            MEM[SP].i = (int)((unsigned)MEM[SP].i << inst.SUITE);
+        }
+        else
+        {
+            // Un négatif est d'abord augmenté de 2^k - 1 pour que le décalage arrondisse vers zéro
+            int x = MEM[SP].i;
+            MEM[SP].i = (x + ((x >> 31) & ((1 << inst.SUITE) - 1))) >> inst.SUITE;
+        }
+        PCi++;
+    }
+    break;
+
+    case STO_IND:
+    {
+        // STO_IND : Prend la valeur à la position SP-1 et stocke cette valeur à l'adresse indiquée par la valeur au sommet de pile.
+        if (SP < 1) Error("Stack underflow STO_IND");
+        int addr = MEM[SP].i;
+        if (addr < 0 || addr >= TAILLEMEM) Error("Invalid address STO_IND");
+        DataValue val = MEM[SP - 1];
+        DataType tt = MEM_TYPE[SP - 1];
+        SP -= 2;
+        MEM[addr] = val;
+        MEM_TYPE[addr] = tt;
+        PCi++;
+    }
+    break;
+
+    case ADD:
+    case SUB:
+    case MUL:
+    case DIVI:
+    case SUBR:
+    case DIVR:
+    {
+        // Opérations arithmétiques :
+        // On dépile les deux opérandes, on effectue l'opération, et on pousse le résultat.
+        // SUBR et DIVR prennent leurs opérandes dans l'ordre inverse de SUB et DIVI
+        // (le premier empilé est le second opérande).
+        if (SP < 1) Error("Stack underflow OP");
+        v2 = MEM[SP];
+        t2 = MEM_TYPE[SP];
+        SP--;
+        v1 = MEM[SP];
+        t1 = MEM_TYPE[SP];
+        Mnemoniques op = inst.MNE;
+        if (op == SUBR || op == DIVR)
+        {
+            DataValue v = v1; v1 = v2; v2 = v;
+            DataType t = t1; t1 = t2; t2 = t;
+            op = (op == SUBR) ? SUB : DIVI;
+        }
+        DataValue res;
+        DataType rt;
+        // Si l'un des opérandes est réel, on effectue l'opération en float.
+        if (t1 == TYPE_REAL || t2 == TYPE_REAL)
+        {
+            float f1 = (t1 == TYPE_REAL) ? v1.f : toFloat(v1.i);
+            float f2 = (t2 == TYPE_REAL) ? v2.f : toFloat(v2.i);
+            rt = TYPE_REAL;
+            switch (op)
+            {
+            case ADD:  res.f = f1 + f2; break;
+            case SUB:  res.f = f1 - f2; break;
+            case MUL:  res.f = f1 * f2; break;
+            case DIVI:
+                if (f2 == 0.0f) Error("Division by zero (float)");
+                res.f = f1 / f2;
+                break;
+            default: break;
+            }
+        }
+        else
+        {
+            // Sinon, on effectue l'opération en entier.
+            rt = TYPE_INT;
+            int i1 = v1.i, i2 = v2.i;
+            switch (op)
+            {
+            case ADD:  res.i = i1 + i2; break;
+            case SUB:  res.i = i1 - i2; break;
+            case MUL:  res.i = i1 * i2; break;
+            case DIVI:
+                if (i2 == 0) Error("Division by zero (int)");
+                res.i = i1 / i2;
+                break;
+            default: break;
+            }
+        }
+        // Remplace les opérandes par le résultat.
+        MEM[SP] = res;
+        MEM_TYPE[SP] = rt;
+        PCi++;
+    }
+    break;
+
+    case EQL:
+    case NEQ:
+    case GTR:
+    case LSS:
+    case GEQ:
+    case LEQ:
+    {
+        // Opérations de comparaison :
+        // On dépile deux opérandes, on compare, et on pousse le résultat (1 ou 0)
+        if (SP < 1) Error("Stack underflow CMP");
+        v2 = MEM[SP];
+        t2 = MEM_TYPE[SP];
+        SP--;
+        v1 = MEM[SP];
+        t1 = MEM_TYPE[SP];
+        int r = comparer(inst.MNE, v1, t1, v2, t2);
+        // Pousse le résultat de la comparaison sur la pile.
+        MEM[SP].i = r;
+        MEM_TYPE[SP] = TYPE_INT;
+        PCi++;
+    }
+    break;
+
+    case BEQ:
+    case BNE:
+    case BLT:
+    case BLE:
+    case BGT:
+    case BGE:
+    {
+        // Comparaison et branchement fusionnés :
+        // On dépile les deux opérandes et on branche si la relation est vraie,
+        // sans passer par un résultat booléen intermédiaire sur la pile.
+        if (SP < 1) Error("Stack underflow CMP-BRANCH");
+        v2 = MEM[SP];
+        t2 = MEM_TYPE[SP];
+        v1 = MEM[SP - 1];
+        t1 = MEM_TYPE[SP - 1];
+        SP -= 2;
+        if (comparer(relationDeBranche(inst.MNE), v1, t1, v2, t2))
+            PCi = inst.SUITE;
+        else
+            PCi++;
+    }
+    break;
+
+    case PRN:
+        // PRN : Imprime la valeur en haut de la pile.
+        if (SP < 0) Error("Stack underflow PRN");
+        INTER_AFFICHER(MEM[SP], MEM_TYPE[SP]);
+        SP--;
+        PCi++;
+        break;
+
+    case INN:
+    {
+        // INN : Lecture d'une valeur (entrée utilisateur) et stockage à l'adresse spécifiée.
+        if (SP < 0) Error("Stack underflow INN");
+        adr = MEM[SP].i;
+        SP--;
+        if (adr < 0 || adr >= TAILLEMEM) Error("Invalid address INN");
+        if (MEM_TYPE[adr] == TYPE_REAL)
+        {
+            float valf;
+            ecrireSortie("Enter a real: ");
+            if (!lireEntree("%f", &valf)) Error("Bad input real");
+            MEM[adr].f = valf;
+            MEM_TYPE[adr] = TYPE_REAL;
+        }
+        else
+        {
+            int vali;
+            ecrireSortie("Enter an integer: ");
+            if (!lireEntree("%d", &vali)) Error("Bad input int");
+            MEM[adr].i = vali;
+            MEM_TYPE[adr] = TYPE_INT;
+        }
+        PCi++;
+    }
+    break;
+
+    case BZE:
+        // BZE : Dépile une condition et branche à l'adresse donnée si la condition vaut 0.
+        if (SP < 0) Error("Stack underflow BZE");
+        {
+            int cond = MEM[SP].i;
+            SP--;
+            if (cond == 0)
+                PCi = inst.SUITE;
+            else
+                PCi++;
+        }
+        break;
+
+    case BRN:
+        // BRN : Branche inconditionnellement à l'adresse donnée.
+        PCi = inst.SUITE;
+        break;
+
+    case CALL:
+    {
+        // CALL : Appel d'une procédure ou fonction. Les arguments empilés par
+        // l'appelant restent en place : ce sont les cases BP-1-n .. BP-2 de
+        // l'appelée (le nombre n est connu à la compilation, il sert au RET).
+        int retAddr = PCi + 1;
+        int oldBP = BP;
+        // 0) Fonction mémoïsée : un résultat connu évite l'appel (le cadre
+        //    aurait sa base deux cases au-dessus du sommet actuel)
+        if (inst.SUITE >= 0 && inst.SUITE < TAILLECODE && PCODE[inst.SUITE].MNE == MEMO &&
+            consulterMemo(inst.SUITE, PCODE[inst.SUITE].SUITE, SP + 2))
+        {
+            PCi = retAddr;
+            break;
+        }
+        // La pile ne doit pas atteindre les globales : le cadre de l'appelée
+        // (liaisons, cases et opérandes) est vérifié une fois pour tout l'appel
+        if (inst.SUITE >= 0 && inst.SUITE < TAILLECODE &&
+            SP + 2 + PILE_REQUISE[inst.SUITE] >= VAR_BASE)
+            Error("Stack overflow: the stack would reach the globals");
+        // 1) Pousse l'adresse de retour.
+        SP++;
+        if (SP >= TAILLEMEM) Error("Stack overflow CALL retAddr");
+        MEM[SP].i = retAddr;
+        MEM_TYPE[SP] = TYPE_INT;
+        // 2) Pousse l'ancien BP ; la nouvelle base pointe dessus.
+        SP++;
+        if (SP >= TAILLEMEM) Error("Stack overflow CALL oldBP");
+        MEM[SP].i = oldBP;
+        MEM_TYPE[SP] = TYPE_INT;
+        BP = SP;
+        // 3) Passe à l'adresse de la fonction/procédure appelée.
+        PCi = inst.SUITE;
+    }
+    break;
+
+    case TAILCALL:
+    {
+        // TAILCALL n : Appel en position terminale d'une procédure qui prend autant
+        // d'arguments que la procédure courante. Les n arguments au sommet de pile
+        // écrasent ceux du cadre courant, la pile revient vers BP, et le BRN qui suit
+        // saute à l'appelée. Son RET revient directement à notre appelant : la
+        // pile ne grandit pas.
+        // Un argument qui désigne une case du cadre courant (valeur calculée,
+        // variable locale) disparaîtrait avec lui : sa valeur est d'abord mise
+        // de côté dans la case de pile de l'argument, puis rangée dans la case
+        // de passage BP + n - i de l'appelée, que l'argument désigne désormais.
+        // La pile reste alors au-dessus des cases de passage remplies.
+        int n = inst.SUITE;
+        if (SP - n < BP) Error("Stack underflow on TAILCALL");
+        int haut = SP - n; // Dernière case du cadre courant
+        int passage = 0;   // Cases de passage remplies
+        for (int i = 0; i < n; i++)
+        {
+            int pile = SP - n + 1 + i;
+            int a = MEM[pile].i;
+            if (MEM_TYPE[pile] == TYPE_INT && a > BP && a <= haut)
+            {
+                MEM[pile] = MEM[a];
+                MEM_TYPE[pile] = MEM_TYPE[a];
+                MEM[BP + CASE_ARGUMENT(i, n)].i = BP + n - i;
+                MEM_TYPE[BP + CASE_ARGUMENT(i, n)] = TYPE_INT;
+                if (n - i > passage)
+                    passage = n - i;
+                continue;
+            }
+            MEM[BP + CASE_ARGUMENT(i, n)]      = MEM[pile];
+            MEM_TYPE[BP + CASE_ARGUMENT(i, n)] = MEM_TYPE[pile];
+        }
+        // Seul un argument mis de côté désigne sa case de passage : les autres
+        // adresses sont hors du cadre courant
+        for (int i = 0; i < n; i++)
+        {
+            if (MEM_TYPE[BP + CASE_ARGUMENT(i, n)] == TYPE_INT &&
+                MEM[BP + CASE_ARGUMENT(i, n)].i == BP + n - i)
+            {
+                MEM[BP + n - i]      = MEM[SP - n + 1 + i];
+                MEM_TYPE[BP + n - i] = MEM_TYPE[SP - n + 1 + i];
+            }
+        }
+        SP = BP + passage;
+        PCi++;
+    }
+    break;
+
+    case RET:
+    {
+        // RET : Retour d'une procédure ou fonction.
+        // On récupère l'adresse de retour et l'ancien BP, on ajuste la pile et on passe à l'instruction suivante.
+        if (BP < 1) Error("Invalid BP in RET");
+        int retAddr = MEM[BP - 1].i;
+        int oldBP   = MEM[BP].i;
+        int n       = inst.SUITE; // Nombre de paramètres utilisateur à enlever
+        // Sauvegarde la valeur de retour (située en haut de la pile)
+        DataValue retVal = MEM[SP];
+        DataType retType = MEM_TYPE[SP];
+        // Ajuste SP pour sortir des paramètres
+        SP = BP - 2 - n;
+        if (SP < -1) Error("Stack pointer negative in RET");
+        // Pousse la valeur de retour sur la pile
+        SP++;
+        MEM[SP] = retVal;
+        MEM_TYPE[SP] = retType;
+        // Fin d'un appel mémoïsé : le résultat entre dans le cache
+        if (nAttentes > 0 && attentes[nAttentes - 1].bp == BP)
+        {
+            nAttentes--;
+            EntreeMemo *e = attentes[nAttentes].entree;
+            *e = attentes[nAttentes].cle;
+            e->occupee = 1;
+            e->resultat = retVal;
+            e->typeResultat = retType;
+        }
+        // Restaure BP et passe à l'adresse de retour
+        BP = oldBP;
+        PCi = retAddr;
+    }
+    break;
+
+    case LDF:
+    {
+        // LDF : Pousse un nombre réel (float) sur la pile à partir d'une représentation en bits.
+        SP++;
+        if (SP >= TAILLEMEM) Error("Stack overflow LDF");
+        float f;
+        memcpy(&f, &inst.SUITE, sizeof(float));
+        MEM[SP].f = f;
+        MEM_TYPE[SP] = TYPE_REAL;
+        PCi++;
+    }
+    break;
+
+    case MEMO:
+        // MEMO n : En-tête d'une fonction mémoïsée, lu par CALL ; rien à faire ici
+        PCi++;
+        break;
+
+    case HLT:
+        // HLT : Arrête l'exécution.
+        PCi++;
+        break;
+    }
+}
+
+// Remet la pile et les caches de mémoïsation à zéro avant une exécution
+void INTER_INITIALISER(void)
+{
+    PCi = 0;
+    SP = -1;
+    BP = -1;
+    INTER_LIBERER();
+    if (PILE_REQUISE[0] >= VAR_BASE)
+        Error("Stack overflow: the main program's stack would reach the globals");
+}
+
+// Exécute l'instruction d'adresse pc et retourne l'adresse de la suivante
+int INTER_UNE(int pc)
+{
+    PCi = pc;
+    INTER_INST(PCODE[PCi]);
+    return PCi;
+}
+
+// Exécute le P-code à partir de l'adresse pc, jusqu'au HLT compris
+void INTER_DEPUIS(int pc)
+{
+    PCi = pc;
+    // Exécute les instructions tant que PCi est valide et que l'instruction n'est pas HLT
+    while (PCi >= 0 && PCi < TAILLECODE && PCODE[PCi].MNE != HLT)
+    {
+        INTER_INST(PCODE[PCi]);
+    }
+    // Si l'instruction HLT est atteinte, on la traite également
+    if (PCi >= 0 && PCi < TAILLECODE && PCODE[PCi].MNE == HLT)
+    {
+        INTER_INST(PCODE[PCi]);
+    }
+}
+
+// Affiche la fin de l'exécution et les compteurs de mémoïsation
+void INTER_TERMINER(void)
+{
+    Informer("End of execution (HLT).\n");
+    afficherMemo();
+    INTER_LIBERER();
+}
+
+// Boucle principale de l'interpréteur qui exécute les instructions du P-code
+void INTER_PCODE()
+{
+    INTER_INITIALISER();
+    INTER_DEPUIS(0);
+    INTER_TERMINER();
+}
@@ -1,9 +1,42 @@
-#ifndef INTERPRETEUR_H
-#define INTERPRETEUR_H
-
-#include "global.h"  // Inclut les définitions globales utilisées dans l'interpréteur
-
-// Déclare la fonction INTER_PCODE qui interprète le P-code généré
-void INTER_PCODE();
-
-#endif
+#ifndef INTERPRETEUR_H
+#define INTERPRETEUR_H
+
+#include "global.h"  // Inclut les définitions globales utilisées dans l'interpréteur
+
+// Entrées/sorties du programme exécuté (write et read). Un rappel NULL
+// garde la console : printf pour l'affichage, scanf pour la saisie.
+typedef struct {
+    void (*ecrire)(void *donnees, const char *texte);   // Texte affiché (PRN, invite de INN)
+    int  (*lire)(void *donnees, char *mot, int taille);  // Mot saisi pour INN ; 0 : plus d'entrée
+    void  *donnees;                                      // Passé tel quel aux rappels
+} Rappels;
+
+// Rappels de l'exécution en cours (par défaut la console)
+extern ETAT_PAR_FIL Rappels RAPPELS;
+
+// Déclare la fonction INTER_PCODE qui interprète le P-code généré
+void INTER_PCODE();
+
+// Étapes de INTER_PCODE, utilisées par le JIT (jit.c) qui exécute une partie
+// du programme en code machine et rend la main à l'interpréteur pour le reste
+
+// Remet la pile et les caches de mémoïsation à zéro avant une exécution
+void INTER_INITIALISER(void);
+
+// Exécute l'instruction d'adresse pc (SP et BP à jour) et retourne l'adresse de la suivante
+int INTER_UNE(int pc);
+
+// Exécute le P-code à partir de l'adresse pc, jusqu'au HLT compris
+void INTER_DEPUIS(int pc);
+
+// Affiche la fin de l'exécution et les compteurs de mémoïsation
+void INTER_TERMINER(void);
+
+// Libère les caches de mémoïsation (exécution terminée ou interrompue)
+void INTER_LIBERER(void);
+
+// Affiche une valeur comme l'instruction PRN ("PRN => ..."), sur la sortie
+// du programme ; utilisé aussi par le JIT de traces (trace.c)
+void INTER_AFFICHER(DataValue v, DataType type);
+
+#endif
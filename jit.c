@@ -0,0 +1,889 @@
+#include "jit.h"
+#include "interpreteur.h"  // Interpréteur : exécution d'une instruction sans gabarit
+#include "generation_c.h"  // RepartirProcedures (exécution par paliers)
+#include "semantique.h"    // TAB_IDFS, getProcFuncAtAddress (rapport des paliers)
+
+// ---------------------------------------------------------------------
+// JIT par recopie de gabarits (copy-and-patch) pour Linux x86-64
+// ---------------------------------------------------------------------
+// Pendant l'exécution du code machine, l'état de la machine P-code reste
+// celui de l'interpréteur, dans des registres :
+//   r12 = SP, r13 = BP (étendus en 64 bits), r14 = MEM, r15 = MEM_TYPE.
+// Chaque gabarit fait d'abord ses vérifications (pile, adresse, opérandes
+// entiers) : si l'une échoue, rien n'a été modifié et il saute à son stub
+// "LENT", qui fait exécuter l'instruction par l'interpréteur (INTER_UNE) ;
+// les erreurs et les réels suivent ainsi exactement le même chemin. Au
+// retour, AIGUILLAGE saute au code de l'instruction suivante par la table
+// des adresses natives. CALL, RET, PRN, INN... n'ont pas de gabarit : leur
+// code est directement le stub. HLT ou une adresse hors du programme
+// rendent la main à l'interpréteur (SORTIE), qui termine l'exécution.
+//
+// Les gabarits ont été assemblés une fois (as --64, syntaxe Intel) ; le
+// code est rappelé en commentaire. Leurs trous sont à zéro.
+// ---------------------------------------------------------------------
+
+#if defined(__x86_64__) && defined(__linux__)
+
+#include <sys/mman.h>  // mmap, mprotect, munmap
+#include <stdint.h>    // uint64_t
+
+#if TAILLEMEM != 500
+#error "Les gabarits du JIT comparent SP et les adresses à TAILLEMEM = 500"
+#endif
+
+// Nature d'un trou d'un gabarit
+typedef enum {
+    TROU_FIN,         // Fin de la liste
+    TROU_ARG,         // Argument de l'instruction (32 bits)
+    TROU_ARG4,        // Argument multiplié par 4 : déplacement dans MEM (32 bits)
+    TROU_LENT,        // Saut relatif vers le stub LENT de l'instruction
+    TROU_CIBLE,       // Saut relatif vers le code de l'instruction SUITE
+    TROU_SORTIE,      // Saut relatif vers SORTIE
+    TROU_COMMUN,      // Saut relatif vers COMMUN
+    TROU_AIGUILLAGE,  // Saut relatif vers AIGUILLAGE
+    TROU_MEM,         // Adresses absolues (64 bits)
+    TROU_MEM_TYPE,
+    TROU_SP,
+    TROU_BP,
+    TROU_INTER_UNE,
+    TROU_TABLE
+} TypeTrou;
+
+typedef struct {
+    int      decalage;  // Position du trou dans le gabarit
+    TypeTrou type;
+} Trou;
+
+// lea rax,[r12+1] ; cmp rax,500 ; jge LENT
+// mov r12,rax ; mov dword [r14+r12*4],a ; mov dword [r15+r12*4],0
+static const unsigned char GABARIT_LDI[] = {
+    0x49, 0x8d, 0x44, 0x24, 0x01, 0x48, 0x3d, 0xf4, 0x01, 0x00, 0x00, 0x0f,
+    0x8d, 0x00, 0x00, 0x00, 0x00, 0x49, 0x89, 0xc4, 0x43, 0xc7, 0x04, 0xa6,
+    0x00, 0x00, 0x00, 0x00, 0x43, 0xc7, 0x04, 0xa7, 0x00, 0x00, 0x00, 0x00
+};
+static const Trou TROUS_LDI[] = {{13, TROU_LENT}, {24, TROU_ARG}, {-1, TROU_FIN}};
+
+// lea rax,[r12+1] ; cmp rax,500 ; jge LENT
+// mov r12,rax ; mov dword [r14+r12*4],a ; mov dword [r15+r12*4],1
+static const unsigned char GABARIT_LDF[] = {
+    0x49, 0x8d, 0x44, 0x24, 0x01, 0x48, 0x3d, 0xf4, 0x01, 0x00, 0x00, 0x0f,
+    0x8d, 0x00, 0x00, 0x00, 0x00, 0x49, 0x89, 0xc4, 0x43, 0xc7, 0x04, 0xa6,
+    0x00, 0x00, 0x00, 0x00, 0x43, 0xc7, 0x04, 0xa7, 0x01, 0x00, 0x00, 0x00
+};
+static const Trou TROUS_LDF[] = {{13, TROU_LENT}, {24, TROU_ARG}, {-1, TROU_FIN}};
+
+// lea rax,[r12+1] ; cmp rax,500 ; jge LENT
+// mov r12,rax ; lea ecx,[r13+a] ; mov [r14+r12*4],ecx
+// mov dword [r15+r12*4],0
+static const unsigned char GABARIT_LLA[] = {
+    0x49, 0x8d, 0x44, 0x24, 0x01, 0x48, 0x3d, 0xf4, 0x01, 0x00, 0x00, 0x0f,
+    0x8d, 0x00, 0x00, 0x00, 0x00, 0x49, 0x89, 0xc4, 0x41, 0x8d, 0x8d, 0x00,
+    0x00, 0x00, 0x00, 0x43, 0x89, 0x0c, 0xa6, 0x43, 0xc7, 0x04, 0xa7, 0x00,
+    0x00, 0x00, 0x00
+};
+static const Trou TROUS_LLA[] = {{13, TROU_LENT}, {23, TROU_ARG}, {-1, TROU_FIN}};
+
+// test r12,r12 ; js LENT ; movsxd rax,dword [r14+r12*4]
+// cmp rax,500 ; jae LENT ; mov ecx,[r14+rax*4]
+// mov [r14+r12*4],ecx ; mov ecx,[r15+rax*4] ; mov [r15+r12*4],ecx
+static const unsigned char GABARIT_LDV[] = {
+    0x4d, 0x85, 0xe4, 0x0f, 0x88, 0x00, 0x00, 0x00, 0x00, 0x4b, 0x63, 0x04,
+    0xa6, 0x48, 0x3d, 0xf4, 0x01, 0x00, 0x00, 0x0f, 0x83, 0x00, 0x00, 0x00,
+    0x00, 0x41, 0x8b, 0x0c, 0x86, 0x43, 0x89, 0x0c, 0xa6, 0x41, 0x8b, 0x0c,
+    0x87, 0x43, 0x89, 0x0c, 0xa7
+};
+static const Trou TROUS_LDV[] = {{5, TROU_LENT}, {21, TROU_LENT}, {-1, TROU_FIN}};
+
+// lea rax,[r12+1] ; cmp rax,500 ; jge LENT
+// lea rdx,[r13+a] ; cmp rdx,500 ; jae LENT
+// mov r12,rax ; mov ecx,[r14+rdx*4] ; mov [r14+r12*4],ecx
+// mov ecx,[r15+rdx*4] ; mov [r15+r12*4],ecx
+static const unsigned char GABARIT_LDL[] = {
+    0x49, 0x8d, 0x44, 0x24, 0x01, 0x48, 0x3d, 0xf4, 0x01, 0x00, 0x00, 0x0f,
+    0x8d, 0x00, 0x00, 0x00, 0x00, 0x49, 0x8d, 0x95, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x81, 0xfa, 0xf4, 0x01, 0x00, 0x00, 0x0f, 0x83, 0x00, 0x00, 0x00,
+    0x00, 0x49, 0x89, 0xc4, 0x41, 0x8b, 0x0c, 0x96, 0x43, 0x89, 0x0c, 0xa6,
+    0x41, 0x8b, 0x0c, 0x97, 0x43, 0x89, 0x0c, 0xa7
+};
+static const Trou TROUS_LDL[] = {{13, TROU_LENT}, {20, TROU_ARG}, {33, TROU_LENT}, {-1, TROU_FIN}};
+
+// test r12,r12 ; js LENT ; mov ecx,[r14+r12*4]
+// mov [r14+4*a],ecx ; mov ecx,[r15+r12*4] ; mov [r15+4*a],ecx
+// dec r12
+static const unsigned char GABARIT_STO[] = {
+    0x4d, 0x85, 0xe4, 0x0f, 0x88, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x0c,
+    0xa6, 0x41, 0x89, 0x8e, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x0c, 0xa7,
+    0x41, 0x89, 0x8f, 0x00, 0x00, 0x00, 0x00, 0x49, 0xff, 0xcc
+};
+static const Trou TROUS_STO[] = {{5, TROU_LENT}, {16, TROU_ARG4}, {27, TROU_ARG4}, {-1, TROU_FIN}};
+
+// test r12,r12 ; js LENT ; dec r12
+static const unsigned char GABARIT_POP[] = {
+    0x4d, 0x85, 0xe4, 0x0f, 0x88, 0x00, 0x00, 0x00, 0x00, 0x49, 0xff, 0xcc
+};
+static const Trou TROUS_POP[] = {{5, TROU_LENT}, {-1, TROU_FIN}};
+
+// test r12,r12 ; js LENT ; mov ecx,[r14+r12*4]
+// mov [r14+4*a],ecx ; mov ecx,[r15+r12*4] ; mov [r15+4*a],ecx
+static const unsigned char GABARIT_STO_KEEP[] = {
+    0x4d, 0x85, 0xe4, 0x0f, 0x88, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x0c,
+    0xa6, 0x41, 0x89, 0x8e, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x0c, 0xa7,
+    0x41, 0x89, 0x8f, 0x00, 0x00, 0x00, 0x00
+};
+static const Trou TROUS_STO_KEEP[] = {{5, TROU_LENT}, {16, TROU_ARG4}, {27, TROU_ARG4}, {-1, TROU_FIN}};
+
+// test r12,r12 ; js LENT ; lea rdx,[r13+a]
+// cmp rdx,500 ; jae LENT ; mov ecx,[r14+r12*4]
+// mov [r14+rdx*4],ecx ; mov ecx,[r15+r12*4] ; mov [r15+rdx*4],ecx
+// dec r12
+static const unsigned char GABARIT_STL[] = {
+    0x4d, 0x85, 0xe4, 0x0f, 0x88, 0x00, 0x00, 0x00, 0x00, 0x49, 0x8d, 0x95,
+    0x00, 0x00, 0x00, 0x00, 0x48, 0x81, 0xfa, 0xf4, 0x01, 0x00, 0x00, 0x0f,
+    0x83, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x0c, 0xa6, 0x41, 0x89, 0x0c,
+    0x96, 0x43, 0x8b, 0x0c, 0xa7, 0x41, 0x89, 0x0c, 0x97, 0x49, 0xff, 0xcc
+};
+static const Trou TROUS_STL[] = {{5, TROU_LENT}, {12, TROU_ARG}, {25, TROU_LENT}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; movsxd rax,dword [r14+r12*4]
+// cmp rax,500 ; jae LENT ; mov ecx,[r14+r12*4-4]
+// mov [r14+rax*4],ecx ; mov ecx,[r15+r12*4-4] ; mov [r15+rax*4],ecx
+// sub r12,2
+static const unsigned char GABARIT_STO_IND[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x4b, 0x63,
+    0x04, 0xa6, 0x48, 0x3d, 0xf4, 0x01, 0x00, 0x00, 0x0f, 0x83, 0x00, 0x00,
+    0x00, 0x00, 0x43, 0x8b, 0x4c, 0xa6, 0xfc, 0x41, 0x89, 0x0c, 0x86, 0x43,
+    0x8b, 0x4c, 0xa7, 0xfc, 0x41, 0x89, 0x0c, 0x87, 0x49, 0x83, 0xec, 0x02
+};
+static const Trou TROUS_STO_IND[] = {{6, TROU_LENT}, {22, TROU_LENT}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4-4] ; add eax,[r14+r12*4] ; mov [r14+r12*4-4],eax
+// dec r12
+static const unsigned char GABARIT_ADD[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x44,
+    0xa6, 0xfc, 0x43, 0x03, 0x04, 0xa6, 0x43, 0x89, 0x44, 0xa6, 0xfc, 0x49,
+    0xff, 0xcc
+};
+static const Trou TROUS_ADD[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4-4] ; sub eax,[r14+r12*4] ; mov [r14+r12*4-4],eax
+// dec r12
+static const unsigned char GABARIT_SUB[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x44,
+    0xa6, 0xfc, 0x43, 0x2b, 0x04, 0xa6, 0x43, 0x89, 0x44, 0xa6, 0xfc, 0x49,
+    0xff, 0xcc
+};
+static const Trou TROUS_SUB[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4] ; sub eax,[r14+r12*4-4] ; mov [r14+r12*4-4],eax
+// dec r12
+static const unsigned char GABARIT_SUBR[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x04,
+    0xa6, 0x43, 0x2b, 0x44, 0xa6, 0xfc, 0x43, 0x89, 0x44, 0xa6, 0xfc, 0x49,
+    0xff, 0xcc
+};
+static const Trou TROUS_SUBR[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4-4] ; imul eax,[r14+r12*4] ; mov [r14+r12*4-4],eax
+// dec r12
+static const unsigned char GABARIT_MUL[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x44,
+    0xa6, 0xfc, 0x43, 0x0f, 0xaf, 0x04, 0xa6, 0x43, 0x89, 0x44, 0xa6, 0xfc,
+    0x49, 0xff, 0xcc
+};
+static const Trou TROUS_MUL[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4-4] ; cmp eax,[r14+r12*4] ; sete al
+// movzx eax,al ; mov [r14+r12*4-4],eax ; dec r12
+static const unsigned char GABARIT_EQL[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x44,
+    0xa6, 0xfc, 0x43, 0x3b, 0x04, 0xa6, 0x0f, 0x94, 0xc0, 0x0f, 0xb6, 0xc0,
+    0x43, 0x89, 0x44, 0xa6, 0xfc, 0x49, 0xff, 0xcc
+};
+static const Trou TROUS_EQL[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4-4] ; cmp eax,[r14+r12*4] ; setne al
+// movzx eax,al ; mov [r14+r12*4-4],eax ; dec r12
+static const unsigned char GABARIT_NEQ[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x44,
+    0xa6, 0xfc, 0x43, 0x3b, 0x04, 0xa6, 0x0f, 0x95, 0xc0, 0x0f, 0xb6, 0xc0,
+    0x43, 0x89, 0x44, 0xa6, 0xfc, 0x49, 0xff, 0xcc
+};
+static const Trou TROUS_NEQ[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4-4] ; cmp eax,[r14+r12*4] ; setg al
+// movzx eax,al ; mov [r14+r12*4-4],eax ; dec r12
+static const unsigned char GABARIT_GTR[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x44,
+    0xa6, 0xfc, 0x43, 0x3b, 0x04, 0xa6, 0x0f, 0x9f, 0xc0, 0x0f, 0xb6, 0xc0,
+    0x43, 0x89, 0x44, 0xa6, 0xfc, 0x49, 0xff, 0xcc
+};
+static const Trou TROUS_GTR[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4-4] ; cmp eax,[r14+r12*4] ; setl al
+// movzx eax,al ; mov [r14+r12*4-4],eax ; dec r12
+static const unsigned char GABARIT_LSS[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x44,
+    0xa6, 0xfc, 0x43, 0x3b, 0x04, 0xa6, 0x0f, 0x9c, 0xc0, 0x0f, 0xb6, 0xc0,
+    0x43, 0x89, 0x44, 0xa6, 0xfc, 0x49, 0xff, 0xcc
+};
+static const Trou TROUS_LSS[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4-4] ; cmp eax,[r14+r12*4] ; setge al
+// movzx eax,al ; mov [r14+r12*4-4],eax ; dec r12
+static const unsigned char GABARIT_GEQ[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x44,
+    0xa6, 0xfc, 0x43, 0x3b, 0x04, 0xa6, 0x0f, 0x9d, 0xc0, 0x0f, 0xb6, 0xc0,
+    0x43, 0x89, 0x44, 0xa6, 0xfc, 0x49, 0xff, 0xcc
+};
+static const Trou TROUS_GEQ[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4-4] ; cmp eax,[r14+r12*4] ; setle al
+// movzx eax,al ; mov [r14+r12*4-4],eax ; dec r12
+static const unsigned char GABARIT_LEQ[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x44,
+    0xa6, 0xfc, 0x43, 0x3b, 0x04, 0xa6, 0x0f, 0x9e, 0xc0, 0x0f, 0xb6, 0xc0,
+    0x43, 0x89, 0x44, 0xa6, 0xfc, 0x49, 0xff, 0xcc
+};
+static const Trou TROUS_LEQ[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4-4] ; lea r12,[r12-2] ; cmp eax,[r14+r12*4+8]
+// je CIBLE
+static const unsigned char GABARIT_BEQ[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x44,
+    0xa6, 0xfc, 0x4d, 0x8d, 0x64, 0x24, 0xfe, 0x43, 0x3b, 0x44, 0xa6, 0x08,
+    0x0f, 0x84, 0x00, 0x00, 0x00, 0x00
+};
+static const Trou TROUS_BEQ[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {50, TROU_CIBLE}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4-4] ; lea r12,[r12-2] ; cmp eax,[r14+r12*4+8]
+// jne CIBLE
+static const unsigned char GABARIT_BNE[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x44,
+    0xa6, 0xfc, 0x4d, 0x8d, 0x64, 0x24, 0xfe, 0x43, 0x3b, 0x44, 0xa6, 0x08,
+    0x0f, 0x85, 0x00, 0x00, 0x00, 0x00
+};
+static const Trou TROUS_BNE[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {50, TROU_CIBLE}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4-4] ; lea r12,[r12-2] ; cmp eax,[r14+r12*4+8]
+// jg CIBLE
+static const unsigned char GABARIT_BGT[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x44,
+    0xa6, 0xfc, 0x4d, 0x8d, 0x64, 0x24, 0xfe, 0x43, 0x3b, 0x44, 0xa6, 0x08,
+    0x0f, 0x8f, 0x00, 0x00, 0x00, 0x00
+};
+static const Trou TROUS_BGT[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {50, TROU_CIBLE}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4-4] ; lea r12,[r12-2] ; cmp eax,[r14+r12*4+8]
+// jl CIBLE
+static const unsigned char GABARIT_BLT[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x44,
+    0xa6, 0xfc, 0x4d, 0x8d, 0x64, 0x24, 0xfe, 0x43, 0x3b, 0x44, 0xa6, 0x08,
+    0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00
+};
+static const Trou TROUS_BLT[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {50, TROU_CIBLE}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4-4] ; lea r12,[r12-2] ; cmp eax,[r14+r12*4+8]
+// jge CIBLE
+static const unsigned char GABARIT_BGE[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x44,
+    0xa6, 0xfc, 0x4d, 0x8d, 0x64, 0x24, 0xfe, 0x43, 0x3b, 0x44, 0xa6, 0x08,
+    0x0f, 0x8d, 0x00, 0x00, 0x00, 0x00
+};
+static const Trou TROUS_BGE[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {50, TROU_CIBLE}, {-1, TROU_FIN}};
+
+// cmp r12,1 ; jl LENT ; cmp dword [r15+r12*4],0
+// jne LENT ; cmp dword [r15+r12*4-4],0 ; jne LENT
+// mov eax,[r14+r12*4-4] ; lea r12,[r12-2] ; cmp eax,[r14+r12*4+8]
+// jle CIBLE
+static const unsigned char GABARIT_BLE[] = {
+    0x49, 0x83, 0xfc, 0x01, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83,
+    0x3c, 0xa7, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x83, 0x7c,
+    0xa7, 0xfc, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x44,
+    0xa6, 0xfc, 0x4d, 0x8d, 0x64, 0x24, 0xfe, 0x43, 0x3b, 0x44, 0xa6, 0x08,
+    0x0f, 0x8e, 0x00, 0x00, 0x00, 0x00
+};
+static const Trou TROUS_BLE[] = {{6, TROU_LENT}, {17, TROU_LENT}, {29, TROU_LENT}, {50, TROU_CIBLE}, {-1, TROU_FIN}};
+
+// test r12,r12 ; js LENT ; mov eax,[r14+r12*4]
+// lea r12,[r12-1] ; test eax,eax ; jz CIBLE
+static const unsigned char GABARIT_BZE[] = {
+    0x4d, 0x85, 0xe4, 0x0f, 0x88, 0x00, 0x00, 0x00, 0x00, 0x43, 0x8b, 0x04,
+    0xa6, 0x4d, 0x8d, 0x64, 0x24, 0xff, 0x85, 0xc0, 0x0f, 0x84, 0x00, 0x00,
+    0x00, 0x00
+};
+static const Trou TROUS_BZE[] = {{5, TROU_LENT}, {22, TROU_CIBLE}, {-1, TROU_FIN}};
+
+// jmp CIBLE
+static const unsigned char GABARIT_BRN[] = {
+    0xe9, 0x00, 0x00, 0x00, 0x00
+};
+static const Trou TROUS_BRN[] = {{1, TROU_CIBLE}, {-1, TROU_FIN}};
+
+// mov eax,pc ; jmp SORTIE
+static const unsigned char GABARIT_HLT[] = {
+    0xb8, 0x00, 0x00, 0x00, 0x00, 0xe9, 0x00, 0x00, 0x00, 0x00
+};
+static const Trou TROUS_HLT[] = {{1, TROU_ARG}, {6, TROU_SORTIE}, {-1, TROU_FIN}};
+
+// mov edi,pc ; jmp COMMUN
+static const unsigned char GABARIT_LENT[] = {
+    0xbf, 0x00, 0x00, 0x00, 0x00, 0xe9, 0x00, 0x00, 0x00, 0x00
+};
+static const Trou TROUS_LENT[] = {{1, TROU_ARG}, {6, TROU_COMMUN}, {-1, TROU_FIN}};
+
+// push rbp ; push rbx ; push r12
+// push r13 ; push r14 ; push r15
+// sub rsp,8 ; movabs r14,&MEM ; movabs r15,&MEM_TYPE
+// movabs rcx,&SP ; movsxd r12,dword [rcx] ; movabs rcx,&BP
+// movsxd r13,dword [rcx] ; mov eax,edi ; jmp AIGUILLAGE
+static const unsigned char GABARIT_PROLOGUE[] = {
+    0x55, 0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57, 0x48, 0x83,
+    0xec, 0x08, 0x49, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x49, 0xbf, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0xb9,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x63, 0x21, 0x48,
+    0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x63, 0x29,
+    0x89, 0xf8, 0xe9, 0x00, 0x00, 0x00, 0x00
+};
+static const Trou TROUS_PROLOGUE[] = {{16, TROU_MEM}, {26, TROU_MEM_TYPE}, {36, TROU_SP}, {49, TROU_BP}, {63, TROU_AIGUILLAGE}, {-1, TROU_FIN}};
+
+// movabs rax,&SP ; mov [rax],r12d ; movabs rax,&BP
+// mov [rax],r13d ; movabs rax,INTER_UNE ; call rax
+// movabs rcx,&SP ; movsxd r12,dword [rcx] ; movabs rcx,&BP
+// movsxd r13,dword [rcx]
+static const unsigned char GABARIT_COMMUN[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x89,
+    0x20, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+    0x89, 0x28, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xff, 0xd0, 0x48, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x4c, 0x63, 0x21, 0x48, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x4c, 0x63, 0x29
+};
+static const Trou TROUS_COMMUN[] = {{2, TROU_SP}, {15, TROU_BP}, {28, TROU_INTER_UNE}, {40, TROU_SP}, {53, TROU_BP}, {-1, TROU_FIN}};
+
+// cmp eax,n ; jae SORTIE ; movabs rcx,table
+// jmp qword [rcx+rax*8]
+static const unsigned char GABARIT_AIGUILLAGE[] = {
+    0x3d, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x83, 0x00, 0x00, 0x00, 0x00, 0x48,
+    0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x24, 0xc1
+};
+static const Trou TROUS_AIGUILLAGE[] = {{1, TROU_ARG}, {7, TROU_SORTIE}, {13, TROU_TABLE}, {-1, TROU_FIN}};
+
+// movabs rcx,&SP ; mov [rcx],r12d ; movabs rcx,&BP
+// mov [rcx],r13d ; add rsp,8 ; pop r15
+// pop r14 ; pop r13 ; pop r12
+// pop rbx ; pop rbp ; ret
+static const unsigned char GABARIT_SORTIE[] = {
+    0x48, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x89,
+    0x21, 0x48, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+    0x89, 0x29, 0x48, 0x83, 0xc4, 0x08, 0x41, 0x5f, 0x41, 0x5e, 0x41, 0x5d,
+    0x41, 0x5c, 0x5b, 0x5d, 0xc3
+};
+static const Trou TROUS_SORTIE[] = {{2, TROU_SP}, {15, TROU_BP}, {-1, TROU_FIN}};
+
+typedef struct {
+    const unsigned char *code;
+    int                  taille;
+    const Trou          *trous;
+} Gabarit;
+
+#define GABARIT(nom) {GABARIT_##nom, (int)sizeof(GABARIT_##nom), TROUS_##nom}
+
+static const Gabarit G_LDI = GABARIT(LDI), G_LDF = GABARIT(LDF), G_LLA = GABARIT(LLA);
+static const Gabarit G_LDV = GABARIT(LDV), G_LDL = GABARIT(LDL), G_STO = GABARIT(STO);
+static const Gabarit G_POP = GABARIT(POP), G_STO_KEEP = GABARIT(STO_KEEP), G_STL = GABARIT(STL);
+static const Gabarit G_STO_IND = GABARIT(STO_IND);
+static const Gabarit G_ADD = GABARIT(ADD), G_SUB = GABARIT(SUB), G_SUBR = GABARIT(SUBR), G_MUL = GABARIT(MUL);
+static const Gabarit G_EQL = GABARIT(EQL), G_NEQ = GABARIT(NEQ), G_GTR = GABARIT(GTR);
+static const Gabarit G_LSS = GABARIT(LSS), G_GEQ = GABARIT(GEQ), G_LEQ = GABARIT(LEQ);
+static const Gabarit G_BEQ = GABARIT(BEQ), G_BNE = GABARIT(BNE), G_BGT = GABARIT(BGT);
+static const Gabarit G_BLT = GABARIT(BLT), G_BGE = GABARIT(BGE), G_BLE = GABARIT(BLE);
+static const Gabarit G_BZE = GABARIT(BZE), G_BRN = GABARIT(BRN), G_HLT = GABARIT(HLT);
+static const Gabarit G_LENT = GABARIT(LENT), G_PROLOGUE = GABARIT(PROLOGUE);
+static const Gabarit G_COMMUN = GABARIT(COMMUN), G_AIGUILLAGE = GABARIT(AIGUILLAGE);
+static const Gabarit G_SORTIE = GABARIT(SORTIE);
+
+// Gabarit de l'instruction i, ou NULL si elle est exécutée par l'interpréteur
+static const Gabarit *gabaritDe(int i)
+{
+    int a = PCODE[i].SUITE;
+    int cibleValide = (a >= 0 && a <= PC);
+    switch (PCODE[i].MNE)
+    {
+    case LDI: case LDA: return &G_LDI;
+    case LDF:      return &G_LDF;
+    case LLA:      return &G_LLA;
+    case LDV:      return &G_LDV;
+    case LDL:      return &G_LDL;
+    case STO:
+        if (a == -9999)
+            return &G_POP;
+        return (a >= 0 && a < TAILLEMEM) ? &G_STO : NULL;
+    case STO_KEEP: return (a >= 0 && a < TAILLEMEM) ? &G_STO_KEEP : NULL;
+    case STL:      return &G_STL;
+    case STO_IND:  return &G_STO_IND;
+    case ADD:      return &G_ADD;
+    case SUB:      return &G_SUB;
+    case SUBR:     return &G_SUBR;
+    case MUL:      return &G_MUL;
+    case EQL:      return &G_EQL;
+    case NEQ:      return &G_NEQ;
+    case GTR:      return &G_GTR;
+    case LSS:      return &G_LSS;
+    case GEQ:      return &G_GEQ;
+    case LEQ:      return &G_LEQ;
+    case BEQ:      return cibleValide ? &G_BEQ : NULL;
+    case BNE:      return cibleValide ? &G_BNE : NULL;
+    case BGT:      return cibleValide ? &G_BGT : NULL;
+    case BLT:      return cibleValide ? &G_BLT : NULL;
+    case BGE:      return cibleValide ? &G_BGE : NULL;
+    case BLE:      return cibleValide ? &G_BLE : NULL;
+    case BZE:      return cibleValide ? &G_BZE : NULL;
+    case BRN:      return cibleValide ? &G_BRN : NULL;
+    case HLT:      return &G_HLT;
+    default:       return NULL; // DIVI, CALL, RET, PRN, INN, ALC... : interpréteur
+    }
+}
+
+// Positions des morceaux de code dans la zone exécutable
+typedef struct {
+    unsigned char *zone;
+    int  commun, aiguillage, sortie;
+    int  natif[TAILLECODE + 1];  // Code de chaque instruction (et de la fin du programme)
+    int  lent[TAILLECODE];       // Stub LENT de chaque instruction
+    int  retour[TAILLECODE];     // Exécution par paliers : stub qui rend la main au pilote
+} Traduction;
+
+static ETAT_PAR_FIL uint64_t tableNative[TAILLECODE]; // Adresse du code de chaque instruction (AIGUILLAGE)
+
+// Recopie le gabarit g à la position pos et remplit ses trous
+static int poser(Traduction *t, int pos, const Gabarit *g, int arg, int lent, int cible)
+{
+    unsigned char *p = t->zone + pos;
+    memcpy(p, g->code, (size_t)g->taille);
+    for (const Trou *tr = g->trous; tr->type != TROU_FIN; tr++)
+    {
+        unsigned char *q = p + tr->decalage;
+        int32_t v32 = 0;
+        uint64_t v64 = 0;
+        int dest = -1;
+        switch (tr->type)
+        {
+        case TROU_ARG:        v32 = arg; break;
+        case TROU_ARG4:       v32 = arg * 4; break;
+        case TROU_LENT:       dest = lent; break;
+        case TROU_CIBLE:      dest = cible; break;
+        case TROU_SORTIE:     dest = t->sortie; break;
+        case TROU_COMMUN:     dest = t->commun; break;
+        case TROU_AIGUILLAGE: dest = t->aiguillage; break;
+        case TROU_MEM:        v64 = (uint64_t)(uintptr_t)MEM; break;
+        case TROU_MEM_TYPE:   v64 = (uint64_t)(uintptr_t)MEM_TYPE; break;
+        case TROU_SP:         v64 = (uint64_t)(uintptr_t)&SP; break;
+        case TROU_BP:         v64 = (uint64_t)(uintptr_t)&BP; break;
+        case TROU_INTER_UNE:  v64 = (uint64_t)(uintptr_t)&INTER_UNE; break;
+        case TROU_TABLE:      v64 = (uint64_t)(uintptr_t)tableNative; break;
+        default: break;
+        }
+        if (tr->type >= TROU_MEM)
+            memcpy(q, &v64, 8);
+        else
+        {
+            if (dest >= 0)
+                v32 = (int32_t)(dest - (pos + tr->decalage + 4)); // Relatif à la fin du saut
+            memcpy(q, &v32, 4);
+        }
+    }
+    return pos + g->taille;
+}
+
+// Écrit le code de l'instruction i : son gabarit et son stub LENT, ou le stub seul
+static void traduireInstruction(Traduction *t, int i)
+{
+    const Gabarit *g = gabaritDe(i);
+    int a = PCODE[i].SUITE;
+    int cible = (a >= 0 && a <= PC) ? t->natif[a] : -1;
+    if (g)
+    {
+        poser(t, t->natif[i], g, (g == &G_HLT) ? i : a, t->lent[i], cible);
+        poser(t, t->lent[i], &G_LENT, i, -1, -1);
+    }
+    else
+        poser(t, t->natif[i], &G_LENT, i, -1, -1);
+}
+
+// Traduit PCODE[0..PC] dans t->zone (taille calculée par une première passe
+// si t->zone est NULL). Retourne la taille du code et compte les instructions
+// qui ont un gabarit. Avec 'paliers', la place de chaque instruction est
+// réservée mais son code est un saut vers un stub RETOUR (comme HLT, il rend
+// son adresse) : chaque procédure est écrite plus tard par traduireInstruction.
+static int traduire(Traduction *t, int *nGabarits, int paliers)
+{
+    int pos = 0;
+    *nGabarits = 0;
+    int entree = pos; // PROLOGUE, appelé comme une fonction C : int (*)(int pc)
+    pos += G_PROLOGUE.taille;
+    t->commun = pos;  // COMMUN se poursuit dans AIGUILLAGE
+    pos += G_COMMUN.taille;
+    t->aiguillage = pos;
+    pos += G_AIGUILLAGE.taille;
+    t->sortie = pos;
+    pos += G_SORTIE.taille;
+    for (int i = 0; i <= PC; i++)
+    {
+        const Gabarit *g = gabaritDe(i);
+        t->natif[i] = pos;
+        pos += g ? g->taille : G_LENT.taille;
+        *nGabarits += (g != NULL);
+    }
+    t->natif[PC + 1] = pos; // Fin du programme : comme un HLT à l'adresse PC + 1
+    pos += G_HLT.taille;
+    for (int i = 0; i <= PC; i++)
+    {
+        t->lent[i] = pos;
+        if (gabaritDe(i))
+            pos += G_LENT.taille;
+    }
+    for (int i = 0; i <= PC && paliers; i++)
+    {
+        t->retour[i] = pos;
+        pos += G_HLT.taille;
+    }
+    if (!t->zone)
+        return pos;
+
+    poser(t, entree, &G_PROLOGUE, 0, -1, -1);
+    poser(t, t->commun, &G_COMMUN, 0, -1, -1);
+    poser(t, t->aiguillage, &G_AIGUILLAGE, PC + 1, -1, -1);
+    poser(t, t->sortie, &G_SORTIE, 0, -1, -1);
+    for (int i = 0; i <= PC; i++)
+    {
+        if (paliers)
+        {
+            // Un saut (5 octets) tient à la place de n'importe quel gabarit
+            poser(t, t->retour[i], &G_HLT, i, -1, -1);
+            poser(t, t->natif[i], &G_BRN, 0, -1, t->retour[i]);
+        }
+        else
+            traduireInstruction(t, i);
+        tableNative[i] = (uint64_t)(uintptr_t)(t->zone + t->natif[i]);
+    }
+    poser(t, t->natif[PC + 1], &G_HLT, PC + 1, -1, -1);
+    return pos;
+}
+
+// Zone exécutable de l'exécution en cours (NULL : aucune)
+static ETAT_PAR_FIL void  *zoneOuverte;
+static ETAT_PAR_FIL size_t tailleOuverte;
+
+// Réserve la zone où écrire le code machine ; NULL si c'est impossible
+static void *ouvrirZone(size_t taille)
+{
+    void *zone = mmap(NULL, taille, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (zone == MAP_FAILED)
+        return NULL;
+    zoneOuverte = zone;
+    tailleOuverte = taille;
+    return zone;
+}
+
+void JIT_LIBERER(void)
+{
+    if (zoneOuverte)
+        munmap(zoneOuverte, tailleOuverte);
+    zoneOuverte = NULL;
+}
+
+void JIT_PCODE(void)
+{
+    static ETAT_PAR_FIL Traduction t;
+    int nGabarits;
+    INTER_INITIALISER();
+    t.zone = NULL;
+    size_t taille = (size_t)traduire(&t, &nGabarits, 0);
+    void *zone = ouvrirZone(taille);
+    if (!zone)
+    {
+        Informer("JIT: no executable memory, interpreting\n");
+        INTER_DEPUIS(0);
+        INTER_TERMINER();
+        return;
+    }
+    t.zone = zone;
+    traduire(&t, &nGabarits, 0);
+    if (mprotect(zone, taille, PROT_READ | PROT_EXEC) != 0)
+    {
+        JIT_LIBERER();
+        Informer("JIT: no executable memory, interpreting\n");
+        INTER_DEPUIS(0);
+        INTER_TERMINER();
+        return;
+    }
+    Informer("JIT: %d/%d instructions compiled, %d bytes\n", nGabarits, PC + 1, (int)taille);
+
+    // Le code machine s'exécute jusqu'à HLT ou une adresse hors du programme ;
+    // l'interpréteur reprend à cette adresse et termine
+    int (*executer)(int) = (int (*)(int))zone;
+    int pc = executer(0);
+    JIT_LIBERER();
+    INTER_DEPUIS(pc);
+    INTER_TERMINER();
+}
+
+// ---------------------------------------------------------------------
+// Exécution par paliers
+// ---------------------------------------------------------------------
+// Toutes les procédures commencent interprétées. Le pilote compte les appels
+// de chaque procédure (CALL, ou saut d'un appel terminal vers son entrée) et
+// les branchements arrière pris dans son code ; au seuil, le code machine de
+// ses instructions est écrit à leur place réservée. Le pilote entre alors
+// dans le code machine dès que l'interpréteur arrive sur une instruction
+// compilée : appel suivant, ou itération suivante d'une boucle en cours. Le
+// code machine rend la main en arrivant sur une instruction pas encore
+// compilée (stub RETOUR), par exemple l'appel d'une procédure encore
+// interprétée ou le retour vers elle.
+
+// Passage au code machine d'une procédure, pour le rapport
+typedef struct {
+    int  entree;        // Adresse d'entrée de la procédure
+    int  parBoucles;    // Seuil atteint par les branchements arrière (sinon par les appels)
+    long interpretees;  // Instructions interprétées jusque-là
+} Palier;
+
+// Nom de la procédure d'entrée e
+static const char *nomProcedure(int e)
+{
+    if (e == 0)
+        return "main";
+    int idf = getProcFuncAtAddress(e);
+    return idf >= 0 ? TAB_IDFS[idf].Nom : "?";
+}
+
+// Attribue chaque instruction à l'entrée de sa procédure (-1 : code mort).
+// Si des procédures partagent du code, tout le programme est une seule unité.
+static void repartir(int procedure[TAILLECODE])
+{
+    for (int i = 0; i <= PC; i++)
+    {
+        Mnemoniques m = PCODE[i].MNE;
+        int a = PCODE[i].SUITE;
+        if ((m == BRN || m == BZE || (m >= BEQ && m <= BGE) || m == CALL) && (a < 0 || a > PC))
+        {
+            // RepartirProcedures refuse un saut hors du programme
+            for (int k = 0; k < TAILLECODE; k++)
+                procedure[k] = (k <= PC) ? 0 : -1;
+            return;
+        }
+    }
+    if (!RepartirProcedures(procedure, NULL))
+    {
+        for (int k = 0; k < TAILLECODE; k++)
+            procedure[k] = (k <= PC) ? 0 : -1;
+    }
+}
+
+ETAT_PAR_FIL int SEUIL_APPELS = 100;
+ETAT_PAR_FIL int SEUIL_BOUCLES = 1000;
+
+void JIT_PAR_PALIERS(void)
+{
+    static ETAT_PAR_FIL Traduction t;
+    static ETAT_PAR_FIL int procedure[TAILLECODE];
+    static ETAT_PAR_FIL char compile[TAILLECODE];      // Instruction dont le code machine est écrit
+    static ETAT_PAR_FIL char procedureCompilee[TAILLECODE];
+    static ETAT_PAR_FIL long appels[TAILLECODE];       // Compteurs par entrée de procédure
+    static ETAT_PAR_FIL long boucles[TAILLECODE];
+    static ETAT_PAR_FIL Palier paliers[TAILLECODE];
+    int nPaliers = 0, nGabarits;
+
+    INTER_INITIALISER();
+    t.zone = NULL;
+    size_t taille = (size_t)traduire(&t, &nGabarits, 1);
+    void *zone = ouvrirZone(taille);
+    if (!zone)
+    {
+        Informer("Tiers: no executable memory, interpreting\n");
+        INTER_DEPUIS(0);
+        INTER_TERMINER();
+        return;
+    }
+    t.zone = zone;
+    traduire(&t, &nGabarits, 1);
+    if (mprotect(zone, taille, PROT_READ | PROT_EXEC) != 0)
+    {
+        JIT_LIBERER();
+        Informer("Tiers: no executable memory, interpreting\n");
+        INTER_DEPUIS(0);
+        INTER_TERMINER();
+        return;
+    }
+    repartir(procedure);
+    memset(compile, 0, sizeof(compile));
+    memset(procedureCompilee, 0, sizeof(procedureCompilee));
+    memset(appels, 0, sizeof(appels));
+    memset(boucles, 0, sizeof(boucles));
+    int nProcedures = 0;
+    for (int i = 0; i <= PC; i++)
+        nProcedures += (procedure[i] == i);
+
+    int (*executer)(int) = (int (*)(int))zone;
+    long interpretees = 0, entrees = 0;
+    int pc = 0;
+    while (pc >= 0 && pc < TAILLECODE && PCODE[pc].MNE != HLT)
+    {
+        int suivant, p = -1, parBoucles = 0;
+        if (compile[pc])
+        {
+            // Jusqu'à une instruction encore interprétée (ou HLT) ; si c'est
+            // l'entrée d'une procédure, le code machine vient de l'appeler
+            suivant = executer(pc);
+            entrees++;
+            if (suivant >= 0 && suivant <= PC && procedure[suivant] == suivant &&
+                !procedureCompilee[suivant] && ++appels[suivant] >= SEUIL_APPELS)
+                p = suivant;
+        }
+        else
+        {
+            suivant = INTER_UNE(pc);
+            interpretees++;
+            Mnemoniques m = PCODE[pc].MNE;
+            int appel = (m == CALL || (m == BRN && pc > 0 && PCODE[pc - 1].MNE == TAILCALL)) &&
+                        suivant == PCODE[pc].SUITE;
+            if (appel && suivant >= 0 && suivant <= PC && procedure[suivant] >= 0)
+            {
+                p = procedure[suivant];
+                if (procedureCompilee[p] || ++appels[p] < SEUIL_APPELS)
+                    p = -1;
+            }
+            else if (!appel && suivant <= pc && suivant == PCODE[pc].SUITE && procedure[pc] >= 0 &&
+                     (m == BRN || m == BZE || (m >= BEQ && m <= BGE)))
+            {
+                p = procedure[pc];
+                parBoucles = 1;
+                if (procedureCompilee[p] || ++boucles[p] < SEUIL_BOUCLES)
+                    p = -1;
+            }
+        }
+        if (p >= 0 && mprotect(zone, taille, PROT_READ | PROT_WRITE) == 0)
+        {
+            // Palier supérieur : le code machine remplace les sauts vers RETOUR
+            for (int i = 0; i <= PC; i++)
+            {
+                if (procedure[i] == p)
+                {
+                    traduireInstruction(&t, i);
+                    compile[i] = 1;
+                }
+            }
+            procedureCompilee[p] = 1;
+            paliers[nPaliers].entree = p;
+            paliers[nPaliers].parBoucles = parBoucles;
+            paliers[nPaliers].interpretees = interpretees;
+            nPaliers++;
+            if (mprotect(zone, taille, PROT_READ | PROT_EXEC) != 0)
+            {
+                // Le code ne peut plus être exécuté : fin en interprétation
+                JIT_LIBERER();
+                INTER_DEPUIS(suivant);
+                INTER_TERMINER();
+                return;
+            }
+        }
+        pc = suivant;
+    }
+    JIT_LIBERER();
+    INTER_DEPUIS(pc);
+    for (int k = 0; k < nPaliers; k++)
+    {
+        int e = paliers[k].entree;
+        if (paliers[k].parBoucles)
+            Informer("Tier-up: %s after %ld loop iterations (%ld instructions interpreted)\n",
+                   nomProcedure(e), boucles[e], paliers[k].interpretees);
+        else
+            Informer("Tier-up: %s after %ld calls (%ld instructions interpreted)\n",
+                   nomProcedure(e), appels[e], paliers[k].interpretees);
+    }
+    Informer("Tiers: %d/%d procedures compiled, %ld instructions interpreted, %ld entries into machine code\n",
+           nPaliers, nProcedures, interpretees, entrees);
+    INTER_TERMINER();
+}
+
+#else
+
+// Plateforme sans JIT : le P-code est interprété
+void JIT_PCODE(void)
+{
+    INTER_PCODE();
+}
+
+void JIT_PAR_PALIERS(void)
+{
+    INTER_PCODE();
+}
+
+void JIT_LIBERER(void)
+{
+}
+
+ETAT_PAR_FIL int SEUIL_APPELS = 100;
+ETAT_PAR_FIL int SEUIL_BOUCLES = 1000;
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef JIT_H
+#define JIT_H
+
+#include "global.h"  // Définitions globales (PCODE, PC, MEM, SP, BP, etc.)
+
+// ---------------------------------------------------------------------
+// JIT_PCODE : exécute le P-code traduit en code machine (option -jit)
+// ---------------------------------------------------------------------
+// Remplace INTER_PCODE sur Linux x86-64 : chaque instruction est traduite
+// en recopiant un gabarit de code machine précompilé dans une zone
+// exécutable (mmap), puis en y inscrivant ses opérandes (constantes,
+// adresses, cibles de saut). Les instructions sans gabarit, et les cas
+// rares d'une instruction qui en a un (réel, adresse invalide...), sont
+// exécutés par l'interpréteur. Ailleurs, ou si la zone exécutable ne peut
+// pas être obtenue, tout le programme est interprété.
+void JIT_PCODE(void);
+
+// ---------------------------------------------------------------------
+// JIT_PAR_PALIERS : exécution par paliers (option -tier)
+// ---------------------------------------------------------------------
+// Toutes les procédures commencent dans l'interpréteur. Une procédure
+// appelée SEUIL_APPELS fois, ou dont les boucles ont fait SEUIL_BOUCLES
+// tours, passe au palier supérieur : son code machine (mêmes gabarits que
+// JIT_PCODE) est écrit, puis les appels suivants et l'itération suivante
+// d'une boucle en cours s'exécutent en code machine. À la fin, un rapport
+// indique quelles procédures ont changé de palier et quand (instructions
+// interprétées jusque-là). Ailleurs que sur Linux x86-64, tout est interprété.
+void JIT_PAR_PALIERS(void);
+
+// Libère le code machine d'une exécution interrompue par une erreur
+// rattrapée (REPRISE_ERREUR) ; sans effet si aucune n'est en cours
+void JIT_LIBERER(void);
+
+// Seuils de l'exécution par paliers (options -tier-calls=<n>, -tier-loops=<n>)
+extern ETAT_PAR_FIL int SEUIL_APPELS;
+extern ETAT_PAR_FIL int SEUIL_BOUCLES;
+
+#endif
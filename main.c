@@ -1,60 +1,158 @@
-#include "global.h"            // Définitions globales (constantes, types, etc.)
-#include "analyse_lexical.h"   // Fonctions d'analyse lexicale (LireCar, SymSuiv, etc.)
-#include "syntaxique.h"        // Fonctions d'analyse syntaxique (Program, etc.)
-#include "semantique.h"        // Fonctions d'analyse sémantique (ConstDecl, VarDecl, etc.)
-#include "generation_pcode.h"  // Fonctions pour générer le P-code (Ecrire1, Ecrire2, etc.)
-#include "interpreteur.h"      // Interpréteur de P-code (INTER_PCODE)
-
-int main(int argc, char* argv[])
-{
-    // Vérifie que l'utilisateur a fourni au moins un argument (fichier source)
-    if(argc < 2){
-        printf("Usage: %s <source_file> [pcode_file]\n", argv[0]); // Message d'usage
-        return 1;
-    }
-
-    // Ouvre le fichier source en mode lecture
-    fsource = fopen(argv[1], "r");
-    if(!fsource){
-        perror("fopen source"); // Affiche l'erreur si le fichier source ne peut être ouvert
-        return 1;
-    }
-
-    // Initialise la lecture du flux source
-    LireCar();   // Lit le premier caractère du fichier source
-    SymSuiv();   // Analyse et charge le premier symbole/token
-
-    // Lance l'analyse syntaxique du programme source.
-    // La fonction Program() va analyser le code source et générer le P-code.
-    Program(); // => Remplit PCODE avec les instructions
-
-    // Initialise MEM_TYPE pour chaque variable globale à partir de la table des symboles.
-    // Pour chaque variable enregistrée, on définit son type dans le tableau MEM_TYPE.
-    for(int i = 0; i < NBR_IDFS; i++){
-        if(TAB_IDFS[i].TIDF == TVAR){
-            int adr = TAB_IDFS[i].Adresse;
-            if(adr >= 0 && adr < TAILLEMEM){
-                MEM_TYPE[adr] = TAB_IDFS[i].type;
-            }
-        }
-    }
-
-    // Affiche un message de succès de compilation et le nombre d'instructions générées.
-    printf("Compilation successful. PC=%d\n", PC);
-    afficherPCode(); // Affiche le P-code généré pour le débogage
-
-    // Si un deuxième argument est fourni, sauvegarde le P-code dans un fichier,
-    // puis recharge le P-code depuis ce fichier.
-    if(argc > 2){
-        sauvegarderPCode(argv[2]);  // Sauvegarde le P-code dans le fichier spécifié
-        fclose(fsource);            // Ferme le fichier source
-        chargerPCode(argv[2]);      // Recharge le P-code à partir du fichier
-    } else {
-        fclose(fsource);            // Ferme le fichier source s'il n'y a pas de sauvegarde
-    }
-
-    // Exécution du P-code à l'aide de l'interpréteur
-    INTER_PCODE();
-
-    return 0; // Fin du programme
-}
+#include "global.h"            // Définitions globales (constantes, types, etc.)
+#include "analyse_lexical.h"   // Fonctions d'analyse lexicale (LireCar, SymSuiv, etc.)
+#include "syntaxique.h"        // Fonctions d'analyse syntaxique (Program, etc.)
+#include "semantique.h"        // Fonctions d'analyse sémantique (ConstDecl, VarDecl, etc.)
+#include "generation_pcode.h"  // Fonctions pour générer le P-code (Ecrire1, Ecrire2, etc.)
+#include "interpreteur.h"      // Interpréteur de P-code (INTER_PCODE)
+#include "optimisation.h"      // Pipeline d'optimisation (Optimiser, NIVEAU_OPTIM)
+#include "jit.h"               // Exécution en code machine (JIT_PCODE, JIT_PAR_PALIERS)
+#include "generation_c.h"      // Traduction en C et compilation native (CompilerNatif)
+#include "generation_asm.h"    // Génération d'assembleur x86-64 (CompilerAssembleur)
+#include "trace.h"             // JIT de traces (TRACE_PCODE, SEUIL_TRACE)
+#include "compilation_lot.h"   // Compilation de plusieurs fichiers en parallèle (CompilerLot)
+
+int main(int argc, char* argv[])
+{
+    // Sépare les options (-O0, -O1, -O2, -inline=<n>, -unroll=<n>, -clone=<n>, -memo, -jit, -tier, -tier-calls=<n>, -tier-loops=<n>, -trace[=<n>], -native=<exe>, -asm=<exe>, -ri, -batch, -batch-out=<dir>, -jobs=<n>) des arguments positionnels
+    const char *fichierSource = NULL; // Fichier source à compiler
+    const char *fichierPcode = NULL;  // Fichier P-code optionnel
+    int jit = 0;                      // Exécution en code machine plutôt qu'interprétée
+    int trace = 0;                    // Exécution par le JIT de traces
+    int paliers = 0;                  // Exécution par paliers (interpréteur puis code machine)
+    const char *executable = NULL;    // Exécutable natif à produire (traduction en C)
+    const char *executableAsm = NULL; // Exécutable natif à produire (assembleur x86-64)
+    int lot = 0;                      // Compilation par lot : chaque argument est un source ou un répertoire
+    const char *repertoireLot = NULL; // Répertoire des P-codes du lot (sinon à côté des sources)
+    int nbFils = 0;                   // Fils de la compilation par lot (0 : un par cœur)
+    char **positionnels = malloc((size_t)argc * sizeof(char *));
+    int nPositionnels = 0;
+    for(int i = 1; i < argc; i++){
+        if(strncmp(argv[i], "-O", 2) == 0){
+            NIVEAU_OPTIM = atoi(argv[i] + 2); // Niveau d'optimisation
+        } else if(strncmp(argv[i], "-inline=", 8) == 0){
+            SEUIL_INLINE = atoi(argv[i] + 8); // Seuil du modèle de coût de l'intégration
+        } else if(strncmp(argv[i], "-unroll=", 8) == 0){
+            FACTEUR_DEROULAGE = atoi(argv[i] + 8); // Facteur de déroulage des boucles for
+        } else if(strncmp(argv[i], "-clone=", 7) == 0){
+            SEUIL_SPECIALISATION = atoi(argv[i] + 7); // Croissance maximale due à la spécialisation
+        } else if(strcmp(argv[i], "-memo") == 0){
+            MEMOISATION = 1;                  // Mémoïsation des fonctions pures récursives
+        } else if(strcmp(argv[i], "-jit") == 0){
+            jit = 1;                          // Exécution par le JIT (x86-64 Linux)
+        } else if(strcmp(argv[i], "-tier") == 0){
+            paliers = 1;                      // Procédures interprétées puis compilées si chaudes
+        } else if(strncmp(argv[i], "-tier-calls=", 12) == 0){
+            paliers = 1;
+            SEUIL_APPELS = atoi(argv[i] + 12);  // Appels avant le passage au code machine
+        } else if(strncmp(argv[i], "-tier-loops=", 12) == 0){
+            paliers = 1;
+            SEUIL_BOUCLES = atoi(argv[i] + 12); // Tours de boucle avant le passage au code machine
+        } else if(strncmp(argv[i], "-trace=", 7) == 0){
+            trace = 1;                        // JIT de traces, seuil des boucles chaudes
+            SEUIL_TRACE = atoi(argv[i] + 7);
+        } else if(strcmp(argv[i], "-trace") == 0){
+            trace = 1;                        // JIT de traces (x86-64 Linux)
+        } else if(strncmp(argv[i], "-native=", 8) == 0){
+            executable = argv[i] + 8;         // Traduction en C puis compilation, sans exécution
+        } else if(strncmp(argv[i], "-asm=", 5) == 0){
+            executableAsm = argv[i] + 5;      // Traduction en assembleur puis assemblage, sans exécution
+        } else if(strcmp(argv[i], "-ri") == 0){
+            AFFICHER_RI = 1;                  // Affichage de la représentation intermédiaire
+        } else if(strcmp(argv[i], "-batch") == 0){
+            lot = 1;                          // Compilation par lot, sans exécution
+        } else if(strncmp(argv[i], "-batch-out=", 11) == 0){
+            lot = 1;
+            repertoireLot = argv[i] + 11;     // Répertoire des P-codes du lot
+        } else if(strncmp(argv[i], "-jobs=", 6) == 0){
+            nbFils = atoi(argv[i] + 6);       // Nombre de fils de la compilation (par lot, ou des corps de procédures)
+        } else {
+            positionnels[nPositionnels++] = argv[i];
+            if(!fichierSource){
+                fichierSource = argv[i];
+            } else if(!fichierPcode){
+                fichierPcode = argv[i];
+            }
+        }
+    }
+
+    // Vérifie que l'utilisateur a fourni au moins un argument (fichier source)
+    if(!fichierSource){
+        printf("Usage: %s [-O0|-O1|-O2] [-inline=<n>] [-unroll=<n>] [-clone=<n>] [-memo] [-jit] [-tier] [-tier-calls=<n>] [-tier-loops=<n>] [-trace[=<n>]] [-native=<exe>] [-asm=<exe>] [-ri] [-jobs=<n>] <source_file> [pcode_file]\n"
+               "       %s -batch [-batch-out=<dir>] [-jobs=<n>] [-O0|-O1|-O2] [-inline=<n>] [-unroll=<n>] [-clone=<n>] [-memo] <source_file|dir>...\n",
+               argv[0], argv[0]); // Message d'usage
+        return 1;
+    }
+
+    // Mode -batch : chaque fichier est compilé par un fil du groupe, avec les options de la ligne de commande
+    if(lot){
+        OptionsCompilation options = {NIVEAU_OPTIM, SEUIL_INLINE, FACTEUR_DEROULAGE, SEUIL_SPECIALISATION, MEMOISATION, 0};
+        int echecs = CompilerLot(positionnels, nPositionnels, repertoireLot, nbFils, &options);
+        free(positionnels);
+        return echecs ? 1 : 0;
+    }
+    free(positionnels);
+    FILS_CORPS = nbFils;                  // Les corps des procédures sont compilés par nbFils fils
+
+    // Ouvre le fichier source en mode lecture
+    fsource = fopen(fichierSource, "r");
+    if(!fsource){
+        perror("fopen source"); // Affiche l'erreur si le fichier source ne peut être ouvert
+        return 1;
+    }
+
+    // Initialise la lecture du flux source (premier caractère, premier token)
+    DebutAnalyse(fsource);
+
+    // Lance l'analyse syntaxique du programme source.
+    // La fonction Program() va analyser le code source et générer le P-code.
+    Program(); // => Remplit PCODE avec les instructions
+
+    // Optimise le P-code selon le niveau choisi (rien à -O0)
+    Optimiser();
+
+    // Initialise MEM_TYPE pour chaque variable globale à partir de la table des symboles.
+    // Pour chaque variable enregistrée, on définit son type dans le tableau MEM_TYPE.
+    for(int i = 0; i < NBR_IDFS; i++){
+        if(TAB_IDFS[i].TIDF == TVAR){
+            int adr = TAB_IDFS[i].Adresse;
+            if(adr >= 0 && adr < TAILLEMEM){
+                MEM_TYPE[adr] = TAB_IDFS[i].type;
+            }
+        }
+    }
+
+    // Affiche un message de succès de compilation et le nombre d'instructions générées.
+    printf("Compilation successful. PC=%d\n", PC);
+    afficherPCode(); // Affiche le P-code généré pour le débogage
+
+    // Si un deuxième argument est fourni, sauvegarde le P-code dans un fichier,
+    // puis recharge le P-code depuis ce fichier.
+    if(fichierPcode){
+        sauvegarderPCode(fichierPcode);  // Sauvegarde le P-code dans le fichier spécifié
+        fclose(fsource);                 // Ferme le fichier source
+        chargerPCode(fichierPcode);      // Recharge le P-code à partir du fichier
+    } else {
+        fclose(fsource);            // Ferme le fichier source s'il n'y a pas de sauvegarde
+    }
+
+    // Pile requise par chaque procédure, vérifiée par l'interpréteur à chaque appel
+    CalculerPileRequise();
+
+    // Mode -native : le P-code devient un exécutable au lieu d'être exécuté
+    if(executable)
+        return CompilerNatif(executable) ? 0 : 1;
+    if(executableAsm)
+        return CompilerAssembleur(executableAsm) ? 0 : 1;
+
+    // Exécution du P-code à l'aide de l'interpréteur (ou d'un JIT)
+    if(trace)
+        TRACE_PCODE();
+    else if(paliers)
+        JIT_PAR_PALIERS();
+    else if(jit)
+        JIT_PCODE();
+    else
+        INTER_PCODE();
+
+    return 0; // Fin du programme
+}
@@ -0,0 +1,3403 @@
+#include "optimisation.h"
+#include "representation_intermediaire.h"
+#include "semantique.h"
+
+#include <limits.h>  // INT_MAX
+
+// Niveau d'optimisation (-O0, -O1, -O2)
+ETAT_PAR_FIL int NIVEAU_OPTIM = 0;
+// Affichage de la RI après optimisation (-ri)
+ETAT_PAR_FIL int AFFICHER_RI = 0;
+
+// Une passe reçoit la RI et retourne le nombre de modifications effectuées
+typedef struct {
+    const char *nom;
+    int (*executer)(RI *ri);
+} Passe;
+
+// ---------------------------------------------------------------------
+// Repli des constantes : calcule à la compilation les opérations
+// arithmétiques dont les deux opérandes sont des constantes, et simplifie
+// les éléments neutres (x + 0, x - 0, x * 1, x / 1)
+// ---------------------------------------------------------------------
+
+// Indique si la valeur est une constante (LDI ou LDF)
+static int estConstante(const RI *ri, int v)
+{
+    return ri->valeurs[v].op == LDI || ri->valeurs[v].op == LDF;
+}
+
+// Retourne la valeur réelle d'une constante (LDI converti en float)
+static float constanteReelle(const RI *ri, int v)
+{
+    float f;
+    if (ri->valeurs[v].op == LDI)
+        return (float)ri->valeurs[v].arg;
+    memcpy(&f, &ri->valeurs[v].arg, sizeof(float));
+    return f;
+}
+
+// Évalue une relation (EQL..LEQ) entre deux constantes, comme l'interpréteur :
+// en float si l'une des deux est réelle
+static int comparerConstantes(const RI *ri, Mnemoniques rel, int a, int b)
+{
+    if (ri->valeurs[a].op == LDF || ri->valeurs[b].op == LDF)
+    {
+        float f1 = constanteReelle(ri, a), f2 = constanteReelle(ri, b);
+        switch (rel)
+        {
+        case EQL: return f1 == f2;
+        case NEQ: return f1 != f2;
+        case GTR: return f1 >  f2;
+        case LSS: return f1 <  f2;
+        case GEQ: return f1 >= f2;
+        default:  return f1 <= f2;
+        }
+    }
+    int i1 = ri->valeurs[a].arg, i2 = ri->valeurs[b].arg;
+    switch (rel)
+    {
+    case EQL: return i1 == i2;
+    case NEQ: return i1 != i2;
+    case GTR: return i1 >  i2;
+    case LSS: return i1 <  i2;
+    case GEQ: return i1 >= i2;
+    default:  return i1 <= i2;
+    }
+}
+
+static int repliConstantes(RI *ri)
+{
+    int modifs = 0;
+    for (int v = 0; v < ri->nValeurs; v++)
+    {
+        Mnemoniques op = ri->valeurs[v].op;
+        if (op >= EQL && op <= LEQ)
+        {
+            int a = RI_Op(ri, v, 0);
+            int b = RI_Op(ri, v, 1);
+            if (estConstante(ri, a) && estConstante(ri, b))
+            {
+                RI_DevenirConstante(ri, v, LDI, comparerConstantes(ri, op, a, b));
+                modifs++;
+            }
+            continue;
+        }
+        if (op != ADD && op != SUB && op != MUL && op != DIVI)
+            continue;
+        int a = RI_Op(ri, v, 0);
+        int b = RI_Op(ri, v, 1);
+
+        if (estConstante(ri, a) && estConstante(ri, b))
+        {
+            if (ri->valeurs[a].op == LDI && ri->valeurs[b].op == LDI)
+            {
+                // Même calcul que l'interpréteur en entier (la division par zéro reste à l'exécution)
+                int i1 = ri->valeurs[a].arg, i2 = ri->valeurs[b].arg, r;
+                if (op == DIVI && i2 == 0)
+                    continue;
+                switch (op)
+                {
+                case ADD: r = i1 + i2; break;
+                case SUB: r = i1 - i2; break;
+                case MUL: r = i1 * i2; break;
+                default:  r = i1 / i2; break;
+                }
+                RI_DevenirConstante(ri, v, LDI, r);
+            }
+            else
+            {
+                // Calcul en float, comme l'interpréteur dès qu'un opérande est réel
+                float f1 = constanteReelle(ri, a), f2 = constanteReelle(ri, b), r;
+                if (op == DIVI && f2 == 0.0f)
+                    continue;
+                switch (op)
+                {
+                case ADD: r = f1 + f2; break;
+                case SUB: r = f1 - f2; break;
+                case MUL: r = f1 * f2; break;
+                default:  r = f1 / f2; break;
+                }
+                int bits;
+                memcpy(&bits, &r, sizeof(float));
+                RI_DevenirConstante(ri, v, LDF, bits);
+            }
+            modifs++;
+            continue;
+        }
+
+        // Éléments neutres entiers : le type de l'autre opérande est conservé
+        int zeroB = (ri->valeurs[b].op == LDI && ri->valeurs[b].arg == 0);
+        int unB   = (ri->valeurs[b].op == LDI && ri->valeurs[b].arg == 1);
+        int zeroA = (ri->valeurs[a].op == LDI && ri->valeurs[a].arg == 0);
+        int unA   = (ri->valeurs[a].op == LDI && ri->valeurs[a].arg == 1);
+        if (((op == ADD || op == SUB) && zeroB) || ((op == MUL || op == DIVI) && unB))
+        {
+            RI_DevenirCopie(ri, v, a);
+            modifs++;
+        }
+        else if ((op == ADD && zeroA) || (op == MUL && unA))
+        {
+            RI_DevenirCopie(ri, v, b);
+            modifs++;
+        }
+    }
+    return modifs;
+}
+
+// ---------------------------------------------------------------------
+// Conditions constantes : un branchement conditionnel dont les opérandes
+// sont des constantes devient un saut (ou disparaît), et la branche qui
+// n'est plus jamais prise devient inaccessible
+// ---------------------------------------------------------------------
+
+// Relation testée par un branchement BEQ..BGE
+static Mnemoniques relationDe(Mnemoniques br)
+{
+    switch (br)
+    {
+    case BEQ: return EQL;
+    case BNE: return NEQ;
+    case BLT: return LSS;
+    case BLE: return LEQ;
+    case BGT: return GTR;
+    default:  return GEQ;
+    }
+}
+
+static int simplifierConditions(RI *ri)
+{
+    int modifs = 0;
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        RI_Bloc *bl = &ri->blocs[b];
+        int t = RI_Terminateur(ri, b);
+        if (bl->proc < 0 || t < 0 || !RI_EstConditionnel(ri->valeurs[t].op))
+            continue;
+        int pris;
+        if (ri->valeurs[t].op == BZE)
+        {
+            int c = RI_Op(ri, t, 0);
+            if (!estConstante(ri, c))
+                continue;
+            pris = (ri->valeurs[c].arg == 0);
+        }
+        else
+        {
+            int a = RI_Op(ri, t, 0), c = RI_Op(ri, t, 1);
+            if (!estConstante(ri, a) || !estConstante(ri, c))
+                continue;
+            pris = comparerConstantes(ri, relationDe(ri->valeurs[t].op), a, c);
+        }
+        if (pris)
+        {
+            ri->valeurs[t].op = BRN;
+            ri->valeurs[t].nOps = 0;
+        }
+        else
+        {
+            RI_RetirerInstr(ri, b, bl->nInstrs - 1);
+            bl->succ[0] = bl->succ[1];
+        }
+        bl->nSucc = 1;
+        modifs++;
+    }
+    return modifs;
+}
+
+// Retire les blocs qu'aucun chemin ne relie plus à l'entrée de leur procédure
+static int supprimerInaccessibles(RI *ri)
+{
+    char *accessible = calloc((size_t)ri->nBlocs, 1);
+    int *aVoir = malloc((size_t)ri->nBlocs * sizeof(int));
+    int nAVoir = 0;
+    for (int p = 0; p < ri->nProcs; p++)
+    {
+        int e = ri->procs[p].entree;
+        if (e >= 0 && !accessible[e])
+        {
+            accessible[e] = 1;
+            aVoir[nAVoir++] = e;
+        }
+    }
+    while (nAVoir > 0)
+    {
+        int b = aVoir[--nAVoir];
+        for (int k = 0; k < ri->blocs[b].nSucc; k++)
+        {
+            int s = ri->blocs[b].succ[k];
+            if (!accessible[s])
+            {
+                accessible[s] = 1;
+                aVoir[nAVoir++] = s;
+            }
+        }
+    }
+    int modifs = 0;
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        if (accessible[b] || ri->blocs[b].proc < 0)
+            continue;
+        ri->blocs[b].proc = -1;
+        ri->blocs[b].nInstrs = 0;
+        ri->blocs[b].nSucc = 0;
+        modifs++;
+    }
+    free(accessible);
+    free(aVoir);
+    if (modifs > 0)
+        RI_CalculerPreds(ri);
+    return modifs;
+}
+
+// ---------------------------------------------------------------------
+// Simplification des sauts : un saut vers un bloc qui ne fait que sauter
+// ailleurs (ou qui est vide) est redirigé directement vers la destination
+// ---------------------------------------------------------------------
+
+// Indique si le bloc ne contient qu'un saut inconditionnel (ou rien) et retourne sa suite
+static int simpleRelais(const RI *ri, int b)
+{
+    const RI_Bloc *bl = &ri->blocs[b];
+    if (bl->nSucc != 1)
+        return -1;
+    if (bl->nInstrs == 0)
+        return bl->succ[0];
+    if (bl->nInstrs == 1 && ri->valeurs[bl->instrs[0]].op == BRN)
+        return bl->succ[0];
+    return -1;
+}
+
+static int simplifierSauts(RI *ri)
+{
+    int modifs = 0;
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        RI_Bloc *bl = &ri->blocs[b];
+        if (bl->proc < 0)
+            continue;
+        for (int k = 0; k < bl->nSucc; k++)
+        {
+            int cible = bl->succ[k];
+            int suite;
+            int pas = 0;
+            // Le compteur de pas évite de tourner indéfiniment sur une boucle vide
+            while ((suite = simpleRelais(ri, cible)) >= 0 && suite != cible && pas < ri->nBlocs)
+            {
+                cible = suite;
+                pas++;
+            }
+            if (cible == bl->succ[k])
+                continue;
+            bl->succ[k] = cible;
+            int t = RI_Terminateur(ri, b);
+            if (k == 0 && t >= 0 && RI_EstBranchement(ri->valeurs[t].op))
+                ri->valeurs[t].arg = cible;
+            modifs++;
+        }
+    }
+    return modifs;
+}
+
+// Indique si un arbre contient un appel de procédure ou de fonction
+static int contientAppel(const RI *ri, int v)
+{
+    if (ri->valeurs[v].op == CALL)
+        return 1;
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+    {
+        if (contientAppel(ri, RI_Op(ri, v, k)))
+            return 1;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------
+// Numérotation globale des valeurs (GVN) et élimination des sous-expressions
+// communes. L'arbre des dominateurs de chaque procédure est parcouru : deux
+// valeurs reçoivent le même numéro si elles appliquent la même opération à
+// des opérandes de même numéro, ou si elles lisent la même version SSA d'une
+// variable. Une lecture d'une version écrite par STO, STL ou STO_KEEP prend
+// le numéro de la valeur écrite (propagation des copies et des constantes).
+// Un calcul déjà disponible est remplacé par la lecture d'une variable qui le
+// contient encore, ou d'un temporaire rempli par STO_KEEP au premier calcul.
+// Les écritures, INN et appels créent de nouvelles versions : les lectures
+// qui suivent ne sont donc plus confondues avec les précédentes.
+// ---------------------------------------------------------------------
+
+#define VN_VERSION (-1)   // Pseudo-opération des clés "lecture d'une version"
+
+typedef struct {
+    int op, arg, a, b;
+} CleVN;
+
+// Représentant disponible d'un numéro de valeur
+typedef struct {
+    int noeud;     // Valeur déjà calculée portant ce numéro (-1 sinon)
+    int bloc;      // Bloc de ce calcul
+    int appels;    // Appels rencontrés avant ce calcul
+    int var;       // Variable contenant ce numéro (-1 sinon)
+    int version;   // Version de la variable qui le contient
+} Chef;
+
+// Entrée du journal qui permet de restaurer les représentants en quittant un bloc
+typedef struct {
+    int  vn;
+    Chef ancien;
+} AnnulChef;
+
+typedef struct {
+    RI        *ri;
+    int        cap;          // Nombre maximal de valeurs pendant la passe
+    int       *vn;           // Numéro de chaque valeur (-1 si pas encore numérotée)
+    int       *temp;         // Temporaire rempli par chaque valeur (-1 sinon)
+    int       *constante;    // Constante (LDI, LDF, LDA) portant chaque numéro (-1 sinon)
+    int        nVN;
+    CleVN     *cles;         // Table de hachage des clés
+    int       *numCle;
+    int        capTable;
+    Chef      *chefs;        // Représentant de chaque numéro
+    AnnulChef *journal;
+    int        nJournal;
+    int       *courante;     // Version courante de chaque variable (-2 si écrasée)
+    int      **enfants;      // Arbre des dominateurs
+    int       *nEnfants;
+    int        appels;       // Appels rencontrés depuis l'entrée du bloc courant
+    int        etatMem;      // État de la mémoire pour les lectures indirectes (change à chaque écriture)
+    int        nEtatsMem;
+    int        recursif;     // La procédure appelle : ses temporaires peuvent être écrasés
+    int        modifs;
+} GVN;
+
+static int nouveauNumero(GVN *g)
+{
+    Chef *ch = &g->chefs[g->nVN];
+    ch->noeud = -1;
+    ch->var = -1;
+    g->constante[g->nVN] = -1;
+    return g->nVN++;
+}
+
+// Retourne le numéro associé à une clé (créé au besoin)
+static int numeroCle(GVN *g, CleVN c)
+{
+    unsigned h = (unsigned)c.op * 31u + (unsigned)c.arg * 131u + (unsigned)c.a * 8191u + (unsigned)c.b * 131071u;
+    unsigned i = h & (unsigned)(g->capTable - 1);
+    while (g->numCle[i] >= 0)
+    {
+        CleVN *k = &g->cles[i];
+        if (k->op == c.op && k->arg == c.arg && k->a == c.a && k->b == c.b)
+            return g->numCle[i];
+        i = (i + 1) & (unsigned)(g->capTable - 1);
+    }
+    g->cles[i] = c;
+    g->numCle[i] = nouveauNumero(g);
+    return g->numCle[i];
+}
+
+// Numéro d'une lecture de la version ver : celui de la valeur écrite si elle est connue
+static int numeroVersion(GVN *g, int ver)
+{
+    RI *ri = g->ri;
+    int def = ri->versions[ver].valeur;
+    if (def >= 0)
+    {
+        Mnemoniques op = ri->valeurs[def].op;
+        if ((op == STO || op == STL || op == STO_KEEP) && g->vn[RI_Op(ri, def, 0)] >= 0)
+            return g->vn[RI_Op(ri, def, 0)];
+    }
+    CleVN c = {VN_VERSION, ver, -1, -1};
+    return numeroCle(g, c);
+}
+
+// Numérote un arbre (opérandes d'abord)
+static void numeroter(GVN *g, int v)
+{
+    RI *ri = g->ri;
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+        numeroter(g, RI_Op(ri, v, k));
+    if (g->vn[v] >= 0)
+        return;
+
+    RI_Valeur *val = &ri->valeurs[v];
+    CleVN c = {val->op, val->arg, -1, -1};
+    switch (val->op)
+    {
+    case LDI: case LDF: case LDA:
+        g->vn[v] = numeroCle(g, c);
+        g->constante[g->vn[v]] = v;
+        break;
+    case LDV:
+        if (val->var >= 0 && val->version >= 0)
+        {
+            g->vn[v] = numeroVersion(g, val->version);
+        }
+        else
+        {
+            // Lecture indirecte (paramètre par adresse) : même adresse et même état de la mémoire
+            c.arg = g->etatMem;
+            c.a = g->vn[RI_Op(ri, v, 0)];
+            g->vn[v] = numeroCle(g, c);
+        }
+        break;
+    case LDL:
+        g->vn[v] = (val->var >= 0 && val->version >= 0) ? numeroVersion(g, val->version) : nouveauNumero(g);
+        break;
+    case STO_KEEP:
+        g->vn[v] = g->vn[RI_Op(ri, v, 0)];
+        break;
+    case ADD: case SUB: case MUL: case DIVI:
+    case EQL: case NEQ: case GTR: case LSS: case GEQ: case LEQ:
+        c.arg = 0;
+        c.a = g->vn[RI_Op(ri, v, 0)];
+        c.b = g->vn[RI_Op(ri, v, 1)];
+        // Opérations commutatives : l'ordre des opérandes n'importe pas
+        if ((val->op == ADD || val->op == MUL || val->op == EQL || val->op == NEQ) && c.a > c.b)
+        {
+            int t = c.a;
+            c.a = c.b;
+            c.b = t;
+        }
+        g->vn[v] = numeroCle(g, c);
+        break;
+    default:
+        g->vn[v] = nouveauNumero(g);
+        break;
+    }
+    // Toute écriture en mémoire globale change l'état vu par les lectures indirectes
+    if ((val->op == STO && val->arg >= 0) || val->op == INN || val->op == CALL || val->op == STO_IND)
+        g->etatMem = ++g->nEtatsMem;
+}
+
+// Nombre d'instructions P-code d'un arbre
+static int taille(const RI *ri, int v)
+{
+    int n = 1;
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+        n += taille(ri, RI_Op(ri, v, k));
+    return n;
+}
+
+// Calculs que l'on peut remplacer par une lecture
+static int estCalcul(Mnemoniques op)
+{
+    return (op >= ADD && op <= LEQ);
+}
+
+// Change de représentant pour le numéro n, en le notant dans le journal
+static void changerChef(GVN *g, int n, Chef nouv)
+{
+    g->journal[g->nJournal].vn = n;
+    g->journal[g->nJournal].ancien = g->chefs[n];
+    g->nJournal++;
+    g->chefs[n] = nouv;
+}
+
+// Le calcul représentant est-il encore utilisable au point courant ?
+static int noeudDisponible(const GVN *g, const Chef *ch, int b)
+{
+    if (ch->noeud < 0)
+        return 0;
+    // Un appel peut rentrer dans la procédure et réécrire ses temporaires
+    return !g->recursif || (ch->bloc == b && ch->appels == g->appels);
+}
+
+// Remplace la valeur v par la lecture de la variable var (globale, temporaire ou case du cadre)
+static void devenirLecture(GVN *g, int v, int var)
+{
+    RI *ri = g->ri;
+    int k;
+    if (var >= TAILLEMEM)
+    {
+        k = RI_NouvelleValeur(ri, LDL, RI_CASE_DE(var), NULL, 0);
+    }
+    else
+    {
+        int a = RI_NouvelleValeur(ri, LDA, var, NULL, 0);
+        g->vn[a] = nouveauNumero(g);
+        g->temp[a] = -1;
+        k = RI_NouvelleValeur(ri, LDV, 0, &a, 1);
+    }
+    RI_DevenirCopie(ri, v, k);
+    g->modifs++;
+}
+
+// Range le résultat du calcul v dans un nouveau temporaire (v devient STO_KEEP)
+static int materialiser(GVN *g, int v)
+{
+    RI *ri = g->ri;
+    if (OFFSET >= TAILLEMEM)
+        return -1;
+    int t = OFFSET++;
+    int ops[2];
+    int nOps = ri->valeurs[v].nOps;
+    for (int k = 0; k < nOps; k++)
+        ops[k] = RI_Op(ri, v, k);
+    int w = RI_NouvelleValeur(ri, ri->valeurs[v].op, ri->valeurs[v].arg, ops, nOps);
+    g->vn[w] = g->vn[v];
+    g->temp[w] = -1;
+    int k = RI_NouvelleValeur(ri, STO_KEEP, t, &w, 1);
+    RI_DevenirCopie(ri, v, k);
+    g->temp[v] = t;
+    return t;
+}
+
+// Parcourt un arbre en ordre d'évaluation et remplace les calculs disponibles
+static void remplacerCommuns(GVN *g, int v, int b)
+{
+    RI *ri = g->ri;
+    int n = g->vn[v];
+    Mnemoniques op = ri->valeurs[v].op;
+
+    // Lecture ou calcul dont la valeur est une constante connue
+    if ((estCalcul(op) || op == LDV || op == LDL) && g->constante[n] >= 0)
+    {
+        int c = g->constante[n];
+        RI_DevenirConstante(ri, v, ri->valeurs[c].op, ri->valeurs[c].arg);
+        g->modifs++;
+        return;
+    }
+    if (estCalcul(op))
+    {
+        int c = taille(ri, v);
+        Chef *ch = &g->chefs[n];
+        if (ch->var >= 0 && g->courante[ch->var] == ch->version &&
+            c > ((ch->var >= TAILLEMEM) ? 1 : 2))
+        {
+            devenirLecture(g, v, ch->var);
+            return;
+        }
+        // Le premier réemploi coûte un STO_KEEP : il faut que le calcul soit assez gros
+        if (noeudDisponible(g, ch, b) && c - 2 > ((g->temp[ch->noeud] >= 0) ? 0 : 1))
+        {
+            int t = g->temp[ch->noeud];
+            if (t < 0)
+                t = materialiser(g, ch->noeud);
+            if (t >= 0)
+            {
+                devenirLecture(g, v, t);
+                return;
+            }
+        }
+    }
+
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+        remplacerCommuns(g, RI_Op(ri, v, k), b);
+
+    RI_Valeur *val = &ri->valeurs[v];
+    if (val->var >= 0 && val->version >= 0 &&
+        (val->op == STO || val->op == STL || val->op == STO_KEEP || val->op == INN))
+    {
+        g->courante[val->var] = val->version;
+        // La variable contient désormais la valeur écrite
+        if (val->op != INN)
+        {
+            Chef nouv = g->chefs[g->vn[RI_Op(ri, v, 0)]];
+            nouv.var = val->var;
+            nouv.version = val->version;
+            changerChef(g, g->vn[RI_Op(ri, v, 0)], nouv);
+        }
+    }
+    if (val->op == CALL || val->op == STO_IND || (val->op == INN && val->var < 0))
+    {
+        for (int i = 0; i < RI_NB_VARS; i++)
+        {
+            if (RI_PeutEcrire(ri, v, i))
+                g->courante[i] = -2;
+        }
+        if (val->op == CALL)
+            g->appels++;
+    }
+    if (estCalcul(val->op) && !noeudDisponible(g, &g->chefs[n], b))
+    {
+        Chef nouv = g->chefs[n];
+        nouv.noeud = v;
+        nouv.bloc = b;
+        nouv.appels = g->appels;
+        changerChef(g, n, nouv);
+    }
+}
+
+// Traite un bloc puis ses enfants dans l'arbre des dominateurs
+static void gvnBloc(GVN *g, int b)
+{
+    RI *ri = g->ri;
+    int nJournal = g->nJournal;
+    int *sauvegarde = malloc(RI_NB_VARS * sizeof(int));
+    memcpy(sauvegarde, g->courante, RI_NB_VARS * sizeof(int));
+
+    for (int f = 0; f < ri->nPhis; f++)
+    {
+        if (ri->phis[f].bloc == b)
+            g->courante[ri->phis[f].var] = ri->phis[f].version;
+    }
+    g->appels = 0;
+    g->etatMem = ++g->nEtatsMem;
+    for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+    {
+        int v = ri->blocs[b].instrs[k];
+        numeroter(g, v);
+        remplacerCommuns(g, v, b);
+    }
+    for (int k = 0; k < g->nEnfants[b]; k++)
+        gvnBloc(g, g->enfants[b][k]);
+
+    // Restaure les représentants et les versions du dominateur
+    while (g->nJournal > nJournal)
+    {
+        g->nJournal--;
+        g->chefs[g->journal[g->nJournal].vn] = g->journal[g->nJournal].ancien;
+    }
+    memcpy(g->courante, sauvegarde, RI_NB_VARS * sizeof(int));
+    free(sauvegarde);
+}
+
+static int eliminerSousExpressions(RI *ri)
+{
+    if (!ri->ssaValide)
+        RI_ConstruireSSA(ri);
+
+    GVN g;
+    memset(&g, 0, sizeof(g));
+    g.ri = ri;
+    // Chaque valeur est remplacée ou rangée au plus une fois (deux nouvelles valeurs chaque fois)
+    g.cap = 5 * ri->nValeurs + 16;
+    g.vn = malloc((size_t)g.cap * sizeof(int));
+    g.temp = malloc((size_t)g.cap * sizeof(int));
+    g.constante = malloc((size_t)g.cap * sizeof(int));
+    for (int v = 0; v < g.cap; v++)
+    {
+        g.vn[v] = -1;
+        g.temp[v] = -1;
+    }
+    g.capTable = 16;
+    while (g.capTable < 2 * g.cap)
+        g.capTable *= 2;
+    g.cles = malloc((size_t)g.capTable * sizeof(CleVN));
+    g.numCle = malloc((size_t)g.capTable * sizeof(int));
+    for (int i = 0; i < g.capTable; i++)
+        g.numCle[i] = -1;
+    g.chefs = malloc((size_t)g.cap * sizeof(Chef));
+    g.journal = malloc((size_t)2 * g.cap * sizeof(AnnulChef));
+    g.courante = malloc(RI_NB_VARS * sizeof(int));
+    g.enfants = calloc((size_t)ri->nBlocs, sizeof(int *));
+    g.nEnfants = calloc((size_t)ri->nBlocs, sizeof(int));
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        int d = ri->blocs[b].idom;
+        if (ri->blocs[b].rpo < 0 || d < 0)
+            continue;
+        g.enfants[d] = realloc(g.enfants[d], (size_t)(g.nEnfants[d] + 1) * sizeof(int));
+        g.enfants[d][g.nEnfants[d]++] = b;
+    }
+
+    for (int p = 0; p < ri->nProcs; p++)
+    {
+        int entree = ri->procs[p].entree;
+        if (entree < 0 || ri->blocs[entree].rpo < 0 || ri->blocs[entree].proc != p)
+            continue;
+        // Le programme principal n'est jamais rappelé ; une procédure qui appelle peut l'être
+        g.recursif = 0;
+        for (int b = 0; p > 0 && b < ri->nBlocs; b++)
+        {
+            if (ri->blocs[b].proc != p)
+                continue;
+            for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+                g.recursif |= contientAppel(ri, ri->blocs[b].instrs[k]);
+        }
+        for (int i = 0; i < RI_NB_VARS; i++)
+            g.courante[i] = -1;
+        gvnBloc(&g, entree);
+    }
+
+    for (int b = 0; b < ri->nBlocs; b++)
+        free(g.enfants[b]);
+    free(g.enfants);
+    free(g.nEnfants);
+    free(g.vn);
+    free(g.temp);
+    free(g.constante);
+    free(g.cles);
+    free(g.numCle);
+    free(g.chefs);
+    free(g.journal);
+    free(g.courante);
+    return g.modifs;
+}
+
+// ---------------------------------------------------------------------
+// Sortie des calculs invariants de boucle. Un calcul pur dont les opérandes
+// ne changent pas dans la boucle est fait une seule fois dans le pré-en-tête
+// et rangé dans un temporaire. Une lecture est invariante si sa version SSA
+// est définie hors de la boucle : les écritures de la boucle, y compris
+// celles des procédures appelées (RI_CalculerEffets), y créent des versions.
+// ---------------------------------------------------------------------
+
+typedef struct {
+    RI        *ri;
+    RI_Boucle *boucles;
+    int        nBoucles;
+    int        i;          // Boucle traitée
+    int        pre;        // Pré-en-tête (-1 tant qu'il n'a pas été créé)
+    int        ecritMem;   // La boucle écrit en mémoire : les lectures indirectes changent
+    int        modifs;
+} SortieBoucle;
+
+// Indique si le diviseur est une constante non nulle (la division ne peut pas échouer)
+static int diviseurSur(const RI *ri, int d)
+{
+    if (ri->valeurs[d].op == LDI)
+        return ri->valeurs[d].arg != 0;
+    return ri->valeurs[d].op == LDF && constanteReelle(ri, d) != 0.0f;
+}
+
+// Indique si la valeur garde la même valeur à chaque tour de la boucle
+static int estInvariant(const SortieBoucle *s, int v)
+{
+    const RI *ri = s->ri;
+    const RI_Valeur *val = &ri->valeurs[v];
+    switch (val->op)
+    {
+    case LDI: case LDF: case LDA:
+        return 1;
+    case LDV: case LDL:
+        if (val->var >= 0)
+        {
+            if (val->version < 0)
+                return 0;
+            const RI_Version *ver = &ri->versions[val->version];
+            // Version d'entrée de la procédure, ou définie hors de la boucle
+            return (ver->valeur < 0 && ver->phi < 0) || !RI_DansBoucle(&s->boucles[s->i], ver->bloc);
+        }
+        return val->op == LDV && !s->ecritMem && estInvariant(s, RI_Op(ri, v, 0));
+    case DIVI:
+        if (!diviseurSur(ri, RI_Op(ri, v, 1)))
+            return 0;
+        return estInvariant(s, RI_Op(ri, v, 0));
+    case ADD: case SUB: case MUL:
+    case EQL: case NEQ: case GTR: case LSS: case GEQ: case LEQ:
+        return estInvariant(s, RI_Op(ri, v, 0)) && estInvariant(s, RI_Op(ri, v, 1));
+    default:
+        return 0;
+    }
+}
+
+// Calcule v dans le pré-en-tête et le remplace par la lecture d'un temporaire
+static void sortirCalcul(SortieBoucle *s, int v)
+{
+    RI *ri = s->ri;
+    if (OFFSET >= TAILLEMEM)
+        return;
+    if (s->pre < 0)
+        s->pre = RI_PreEntete(ri, s->boucles, s->nBoucles, s->i);
+    int t = OFFSET++;
+    int ops[2];
+    int nOps = ri->valeurs[v].nOps;
+    for (int k = 0; k < nOps; k++)
+        ops[k] = RI_Op(ri, v, k);
+    int w = RI_NouvelleValeur(ri, ri->valeurs[v].op, ri->valeurs[v].arg, ops, nOps);
+    int st = RI_NouvelleValeur(ri, STO, t, &w, 1);
+    RI_InsererInstr(ri, s->pre, ri->blocs[s->pre].nInstrs, st);
+
+    int a = RI_NouvelleValeur(ri, LDA, t, NULL, 0);
+    int k = RI_NouvelleValeur(ri, LDV, 0, &a, 1);
+    RI_DevenirCopie(ri, v, k);
+    s->modifs++;
+}
+
+// Parcourt les opérandes d'un arbre et sort les plus grands calculs invariants
+static void sortirInvariants(SortieBoucle *s, int v)
+{
+    RI *ri = s->ri;
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+    {
+        int o = RI_Op(ri, v, k);
+        if (estCalcul(ri->valeurs[o].op) && taille(ri, o) > 2 && estInvariant(s, o))
+            sortirCalcul(s, o);
+        else
+            sortirInvariants(s, o);
+    }
+}
+
+// Indique si un arbre écrit en mémoire globale
+static int ecritMemoire(const RI *ri, int v)
+{
+    Mnemoniques op = ri->valeurs[v].op;
+    if ((op == STO && ri->valeurs[v].arg >= 0) || op == INN || op == CALL || op == STO_IND)
+        return 1;
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+    {
+        if (ecritMemoire(ri, RI_Op(ri, v, k)))
+            return 1;
+    }
+    return 0;
+}
+
+static int sortirInvariantsBoucles(RI *ri)
+{
+    if (!ri->ssaValide)
+        RI_ConstruireSSA(ri);
+
+    SortieBoucle s;
+    s.ri = ri;
+    s.nBoucles = RI_TrouverBoucles(ri, &s.boucles);
+    s.modifs = 0;
+    for (s.i = 0; s.i < s.nBoucles; s.i++)
+    {
+        RI_Boucle *l = &s.boucles[s.i];
+        int nb = ri->nBlocs;
+        int appel = 0;
+        s.pre = -1;
+        s.ecritMem = 0;
+        for (int b = 0; b < nb; b++)
+        {
+            if (!RI_DansBoucle(l, b))
+                continue;
+            for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+            {
+                appel |= contientAppel(ri, ri->blocs[b].instrs[k]);
+                s.ecritMem |= ecritMemoire(ri, ri->blocs[b].instrs[k]);
+            }
+        }
+        // Dans une procédure, un appel peut la rappeler et réécrire ses temporaires
+        if (appel && l->proc > 0)
+            continue;
+        for (int b = 0; b < nb; b++)
+        {
+            if (!RI_DansBoucle(l, b))
+                continue;
+            for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+                sortirInvariants(&s, ri->blocs[b].instrs[k]);
+        }
+    }
+    RI_LibererBoucles(s.boucles, s.nBoucles);
+    return s.modifs;
+}
+
+// ---------------------------------------------------------------------
+// Élimination des écritures mortes. Analyse de vivacité arrière des
+// variables (globales, temporaires, cases du cadre) sur le graphe de chaque
+// procédure. Une écriture dont la variable n'est plus lue avant d'être
+// réécrite ou avant la fin du programme est supprimée ; si la valeur écrite
+// a un effet (appel, lecture), elle est seulement dépilée.
+// Au RET, les globales restent vivantes pour l'appelant, sauf les
+// temporaires des passes qui n'appartiennent qu'à leur procédure.
+// ---------------------------------------------------------------------
+
+// Indique si la valeur v écrit la variable qu'elle nomme
+static int definitVar(const RI *ri, int v)
+{
+    Mnemoniques op = ri->valeurs[v].op;
+    return (op == STO || op == STO_KEEP || op == STL || op == INN) && ri->valeurs[v].var >= 0;
+}
+
+// Indique si l'évaluation d'un arbre n'a aucun effet (on peut la supprimer)
+static int estPur(const RI *ri, int v)
+{
+    switch (ri->valeurs[v].op)
+    {
+    case CALL: case INN: case STO: case STO_KEEP: case STL: case STO_IND: case PRN: case ALC:
+        return 0;
+    case DIVI:
+        if (!diviseurSur(ri, RI_Op(ri, v, 1)))
+            return 0;
+        break;
+    case DIVR:
+        if (!diviseurSur(ri, RI_Op(ri, v, 0)))
+            return 0;
+        break;
+    default:
+        break;
+    }
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+    {
+        if (!estPur(ri, RI_Op(ri, v, k)))
+            return 0;
+    }
+    return 1;
+}
+
+// Transfert arrière d'un arbre : viv décrit la vivacité après l'arbre et
+// devient celle d'avant. Si eliminer est non nul, les STO_KEEP morts sont retirés.
+static int vivaciteArbre(RI *ri, int v, char *viv, int eliminer)
+{
+    int modifs = 0;
+    while (eliminer && ri->valeurs[v].op == STO_KEEP && ri->valeurs[v].var >= 0 &&
+           !viv[ri->valeurs[v].var])
+    {
+        RI_DevenirCopie(ri, v, RI_Op(ri, v, 0));
+        modifs++;
+    }
+
+    RI_Valeur *val = &ri->valeurs[v];
+    if (val->op == HLT)
+        memset(viv, 0, RI_NB_VARS);
+    if (val->op == RET)
+    {
+        for (int a = 0; a < RI_NB_VARS; a++)
+            viv[a] = (a < TAILLEMEM && a < ri->premierTemp);
+    }
+    if (definitVar(ri, v))
+        viv[val->var] = 0;
+    if ((val->op == LDV || val->op == LDL) && val->var >= 0)
+        viv[val->var] = 1;
+    if (val->op == CALL || (val->op == LDV && val->var < 0))
+    {
+        for (int a = 0; a < RI_NB_VARS; a++)
+        {
+            if (RI_PeutLire(ri, v, a))
+                viv[a] = 1;
+        }
+    }
+    for (int k = ri->valeurs[v].nOps - 1; k >= 0; k--)
+        modifs += vivaciteArbre(ri, RI_Op(ri, v, k), viv, eliminer);
+    return modifs;
+}
+
+// Vivacité à la sortie du bloc b : union des entrées de ses successeurs
+static void vivaciteSortie(const RI *ri, int b, const char *entree, char *viv)
+{
+    memset(viv, 0, RI_NB_VARS);
+    for (int k = 0; k < ri->blocs[b].nSucc; k++)
+    {
+        const char *e = &entree[(size_t)ri->blocs[b].succ[k] * RI_NB_VARS];
+        for (int a = 0; a < RI_NB_VARS; a++)
+            viv[a] |= e[a];
+    }
+}
+
+// Vivacité des variables à l'entrée de chaque bloc : entree[b * RI_NB_VARS + var]
+// (effets à jour). Le tableau est à libérer par l'appelant.
+static char *vivaciteEntrees(RI *ri)
+{
+    int nb = ri->nBlocs;
+    char *entree = calloc((size_t)nb * RI_NB_VARS, 1);
+    char *viv = malloc(RI_NB_VARS);
+
+    // Point fixe de la vivacité à l'entrée des blocs
+    int change = 1;
+    while (change)
+    {
+        change = 0;
+        for (int b = nb - 1; b >= 0; b--)
+        {
+            if (ri->blocs[b].proc < 0)
+                continue;
+            vivaciteSortie(ri, b, entree, viv);
+            for (int k = ri->blocs[b].nInstrs - 1; k >= 0; k--)
+                vivaciteArbre(ri, ri->blocs[b].instrs[k], viv, 0);
+            if (memcmp(viv, &entree[(size_t)b * RI_NB_VARS], RI_NB_VARS) != 0)
+            {
+                memcpy(&entree[(size_t)b * RI_NB_VARS], viv, RI_NB_VARS);
+                change = 1;
+            }
+        }
+    }
+    free(viv);
+    return entree;
+}
+
+static int eliminerEcrituresMortes(RI *ri)
+{
+    RI_CalculerPreds(ri);
+    RI_CalculerEffets(ri);
+    int nb = ri->nBlocs;
+    char *entree = vivaciteEntrees(ri);
+    char *viv = malloc(RI_NB_VARS);
+    int modifs = 0;
+
+    // Suppression des écritures mortes, en remontant chaque bloc
+    for (int b = 0; b < nb; b++)
+    {
+        if (ri->blocs[b].proc < 0)
+            continue;
+        vivaciteSortie(ri, b, entree, viv);
+        for (int k = ri->blocs[b].nInstrs - 1; k >= 0; k--)
+        {
+            int v = ri->blocs[b].instrs[k];
+            RI_Valeur *val = &ri->valeurs[v];
+            int morte = (val->op == STO || val->op == STL) && val->var >= 0 && !viv[val->var];
+            int pop = (val->op == STO && val->arg == -9999);
+            if (morte || pop)
+            {
+                if (estPur(ri, RI_Op(ri, v, 0)))
+                {
+                    RI_RetirerInstr(ri, b, k);
+                    modifs++;
+                    continue;
+                }
+                if (morte)
+                {
+                    // La valeur a un effet : elle est calculée puis dépilée
+                    val->op = STO;
+                    val->arg = -9999;
+                    val->var = -1;
+                    val->version = -1;
+                    modifs++;
+                }
+            }
+            modifs += vivaciteArbre(ri, v, viv, 1);
+        }
+    }
+    free(entree);
+    free(viv);
+    return modifs;
+}
+
+// ---------------------------------------------------------------------
+// Déroulage des boucles for. Une boucle d'un seul bloc dont le dernier
+// calcul est "i := i + c" (ou "i := i - c", c constant positif) suivi du
+// test "i <= borne" (ou "i >= borne"), avec une borne invariante, est recopiée U fois
+// (-unroll=<n>). Si le nombre de tours N est connu (début et borne
+// constants), la boucle est entièrement déroulée quand elle est petite,
+// sinon la boucle déroulée fait N / U tours suivis des N mod U derniers
+// corps à la suite. Sinon, la boucle déroulée ne tourne que tant qu'il
+// reste au moins U tours, et la boucle d'origine finit les tours restants.
+// Les corps gardent leur ordre et i reçoit la même valeur finale.
+// ---------------------------------------------------------------------
+
+// Facteur de déroulage des boucles for (-unroll=<n>, 1 ou moins : pas de déroulage)
+ETAT_PAR_FIL int FACTEUR_DEROULAGE = 4;
+
+// Nombre maximal d'instructions P-code d'un corps déroulé
+#define TAILLE_DEROULAGE 64
+
+// Taille du programme au-delà de laquelle on ne déroule plus (PCODE est borné)
+#define TAILLE_PROGRAMME_DEROULAGE (TAILLECODE * 3 / 4)
+
+typedef struct {
+    int b;        // Bloc de la boucle
+    int var;      // Variable de boucle
+    int monte;    // 1 : i := i + c et test <= ; 0 : i := i - c et test >=
+    int pas;      // Pas c de la variable de boucle
+    int borne;    // Valeur de la borne (LDI ou lecture invariante)
+    int sortie;   // Bloc de sortie
+    int u;        // Facteur retenu
+    int n;        // Nombre de tours connu (-1 sinon)
+    int s;        // Taille d'un tour (corps et incrément)
+} Deroulage;
+
+// Copie un arbre (chaque copie du corps a ses propres valeurs)
+static int copierArbre(RI *ri, int v)
+{
+    int nOps = ri->valeurs[v].nOps;
+    int *ops = malloc((size_t)(nOps > 0 ? nOps : 1) * sizeof(int)); // Un appel a n opérandes
+    if (!ops)
+        Error("Out of memory (IR)");
+    for (int k = 0; k < nOps; k++)
+        ops[k] = copierArbre(ri, RI_Op(ri, v, k));
+    int w = RI_NouvelleValeur(ri, ri->valeurs[v].op, ri->valeurs[v].arg, ops, nOps);
+    free(ops);
+    return w;
+}
+
+// Lecture d'une variable (globale ou case du cadre)
+static int lireVariable(RI *ri, int var)
+{
+    if (var >= TAILLEMEM)
+        return RI_NouvelleValeur(ri, LDL, RI_CASE_DE(var), NULL, 0);
+    int a = RI_NouvelleValeur(ri, LDA, var, NULL, 0);
+    return RI_NouvelleValeur(ri, LDV, 0, &a, 1);
+}
+
+// Indique si la valeur est une lecture de la variable var
+static int estLecture(const RI *ri, int v, int var)
+{
+    Mnemoniques op = ri->valeurs[v].op;
+    return (op == LDV || op == LDL) && var >= 0 && ri->valeurs[v].var == var;
+}
+
+// Indique si un arbre peut écrire la variable var (effets à jour)
+static int ecritVariable(const RI *ri, int v, int var)
+{
+    if ((definitVar(ri, v) && ri->valeurs[v].var == var) || RI_PeutEcrire(ri, v, var))
+        return 1;
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+    {
+        if (ecritVariable(ri, RI_Op(ri, v, k), var))
+            return 1;
+    }
+    return 0;
+}
+
+// Indique si la version ver donne une valeur constante à sa variable (placée dans *c)
+static int initialeConstante(const RI *ri, int ver, int *c)
+{
+    if (ver < 0 || ri->versions[ver].valeur < 0)
+        return 0;
+    int d = ri->versions[ver].valeur;
+    if ((ri->valeurs[d].op != STO && ri->valeurs[d].op != STL) || ri->valeurs[d].nOps != 1)
+        return 0;
+    int x = RI_Op(ri, d, 0);
+    if (ri->valeurs[x].op != LDI)
+        return 0;
+    *c = ri->valeurs[x].arg;
+    return 1;
+}
+
+// Reconnaît une boucle for déroulable dans le bloc b
+static int analyserDeroulage(RI *ri, int b, Deroulage *d)
+{
+    RI_Bloc *bl = &ri->blocs[b];
+    int t = RI_Terminateur(ri, b);
+    if (bl->deroule || t < 0 || bl->nSucc != 2 || bl->succ[0] != b || bl->succ[1] == b ||
+        bl->nPreds != 2 || bl->nInstrs < 2)
+        return 0;
+    int ext = (bl->preds[0] == b) ? 1 : 0;
+    if (bl->preds[1 - ext] != b || bl->preds[ext] == b)
+        return 0;
+
+    // Incrément juste avant le test
+    Mnemoniques rel = ri->valeurs[t].op;
+    int inc = bl->instrs[bl->nInstrs - 2];
+    if ((rel != BLE && rel != BGE) || !definitVar(ri, inc) || ri->valeurs[inc].op == INN)
+        return 0;
+    int var = ri->valeurs[inc].var;
+    int e = RI_Op(ri, inc, 0);
+    Mnemoniques sens = (rel == BLE) ? ADD : SUB;
+    if (ri->valeurs[e].op != sens || !estLecture(ri, RI_Op(ri, e, 0), var))
+        return 0;
+    int c = RI_Op(ri, e, 1);
+    if (ri->valeurs[c].op != LDI || ri->valeurs[c].arg < 1)
+        return 0;
+    int pas = ri->valeurs[c].arg;
+    if (!estLecture(ri, RI_Op(ri, t, 0), var))
+        return 0;
+
+    // Borne invariante : constante, ou variable que la boucle n'écrit pas
+    int borne = RI_Op(ri, t, 1);
+    int varBorne = -1;
+    if (ri->valeurs[borne].op != LDI)
+    {
+        varBorne = ri->valeurs[borne].var;
+        if (!estLecture(ri, borne, varBorne) || varBorne == var)
+            return 0;
+    }
+
+    // Le corps n'écrit ni la variable de boucle ni la borne
+    int s = 0;
+    for (int k = 0; k < bl->nInstrs - 2; k++)
+    {
+        int v = bl->instrs[k];
+        if (ecritVariable(ri, v, var) || (varBorne >= 0 && ecritVariable(ri, v, varBorne)))
+            return 0;
+        s += taille(ri, v);
+    }
+    if (varBorne >= 0 && ecritVariable(ri, inc, varBorne))
+        return 0;
+    s += taille(ri, inc);
+
+    int u = FACTEUR_DEROULAGE;
+    if (u * s > TAILLE_DEROULAGE)
+        u = TAILLE_DEROULAGE / s;
+    if (u < 2)
+        return 0;
+
+    // Nombre de tours connu : valeur d'entrée constante (phi) et borne constante.
+    // Le corps s'exécute au moins une fois (le test est en bas de la boucle).
+    int n = -1;
+    int debut;
+    for (int i = 0; i < ri->nPhis && ri->valeurs[borne].op == LDI; i++)
+    {
+        if (ri->phis[i].bloc != b || ri->phis[i].var != var ||
+            !initialeConstante(ri, ri->phis[i].args[ext], &debut))
+            continue;
+        long ecart = (rel == BLE) ? (long)ri->valeurs[borne].arg - debut
+                                  : (long)debut - ri->valeurs[borne].arg;
+        if (ecart < 1000000000L)
+            n = (ecart < 0) ? 1 : (int)(ecart / pas) + 1;
+    }
+
+    d->b = b;
+    d->var = var;
+    d->monte = (rel == BLE);
+    d->pas = pas;
+    d->borne = borne;
+    d->sortie = bl->succ[1];
+    d->u = u;
+    d->n = n;
+    d->s = s;
+    return 1;
+}
+
+// Ajoute à la fin du bloc dst une copie du corps (incrément compris) de la boucle
+static void copierTour(RI *ri, int dst, int b)
+{
+    for (int k = 0; k < ri->blocs[b].nInstrs - 1; k++)
+    {
+        int c = copierArbre(ri, ri->blocs[b].instrs[k]);
+        RI_InsererInstr(ri, dst, ri->blocs[dst].nInstrs, c);
+    }
+}
+
+// Termine le bloc par "si (i +/- ecart) rel borne aller à cible", sinon suite
+static void terminerPar(RI *ri, const Deroulage *d, int bl, Mnemoniques rel, int ecart, int cible, int suite)
+{
+    int ops[2];
+    ops[0] = lireVariable(ri, d->var);
+    if (ecart != 0)
+    {
+        ops[1] = RI_NouvelleValeur(ri, LDI, ecart, NULL, 0);
+        ops[0] = RI_NouvelleValeur(ri, d->monte ? ADD : SUB, 0, ops, 2);
+    }
+    ops[1] = copierArbre(ri, d->borne);
+    int t = RI_NouvelleValeur(ri, rel, cible, ops, 2);
+    RI_InsererInstr(ri, bl, ri->blocs[bl].nInstrs, t);
+    ri->blocs[bl].succ[0] = cible;
+    ri->blocs[bl].succ[1] = suite;
+    ri->blocs[bl].nSucc = 2;
+}
+
+// Indique si la boucle est assez courte pour être entièrement déroulée
+static int deroulageComplet(const Deroulage *d)
+{
+    return d->n > 0 && d->n <= TAILLE_DEROULAGE && d->n * d->s <= TAILLE_DEROULAGE;
+}
+
+// Nombre d'instructions P-code ajoutées par le déroulage (tests compris)
+static int croissanceDeroulage(const Deroulage *d)
+{
+    if (deroulageComplet(d))
+        return (d->n - 1) * d->s;
+    if (d->n >= d->u)
+        return (d->u + d->n % d->u) * d->s + 4;
+    return d->u * d->s + 20;
+}
+
+// Taille approximative du programme : arbres des blocs accessibles et un saut par bloc
+static int tailleProgramme(const RI *ri)
+{
+    int n = 0;
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        if (ri->blocs[b].proc < 0)
+            continue;
+        for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+            n += taille(ri, ri->blocs[b].instrs[k]);
+        n++;
+    }
+    return n;
+}
+
+static void derouler(RI *ri, RI_Boucle *boucles, int nBoucles, int i, const Deroulage *d)
+{
+    int b = d->b;
+    int proc = ri->blocs[b].proc;
+    int pre = RI_PreEntete(ri, boucles, nBoucles, i);
+    Mnemoniques continuer = d->monte ? BLE : BGE;
+    Mnemoniques depasse = d->monte ? BGT : BLT;
+
+    // Nombre de tours connu et petit : plus de boucle
+    if (deroulageComplet(d))
+    {
+        for (int k = 0; k < d->n; k++)
+            copierTour(ri, pre, b);
+        ri->blocs[pre].succ[0] = d->sortie;
+        return;
+    }
+
+    int ub = RI_NouveauBloc(ri, proc, b);
+    ri->blocs[ub].deroule = 1;
+    ri->blocs[b].deroule = 1;
+    for (int k = 0; k < d->u; k++)
+        copierTour(ri, ub, b);
+
+    if (d->n >= d->u)
+    {
+        // N / U tours de la boucle déroulée, puis les N mod U derniers corps
+        int r = d->n % d->u;
+        int fin = d->sortie;
+        if (r > 0)
+        {
+            fin = RI_NouveauBloc(ri, proc, b);
+            for (int k = 0; k < r; k++)
+                copierTour(ri, fin, b);
+            ri->blocs[fin].succ[0] = d->sortie;
+            ri->blocs[fin].nSucc = 1;
+        }
+        int borne = ri->valeurs[d->borne].arg;
+        int dBorne = RI_NouvelleValeur(ri, LDI, d->monte ? borne - r * d->pas : borne + r * d->pas, NULL, 0);
+        Deroulage dd = *d;
+        dd.borne = dBorne;
+        terminerPar(ri, &dd, ub, continuer, 0, ub, fin);
+        ri->blocs[pre].succ[0] = ub;
+        return;
+    }
+
+    // Nombre de tours inconnu : la boucle déroulée tourne tant qu'il reste U tours,
+    // puis la boucle d'origine fait le reste
+    int reste = RI_NouveauBloc(ri, proc, b);
+    terminerPar(ri, d, pre, depasse, (d->u - 1) * d->pas, b, ub);
+    terminerPar(ri, d, ub, continuer, (d->u - 1) * d->pas, ub, reste);
+    terminerPar(ri, d, reste, depasse, 0, d->sortie, b);
+}
+
+static int deroulerBoucles(RI *ri)
+{
+    if (FACTEUR_DEROULAGE <= 1)
+        return 0;
+    if (!ri->ssaValide)
+        RI_ConstruireSSA(ri);
+    RI_CalculerEffets(ri);
+
+    RI_Boucle *boucles;
+    int nBoucles = RI_TrouverBoucles(ri, &boucles);
+    Deroulage *d = malloc((size_t)(nBoucles + 1) * sizeof(Deroulage));
+    char *choisie = calloc((size_t)nBoucles + 1, 1);
+
+    // Toutes les boucles sont analysées avant la première transformation (SSA à jour)
+    for (int i = 0; i < nBoucles; i++)
+    {
+        if (boucles[i].nBlocs == 1 && ri->blocs[boucles[i].entete].proc >= 0)
+            choisie[i] = analyserDeroulage(ri, boucles[i].entete, &d[i]);
+    }
+    int modifs = 0;
+    int total = tailleProgramme(ri);
+    for (int i = 0; i < nBoucles; i++)
+    {
+        if (!choisie[i] || total + croissanceDeroulage(&d[i]) > TAILLE_PROGRAMME_DEROULAGE)
+            continue;
+        total += croissanceDeroulage(&d[i]);
+        derouler(ri, boucles, nBoucles, i, &d[i]);
+        RI_CalculerPreds(ri);
+        modifs++;
+    }
+    free(choisie);
+    free(d);
+    RI_LibererBoucles(boucles, nBoucles);
+    return modifs;
+}
+
+// ---------------------------------------------------------------------
+// Variables d'induction. Une variable de base i n'est modifiée dans la
+// boucle que par des "i := i + c" (c constant) et y entre avec une valeur
+// entière constante. Un produit i * k (k constant) lu dans la boucle devient
+// un temporaire t, initialisé à i * k dans le pré-en-tête et augmenté de
+// c * k juste après chaque "i := i + c" : la multiplication devient une
+// addition. Un test "i rel borne" (borne constante) devient "t rel borne * k"
+// quand k > 0 et que t ne peut pas déborder. Si i n'est alors plus lue dans
+// la boucle que par ses incréments et n'est pas vivante à la sortie, elle est
+// redondante et ses incréments disparaissent. Le modèle de coût compte les
+// instructions exécutées par tour, la réduction n'est faite que si elle en
+// retire.
+// ---------------------------------------------------------------------
+
+// Nombre maximal de produits i * k différents réduits par boucle
+#define MAX_INDUCTIONS 8
+
+// Instructions exécutées par "t := t + c * k" et par une lecture de t
+#define COUT_INCREMENT 5
+#define COUT_LECTURE   2
+
+typedef struct {
+    int var;        // Variable de base
+    int k;          // Facteur
+    int temp;       // Temporaire qui vaut var * k dans la boucle
+    int debut;      // Valeur d'entrée commune de var (si debutConnu)
+    int debutConnu; // Toutes les entrées de var ont la même constante
+    int test;       // Test réécrit en "t rel borne * k" (-1 sinon)
+    int eliminer;   // var disparaît de la boucle (une seule induction par variable le porte)
+} Induction;
+
+typedef struct {
+    int       nInd;
+    Induction ind[MAX_INDUCTIONS];
+    int      *muls;   // Produits remplacés : muls[2m] valeur MUL, muls[2m + 1] induction
+    int       nMuls;
+} Reduction;
+
+// Pas c si la valeur est un incrément "var := var +/- c" (0 sinon)
+static int pasIncrement(const RI *ri, int v, int var)
+{
+    if ((ri->valeurs[v].op != STO && ri->valeurs[v].op != STL) || var < 0 || ri->valeurs[v].var != var)
+        return 0;
+    int e = RI_Op(ri, v, 0);
+    Mnemoniques op = ri->valeurs[e].op;
+    if ((op != ADD && op != SUB) || !estLecture(ri, RI_Op(ri, e, 0), var))
+        return 0;
+    int c = RI_Op(ri, e, 1);
+    if (ri->valeurs[c].op != LDI)
+        return 0;
+    return (op == ADD) ? ri->valeurs[c].arg : -ri->valeurs[c].arg;
+}
+
+// Facteur k si la valeur est le produit var * k ou k * var (0 sinon)
+static int facteurProduit(const RI *ri, int v, int var)
+{
+    if (ri->valeurs[v].op != MUL)
+        return 0;
+    int a = RI_Op(ri, v, 0), b = RI_Op(ri, v, 1);
+    if (estLecture(ri, a, var) && ri->valeurs[b].op == LDI)
+        return ri->valeurs[b].arg;
+    if (estLecture(ri, b, var) && ri->valeurs[a].op == LDI)
+        return ri->valeurs[a].arg;
+    return 0;
+}
+
+// Compte les lectures de var dans un arbre hors des produits var * k. Un appel ou
+// une lecture indirecte qui peut lire var compte aussi.
+static int lecturesHorsProduits(const RI *ri, int v, int var)
+{
+    const RI_Valeur *val = &ri->valeurs[v];
+    if (facteurProduit(ri, v, var) != 0)
+        return 0;
+    int n = estLecture(ri, v, var);
+    if (val->op == CALL || (val->op == LDV && val->var < 0))
+        n += RI_PeutLire(ri, v, var);
+    for (int k = 0; k < val->nOps; k++)
+        n += lecturesHorsProduits(ri, RI_Op(ri, v, k), var);
+    return n;
+}
+
+// Ajoute à la réduction les produits var * k d'un arbre qu'aucune autre boucle n'a pris
+static void chercherProduits(RI *ri, int v, int var, Reduction *r, const char *pris)
+{
+    int k = facteurProduit(ri, v, var);
+    if (k != 0 && k != 1 && !pris[v])
+    {
+        int i = 0;
+        while (i < r->nInd && (r->ind[i].var != var || r->ind[i].k != k))
+            i++;
+        if (i == MAX_INDUCTIONS)
+            return;
+        if (i == r->nInd)
+        {
+            memset(&r->ind[i], 0, sizeof(Induction));
+            r->ind[i].var = var;
+            r->ind[i].k = k;
+            r->ind[i].test = -1;
+            r->nInd++;
+        }
+        r->muls = realloc(r->muls, (size_t)(r->nMuls + 1) * 2 * sizeof(int));
+        r->muls[2 * r->nMuls] = v;
+        r->muls[2 * r->nMuls + 1] = i;
+        r->nMuls++;
+        return;
+    }
+    for (int j = 0; j < ri->valeurs[v].nOps; j++)
+        chercherProduits(ri, RI_Op(ri, v, j), var, r, pris);
+}
+
+// Relation inverse (non r) et relation vue depuis l'autre opérande (b r a)
+static Mnemoniques relationInverse(Mnemoniques r)
+{
+    switch (r)
+    {
+    case EQL: return NEQ;
+    case NEQ: return EQL;
+    case GTR: return LEQ;
+    case LSS: return GEQ;
+    case GEQ: return LSS;
+    default:  return GTR;
+    }
+}
+
+static Mnemoniques relationMiroir(Mnemoniques r)
+{
+    switch (r)
+    {
+    case GTR: return LSS;
+    case LSS: return GTR;
+    case GEQ: return LEQ;
+    case LEQ: return GEQ;
+    default:  return r;
+    }
+}
+
+// Si le bloc b de la boucle se termine par un test de var contre une constante
+// qui décide de rester dans la boucle, retourne la relation "var rel borne" qui
+// y garde (EQL..LEQ) et place la constante dans *borne. Retourne -1 sinon.
+static int relationContinuer(const RI *ri, const RI_Boucle *l, int b, int var, int *borne)
+{
+    int t = RI_Terminateur(ri, b);
+    if (t < 0 || !RI_EstConditionnel(ri->valeurs[t].op) ||
+        RI_DansBoucle(l, ri->blocs[b].succ[0]) == RI_DansBoucle(l, ri->blocs[b].succ[1]))
+        return -1;
+    int cmp = t;
+    Mnemoniques rel;
+    int prisReste = RI_DansBoucle(l, ri->blocs[b].succ[0]);
+    if (ri->valeurs[t].op == BZE)
+    {
+        // BZE saute quand la comparaison est fausse
+        cmp = RI_Op(ri, t, 0);
+        if (ri->valeurs[cmp].op < EQL || ri->valeurs[cmp].op > LEQ)
+            return -1;
+        rel = ri->valeurs[cmp].op;
+        prisReste = !prisReste;
+    }
+    else
+    {
+        rel = relationDe(ri->valeurs[t].op);
+    }
+    int a = RI_Op(ri, cmp, 0), c = RI_Op(ri, cmp, 1);
+    if (estLecture(ri, c, var) && ri->valeurs[a].op == LDI)
+    {
+        int x = a;
+        a = c;
+        c = x;
+        rel = relationMiroir(rel);
+    }
+    if (!estLecture(ri, a, var) || ri->valeurs[c].op != LDI)
+        return -1;
+    *borne = ri->valeurs[c].arg;
+    return prisReste ? rel : relationInverse(rel);
+}
+
+// Indique si x tient dans un entier
+static int tientDansEntier(long x)
+{
+    return x > -2147483647L && x < 2147483647L;
+}
+
+// Étudie la variable var de la boucle l ; ajoute ses inductions à r si elles sont rentables
+static void analyserVariable(RI *ri, const RI_Boucle *l, int var, Reduction *r,
+                             const char *entree, const char *pris)
+{
+    int nb = (l->taille < ri->nBlocs) ? l->taille : ri->nBlocs;
+    int h = l->entete;
+
+    // Toutes les écritures de var dans la boucle sont des incréments de même sens
+    int nIncrs = 0, coutIncrs = 0, somme = 0, croit = 0, decroit = 0;
+    for (int b = 0; b < nb; b++)
+    {
+        for (int q = 0; RI_DansBoucle(l, b) && q < ri->blocs[b].nInstrs; q++)
+        {
+            int v = ri->blocs[b].instrs[q];
+            int c = pasIncrement(ri, v, var);
+            if (c != 0)
+            {
+                nIncrs++;
+                coutIncrs += taille(ri, v);
+                somme += (c > 0) ? c : -c;
+                croit |= (c > 0);
+                decroit |= (c < 0);
+            }
+            else if (ecritVariable(ri, v, var))
+            {
+                return;
+            }
+        }
+    }
+
+    // Valeur d'entrée : constante entière sur chaque arc qui entre dans la boucle
+    int debut = 0, debutConnu = 1, nEntrees = 0;
+    for (int f = 0; f < ri->nPhis; f++)
+    {
+        const RI_Phi *phi = &ri->phis[f];
+        if (phi->bloc != h || phi->var != var)
+            continue;
+        for (int k = 0; k < ri->blocs[h].nPreds; k++)
+        {
+            int c;
+            if (RI_DansBoucle(l, ri->blocs[h].preds[k]))
+                continue;
+            if (!initialeConstante(ri, phi->args[k], &c))
+                return;
+            if (nEntrees++ == 0)
+                debut = c;
+            else if (c != debut)
+                debutConnu = 0;
+        }
+    }
+    if (nEntrees == 0)
+        return;
+
+    // Produits var * k de la boucle
+    int premierInd = r->nInd, premierMul = r->nMuls;
+    for (int b = 0; b < nb; b++)
+    {
+        for (int q = 0; RI_DansBoucle(l, b) && q < ri->blocs[b].nInstrs; q++)
+            chercherProduits(ri, ri->blocs[b].instrs[q], var, r, pris);
+    }
+    if (r->nInd == premierInd)
+        return;
+    int gain = 0;
+    for (int m = premierMul; m < r->nMuls; m++)
+        gain += taille(ri, r->muls[2 * m]) - COUT_LECTURE;
+    gain -= COUT_INCREMENT * nIncrs * (r->nInd - premierInd);
+
+    // Test de sortie réécrit sur le premier facteur positif. t ne déborde pas :
+    // var part de debut, va dans un seul sens et la boucle ne continue que tant
+    // qu'elle n'a pas dépassé la borne (d'au plus la somme des pas d'un tour)
+    int kTest = -1, test = -1;
+    for (int i = premierInd; i < r->nInd && kTest < 0; i++)
+    {
+        if (r->ind[i].k > 0)
+            kTest = i;
+    }
+    for (int b = 0; b < nb && kTest >= 0 && test < 0 && debutConnu && croit != decroit; b++)
+    {
+        int borne;
+        int rel = RI_DansBoucle(l, b) ? relationContinuer(ri, l, b, var, &borne) : -1;
+        if (rel < 0 || (croit && rel != LEQ && rel != LSS) || (decroit && rel != GEQ && rel != GTR))
+            continue;
+        long k = r->ind[kTest].k;
+        long bout = croit ? (long)borne + somme : (long)borne - somme;
+        if (tientDansEntier((long)debut * k) && tientDansEntier(bout * k))
+            test = RI_Terminateur(ri, b);
+    }
+
+    // var est redondante si plus rien ne la lit dans la boucle (hors ses incréments
+    // et le test réécrit) ni à la sortie
+    int lues = -nIncrs - (test >= 0);
+    int vivante = 0;
+    for (int b = 0; b < nb; b++)
+    {
+        if (!RI_DansBoucle(l, b))
+            continue;
+        for (int q = 0; q < ri->blocs[b].nInstrs; q++)
+            lues += lecturesHorsProduits(ri, ri->blocs[b].instrs[q], var);
+        int t = RI_Terminateur(ri, b);
+        if (t >= 0 && ri->valeurs[t].op == RET && var < ri->premierTemp)
+            vivante = 1;
+        for (int k = 0; k < ri->blocs[b].nSucc; k++)
+        {
+            int s = ri->blocs[b].succ[k];
+            if (!RI_DansBoucle(l, s) && entree[(size_t)s * RI_NB_VARS + var])
+                vivante = 1;
+        }
+    }
+    int eliminer = (lues == 0 && !vivante);
+    if (eliminer)
+        gain += coutIncrs;
+
+    if (gain <= 0)
+    {
+        r->nInd = premierInd;
+        r->nMuls = premierMul;
+        return;
+    }
+    for (int i = premierInd; i < r->nInd; i++)
+    {
+        r->ind[i].debut = debut;
+        r->ind[i].debutConnu = debutConnu;
+    }
+    // Sans élimination, le test réécrit ne retire rien : il est gardé sur var
+    if (eliminer)
+        r->ind[kTest >= 0 ? kTest : premierInd].test = test;
+    r->ind[premierInd].eliminer = eliminer;
+}
+
+// Applique la réduction à la boucle i
+static void reduireBoucle(RI *ri, RI_Boucle *boucles, int nBoucles, int i, Reduction *r)
+{
+    RI_Boucle *l = &boucles[i];
+    int nb = (l->taille < ri->nBlocs) ? l->taille : ri->nBlocs;
+    int pre = RI_PreEntete(ri, boucles, nBoucles, i);
+
+    // Temporaires initialisés à var * k dans le pré-en-tête
+    for (int j = 0; j < r->nInd; j++)
+    {
+        Induction *in = &r->ind[j];
+        in->temp = OFFSET++;
+        int ops[2];
+        int init;
+        if (in->debutConnu)
+        {
+            init = RI_NouvelleValeur(ri, LDI, in->debut * in->k, NULL, 0);
+        }
+        else
+        {
+            ops[0] = lireVariable(ri, in->var);
+            ops[1] = RI_NouvelleValeur(ri, LDI, in->k, NULL, 0);
+            init = RI_NouvelleValeur(ri, MUL, 0, ops, 2);
+        }
+        int st = RI_NouvelleValeur(ri, STO, in->temp, &init, 1);
+        RI_InsererInstr(ri, pre, ri->blocs[pre].nInstrs, st);
+    }
+
+    // Les produits deviennent des lectures des temporaires
+    for (int m = 0; m < r->nMuls; m++)
+    {
+        int v = r->muls[2 * m];
+        int lu = lireVariable(ri, r->ind[r->muls[2 * m + 1]].temp);
+        RI_DevenirCopie(ri, v, lu);
+    }
+
+    // Tests réécrits : "var rel borne" devient "t rel borne * k"
+    for (int j = 0; j < r->nInd; j++)
+    {
+        int t = r->ind[j].test;
+        if (t < 0)
+            continue;
+        int cmp = (ri->valeurs[t].op == BZE) ? RI_Op(ri, t, 0) : t;
+        for (int k = 0; k < 2; k++)
+        {
+            int o = RI_Op(ri, cmp, k);
+            if (estLecture(ri, o, r->ind[j].var))
+                RI_ChangerOp(ri, cmp, k, lireVariable(ri, r->ind[j].temp));
+            else
+                RI_DevenirConstante(ri, o, LDI, ri->valeurs[o].arg * r->ind[j].k);
+        }
+    }
+
+    // Après chaque incrément de var : t := t + c * k ; la variable redondante disparaît
+    for (int b = 0; b < nb; b++)
+    {
+        if (!RI_DansBoucle(l, b))
+            continue;
+        for (int q = 0; q < ri->blocs[b].nInstrs; q++)
+        {
+            int inc = ri->blocs[b].instrs[q];
+            int var = ri->valeurs[inc].var;
+            int c = pasIncrement(ri, inc, var);
+            int pos = q, eliminer = 0;
+            for (int j = 0; c != 0 && j < r->nInd; j++)
+            {
+                if (r->ind[j].var != var)
+                    continue;
+                int ops[2];
+                ops[0] = lireVariable(ri, r->ind[j].temp);
+                ops[1] = RI_NouvelleValeur(ri, LDI, c * r->ind[j].k, NULL, 0);
+                int e = RI_NouvelleValeur(ri, ADD, 0, ops, 2);
+                int st = RI_NouvelleValeur(ri, STO, r->ind[j].temp, &e, 1);
+                RI_InsererInstr(ri, b, ++q, st);
+                eliminer |= r->ind[j].eliminer;
+            }
+            if (eliminer)
+            {
+                RI_RetirerInstr(ri, b, pos);
+                q--;
+            }
+        }
+    }
+}
+
+// Indique si un bloc de la boucle contient un appel
+static int boucleAppelle(const RI *ri, const RI_Boucle *l)
+{
+    for (int b = 0; b < l->taille && b < ri->nBlocs; b++)
+    {
+        for (int q = 0; RI_DansBoucle(l, b) && q < ri->blocs[b].nInstrs; q++)
+        {
+            if (contientAppel(ri, ri->blocs[b].instrs[q]))
+                return 1;
+        }
+    }
+    return 0;
+}
+
+static int reduireInductions(RI *ri)
+{
+    if (!ri->ssaValide)
+        RI_ConstruireSSA(ri);
+    RI_CalculerPreds(ri);
+    RI_CalculerEffets(ri);
+    char *entree = vivaciteEntrees(ri);
+    char *pris = calloc((size_t)ri->nValeurs, 1);
+    char *vue = malloc(RI_NB_VARS);
+    RI_Boucle *boucles;
+    int nBoucles = RI_TrouverBoucles(ri, &boucles);
+    Reduction *red = calloc((size_t)nBoucles + 1, sizeof(Reduction));
+
+    // Toutes les boucles sont analysées avant la première transformation (SSA à jour),
+    // les plus petites d'abord : un produit n'est réduit que par une boucle
+    for (int i = 0; i < nBoucles; i++)
+    {
+        RI_Boucle *l = &boucles[i];
+        // Dans une procédure, un appel peut la rappeler et réécrire ses temporaires
+        if (l->proc > 0 && boucleAppelle(ri, l))
+            continue;
+        memset(vue, 0, RI_NB_VARS);
+        for (int b = 0; b < l->taille && b < ri->nBlocs; b++)
+        {
+            for (int q = 0; RI_DansBoucle(l, b) && q < ri->blocs[b].nInstrs; q++)
+            {
+                int v = ri->blocs[b].instrs[q];
+                int var = ri->valeurs[v].var;
+                if (!pasIncrement(ri, v, var) || vue[var])
+                    continue;
+                vue[var] = 1;
+                analyserVariable(ri, l, var, &red[i], entree, pris);
+            }
+        }
+        for (int m = 0; m < red[i].nMuls; m++)
+            pris[red[i].muls[2 * m]] = 1;
+    }
+
+    int modifs = 0;
+    for (int i = 0; i < nBoucles; i++)
+    {
+        if (red[i].nInd > 0 && OFFSET + red[i].nInd <= TAILLEMEM)
+        {
+            reduireBoucle(ri, boucles, nBoucles, i, &red[i]);
+            RI_CalculerPreds(ri);
+            modifs++;
+        }
+        free(red[i].muls);
+    }
+    free(red);
+    free(vue);
+    free(pris);
+    free(entree);
+    RI_LibererBoucles(boucles, nBoucles);
+    return modifs;
+}
+
+// ---------------------------------------------------------------------
+// Procédures mortes : seules les procédures et fonctions accessibles depuis
+// le programme principal dans le graphe d'appels sont gardées. Le programme
+// principal est placé en tête du code, ce qui rend inutile le saut initial
+// par-dessus les corps des procédures. L'abaissement reloge les adresses
+// des procédures restantes dans TAB_IDFS (-1 pour une procédure retirée).
+// ---------------------------------------------------------------------
+
+static int eliminerProceduresMortes(RI *ri)
+{
+    RI_CalculerEffets(ri);
+    int np = ri->nProcs;
+    char *atteinte = calloc((size_t)np, 1);
+    int *aVoir = malloc((size_t)np * sizeof(int));
+    int nAVoir = 0;
+    int modifs = 0;
+
+    atteinte[0] = 1;
+    aVoir[nAVoir++] = 0;
+    while (nAVoir > 0)
+    {
+        int p = aVoir[--nAVoir];
+        for (int q = 0; q < np; q++)
+        {
+            if (ri->appelle[p * np + q] && !atteinte[q])
+            {
+                atteinte[q] = 1;
+                aVoir[nAVoir++] = q;
+            }
+        }
+    }
+    for (int p = 1; p < np; p++)
+    {
+        if (atteinte[p] || ri->procs[p].entree < 0)
+            continue;
+        ri->procs[p].entree = -1;
+        for (int b = 0; b < ri->nBlocs; b++)
+        {
+            if (ri->blocs[b].proc != p)
+                continue;
+            ri->blocs[b].proc = -1;
+            ri->blocs[b].nInstrs = 0;
+            ri->blocs[b].nSucc = 0;
+        }
+        modifs++;
+    }
+
+    // Programme principal d'abord (son entrée doit rester à l'adresse 0), puis les procédures
+    int *ordre = aVoir = realloc(aVoir, (size_t)ri->nOrdre * sizeof(int));
+    int n = 0;
+    for (int i = 0; i < ri->nOrdre; i++)
+    {
+        if (ri->blocs[ri->ordre[i]].proc == 0)
+            ordre[n++] = ri->ordre[i];
+    }
+    for (int i = 0; i < ri->nOrdre; i++)
+    {
+        if (ri->blocs[ri->ordre[i]].proc != 0)
+            ordre[n++] = ri->ordre[i];
+    }
+    if (memcmp(ordre, ri->ordre, (size_t)n * sizeof(int)) != 0)
+    {
+        memcpy(ri->ordre, ordre, (size_t)n * sizeof(int));
+        modifs++;
+    }
+    if (modifs > 0)
+        RI_CalculerPreds(ri);
+    free(atteinte);
+    free(aVoir);
+    return modifs;
+}
+
+// ---------------------------------------------------------------------
+// Compactage des globales : les variables et temporaires que le code ne
+// référence plus sont retirés du segment des globales, les autres sont
+// renumérotés à partir de VAR_BASE (TAB_IDFS et OFFSET sont mis à jour)
+// ---------------------------------------------------------------------
+
+// Applique f à chaque adresse globale nommée par un arbre
+static void adressesArbre(RI *ri, int v, char *vu, int *nouv)
+{
+    if (vu[v])
+        return;
+    vu[v] = 1;
+    RI_Valeur *val = &ri->valeurs[v];
+    int adresse = -1;   // Valeur dont l'argument est une adresse
+    if (val->op == LDA || ((val->op == STO || val->op == STO_KEEP) && val->arg >= 0))
+        adresse = v;
+    else if (val->op == INN && ri->valeurs[RI_Op(ri, v, 0)].op == LDI)
+        adresse = RI_Op(ri, v, 0);
+    else if (val->op == STO_IND && ri->valeurs[RI_Op(ri, v, 1)].op == LDI)
+        adresse = RI_Op(ri, v, 1);
+
+    if (adresse >= 0)
+    {
+        int a = ri->valeurs[adresse].arg;
+        if (a >= VAR_BASE && a < TAILLEMEM)
+        {
+            if (nouv)
+                ri->valeurs[adresse].arg = nouv[a];
+            else
+                vu[ri->nValeurs + a] = 1;
+        }
+        if (adresse != v)
+            vu[adresse] = 1;
+    }
+    if (nouv && val->var >= VAR_BASE && val->var < TAILLEMEM)
+        val->var = nouv[val->var];
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+        adressesArbre(ri, RI_Op(ri, v, k), vu, nouv);
+}
+
+// Parcourt toutes les valeurs accessibles : marque les adresses utilisées
+// (nouv == NULL) ou les renumérote
+static void parcourirAdresses(RI *ri, char *vu, int *nouv)
+{
+    memset(vu, 0, (size_t)ri->nValeurs);
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        if (ri->blocs[b].proc < 0)
+            continue;
+        for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+            adressesArbre(ri, ri->blocs[b].instrs[k], vu, nouv);
+    }
+}
+
+static int compacterGlobales(RI *ri)
+{
+    // vu : une case par valeur, puis une case par adresse mémoire
+    char *vu = calloc((size_t)ri->nValeurs + TAILLEMEM, 1);
+    parcourirAdresses(ri, vu, NULL);
+    const char *utilisee = vu + ri->nValeurs;
+
+    int nouv[TAILLEMEM];
+    int suivante = VAR_BASE;
+    int premierTemp = -1;
+    int modifs = 0;
+    for (int a = VAR_BASE; a < OFFSET; a++)
+    {
+        if (a >= ri->premierTemp && premierTemp < 0)
+            premierTemp = suivante;
+        nouv[a] = utilisee[a] ? suivante++ : -1;
+        if (nouv[a] != a)
+            modifs++;
+    }
+    if (modifs == 0)
+    {
+        free(vu);
+        return 0;
+    }
+
+    for (int i = 0; i < NBR_IDFS; i++)
+    {
+        int a = TAB_IDFS[i].Adresse;
+        if (TAB_IDFS[i].TIDF == TVAR && a >= VAR_BASE && a < OFFSET)
+            TAB_IDFS[i].Adresse = nouv[a];
+    }
+    parcourirAdresses(ri, vu, nouv);
+    ri->premierTemp = (premierTemp >= 0) ? premierTemp : suivante;
+    OFFSET = suivante;
+    free(vu);
+    return modifs;
+}
+
+// ---------------------------------------------------------------------
+// Intégration des procédures (inlining). Un appel d'une procédure ou
+// fonction feuille (sans appel) dont le corps tient en un bloc est remplacé
+// par une copie de ce corps, placée avant l'instruction de l'appel. Les
+// cases du cadre de l'appelée sont renommées en variables de l'appelant :
+// un paramètre jamais réécrit devient l'argument lui-même (LDA x, LLA k), les
+// autres cases (dont la case 0 qui reçoit le résultat d'une fonction)
+// deviennent des temporaires. Le modèle de coût compare la taille du corps
+// au coût de l'appel qu'il remplace ; une procédure appelée une seule fois
+// est toujours intégrée. La directive "noinline" l'interdit.
+// ---------------------------------------------------------------------
+
+// Croissance maximale du code acceptée par appel intégré (-inline=<n>, 0 : pas d'intégration)
+ETAT_PAR_FIL int SEUIL_INLINE = 8;
+
+// Cases du cadre lues et écrites par un corps intégrable, indexées par k - RI_CASE_MIN
+typedef struct {
+    int  nArgs;                 // Nombre d'arguments de l'appelée
+    char ecrite[RI_MAX_LOCAUX]; // La case est réécrite par le corps
+    char lue[RI_MAX_LOCAUX];    // La case est lue avant d'être réécrite
+} CasesCadre;
+
+// Marque les cases du cadre lues et écrites par un arbre, en ordre d'évaluation.
+// Retourne 0 si une case n'est ni un argument ni une case locale suivie.
+// LLA ne sert qu'à INN (l'appelée ne fait pas d'appel) : la case est lue et écrite.
+static int casesEcrites(const RI *ri, int v, CasesCadre *cc)
+{
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+    {
+        if (!casesEcrites(ri, RI_Op(ri, v, k), cc))
+            return 0;
+    }
+    const RI_Valeur *val = &ri->valeurs[v];
+    if (val->op != LDL && val->op != STL && val->op != LLA)
+        return 1;
+    int k = val->arg;
+    if (!RI_CASE_SUIVIE(k) || (k < 1 && (k < CASE_ARGUMENT(0, cc->nArgs) || k > -2)))
+        return 0;
+    int c = k - RI_CASE_MIN;
+    if (val->op != STL && !cc->ecrite[c])
+        cc->lue[c] = 1;
+    if (val->op != LDL)
+        cc->ecrite[c] = 1;
+    return 1;
+}
+
+// Parcourt le corps (bloc unique) de la procédure q et remplit cc.
+// Retourne 0 si une case du cadre n'est pas un argument.
+static int casesCorps(const RI *ri, int q, CasesCadre *cc)
+{
+    int b = ri->procs[q].entree;
+    memset(cc, 0, sizeof(*cc));
+    cc->nArgs = getArgCount(ri->procs[q].idf);
+    for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+    {
+        if (!casesEcrites(ri, ri->blocs[b].instrs[k], cc))
+            return 0;
+    }
+    return 1;
+}
+
+// Coût de l'intégration de la procédure q (croissance du code par appel),
+// ou INT_MAX si son corps ne peut pas être intégré
+static int coutIntegration(const RI *ri, int q)
+{
+    int idf = ri->procs[q].idf;
+    int b = ri->procs[q].entree;
+    if (q == 0 || idf < 0 || b < 0 || TAB_IDFS[idf].SansInline)
+        return INT_MAX;
+    int t = RI_Terminateur(ri, b);
+    if (t < 0 || ri->valeurs[t].op != RET)
+        return INT_MAX;
+
+    CasesCadre cc;
+    if (!casesCorps(ri, q, &cc))
+        return INT_MAX;
+    int corps = 0;
+    for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+    {
+        int v = ri->blocs[b].instrs[k];
+        if (contientAppel(ri, v))
+            return INT_MAX;
+        if (v != t && ri->valeurs[v].op != ALC)
+            corps += taille(ri, v);
+    }
+    if (ri->valeurs[t].nOps > 0)
+        corps += taille(ri, RI_Op(ri, t, 0)) - 1; // Le résultat lu (LDL r) disparaît
+    // Économie : CALL et RET (les arguments sont évalués dans les deux cas) ;
+    // le ALC disparaît aussi, les cases locales devenant des temporaires
+    int economie = 2;
+    return corps - economie;
+}
+
+// Compte les appels de chaque procédure dans un arbre
+static void compterAppels(const RI *ri, int v, int *appels)
+{
+    if (ri->valeurs[v].op == CALL)
+        appels[ri->valeurs[v].arg]++;
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+        compterAppels(ri, RI_Op(ri, v, k), appels);
+}
+
+typedef struct {
+    RI  *ri;
+    int  remplace[RI_MAX_LOCAUX]; // Case k - RI_CASE_MIN : argument constant qui la remplace (-1 sinon)
+    int  temp[RI_MAX_LOCAUX];     // Case k - RI_CASE_MIN : temporaire de l'appelant (-1 si pas encore choisi)
+} Integration;
+
+// Temporaire de l'appelant qui tient la case k du cadre de l'appelée
+static int tempCase(Integration *in, int k)
+{
+    int c = k - RI_CASE_MIN;
+    if (in->temp[c] < 0)
+        in->temp[c] = OFFSET++;
+    return in->temp[c];
+}
+
+// Copie un arbre de l'appelée en renommant les cases de son cadre
+static int copierCorps(Integration *in, int v)
+{
+    RI *ri = in->ri;
+    Mnemoniques op = ri->valeurs[v].op;
+    int arg = ri->valeurs[v].arg;
+    int nOps = ri->valeurs[v].nOps;
+    if (op == LDL)
+    {
+        int r = in->remplace[arg - RI_CASE_MIN];
+        if (r >= 0) // Argument de l'appelant : ses cases ne sont pas renommées
+            return RI_NouvelleValeur(ri, ri->valeurs[r].op, ri->valeurs[r].arg, NULL, 0);
+        int a = RI_NouvelleValeur(ri, LDA, tempCase(in, arg), NULL, 0);
+        return RI_NouvelleValeur(ri, LDV, 0, &a, 1);
+    }
+    if (op == LLA)
+        return RI_NouvelleValeur(ri, LDA, tempCase(in, arg), NULL, 0);
+    int *ops = malloc((size_t)(nOps > 0 ? nOps : 1) * sizeof(int)); // Un appel a n opérandes
+    if (!ops)
+        Error("Out of memory (IR)");
+    for (int k = 0; k < nOps; k++)
+        ops[k] = copierCorps(in, RI_Op(ri, v, k));
+    int w;
+    if (op == STL)
+        w = RI_NouvelleValeur(ri, STO, tempCase(in, arg), ops, nOps);
+    // Un paramètre remplacé par une case de l'appelant (LLA k) est lu et écrit dans cette case
+    else if (op == LDV && ri->valeurs[ops[0]].op == LLA)
+        w = RI_NouvelleValeur(ri, LDL, ri->valeurs[ops[0]].arg, NULL, 0);
+    else if (op == STO_IND && ri->valeurs[ops[1]].op == LLA)
+        w = RI_NouvelleValeur(ri, STL, ri->valeurs[ops[1]].arg, ops, 1);
+    else
+        w = RI_NouvelleValeur(ri, op, arg, ops, nOps);
+    free(ops);
+    return w;
+}
+
+// Indique si un noeud évalué avant l'appel c peut être évalué après le corps intégré
+static int evaluableApres(const RI *ri, int v, int c)
+{
+    const RI_Valeur *val = &ri->valeurs[v];
+    int q = ri->valeurs[c].arg;
+    switch (val->op)
+    {
+    case LDI: case LDF: case LDA: case LLA:
+        return 1;
+    case LDL:
+        return val->var >= 0 && !RI_PeutEcrire(ri, c, val->var); // Case passée à l'appel
+    case LDV:
+        return val->var >= 0 && val->var < TAILLEMEM && !ri->ecritTout[q] &&
+               !ri->ecrit[q * TAILLEMEM + val->var];
+    case DIVI:
+        return diviseurSur(ri, RI_Op(ri, v, 1));
+    default:
+        return estCalcul(val->op);
+    }
+}
+
+// Cherche en ordre d'évaluation un appel intégrable dans l'arbre v. Les noeuds
+// déjà évalués sont notés dans avant : ceux qui précèdent l'appel doivent
+// pouvoir passer après le corps intégré.
+static int chercherAppel(const RI *ri, int v, const char *integrable, int *avant, int *nAvant)
+{
+    int debut = *nAvant;
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+    {
+        int c = chercherAppel(ri, RI_Op(ri, v, k), integrable, avant, nAvant);
+        if (c >= 0)
+            return c;
+    }
+    if (ri->valeurs[v].op == CALL && integrable[ri->valeurs[v].arg])
+    {
+        int ok = 1;
+        for (int i = 0; i < debut && ok; i++)
+            ok = evaluableApres(ri, avant[i], v);
+        for (int k = 0; k < ri->valeurs[v].nOps && ok; k++)
+            ok = !contientAppel(ri, RI_Op(ri, v, k));
+        if (ok)
+            return v;
+    }
+    avant[(*nAvant)++] = v;
+    return -1;
+}
+
+// Remplace l'appel c de l'instruction pos du bloc b par le corps de l'appelée.
+// Retourne le nombre d'instructions insérées avant l'appel.
+static int integrerAppel(RI *ri, int b, int pos, int c)
+{
+    int q = ri->valeurs[c].arg;
+    int corps = ri->procs[q].entree;
+    CasesCadre cc;
+    casesCorps(ri, q, &cc);
+    Integration in;
+    in.ri = ri;
+    for (int i = 0; i < RI_MAX_LOCAUX; i++)
+    {
+        in.remplace[i] = -1;
+        in.temp[i] = -1;
+    }
+
+    // Arguments : une adresse ou une constante remplace directement une case
+    // jamais réécrite, ou disparaît si elle est réécrite avant d'être lue
+    // (case du résultat) ; les autres sont rangés dans l'ordre d'évaluation
+    int inserees = 0;
+    for (int p = 0; p < ri->valeurs[c].nOps; p++)
+    {
+        int a = RI_Op(ri, c, p);
+        int k = CASE_ARGUMENT(p, cc.nArgs);
+        Mnemoniques op = ri->valeurs[a].op;
+        if (op == LDA || op == LLA || op == LDI || op == LDF)
+        {
+            if (!cc.ecrite[k - RI_CASE_MIN])
+            {
+                in.remplace[k - RI_CASE_MIN] = a;
+                continue;
+            }
+            if (!cc.lue[k - RI_CASE_MIN])
+                continue;
+        }
+        int s = RI_NouvelleValeur(ri, STO, tempCase(&in, k), &a, 1);
+        RI_InsererInstr(ri, b, pos + inserees++, s);
+    }
+    // Cases locales lues avant d'être écrites : ALC les met à 0
+    for (int k = 1; RI_CASE_SUIVIE(k); k++)
+    {
+        if (!cc.lue[k - RI_CASE_MIN])
+            continue;
+        int z = RI_NouvelleValeur(ri, LDI, 0, NULL, 0);
+        RI_InsererInstr(ri, b, pos + inserees++, RI_NouvelleValeur(ri, STO, tempCase(&in, k), &z, 1));
+    }
+
+    // Corps sans le ALC ni le RET
+    int resultat = -1;
+    for (int k = 0; k < ri->blocs[corps].nInstrs; k++)
+    {
+        int v = ri->blocs[corps].instrs[k];
+        if (ri->valeurs[v].op == ALC)
+            continue;
+        if (ri->valeurs[v].op == RET)
+        {
+            if (ri->valeurs[v].nOps > 0)
+                resultat = copierCorps(&in, RI_Op(ri, v, 0));
+            break;
+        }
+        int w = copierCorps(&in, v);
+        RI_InsererInstr(ri, b, pos + inserees++, w);
+    }
+
+    // L'appel devient le résultat (une procédure rend une valeur ignorée)
+    if (resultat < 0)
+        resultat = RI_NouvelleValeur(ri, LDI, 0, NULL, 0);
+    RI_DevenirCopie(ri, c, resultat);
+    return inserees;
+}
+
+static int integrerProcedures(RI *ri)
+{
+    if (SEUIL_INLINE <= 0)
+        return 0;
+    RI_CalculerEffets(ri);
+    int np = ri->nProcs;
+
+    // Nombre d'appels de chaque procédure
+    int *appels = calloc((size_t)np, sizeof(int));
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        if (ri->blocs[b].proc < 0)
+            continue;
+        for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+            compterAppels(ri, ri->blocs[b].instrs[k], appels);
+    }
+    char *integrable = calloc((size_t)np, 1);
+    for (int q = 1; q < np; q++)
+    {
+        int cout = coutIntegration(ri, q);
+        integrable[q] = cout != INT_MAX && (appels[q] == 1 || cout <= SEUIL_INLINE);
+    }
+
+    int modifs = 0;
+    int *avant = NULL;
+    int capAvant = 0;
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        if (ri->blocs[b].proc < 0)
+            continue;
+        for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+        {
+            int v = ri->blocs[b].instrs[k];
+            if (capAvant < ri->nValeurs)
+            {
+                capAvant = ri->nValeurs;
+                avant = realloc(avant, (size_t)capAvant * sizeof(int));
+            }
+            int nAvant = 0;
+            int c = chercherAppel(ri, v, integrable, avant, &nAvant);
+            // Chaque case de l'appelée peut demander un temporaire
+            if (c < 0 || OFFSET + RI_MAX_LOCAUX > TAILLEMEM)
+                continue;
+            k += integrerAppel(ri, b, k, c);
+            k--; // L'instruction peut contenir d'autres appels
+            modifs++;
+        }
+    }
+    free(avant);
+    free(appels);
+    free(integrable);
+    return modifs;
+}
+
+// ---------------------------------------------------------------------
+// Appels purs. Une fonction est pure si elle n'écrit ni globale ni
+// paramètre, ne lit aucune globale, ne fait ni read ni write et n'appelle
+// que des fonctions pures : son résultat ne dépend que de ses arguments.
+// Un appel dont tous les arguments sont connus (constantes rangées juste
+// avant l'appel dans la case passée) est exécuté à la compilation par un
+// évaluateur isolé qui parcourt la RI de l'appelée, et devient son
+// résultat (LDI ou LDF). L'évaluation est abandonnée, et l'appel gardé,
+// si elle lit une case inconnue, divise par zéro ou dépasse sa limite de pas.
+// ---------------------------------------------------------------------
+
+#define PAS_EVALUATION  100000 // Noeuds évalués au plus pour replier un appel
+#define PILE_EVALUATION 4096   // Cases de la pile de l'évaluateur
+
+// Case de l'évaluateur : valeur, type et indicateur "valeur connue"
+typedef struct {
+    DataValue v;
+    DataType  t;
+    char      connue;
+} Cellule;
+
+// Les adresses >= TAILLEMEM désignent la pile de l'évaluateur : elle ne se
+// confond jamais avec la mémoire du programme, que l'évaluateur ne lit pas
+typedef struct {
+    const RI *ri;
+    Cellule   glob[TAILLEMEM];        // Globales (seuls les temporaires des passes y sont écrits)
+    Cellule   pile[PILE_EVALUATION];  // Arguments, liens et cases des cadres
+    int       sp;                     // Première case libre de la pile
+    int       pas;                    // Pas restants
+    int       echec;                  // Évaluation abandonnée
+} Evaluateur;
+
+// Indique si un arbre de la procédure garde la pureté (pure : fonctions encore pures)
+static int arbrePur(const RI *ri, int v, const char *pure)
+{
+    const RI_Valeur *val = &ri->valeurs[v];
+    switch (val->op)
+    {
+    case INN: case PRN: case HLT: case STO_IND:
+        return 0;
+    case STO: case STO_KEEP: case LDA:
+        if (val->arg >= 0 && val->arg < ri->premierTemp)
+            return 0; // Globale du programme (les temporaires des passes sont permis)
+        break;
+    case CALL:
+        if (!pure[val->arg])
+            return 0;
+        break;
+    default:
+        break;
+    }
+    for (int k = 0; k < val->nOps; k++)
+    {
+        if (!arbrePur(ri, RI_Op(ri, v, k), pure))
+            return 0;
+    }
+    return 1;
+}
+
+// Calcule les fonctions pures (point fixe : une fonction cesse d'être pure
+// dès qu'elle appelle une fonction qui ne l'est pas)
+static char *fonctionsPures(const RI *ri)
+{
+    char *pure = calloc((size_t)ri->nProcs, 1);
+    for (int q = 1; q < ri->nProcs; q++)
+    {
+        int idf = ri->procs[q].idf;
+        pure[q] = idf >= 0 && ri->procs[q].entree >= 0 && TAB_IDFS[idf].TIDF == TFUNC;
+    }
+    int change = 1;
+    while (change)
+    {
+        change = 0;
+        for (int b = 0; b < ri->nBlocs; b++)
+        {
+            int p = ri->blocs[b].proc;
+            if (p <= 0 || !pure[p])
+                continue;
+            for (int k = 0; k < ri->blocs[b].nInstrs && pure[p]; k++)
+            {
+                if (!arbrePur(ri, ri->blocs[b].instrs[k], pure))
+                {
+                    pure[p] = 0;
+                    change = 1;
+                }
+            }
+        }
+    }
+    return pure;
+}
+
+// Case désignée par une adresse, ou NULL si elle est hors de l'évaluateur
+static Cellule *celluleEvaluee(Evaluateur *ev, int adr)
+{
+    if (adr >= TAILLEMEM && adr - TAILLEMEM < ev->sp)
+        return &ev->pile[adr - TAILLEMEM];
+    if (adr >= ev->ri->premierTemp && adr < TAILLEMEM)
+        return &ev->glob[adr];
+    ev->echec = 1;
+    return NULL;
+}
+
+static Cellule lireEvaluee(Evaluateur *ev, int adr)
+{
+    Cellule *c = celluleEvaluee(ev, adr);
+    if (c && c->connue)
+        return *c;
+    ev->echec = 1;
+    return (Cellule){{0}, TYPE_INT, 0};
+}
+
+static void ecrireEvaluee(Evaluateur *ev, int adr, Cellule x)
+{
+    Cellule *c = celluleEvaluee(ev, adr);
+    if (c)
+        *c = x;
+}
+
+static Cellule entierEvalue(int i)
+{
+    Cellule c = {{0}, TYPE_INT, 1};
+    c.v.i = i;
+    return c;
+}
+
+static float reelEvalue(Cellule c)
+{
+    return (c.t == TYPE_REAL) ? c.v.f : (float)c.v.i;
+}
+
+// Relation EQL..LEQ entre deux cases, comme l'interpréteur
+static int comparerEvaluees(Mnemoniques rel, Cellule a, Cellule b)
+{
+    if (a.t == TYPE_REAL || b.t == TYPE_REAL)
+    {
+        float f1 = reelEvalue(a), f2 = reelEvalue(b);
+        switch (rel)
+        {
+        case EQL: return f1 == f2;
+        case NEQ: return f1 != f2;
+        case GTR: return f1 >  f2;
+        case LSS: return f1 <  f2;
+        case GEQ: return f1 >= f2;
+        default:  return f1 <= f2;
+        }
+    }
+    int i1 = a.v.i, i2 = b.v.i;
+    switch (rel)
+    {
+    case EQL: return i1 == i2;
+    case NEQ: return i1 != i2;
+    case GTR: return i1 >  i2;
+    case LSS: return i1 <  i2;
+    case GEQ: return i1 >= i2;
+    default:  return i1 <= i2;
+    }
+}
+
+// Opération ADD..DIVI, SHL, SHR, comme l'interpréteur (la division par zéro abandonne)
+static Cellule calculerEvaluee(Evaluateur *ev, Mnemoniques op, int arg, Cellule a, Cellule b)
+{
+    Cellule r = {{0}, TYPE_INT, 1};
+    if (op == SHL || op == SHR)
+    {
+        r = a;
+        if (a.t == TYPE_REAL)
+            r.v.f = (op == SHL) ? a.v.f * (float)(1 << arg) : a.v.f / (float)(1 << arg);
+        else if (op == SHL)
+            r.v.i = (int)((unsigned)a.v.i << arg);
+        else
+            r.v.i = (a.v.i + ((a.v.i >> 31) & ((1 << arg) - 1))) >> arg;
+        return r;
+    }
+    if (a.t == TYPE_REAL || b.t == TYPE_REAL)
+    {
+        float f1 = reelEvalue(a), f2 = reelEvalue(b);
+        r.t = TYPE_REAL;
+        switch (op)
+        {
+        case ADD: r.v.f = f1 + f2; break;
+        case SUB: r.v.f = f1 - f2; break;
+        case MUL: r.v.f = f1 * f2; break;
+        default:
+            if (f2 == 0.0f)
+                ev->echec = 1;
+            else
+                r.v.f = f1 / f2;
+            break;
+        }
+        return r;
+    }
+    int i1 = a.v.i, i2 = b.v.i;
+    switch (op)
+    {
+    case ADD: r.v.i = i1 + i2; break;
+    case SUB: r.v.i = i1 - i2; break;
+    case MUL: r.v.i = i1 * i2; break;
+    default:
+        if (i2 == 0)
+            ev->echec = 1;
+        else
+            r.v.i = i1 / i2;
+        break;
+    }
+    return r;
+}
+
+static Cellule executerAppel(Evaluateur *ev, int q, int n);
+
+// Évalue un arbre dans le cadre de base bp
+static Cellule evaluerArbre(Evaluateur *ev, int v, int bp)
+{
+    const RI *ri = ev->ri;
+    const RI_Valeur *val = &ri->valeurs[v];
+    Cellule ops[2];
+    Cellule r = entierEvalue(0);
+    if (--ev->pas < 0)
+        ev->echec = 1;
+    if (val->op == CALL)
+    {
+        // Les arguments sont empilés comme par l'interpréteur
+        for (int k = 0; k < val->nOps && !ev->echec; k++)
+        {
+            Cellule a = evaluerArbre(ev, RI_Op(ri, v, k), bp);
+            if (ev->sp >= PILE_EVALUATION)
+                ev->echec = 1;
+            else
+                ev->pile[ev->sp++] = a;
+        }
+        return ev->echec ? r : executerAppel(ev, val->arg, val->nOps);
+    }
+    for (int k = 0; k < val->nOps && !ev->echec; k++)
+        ops[k] = evaluerArbre(ev, RI_Op(ri, v, k), bp);
+    if (ev->echec)
+        return r;
+
+    switch (val->op)
+    {
+    case LDI: case LDA:
+        return entierEvalue(val->arg);
+    case LDF:
+        r.t = TYPE_REAL;
+        memcpy(&r.v.f, &val->arg, sizeof(float));
+        return r;
+    case LLA:
+        return entierEvalue(TAILLEMEM + bp + val->arg);
+    case LDL:
+        return lireEvaluee(ev, TAILLEMEM + bp + val->arg);
+    case LDV:
+        return lireEvaluee(ev, ops[0].v.i);
+    case STO:
+        if (val->arg >= 0)
+            ecrireEvaluee(ev, val->arg, ops[0]);
+        return r;
+    case STO_KEEP:
+        ecrireEvaluee(ev, val->arg, ops[0]);
+        return ops[0];
+    case STL:
+        ecrireEvaluee(ev, TAILLEMEM + bp + val->arg, ops[0]);
+        return r;
+    case ADD: case SUB: case MUL: case DIVI:
+        return calculerEvaluee(ev, val->op, 0, ops[0], ops[1]);
+    case SHL: case SHR:
+        return calculerEvaluee(ev, val->op, val->arg, ops[0], ops[0]);
+    case EQL: case NEQ: case GTR: case LSS: case GEQ: case LEQ:
+        return entierEvalue(comparerEvaluees(val->op, ops[0], ops[1]));
+    default:
+        ev->echec = 1; // Entrée, sortie ou écriture indirecte
+        return r;
+    }
+}
+
+// Exécute la procédure q dont les n arguments sont au sommet de la pile de
+// l'évaluateur, et retourne la valeur laissée par RET
+static Cellule executerAppel(Evaluateur *ev, int q, int n)
+{
+    const RI *ri = ev->ri;
+    Cellule r = entierEvalue(0);
+    int base = ev->sp - n;
+    // Adresse de retour et ancien BP, comme le CALL de l'interpréteur
+    if (ev->sp + 2 > PILE_EVALUATION)
+    {
+        ev->echec = 1;
+        return r;
+    }
+    ev->pile[ev->sp++] = entierEvalue(0);
+    ev->pile[ev->sp++] = entierEvalue(0);
+    int bp = ev->sp - 1;
+
+    int b = ri->procs[q].entree;
+    while (!ev->echec)
+    {
+        const RI_Bloc *bl = &ri->blocs[b];
+        int suivant = (bl->nSucc > 0) ? bl->succ[0] : -1;
+        for (int k = 0; k < bl->nInstrs && !ev->echec; k++)
+        {
+            int v = bl->instrs[k];
+            const RI_Valeur *val = &ri->valeurs[v];
+            if (val->op == ALC)
+            {
+                // Cases du cadre mises à 0
+                if (bp + 1 + val->arg > PILE_EVALUATION)
+                    ev->echec = 1;
+                for (int c = 1; c <= val->arg && !ev->echec; c++)
+                    ev->pile[bp + c] = entierEvalue(0);
+                ev->sp = bp + 1 + val->arg;
+            }
+            else if (val->op == RET)
+            {
+                if (val->nOps > 0)
+                    r = evaluerArbre(ev, RI_Op(ri, v, 0), bp);
+                ev->sp = base;
+                return r;
+            }
+            else if (RI_EstConditionnel(val->op))
+            {
+                Cellule a = evaluerArbre(ev, RI_Op(ri, v, 0), bp);
+                int pris;
+                if (val->op == BZE)
+                    pris = (a.v.i == 0);
+                else
+                    pris = comparerEvaluees(relationDe(val->op), a, evaluerArbre(ev, RI_Op(ri, v, 1), bp));
+                suivant = bl->succ[pris ? 0 : 1];
+            }
+            else if (val->op != BRN)
+            {
+                evaluerArbre(ev, v, bp);
+            }
+        }
+        if (suivant < 0)
+            ev->echec = 1; // HLT ou bloc sans suite
+        b = suivant;
+    }
+    ev->sp = base;
+    return r;
+}
+
+// Indique si un noeud de l'arbre v évalué avant c peut écrire var
+// (*trouve passe à 1 quand c est atteint ; le parcours s'arrête alors)
+static int ecritAvant(const RI *ri, int v, int c, int var, int *trouve)
+{
+    if (v == c)
+    {
+        *trouve = 1;
+        return 0;
+    }
+    for (int k = 0; k < ri->valeurs[v].nOps && !*trouve; k++)
+    {
+        if (ecritAvant(ri, RI_Op(ri, v, k), c, var, trouve))
+            return 1;
+    }
+    if (*trouve)
+        return 0;
+    return (definitVar(ri, v) && ri->valeurs[v].var == var) || RI_PeutEcrire(ri, v, var);
+}
+
+// Valeur de la variable var quand l'appel c de l'instruction pos du bloc b
+// est atteint : la constante rangée par la dernière écriture qui la précède
+// dans le bloc, sans écriture possible entre les deux. Retourne 0 si inconnue.
+static int valeurAvantAppel(const RI *ri, int b, int pos, int c, int var, Cellule *x)
+{
+    int trouve = 0;
+    if (ecritAvant(ri, ri->blocs[b].instrs[pos], c, var, &trouve))
+        return 0;
+    for (int k = pos - 1; k >= 0; k--)
+    {
+        int w = ri->blocs[b].instrs[k];
+        if (definitVar(ri, w) && ri->valeurs[w].var == var && ri->valeurs[w].op != INN)
+        {
+            int d = RI_Op(ri, w, 0);
+            if (!estConstante(ri, d))
+                return 0;
+            *x = entierEvalue(ri->valeurs[d].arg);
+            if (ri->valeurs[d].op == LDF)
+                x->t = TYPE_REAL;
+            return 1;
+        }
+        if (ecritVariable(ri, w, var))
+            return 0;
+    }
+    return 0;
+}
+
+// Tente d'évaluer l'appel c (fonction pure) de l'instruction pos du bloc b
+static int replierAppel(RI *ri, Evaluateur *ev, int b, int pos, int c)
+{
+    int n = ri->valeurs[c].nOps;
+    Cellule args[RI_MAX_LOCAUX];
+    if (n > RI_MAX_LOCAUX)
+        return 0;
+    // Les valeurs passées par adresse sont placées au bas de la pile de
+    // l'évaluateur, les arguments au-dessus
+    ev->sp = 0;
+    for (int k = 0; k < n; k++)
+    {
+        int a = RI_Op(ri, c, k);
+        const RI_Valeur *arg = &ri->valeurs[a];
+        if (k == 0)
+        {
+            // Case du résultat : une valeur, en général LDI 0
+            if (!estConstante(ri, a))
+                return 0;
+            args[0] = entierEvalue(arg->arg);
+            if (arg->op == LDF)
+                args[0].t = TYPE_REAL;
+            continue;
+        }
+        int var = -1;
+        if (arg->op == LDA && arg->arg >= 0)
+            var = arg->arg;
+        else if (arg->op == LLA && RI_CASE_SUIVIE(arg->arg))
+            var = RI_VAR_LOCALE(arg->arg);
+        if (var < 0 || !valeurAvantAppel(ri, b, pos, c, var, &ev->pile[ev->sp]))
+            return 0;
+        args[k] = entierEvalue(TAILLEMEM + ev->sp++);
+    }
+
+    memcpy(&ev->pile[ev->sp], args, (size_t)n * sizeof(Cellule));
+    ev->sp += n;
+    memset(ev->glob, 0, sizeof(ev->glob));
+    ev->pas = PAS_EVALUATION;
+    ev->echec = 0;
+    Cellule r = executerAppel(ev, ri->valeurs[c].arg, n);
+    if (ev->echec || !r.connue)
+        return 0;
+    if (r.t == TYPE_REAL)
+    {
+        int bits;
+        memcpy(&bits, &r.v.f, sizeof(float));
+        RI_DevenirConstante(ri, c, LDF, bits);
+    }
+    else
+    {
+        RI_DevenirConstante(ri, c, LDI, r.v.i);
+    }
+    return 1;
+}
+
+// Replie les appels purs d'un arbre, les plus profonds d'abord
+static int replierArbre(RI *ri, Evaluateur *ev, const char *pure, int b, int pos, int v)
+{
+    int modifs = 0;
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+        modifs += replierArbre(ri, ev, pure, b, pos, RI_Op(ri, v, k));
+    if (ri->valeurs[v].op == CALL && pure[ri->valeurs[v].arg])
+        modifs += replierAppel(ri, ev, b, pos, v);
+    return modifs;
+}
+
+static int replierAppelsPurs(RI *ri)
+{
+    RI_CalculerEffets(ri);
+    char *pure = fonctionsPures(ri);
+    int aucune = 1;
+    for (int q = 1; q < ri->nProcs && aucune; q++)
+        aucune = !pure[q];
+    if (aucune)
+    {
+        free(pure);
+        return 0;
+    }
+
+    Evaluateur *ev = malloc(sizeof(Evaluateur));
+    ev->ri = ri;
+    int modifs = 0;
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        if (ri->blocs[b].proc < 0)
+            continue;
+        for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+            modifs += replierArbre(ri, ev, pure, b, k, ri->blocs[b].instrs[k]);
+    }
+    free(ev);
+    free(pure);
+    return modifs;
+}
+
+// ---------------------------------------------------------------------
+// Spécialisation (clonage). Un appel dont certains arguments sont connus
+// (constantes rangées juste avant l'appel, comme pour les appels purs) est
+// redirigé vers un clone de l'appelée où la lecture de ces paramètres est
+// remplacée par leur valeur : les autres passes replient ensuite les
+// conditions et les calculs qui en dépendent. L'appel garde ses arguments.
+// Les appels d'un même clone (même appelée, mêmes valeurs) le partagent, et
+// un appel récursif qui retransmet les paramètres connus reste dans le clone.
+// Seules les procédures qui n'écrivent jamais par leurs paramètres sont
+// clonées. La croissance totale du code est bornée par -clone=<n>.
+// ---------------------------------------------------------------------
+
+// Croissance maximale du code due aux clones (-clone=<n>, 0 : pas de spécialisation)
+ETAT_PAR_FIL int SEUIL_SPECIALISATION = 64;
+
+#define MAX_CLONES 16  // Moins de 100 : le nom d'un clone finit par "#nn"
+
+typedef struct {
+    int  origine;                 // Procédure clonée
+    int  proc;                    // Clone
+    char connu[RI_MAX_LOCAUX];    // L'argument k est remplacé par une constante
+    int  valeur[RI_MAX_LOCAUX];   // Constante (LDI, ou bits de LDF)
+    char reel[RI_MAX_LOCAUX];     // La constante est réelle (LDF)
+} Clone;
+
+static ETAT_PAR_FIL Clone clones[MAX_CLONES];
+static ETAT_PAR_FIL int   nClones = 0;
+static ETAT_PAR_FIL int   croissanceClones = 0; // Instructions ajoutées par les clones
+
+// Paramètres de la procédure q, indexés par argument
+typedef struct {
+    int  nArgs;
+    int  premier;                 // Premier argument qui est un paramètre (1 pour une fonction)
+    char lu[RI_MAX_LOCAUX];       // Le paramètre est lu (LDV)
+    char exclu[RI_MAX_LOCAUX];    // Son adresse sert à autre chose : pas de spécialisation
+} Parametres;
+
+// Argument dont la case (décalage k par rapport à BP) est celle d'un paramètre, ou -1
+static int argumentDeCase(const Parametres *pa, int k)
+{
+    for (int a = pa->premier; a < pa->nArgs; a++)
+    {
+        if (CASE_ARGUMENT(a, pa->nArgs) == k)
+            return a;
+    }
+    return -1;
+}
+
+// Examine les utilisations des paramètres dans un arbre de q. Retourne 0 si
+// q peut écrire par un paramètre (STO_IND, INN indirect).
+static int examinerParametres(const RI *ri, int q, int v, int parent, int rang, Parametres *pa)
+{
+    const RI_Valeur *val = &ri->valeurs[v];
+    if (val->op == STO_IND || (val->op == INN && val->var < 0))
+        return 0;
+    if (val->op == LDL || val->op == STL || val->op == LLA)
+    {
+        int a = argumentDeCase(pa, val->arg);
+        if (a >= 0)
+        {
+            if (val->op == LDL && parent >= 0 && ri->valeurs[parent].op == LDV)
+                pa->lu[a] = 1;
+            else if (!(val->op == LDL && parent >= 0 && ri->valeurs[parent].op == CALL &&
+                       ri->valeurs[parent].arg == q && rang == a))
+                pa->exclu[a] = 1; // Seul un appel récursif peut retransmettre le paramètre
+        }
+    }
+    for (int k = 0; k < val->nOps; k++)
+    {
+        if (!examinerParametres(ri, q, RI_Op(ri, v, k), v, k, pa))
+            return 0;
+    }
+    return 1;
+}
+
+// Analyse les paramètres de q et retourne la taille de son corps, ou 0 si elle
+// ne peut pas être clonée
+static int analyserParametres(const RI *ri, int q, Parametres *pa)
+{
+    int idf = ri->procs[q].idf;
+    memset(pa, 0, sizeof(*pa));
+    if (idf < 0 || ri->procs[q].entree < 0)
+        return 0;
+    pa->nArgs = getArgCount(idf);
+    pa->premier = (TAB_IDFS[idf].TIDF == TFUNC) ? 1 : 0;
+    if (pa->nArgs > RI_MAX_LOCAUX || pa->premier >= pa->nArgs)
+        return 0;
+    int corps = 0;
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        if (ri->blocs[b].proc != q)
+            continue;
+        for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+        {
+            int v = ri->blocs[b].instrs[k];
+            if (!examinerParametres(ri, q, v, -1, 0, pa))
+                return 0;
+            corps += taille(ri, v);
+        }
+    }
+    return corps;
+}
+
+typedef struct {
+    RI          *ri;
+    const Clone *cl;
+    const int   *copie;   // Bloc copié de chaque bloc de l'origine (-1 sinon)
+    int          nArgs;
+} Clonage;
+
+// Indique si l'appel v retransmet à l'origine tous les paramètres connus du clone
+static int retransmetConnus(const Clonage *c, int v)
+{
+    const RI *ri = c->ri;
+    if (ri->valeurs[v].op != CALL || ri->valeurs[v].arg != c->cl->origine)
+        return 0;
+    for (int a = 0; a < c->nArgs; a++)
+    {
+        int x = RI_Op(ri, v, a);
+        if (c->cl->connu[a] && (ri->valeurs[x].op != LDL || ri->valeurs[x].arg != CASE_ARGUMENT(a, c->nArgs)))
+            return 0;
+    }
+    return 1;
+}
+
+// Copie un arbre de l'origine dans le clone
+static int copierClone(const Clonage *c, int v)
+{
+    RI *ri = c->ri;
+    Mnemoniques op = ri->valeurs[v].op;
+    int arg = ri->valeurs[v].arg;
+    int nOps = ri->valeurs[v].nOps;
+    if (op == LDV && ri->valeurs[RI_Op(ri, v, 0)].op == LDL)
+    {
+        // Lecture d'un paramètre connu : sa valeur
+        int k = ri->valeurs[RI_Op(ri, v, 0)].arg;
+        for (int a = 0; a < c->nArgs; a++)
+        {
+            if (c->cl->connu[a] && CASE_ARGUMENT(a, c->nArgs) == k)
+                return RI_NouvelleValeur(ri, c->cl->reel[a] ? LDF : LDI, c->cl->valeur[a], NULL, 0);
+        }
+    }
+    if (RI_EstBranchement(op))
+        arg = c->copie[arg];
+    else if (retransmetConnus(c, v))
+        arg = c->cl->proc;
+    int *ops = malloc((size_t)(nOps > 0 ? nOps : 1) * sizeof(int));
+    for (int k = 0; k < nOps; k++)
+        ops[k] = copierClone(c, RI_Op(ri, v, k));
+    int w = RI_NouvelleValeur(ri, op, arg, ops, nOps);
+    free(ops);
+    return w;
+}
+
+// Crée le clone cl->proc de cl->origine
+static void creerClone(RI *ri, Clone *cl)
+{
+    int q = cl->origine;
+    int idf = ri->procs[q].idf;
+    char nom[sizeof(TAB_IDFS[idf].Nom)];
+    // nClones <= MAX_CLONES < 100 : deux chiffres au plus après le '#'
+    snprintf(nom, sizeof(nom), "%.24s#%u", TAB_IDFS[idf].Nom, (unsigned)nClones % 100);
+    int nouv = NBR_IDFS++;
+    TAB_IDFS[nouv] = TAB_IDFS[idf];
+    strcpy(TAB_IDFS[nouv].Nom, nom);
+    cl->proc = ri->nProcs++;
+    ri->procs[cl->proc].idf = nouv;
+
+    int nb = ri->nBlocs;
+    int *copie = malloc((size_t)nb * sizeof(int));
+    for (int b = 0; b < nb; b++)
+        copie[b] = (ri->blocs[b].proc == q) ? RI_NouveauBloc(ri, cl->proc, -1) : -1;
+    Clonage c = {ri, cl, copie, getArgCount(idf)};
+    for (int b = 0; b < nb; b++)
+    {
+        if (copie[b] < 0)
+            continue;
+        for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+        {
+            int w = copierClone(&c, ri->blocs[b].instrs[k]);
+            RI_InsererInstr(ri, copie[b], k, w);
+        }
+        RI_Bloc *dst = &ri->blocs[copie[b]];
+        dst->nSucc = ri->blocs[b].nSucc;
+        for (int s = 0; s < dst->nSucc; s++)
+            dst->succ[s] = copie[ri->blocs[b].succ[s]];
+        dst->deroule = ri->blocs[b].deroule;
+    }
+    ri->procs[cl->proc].entree = copie[ri->procs[q].entree];
+    free(copie);
+}
+
+// Clone existant de q pour ces constantes, ou -1
+static int chercherClone(int q, const Clone *cle, int nArgs)
+{
+    for (int i = 0; i < nClones; i++)
+    {
+        const Clone *cl = &clones[i];
+        int pareil = cl->origine == q;
+        for (int a = 0; a < nArgs && pareil; a++)
+        {
+            pareil = cl->connu[a] == cle->connu[a] &&
+                     (!cl->connu[a] || (cl->valeur[a] == cle->valeur[a] && cl->reel[a] == cle->reel[a]));
+        }
+        if (pareil)
+            return i;
+    }
+    return -1;
+}
+
+// Indique si p est un clone
+static int estClone(int p)
+{
+    for (int i = 0; i < nClones; i++)
+    {
+        if (clones[i].proc == p)
+            return 1;
+    }
+    return 0;
+}
+
+// Tente de rediriger l'appel c de l'instruction pos du bloc b vers un clone
+static int specialiserAppel(RI *ri, int b, int pos, int c)
+{
+    int q = ri->valeurs[c].arg;
+    if (q <= 0 || estClone(q))
+        return 0;
+    Parametres pa;
+    int corps = analyserParametres(ri, q, &pa);
+    if (corps <= 0)
+        return 0;
+
+    Clone cle;
+    memset(&cle, 0, sizeof(cle));
+    int connus = 0;
+    for (int a = pa.premier; a < pa.nArgs; a++)
+    {
+        if (!pa.lu[a] || pa.exclu[a])
+            continue;
+        int x = RI_Op(ri, c, a);
+        int var = -1;
+        if (ri->valeurs[x].op == LDA && ri->valeurs[x].arg >= 0 &&
+            !ri->ecritTout[q] && !ri->ecrit[q * TAILLEMEM + ri->valeurs[x].arg])
+            var = ri->valeurs[x].arg; // Globale que l'appelée n'écrit pas par son nom
+        else if (ri->valeurs[x].op == LLA && RI_CASE_SUIVIE(ri->valeurs[x].arg))
+            var = RI_VAR_LOCALE(ri->valeurs[x].arg);
+        Cellule val;
+        if (var < 0 || !valeurAvantAppel(ri, b, pos, c, var, &val))
+            continue;
+        cle.connu[a] = 1;
+        cle.reel[a] = (val.t == TYPE_REAL);
+        if (cle.reel[a])
+            memcpy(&cle.valeur[a], &val.v.f, sizeof(float));
+        else
+            cle.valeur[a] = val.v.i;
+        connus++;
+    }
+    if (connus == 0)
+        return 0;
+
+    int i = chercherClone(q, &cle, pa.nArgs);
+    if (i < 0)
+    {
+        if (nClones >= MAX_CLONES || ri->nProcs >= RI_MAX_PROCS || NBR_IDFS >= TAILLEIDFS ||
+            croissanceClones + corps > SEUIL_SPECIALISATION ||
+            tailleProgramme(ri) + corps > TAILLE_PROGRAMME_DEROULAGE)
+            return 0;
+        i = nClones++;
+        clones[i] = cle;
+        clones[i].origine = q;
+        creerClone(ri, &clones[i]);
+        croissanceClones += corps;
+    }
+    ri->valeurs[c].arg = clones[i].proc;
+    return 1;
+}
+
+// Spécialise les appels d'un arbre, en ordre d'évaluation
+static int specialiserArbre(RI *ri, int b, int pos, int v)
+{
+    int modifs = 0;
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+        modifs += specialiserArbre(ri, b, pos, RI_Op(ri, v, k));
+    if (ri->valeurs[v].op == CALL)
+        modifs += specialiserAppel(ri, b, pos, v);
+    return modifs;
+}
+
+static int specialiserProcedures(RI *ri)
+{
+    if (SEUIL_SPECIALISATION <= 0)
+        return 0;
+    RI_CalculerEffets(ri);
+    int modifs = 0;
+    int nb = ri->nBlocs; // Les blocs des clones créés ici ne sont pas reparcourus
+    for (int b = 0; b < nb; b++)
+    {
+        if (ri->blocs[b].proc < 0)
+            continue;
+        for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+        {
+            int n = specialiserArbre(ri, b, k, ri->blocs[b].instrs[k]);
+            if (n > 0)
+                RI_CalculerEffets(ri); // Nouveau clone : graphe d'appels et effets
+            modifs += n;
+        }
+    }
+    if (modifs > 0)
+        RI_CalculerPreds(ri);
+    return modifs;
+}
+
+// ---------------------------------------------------------------------
+// Mémoïsation (-memo). Une fonction pure et récursive reçoit en tête de son
+// code l'instruction MEMO n (n arguments, résultat compris) : l'interpréteur
+// garde alors un cache de ses résultats, indexé par la valeur des arguments,
+// qu'il consulte à chaque CALL avant de construire le cadre. La pureté est
+// celle du repli des appels purs : le résultat ne dépend que des arguments.
+// ---------------------------------------------------------------------
+
+// Si non nul, les fonctions pures récursives sont mémoïsées (-memo)
+ETAT_PAR_FIL int MEMOISATION = 0;
+
+// Indique si la procédure q peut s'appeler elle-même, directement ou non (effets à jour)
+static int estRecursive(const RI *ri, int q)
+{
+    int np = ri->nProcs;
+    char *vu = calloc((size_t)np, 1);
+    int *pile = malloc((size_t)np * sizeof(int));
+    int n = 0, trouve = 0;
+    pile[n++] = q;
+    while (n > 0 && !trouve)
+    {
+        int p = pile[--n];
+        for (int r = 0; r < np; r++)
+        {
+            if (!ri->appelle[p * np + r] || vu[r])
+                continue;
+            if (r == q)
+                trouve = 1;
+            vu[r] = 1;
+            pile[n++] = r;
+        }
+    }
+    free(vu);
+    free(pile);
+    return trouve;
+}
+
+// Place MEMO en tête des fonctions pures récursives. Retourne leur nombre.
+static int marquerMemoisation(RI *ri)
+{
+    if (!MEMOISATION)
+        return 0;
+    RI_CalculerEffets(ri);
+    char *pure = fonctionsPures(ri);
+    int marquees = 0;
+    for (int q = 1; q < ri->nProcs; q++)
+    {
+        if (!pure[q] || !estRecursive(ri, q))
+            continue;
+        int v = RI_NouvelleValeur(ri, MEMO, getArgCount(ri->procs[q].idf), NULL, 0);
+        RI_InsererInstr(ri, ri->procs[q].entree, 0, v);
+        marquees++;
+    }
+    free(pure);
+    return marquees;
+}
+
+// ---------------------------------------------------------------------
+// Décalages : une multiplication ou une division par la constante entière
+// 2^k devient SHL k ou SHR k, une instruction de moins. SHR arrondit vers
+// zéro comme DIVI et un réel reste calculé en float. Cette réécriture est
+// faite après le pipeline : les autres passes ne voient que MUL et DIVI.
+// ---------------------------------------------------------------------
+
+// Exposant k si la valeur est la constante entière 2^k (1 <= k <= 30), 0 sinon
+static int exposantDeDeux(const RI *ri, int v)
+{
+    if (ri->valeurs[v].op != LDI)
+        return 0;
+    for (int k = 1; k <= 30; k++)
+    {
+        if (ri->valeurs[v].arg == (1 << k))
+            return k;
+    }
+    return 0;
+}
+
+// Remplace les MUL et DIVI par 2^k de l'arbre v par SHL et SHR
+static void decalerArbre(RI *ri, int v, int *modifs)
+{
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+        decalerArbre(ri, RI_Op(ri, v, k), modifs);
+    Mnemoniques op = ri->valeurs[v].op;
+    if (op != MUL && op != DIVI)
+        return;
+    int x = RI_Op(ri, v, 0);
+    int k = exposantDeDeux(ri, RI_Op(ri, v, 1));
+    if (k == 0 && op == MUL)
+    {
+        // 2^k * x : la constante n'a pas d'effet, l'ordre d'évaluation n'importe pas
+        k = exposantDeDeux(ri, x);
+        x = RI_Op(ri, v, 1);
+    }
+    if (k == 0)
+        return;
+    RI_ChangerOp(ri, v, 0, x);
+    ri->valeurs[v].op = (op == MUL) ? SHL : SHR;
+    ri->valeurs[v].arg = k;
+    ri->valeurs[v].nOps = 1;
+    (*modifs)++;
+}
+
+// Seuls les arbres du code vivant sont réécrits : une valeur morte peut
+// encore partager un noeud avec eux
+static int remplacerParDecalages(RI *ri)
+{
+    int modifs = 0;
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        if (ri->blocs[b].proc < 0)
+            continue;
+        for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+            decalerArbre(ri, ri->blocs[b].instrs[k], &modifs);
+    }
+    return modifs;
+}
+
+// ---------------------------------------------------------------------
+// Ordre d'évaluation (Sethi-Ullman). Une machine à pile évalue les opérandes
+// dans l'ordre : pour x - y * z, x reste sur la pile pendant le produit et il
+// faut trois cases. Le besoin d'un arbre est le nombre de cases qu'il occupe
+// au plus ; l'opérande qui en demande le plus est évalué en premier, si les
+// deux opérandes sont purs (l'ordre de leurs lectures n'importe pas). ADD,
+// MUL, EQL et NEQ sont commutatifs ; SUB et DIVI deviennent SUBR et DIVR, une
+// comparaison ou un branchement prend la relation inverse (< devient >).
+// Passe finale, comme les décalages : les autres passes ne voient pas SUBR.
+// ---------------------------------------------------------------------
+
+// Opération qui donne le même résultat avec les deux opérandes échangés, ou -1
+static int operationInversee(Mnemoniques op)
+{
+    switch (op)
+    {
+    case ADD: case MUL: case EQL: case NEQ: case BEQ: case BNE:
+        return op;
+    case SUB:  return SUBR;
+    case SUBR: return SUB;
+    case DIVI: return DIVR;
+    case DIVR: return DIVI;
+    case GTR:  return LSS;
+    case LSS:  return GTR;
+    case GEQ:  return LEQ;
+    case LEQ:  return GEQ;
+    case BGT:  return BLT;
+    case BLT:  return BGT;
+    case BGE:  return BLE;
+    case BLE:  return BGE;
+    default:   return -1;
+    }
+}
+
+// Ordonne les opérandes de l'arbre v et retourne son besoin en cases de pile
+static int ordonnerArbre(RI *ri, int v, int *modifs)
+{
+    int nOps = ri->valeurs[v].nOps;
+    int besoin = 1;
+    int besoins[2] = {0, 0};
+    for (int k = 0; k < nOps; k++)
+    {
+        int b = ordonnerArbre(ri, RI_Op(ri, v, k), modifs);
+        if (k < 2)
+            besoins[k] = b;
+        if (k + b > besoin)
+            besoin = k + b; // Les k opérandes précédents sont encore sur la pile
+    }
+    int inverse = operationInversee(ri->valeurs[v].op);
+    if (nOps == 2 && inverse >= 0 && besoins[1] > besoins[0] &&
+        estPur(ri, RI_Op(ri, v, 0)) && estPur(ri, RI_Op(ri, v, 1)))
+    {
+        int a = RI_Op(ri, v, 0);
+        RI_ChangerOp(ri, v, 0, RI_Op(ri, v, 1));
+        RI_ChangerOp(ri, v, 1, a);
+        ri->valeurs[v].op = (Mnemoniques)inverse;
+        besoin = (besoins[0] + 1 > besoins[1]) ? besoins[0] + 1 : besoins[1];
+        (*modifs)++;
+    }
+    return besoin;
+}
+
+static int ordonnerOperandes(RI *ri)
+{
+    int modifs = 0;
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        if (ri->blocs[b].proc < 0)
+            continue;
+        for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+            ordonnerArbre(ri, ri->blocs[b].instrs[k], &modifs);
+    }
+    return modifs;
+}
+
+// ---------------------------------------------------------------------
+// Pipelines de passes par niveau
+// ---------------------------------------------------------------------
+
+static const Passe PIPELINE_O1[] = {
+    {"repli-constantes",     repliConstantes},
+    {"appels-purs",          replierAppelsPurs},
+    {"conditions-constantes", simplifierConditions},
+    {"simplification-sauts", simplifierSauts},
+    {"blocs-inaccessibles",  supprimerInaccessibles},
+    {"procedures-mortes",    eliminerProceduresMortes},
+    {"compactage-globales",  compacterGlobales},
+    {NULL, NULL}
+};
+
+static const Passe PIPELINE_O2[] = {
+    {"specialisation",       specialiserProcedures},
+    {"integration",          integrerProcedures},
+    {"repli-constantes",     repliConstantes},
+    {"appels-purs",          replierAppelsPurs},
+    {"conditions-constantes", simplifierConditions},
+    {"sous-expressions",     eliminerSousExpressions},
+    {"invariants-boucles",   sortirInvariantsBoucles},
+    {"variables-induction",  reduireInductions},
+    {"deroulage-boucles",    deroulerBoucles},
+    {"ecritures-mortes",     eliminerEcrituresMortes},
+    {"simplification-sauts", simplifierSauts},
+    {"blocs-inaccessibles",  supprimerInaccessibles},
+    {"procedures-mortes",    eliminerProceduresMortes},
+    {"compactage-globales",  compacterGlobales},
+    {NULL, NULL}
+};
+
+// Nombre maximal de tours du pipeline -O2
+#define TOURS_MAX_O2 4
+
+void Optimiser()
+{
+    if (NIVEAU_OPTIM <= 0 && !MEMOISATION)
+        return; // -O0 : aucune représentation intermédiaire, compilation en une passe
+
+    RI *ri = RI_Construire();
+    if (!ri)
+    {
+        Informer("Optimisation skipped: unsupported P-code shape\n");
+        return;
+    }
+
+    // Une erreur (code trop long après abaissement...) libère la RI avant
+    // d'être relayée au point de reprise englobant
+    jmp_buf reprise;
+    jmp_buf *englobante = REPRISE_ERREUR;
+    REPRISE_ERREUR = &reprise;
+    if (setjmp(reprise) != 0)
+    {
+        REPRISE_ERREUR = englobante;
+        RI_Liberer(ri);
+        RelayerErreur(MESSAGE_ERREUR);
+    }
+
+    int avant = PC + 1;
+    int globalesAvant = OFFSET - VAR_BASE;
+    nClones = 0;
+    croissanceClones = 0;
+    const Passe *pipeline = (NIVEAU_OPTIM >= 2) ? PIPELINE_O2 : PIPELINE_O1;
+    int tours = (NIVEAU_OPTIM >= 2) ? TOURS_MAX_O2 : (NIVEAU_OPTIM == 1) ? 1 : 0;
+    for (int tour = 0; tour < tours; tour++)
+    {
+        int total = 0;
+        for (const Passe *p = pipeline; p->nom; p++)
+        {
+            int n = p->executer(ri);
+            if (n > 0)
+                RI_Invalider(ri);
+            total += n;
+        }
+        if (total == 0)
+            break; // Point fixe atteint
+    }
+    if (NIVEAU_OPTIM > 0)
+    {
+        remplacerParDecalages(ri);
+        ordonnerOperandes(ri);
+    }
+    marquerMemoisation(ri);
+
+    if (AFFICHER_RI)
+    {
+        RI_ConstruireSSA(ri);
+        RI_Afficher(ri);
+    }
+    RI_Abaisser(ri);
+    REPRISE_ERREUR = englobante;
+    RI_Liberer(ri);
+    Informer("Optimisation -O%d: %d -> %d instructions, %d -> %d globals\n",
+           NIVEAU_OPTIM, avant, PC + 1, globalesAvant, OFFSET - VAR_BASE);
+}
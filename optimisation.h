@@ -0,0 +1,36 @@
+#ifndef OPTIMISATION_H
+#define OPTIMISATION_H
+
+#include "global.h"  // Définitions globales (PCODE, PC, etc.)
+
+// Niveau d'optimisation choisi avec -O0, -O1 ou -O2 (0 par défaut)
+// -O0 : le P-code produit par l'analyse syntaxique est gardé tel quel (aucune RI)
+// -O1 : passes locales rapides sur la représentation intermédiaire
+// -O2 : pipeline complet, répété tant qu'il modifie le programme
+extern ETAT_PAR_FIL int NIVEAU_OPTIM;
+
+// Croissance maximale du code acceptée pour intégrer un appel à -O2 (-inline=<n>,
+// 8 par défaut, 0 désactive l'intégration). Une procédure appelée une seule
+// fois est intégrée quelle que soit sa taille.
+extern ETAT_PAR_FIL int SEUIL_INLINE;
+
+// Facteur de déroulage des boucles for à -O2 (-unroll=<n>, 4 par défaut,
+// 1 ou moins désactive le déroulage)
+extern ETAT_PAR_FIL int FACTEUR_DEROULAGE;
+
+// Nombre maximal d'instructions ajoutées par les clones spécialisés à -O2
+// (-clone=<n>, 64 par défaut, 0 désactive la spécialisation)
+extern ETAT_PAR_FIL int SEUIL_SPECIALISATION;
+
+// Si non nul, les fonctions pures récursives sont mémoïsées à l'exécution (-memo,
+// à tout niveau : à -O0 la RI est construite sans exécuter de passe)
+extern ETAT_PAR_FIL int MEMOISATION;
+
+// Si non nul, affiche la représentation intermédiaire après optimisation (-ri)
+extern ETAT_PAR_FIL int AFFICHER_RI;
+
+// Construit la représentation intermédiaire à partir de PCODE, exécute le
+// pipeline de passes du niveau choisi puis réécrit PCODE (abaissement)
+void Optimiser();
+
+#endif
@@ -0,0 +1,1463 @@
+#include "representation_intermediaire.h"
+#include "generation_pcode.h"
+#include "semantique.h"
+
+// ---------------------------------------------------------------------
+// Outils de gestion des tableaux dynamiques
+// ---------------------------------------------------------------------
+
+// Agrandit un tableau dynamique pour qu'il puisse contenir 'besoin' éléments
+static void *agrandir(void *tab, int *cap, int besoin, size_t taille)
+{
+    if (besoin <= *cap)
+        return tab;
+    int nouv = (*cap < 16) ? 16 : *cap;
+    while (nouv < besoin)
+        nouv *= 2;
+    tab = realloc(tab, (size_t)nouv * taille);
+    if (!tab)
+        Error("Out of memory (IR)");
+    *cap = nouv;
+    return tab;
+}
+
+// ---------------------------------------------------------------------
+// Effet des instructions sur la pile
+// ---------------------------------------------------------------------
+
+// Nombre de valeurs dépilées (CALL et RET sont traités à part)
+static int nbDepiles(Mnemoniques op)
+{
+    switch (op)
+    {
+    case ADD: case SUB: case MUL: case DIVI: case SUBR: case DIVR:
+    case EQL: case NEQ: case GTR: case LSS: case GEQ: case LEQ:
+    case STO_IND:
+    case BEQ: case BNE: case BLT: case BLE: case BGT: case BGE:
+        return 2;
+    case PRN: case INN: case LDV: case STO: case BZE: case STL:
+    case STO_KEEP: case SHL: case SHR:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+// Indique si l'instruction empile un résultat
+static int empile(Mnemoniques op)
+{
+    switch (op)
+    {
+    case ADD: case SUB: case MUL: case DIVI: case SUBR: case DIVR:
+    case EQL: case NEQ: case GTR: case LSS: case GEQ: case LEQ:
+    case LDI: case LDA: case LDV: case LDL: case LDF: case LLA:
+    case CALL: case STO_KEEP: case SHL: case SHR:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+int RI_EstBranchement(Mnemoniques op)
+{
+    return op == BRN || RI_EstConditionnel(op);
+}
+
+int RI_EstConditionnel(Mnemoniques op)
+{
+    return op == BZE || (op >= BEQ && op <= BGE);
+}
+
+// ---------------------------------------------------------------------
+// Valeurs
+// ---------------------------------------------------------------------
+
+// Détermine la variable lue ou écrite par la valeur v (-1 si aucune)
+static int variableDe(const RI *ri, int v)
+{
+    const RI_Valeur *val = &ri->valeurs[v];
+    switch (val->op)
+    {
+    case LDV:
+    {
+        int a = RI_Op(ri, v, 0);
+        return (ri->valeurs[a].op == LDA) ? ri->valeurs[a].arg : -1;
+    }
+    case INN:
+    {
+        int a = RI_Op(ri, v, 0);
+        if (ri->valeurs[a].op == LLA)
+            return RI_CASE_SUIVIE(ri->valeurs[a].arg) ? RI_VAR_LOCALE(ri->valeurs[a].arg) : -1;
+        return (ri->valeurs[a].op == LDI || ri->valeurs[a].op == LDA) ? ri->valeurs[a].arg : -1;
+    }
+    case STO:
+    case STO_KEEP:
+        return (val->arg >= 0) ? val->arg : -1;
+    case LDL:
+    case STL:
+        return RI_CASE_SUIVIE(val->arg) ? RI_VAR_LOCALE(val->arg) : -1;
+    default:
+        return -1;
+    }
+}
+
+int RI_NouvelleValeur(RI *ri, Mnemoniques op, int arg, const int *ops, int nOps)
+{
+    ri->valeurs = agrandir(ri->valeurs, &ri->capValeurs, ri->nValeurs + 1, sizeof(RI_Valeur));
+    ri->operandes = agrandir(ri->operandes, &ri->capOperandes, ri->nOperandes + nOps, sizeof(int));
+    int v = ri->nValeurs++;
+    RI_Valeur *val = &ri->valeurs[v];
+    val->op = op;
+    val->arg = arg;
+    val->premierOp = ri->nOperandes;
+    val->nOps = nOps;
+    val->version = -1;
+    for (int k = 0; k < nOps; k++)
+        ri->operandes[ri->nOperandes++] = ops[k];
+    val->var = variableDe(ri, v);
+    return v;
+}
+
+int RI_Op(const RI *ri, int v, int k)
+{
+    return ri->operandes[ri->valeurs[v].premierOp + k];
+}
+
+void RI_ChangerOp(RI *ri, int v, int k, int nouv)
+{
+    ri->operandes[ri->valeurs[v].premierOp + k] = nouv;
+    ri->valeurs[v].var = variableDe(ri, v);
+}
+
+void RI_DevenirConstante(RI *ri, int v, Mnemoniques op, int arg)
+{
+    RI_Valeur *val = &ri->valeurs[v];
+    val->op = op;
+    val->arg = arg;
+    val->nOps = 0;
+    val->var = -1;
+    val->version = -1;
+}
+
+void RI_DevenirCopie(RI *ri, int v, int x)
+{
+    int nOps = ri->valeurs[x].nOps;
+    ri->operandes = agrandir(ri->operandes, &ri->capOperandes, ri->nOperandes + nOps, sizeof(int));
+    int premier = ri->nOperandes;
+    for (int k = 0; k < nOps; k++)
+        ri->operandes[ri->nOperandes++] = ri->operandes[ri->valeurs[x].premierOp + k];
+    ri->valeurs[v] = ri->valeurs[x];
+    ri->valeurs[v].premierOp = premier;
+}
+
+// ---------------------------------------------------------------------
+// Blocs
+// ---------------------------------------------------------------------
+
+int RI_NouveauBloc(RI *ri, int proc, int avant)
+{
+    ri->blocs = agrandir(ri->blocs, &ri->capBlocs, ri->nBlocs + 1, sizeof(RI_Bloc));
+    int b = ri->nBlocs++;
+    memset(&ri->blocs[b], 0, sizeof(RI_Bloc));
+    ri->blocs[b].proc = proc;
+    ri->blocs[b].adresse = -1;
+    ri->blocs[b].idom = -1;
+    ri->blocs[b].rpo = -1;
+
+    // Place le bloc dans la disposition
+    ri->ordre = realloc(ri->ordre, (size_t)ri->nBlocs * sizeof(int));
+    int pos = ri->nOrdre;
+    for (int i = 0; avant >= 0 && i < ri->nOrdre; i++)
+    {
+        if (ri->ordre[i] == avant)
+        {
+            pos = i;
+            break;
+        }
+    }
+    memmove(&ri->ordre[pos + 1], &ri->ordre[pos], (size_t)(ri->nOrdre - pos) * sizeof(int));
+    ri->ordre[pos] = b;
+    ri->nOrdre++;
+    return b;
+}
+
+void RI_InsererInstr(RI *ri, int b, int pos, int v)
+{
+    RI_Bloc *bl = &ri->blocs[b];
+    bl->instrs = agrandir(bl->instrs, &bl->capInstrs, bl->nInstrs + 1, sizeof(int));
+    memmove(&bl->instrs[pos + 1], &bl->instrs[pos], (size_t)(bl->nInstrs - pos) * sizeof(int));
+    bl->instrs[pos] = v;
+    bl->nInstrs++;
+}
+
+void RI_RetirerInstr(RI *ri, int b, int pos)
+{
+    RI_Bloc *bl = &ri->blocs[b];
+    memmove(&bl->instrs[pos], &bl->instrs[pos + 1], (size_t)(bl->nInstrs - pos - 1) * sizeof(int));
+    bl->nInstrs--;
+}
+
+int RI_Terminateur(const RI *ri, int b)
+{
+    const RI_Bloc *bl = &ri->blocs[b];
+    if (bl->nInstrs == 0)
+        return -1;
+    int v = bl->instrs[bl->nInstrs - 1];
+    Mnemoniques op = ri->valeurs[v].op;
+    return (RI_EstBranchement(op) || op == RET || op == HLT) ? v : -1;
+}
+
+void RI_Invalider(RI *ri)
+{
+    ri->ssaValide = 0;
+}
+
+// ---------------------------------------------------------------------
+// Construction de la RI à partir du P-code
+// ---------------------------------------------------------------------
+
+// Abandonne la construction : la RI partielle est libérée
+// Indique si un arbre contient un appel
+static int contientCall(const RI *ri, int v)
+{
+    if (ri->valeurs[v].op == CALL)
+        return 1;
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+    {
+        if (contientCall(ri, RI_Op(ri, v, k)))
+            return 1;
+    }
+    return 0;
+}
+
+// Indique si un arbre ne fait que des calculs sur des constantes et des
+// adresses : son évaluation peut être déplacée après un appel
+static int arbreDeplacable(const RI *ri, int v)
+{
+    switch (ri->valeurs[v].op)
+    {
+    case LDV: case LDL: case CALL: case STO_KEEP:
+        return 0;
+    default:
+        break;
+    }
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+    {
+        if (!arbreDeplacable(ri, RI_Op(ri, v, k)))
+            return 0;
+    }
+    return 1;
+}
+
+static RI *echec(RI *ri, void *a, void *b)
+{
+    free(a);
+    free(b);
+    RI_Liberer(ri);
+    return NULL;
+}
+
+RI *RI_Construire(void)
+{
+    int n = PC + 1;
+    if (n <= 0)
+        return NULL;
+
+    RI *ri = calloc(1, sizeof(RI));
+    char *chef = calloc((size_t)n + 1, 1);     // Début de bloc ?
+    int *blocDe = malloc((size_t)n * sizeof(int)); // Bloc de chaque adresse
+    if (!ri || !chef || !blocDe)
+        Error("Out of memory (IR)");
+    ri->premierTemp = OFFSET; // Les passes prennent leurs temporaires après les globales
+
+    // 1) Repère les débuts de blocs
+    chef[0] = 1;
+    for (int i = 0; i < n; i++)
+    {
+        Mnemoniques op = PCODE[i].MNE;
+        int s = PCODE[i].SUITE;
+        if (RI_EstBranchement(op) || op == CALL)
+        {
+            if (s < 0 || s >= n)
+                return echec(ri, chef, blocDe);
+            chef[s] = 1;
+        }
+        if (RI_EstBranchement(op) || op == RET || op == HLT)
+            chef[i + 1] = 1;
+    }
+    for (int i = 0; i < NBR_IDFS; i++)
+    {
+        if ((TAB_IDFS[i].TIDF == TPROC || TAB_IDFS[i].TIDF == TFUNC) &&
+            TAB_IDFS[i].Adresse >= 0 && TAB_IDFS[i].Adresse < n)
+            chef[TAB_IDFS[i].Adresse] = 1;
+    }
+
+    // 2) Crée les blocs
+    for (int i = 0; i < n; i++)
+    {
+        if (chef[i])
+        {
+            int b = RI_NouveauBloc(ri, -1, -1);
+            ri->blocs[b].adresse = i;
+        }
+        blocDe[i] = ri->nBlocs - 1;
+    }
+
+    // 3) Simule la pile de chaque bloc pour construire les arbres
+    int *pile = malloc((size_t)n * sizeof(int));
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        int debut = ri->blocs[b].adresse;
+        int fin = (b + 1 < ri->nBlocs) ? ri->blocs[b + 1].adresse : n;
+        int sp = 0;
+        for (int i = debut; i < fin; i++)
+        {
+            Mnemoniques op = PCODE[i].MNE;
+            int arg = PCODE[i].SUITE;
+            int v;
+            // "TAILCALL n ; BRN adresse" est un CALL suivi du RET : l'abaissement
+            // retrouve les appels terminaux. Le BRN ne crée pas d'arc dans le CFG.
+            int terminal = (op == TAILCALL);
+            if (terminal)
+            {
+                if (i + 1 >= fin || PCODE[i + 1].MNE != BRN)
+                {
+                    free(pile);
+                    return echec(ri, chef, blocDe);
+                }
+                op = CALL;
+                arg = PCODE[++i].SUITE;
+            }
+            if (op == CALL)
+            {
+                // Le nombre d'arguments est celui de l'appelée
+                int q = getProcFuncAtAddress(arg);
+                int nb = (q >= 0) ? getArgCount(q) : -1;
+                if (nb < 0 || sp < nb || (terminal && nb != PCODE[i - 1].SUITE))
+                {
+                    free(pile);
+                    return echec(ri, chef, blocDe);
+                }
+                sp -= nb;
+                v = RI_NouvelleValeur(ri, CALL, arg, &pile[sp], nb);
+                if (terminal)
+                {
+                    // Le résultat d'une fonction est rendu, celui d'une procédure ignoré
+                    if (sp != 0)
+                    {
+                        free(pile);
+                        return echec(ri, chef, blocDe);
+                    }
+                    if (TAB_IDFS[q].TIDF != TFUNC)
+                    {
+                        RI_InsererInstr(ri, b, ri->blocs[b].nInstrs,
+                                        RI_NouvelleValeur(ri, STO, -9999, &v, 1));
+                        v = RI_NouvelleValeur(ri, RET, nb, NULL, 0);
+                    }
+                    else
+                    {
+                        v = RI_NouvelleValeur(ri, RET, nb, &v, 1);
+                    }
+                    RI_InsererInstr(ri, b, ri->blocs[b].nInstrs, v);
+                    continue;
+                }
+            }
+            else if (op == RET)
+            {
+                // RET rend la valeur au sommet (résultat d'une fonction) s'il y en a une
+                if (sp > 1)
+                {
+                    free(pile);
+                    return echec(ri, chef, blocDe);
+                }
+                v = RI_NouvelleValeur(ri, RET, arg, pile, sp);
+                sp = 0;
+            }
+            else
+            {
+                int k = nbDepiles(op);
+                if (sp < k)
+                {
+                    free(pile);
+                    return echec(ri, chef, blocDe);
+                }
+                sp -= k;
+                if (RI_EstBranchement(op))
+                    arg = blocDe[arg];
+                v = RI_NouvelleValeur(ri, op, arg, &pile[sp], k);
+            }
+            if (empile(op))
+            {
+                pile[sp++] = v;
+                continue;
+            }
+            // Une instruction rangée pendant le calcul d'une expression (argument
+            // passé par valeur, STL dans une case réservée) est abaissée avant les
+            // valeurs en attente : si elle fait un appel, celles-ci ne doivent rien
+            // lire ni appeler
+            for (int j = 0; j < sp && contientCall(ri, v); j++)
+            {
+                if (!arbreDeplacable(ri, pile[j]))
+                {
+                    free(pile);
+                    return echec(ri, chef, blocDe);
+                }
+            }
+            RI_InsererInstr(ri, b, ri->blocs[b].nInstrs, v);
+        }
+        // La pile doit être vide à la fin de chaque bloc
+        if (sp != 0)
+        {
+            free(pile);
+            return echec(ri, chef, blocDe);
+        }
+    }
+    free(pile);
+
+    // 4) Successeurs
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        RI_Bloc *bl = &ri->blocs[b];
+        int t = RI_Terminateur(ri, b);
+        Mnemoniques op = (t >= 0) ? ri->valeurs[t].op : HLT;
+        if (t >= 0 && (op == RET || op == HLT))
+        {
+            bl->nSucc = 0;
+            continue;
+        }
+        if (t < 0 || RI_EstConditionnel(op))
+        {
+            // Suite en séquence : le bloc suivant doit exister
+            if (b + 1 >= ri->nBlocs)
+                return echec(ri, chef, blocDe);
+        }
+        if (t < 0)
+        {
+            bl->succ[0] = b + 1;
+            bl->nSucc = 1;
+        }
+        else if (op == BRN)
+        {
+            bl->succ[0] = ri->valeurs[t].arg;
+            bl->nSucc = 1;
+        }
+        else
+        {
+            bl->succ[0] = ri->valeurs[t].arg;
+            bl->succ[1] = b + 1;
+            bl->nSucc = 2;
+        }
+    }
+
+    // 5) Procédures : le programme principal commence à l'adresse 0
+    ri->procs[0].entree = 0;
+    ri->procs[0].idf = -1;
+    ri->nProcs = 1;
+    for (int i = 0; i < NBR_IDFS; i++)
+    {
+        if ((TAB_IDFS[i].TIDF == TPROC || TAB_IDFS[i].TIDF == TFUNC) &&
+            TAB_IDFS[i].Adresse >= 0 && TAB_IDFS[i].Adresse < n)
+        {
+            ri->procs[ri->nProcs].entree = blocDe[TAB_IDFS[i].Adresse];
+            ri->procs[ri->nProcs].idf = i;
+            ri->nProcs++;
+        }
+    }
+
+    // Les CALL désignent désormais une procédure de la RI
+    for (int v = 0; v < ri->nValeurs; v++)
+    {
+        if (ri->valeurs[v].op != CALL)
+            continue;
+        int cible = blocDe[ri->valeurs[v].arg];
+        int p;
+        for (p = 1; p < ri->nProcs && ri->procs[p].entree != cible; p++)
+            ;
+        if (p == ri->nProcs)
+            return echec(ri, chef, blocDe);
+        ri->valeurs[v].arg = p;
+    }
+
+    // Rattache chaque bloc accessible à sa procédure (parcours depuis l'entrée)
+    int *aVoir = malloc((size_t)ri->nBlocs * sizeof(int));
+    for (int p = 0; p < ri->nProcs; p++)
+    {
+        int nAVoir = 0;
+        if (ri->blocs[ri->procs[p].entree].proc < 0)
+        {
+            ri->blocs[ri->procs[p].entree].proc = p;
+            aVoir[nAVoir++] = ri->procs[p].entree;
+        }
+        while (nAVoir > 0)
+        {
+            int b = aVoir[--nAVoir];
+            for (int k = 0; k < ri->blocs[b].nSucc; k++)
+            {
+                int s = ri->blocs[b].succ[k];
+                if (ri->blocs[s].proc < 0)
+                {
+                    ri->blocs[s].proc = p;
+                    aVoir[nAVoir++] = s;
+                }
+            }
+        }
+    }
+    free(aVoir);
+    free(chef);
+    free(blocDe);
+    return ri;
+}
+
+// ---------------------------------------------------------------------
+// Abaissement de la RI vers le P-code
+// ---------------------------------------------------------------------
+
+// Saut ou appel dont la cible est à corriger après l'émission
+typedef struct {
+    int pc;      // Instruction à corriger
+    int bloc;    // Bloc cible (saut) ou -1
+    int proc;    // Procédure cible (appel) ou -1
+} Correctif;
+
+typedef struct {
+    Correctif *tab;
+    int n;
+    int cap;
+} Correctifs;
+
+static void ajouterCorrectif(Correctifs *c, int pc, int bloc, int proc)
+{
+    c->tab = agrandir(c->tab, &c->cap, c->n + 1, sizeof(Correctif));
+    c->tab[c->n].pc = pc;
+    c->tab[c->n].bloc = bloc;
+    c->tab[c->n].proc = proc;
+    c->n++;
+}
+
+// Émet un arbre en ordre postfixe (ordre d'évaluation sur la pile)
+static void emettreArbre(const RI *ri, int v, Correctifs *c)
+{
+    const RI_Valeur *val = &ri->valeurs[v];
+    for (int k = 0; k < val->nOps; k++)
+        emettreArbre(ri, RI_Op(ri, v, k), c);
+    if (val->op == CALL)
+    {
+        Ecrire2(CALL, 0);
+        ajouterCorrectif(c, PC, -1, val->arg);
+    }
+    else
+    {
+        Ecrire2(val->op, val->arg);
+    }
+}
+
+void RI_Abaisser(RI *ri)
+{
+    // Blocs accessibles depuis l'entrée d'une procédure
+    char *accessible = calloc((size_t)ri->nBlocs, 1);
+    int *aVoir = malloc((size_t)ri->nBlocs * sizeof(int));
+    int nAVoir = 0;
+    for (int p = 0; p < ri->nProcs; p++)
+    {
+        if (ri->procs[p].entree >= 0 && !accessible[ri->procs[p].entree])
+        {
+            accessible[ri->procs[p].entree] = 1;
+            aVoir[nAVoir++] = ri->procs[p].entree;
+        }
+    }
+    while (nAVoir > 0)
+    {
+        int b = aVoir[--nAVoir];
+        for (int k = 0; k < ri->blocs[b].nSucc; k++)
+        {
+            int s = ri->blocs[b].succ[k];
+            if (!accessible[s])
+            {
+                accessible[s] = 1;
+                aVoir[nAVoir++] = s;
+            }
+        }
+    }
+
+    // Blocs émis, dans l'ordre de disposition
+    int *emis = aVoir;
+    int nEmis = 0;
+    for (int i = 0; i < ri->nOrdre; i++)
+    {
+        if (accessible[ri->ordre[i]])
+            emis[nEmis++] = ri->ordre[i];
+    }
+
+    int *nouvAdr = malloc((size_t)ri->nBlocs * sizeof(int));
+    for (int b = 0; b < ri->nBlocs; b++)
+        nouvAdr[b] = -1;
+    Correctifs *c = calloc(1, sizeof(Correctifs));
+    if (!accessible || !aVoir || !nouvAdr || !c)
+        Error("Out of memory (IR)");
+
+    // Une erreur pendant l'émission (code trop long) libère les tableaux de
+    // travail avant d'être relayée au point de reprise englobant
+    jmp_buf reprise;
+    jmp_buf *englobante = REPRISE_ERREUR;
+    REPRISE_ERREUR = &reprise;
+    if (setjmp(reprise) != 0)
+    {
+        REPRISE_ERREUR = englobante;
+        free(c->tab);
+        free(c);
+        free(nouvAdr);
+        free(aVoir);
+        free(accessible);
+        RelayerErreur(MESSAGE_ERREUR);
+    }
+
+    PC = -1;
+    for (int i = 0; i < nEmis; i++)
+    {
+        int b = emis[i];
+        int suivant = (i + 1 < nEmis) ? emis[i + 1] : -1;
+        RI_Bloc *bl = &ri->blocs[b];
+        int t = RI_Terminateur(ri, b);
+        nouvAdr[b] = PC + 1;
+
+        for (int k = 0; k < bl->nInstrs; k++)
+        {
+            int v = bl->instrs[k];
+            if (v != t || !RI_EstBranchement(ri->valeurs[v].op))
+            {
+                emettreArbre(ri, v, c);
+                continue;
+            }
+            // Branchement terminal : la cible est corrigée plus tard,
+            // un saut vers le bloc émis juste après est inutile
+            for (int j = 0; j < ri->valeurs[v].nOps; j++)
+                emettreArbre(ri, RI_Op(ri, v, j), c);
+            if (ri->valeurs[v].op == BRN)
+            {
+                if (bl->succ[0] != suivant)
+                {
+                    Ecrire2(BRN, 0);
+                    ajouterCorrectif(c, PC, bl->succ[0], -1);
+                }
+            }
+            else
+            {
+                Ecrire2(ri->valeurs[v].op, 0);
+                ajouterCorrectif(c, PC, bl->succ[0], -1);
+                if (bl->succ[1] != suivant)
+                {
+                    Ecrire2(BRN, 0);
+                    ajouterCorrectif(c, PC, bl->succ[1], -1);
+                }
+            }
+        }
+        if (t < 0 && bl->nSucc == 1 && bl->succ[0] != suivant)
+        {
+            Ecrire2(BRN, 0);
+            ajouterCorrectif(c, PC, bl->succ[0], -1);
+        }
+    }
+
+    // Corrige les cibles des sauts et des appels
+    for (int i = 0; i < c->n; i++)
+    {
+        if (c->tab[i].bloc >= 0)
+            PCODE[c->tab[i].pc].SUITE = nouvAdr[c->tab[i].bloc];
+        else
+            PCODE[c->tab[i].pc].SUITE = nouvAdr[ri->procs[c->tab[i].proc].entree];
+    }
+    // Met à jour l'adresse des procédures et fonctions dans la table des symboles
+    for (int p = 1; p < ri->nProcs; p++)
+    {
+        if (ri->procs[p].idf >= 0)
+            TAB_IDFS[ri->procs[p].idf].Adresse =
+                (ri->procs[p].entree >= 0) ? nouvAdr[ri->procs[p].entree] : -1;
+    }
+    // Appels terminaux, une fois les adresses connues. Le CALL peut être dans
+    // le bloc précédant le RET : sans saut entre les deux, l'exécution passe
+    // toujours de l'appel à ce RET.
+    for (int i = 0; i <= PC; i++)
+    {
+        if (PCODE[i].MNE == RET)
+            MarquerAppelTerminal(i, 0);
+    }
+
+    REPRISE_ERREUR = englobante;
+    free(c->tab);
+    free(c);
+    free(nouvAdr);
+    free(aVoir);
+    free(accessible);
+}
+
+void RI_Liberer(RI *ri)
+{
+    if (!ri)
+        return;
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        free(ri->blocs[b].instrs);
+        free(ri->blocs[b].preds);
+    }
+    for (int i = 0; i < ri->nPhis; i++)
+        free(ri->phis[i].args);
+    free(ri->valeurs);
+    free(ri->operandes);
+    free(ri->blocs);
+    free(ri->ordre);
+    free(ri->phis);
+    free(ri->versions);
+    free(ri->ecrit);
+    free(ri->lit);
+    free(ri->appelle);
+    free(ri);
+}
+
+// ---------------------------------------------------------------------
+// Analyses : prédécesseurs, dominateurs
+// ---------------------------------------------------------------------
+
+void RI_CalculerPreds(RI *ri)
+{
+    for (int b = 0; b < ri->nBlocs; b++)
+        ri->blocs[b].nPreds = 0;
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        if (ri->blocs[b].proc < 0)
+            continue;
+        for (int k = 0; k < ri->blocs[b].nSucc; k++)
+        {
+            RI_Bloc *s = &ri->blocs[ri->blocs[b].succ[k]];
+            // Un bloc qui branche deux fois vers le même successeur n'y compte qu'une fois
+            if (k == 1 && ri->blocs[b].succ[0] == ri->blocs[b].succ[1])
+                continue;
+            s->preds = agrandir(s->preds, &s->capPreds, s->nPreds + 1, sizeof(int));
+            s->preds[s->nPreds++] = b;
+        }
+    }
+}
+
+// Parcours en profondeur : range les blocs en ordre postfixe
+static void parcoursPostfixe(RI *ri, int b, char *vu, int *post, int *nPost)
+{
+    vu[b] = 1;
+    for (int k = 0; k < ri->blocs[b].nSucc; k++)
+    {
+        int s = ri->blocs[b].succ[k];
+        if (!vu[s])
+            parcoursPostfixe(ri, s, vu, post, nPost);
+    }
+    post[(*nPost)++] = b;
+}
+
+// Remonte les dominateurs de deux blocs jusqu'à leur ancêtre commun
+static int intersection(const RI *ri, int a, int b)
+{
+    while (a != b)
+    {
+        while (ri->blocs[a].rpo > ri->blocs[b].rpo)
+            a = ri->blocs[a].idom;
+        while (ri->blocs[b].rpo > ri->blocs[a].rpo)
+            b = ri->blocs[b].idom;
+    }
+    return a;
+}
+
+void RI_CalculerDominateurs(RI *ri)
+{
+    RI_CalculerPreds(ri);
+    char *vu = calloc((size_t)ri->nBlocs, 1);
+    int *post = malloc((size_t)ri->nBlocs * sizeof(int));
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        ri->blocs[b].idom = -1;
+        ri->blocs[b].rpo = -1;
+    }
+
+    for (int p = 0; p < ri->nProcs; p++)
+    {
+        int entree = ri->procs[p].entree;
+        if (entree < 0 || vu[entree])
+            continue;
+        int nPost = 0;
+        parcoursPostfixe(ri, entree, vu, post, &nPost);
+        for (int i = 0; i < nPost; i++)
+            ri->blocs[post[i]].rpo = nPost - 1 - i;
+
+        // Algorithme itératif de Cooper, Harvey et Kennedy
+        ri->blocs[entree].idom = entree;
+        int change = 1;
+        while (change)
+        {
+            change = 0;
+            for (int i = nPost - 2; i >= 0; i--)
+            {
+                int b = post[i];
+                int nouv = -1;
+                for (int k = 0; k < ri->blocs[b].nPreds; k++)
+                {
+                    int pr = ri->blocs[b].preds[k];
+                    if (ri->blocs[pr].idom < 0)
+                        continue;
+                    nouv = (nouv < 0) ? pr : intersection(ri, pr, nouv);
+                }
+                if (nouv != ri->blocs[b].idom)
+                {
+                    ri->blocs[b].idom = nouv;
+                    change = 1;
+                }
+            }
+        }
+        ri->blocs[entree].idom = -1;
+    }
+    free(vu);
+    free(post);
+}
+
+int RI_Domine(const RI *ri, int a, int b)
+{
+    while (b >= 0)
+    {
+        if (a == b)
+            return 1;
+        b = ri->blocs[b].idom;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------
+// Construction SSA des variables (placement des phi et renommage)
+// ---------------------------------------------------------------------
+
+// Crée une nouvelle version de la variable var
+static int nouvelleVersion(RI *ri, int var, int valeur, int phi, int bloc)
+{
+    ri->versions = agrandir(ri->versions, &ri->capVersions, ri->nVersions + 1, sizeof(RI_Version));
+    RI_Version *ver = &ri->versions[ri->nVersions];
+    ver->var = var;
+    ver->valeur = valeur;
+    ver->phi = phi;
+    ver->bloc = bloc;
+    return ri->nVersions++;
+}
+
+// Indique si la valeur peut écraser des globales qu'elle ne nomme pas
+// (appel, écriture indirecte, lecture sans adresse)
+static int ecraseGlobales(const RI *ri, int v)
+{
+    Mnemoniques op = ri->valeurs[v].op;
+    return op == CALL || op == STO_IND || (op == INN && ri->valeurs[v].var < 0);
+}
+
+// Indique si l'appel v reçoit l'adresse de la case du cadre var (LLA en argument) :
+// l'appelée peut alors la lire et l'écrire. Aucune autre instruction ne peut
+// atteindre le cadre courant par une adresse.
+static int recoitCase(const RI *ri, int v, int var)
+{
+    if (ri->valeurs[v].op != CALL)
+        return 0;
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+    {
+        const RI_Valeur *a = &ri->valeurs[RI_Op(ri, v, k)];
+        if (a->op == LLA && RI_CASE_SUIVIE(a->arg) && RI_VAR_LOCALE(a->arg) == var)
+            return 1;
+    }
+    return 0;
+}
+
+int RI_PeutEcrire(const RI *ri, int v, int var)
+{
+    if (var >= TAILLEMEM)
+        return recoitCase(ri, v, var);
+    if (!ecraseGlobales(ri, v))
+        return 0;
+    if (ri->valeurs[v].op != CALL)
+        return 1;
+    int p = ri->valeurs[v].arg;
+    return ri->ecritTout[p] || ri->ecrit[p * TAILLEMEM + var];
+}
+
+int RI_PeutLire(const RI *ri, int v, int var)
+{
+    const RI_Valeur *val = &ri->valeurs[v];
+    if (var >= TAILLEMEM)
+        return recoitCase(ri, v, var);
+    if (val->op == LDV)
+        return val->var < 0;
+    if (val->op != CALL)
+        return 0;
+    return ri->litTout[val->arg] || ri->lit[val->arg * TAILLEMEM + var];
+}
+
+// Indique si la valeur définit sa variable (par opposition à une lecture)
+static int definitVariable(const RI *ri, int v)
+{
+    Mnemoniques op = ri->valeurs[v].op;
+    return (op == STO || op == STO_KEEP || op == STL || op == INN) && ri->valeurs[v].var >= 0;
+}
+
+// État du renommage d'une procédure
+typedef struct {
+    int  *indice;     // Indice dense de chaque variable suivie (-1 sinon)
+    int  *vars;       // Variables suivies
+    int   nVars;
+    int  *courante;   // Version courante de chaque variable suivie
+    int **enfants;    // Enfants de chaque bloc dans l'arbre des dominateurs
+    int  *nEnfants;
+    int **phisDe;     // Phi de chaque bloc
+    int  *nPhisDe;
+} Renommage;
+
+// Renomme les lectures et définitions d'un arbre, en ordre d'évaluation
+static void renommerArbre(RI *ri, Renommage *r, int v, int b)
+{
+    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+        renommerArbre(ri, r, RI_Op(ri, v, k), b);
+
+    RI_Valeur *val = &ri->valeurs[v];
+    if (val->var >= 0 && r->indice[val->var] >= 0)
+    {
+        int i = r->indice[val->var];
+        if (definitVariable(ri, v))
+            r->courante[i] = nouvelleVersion(ri, val->var, v, -1, b);
+        val->version = r->courante[i];
+    }
+    if (ecraseGlobales(ri, v))
+    {
+        for (int i = 0; i < r->nVars; i++)
+        {
+            if (RI_PeutEcrire(ri, v, r->vars[i]))
+                r->courante[i] = nouvelleVersion(ri, r->vars[i], v, -1, b);
+        }
+    }
+}
+
+// Renomme un bloc puis ses enfants dans l'arbre des dominateurs
+static void renommerBloc(RI *ri, Renommage *r, int b)
+{
+    int *sauvegarde = malloc((size_t)(r->nVars + 1) * sizeof(int));
+    memcpy(sauvegarde, r->courante, (size_t)r->nVars * sizeof(int));
+
+    for (int k = 0; k < r->nPhisDe[b]; k++)
+    {
+        RI_Phi *phi = &ri->phis[r->phisDe[b][k]];
+        r->courante[r->indice[phi->var]] = phi->version;
+    }
+    for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+        renommerArbre(ri, r, ri->blocs[b].instrs[k], b);
+
+    // Transmet les versions courantes aux phi des successeurs
+    for (int k = 0; k < ri->blocs[b].nSucc; k++)
+    {
+        int s = ri->blocs[b].succ[k];
+        int j;
+        for (j = 0; j < ri->blocs[s].nPreds && ri->blocs[s].preds[j] != b; j++)
+            ;
+        for (int f = 0; f < r->nPhisDe[s]; f++)
+        {
+            RI_Phi *phi = &ri->phis[r->phisDe[s][f]];
+            phi->args[j] = r->courante[r->indice[phi->var]];
+        }
+    }
+    for (int k = 0; k < r->nEnfants[b]; k++)
+        renommerBloc(ri, r, r->enfants[b][k]);
+
+    memcpy(r->courante, sauvegarde, (size_t)r->nVars * sizeof(int));
+    free(sauvegarde);
+}
+
+// Ajoute un élément à une liste d'entiers associée à un bloc
+static void ajouterListe(int **liste, int *n, int x)
+{
+    *liste = realloc(*liste, (size_t)(*n + 1) * sizeof(int));
+    (*liste)[(*n)++] = x;
+}
+
+void RI_ConstruireSSA(RI *ri)
+{
+    RI_CalculerDominateurs(ri);
+    RI_CalculerEffets(ri);
+    for (int i = 0; i < ri->nPhis; i++)
+        free(ri->phis[i].args);
+    ri->nPhis = 0;
+    ri->nVersions = 0;
+    // Une passe a pu changer un opérande en LDA : la variable nommée est recalculée
+    for (int v = 0; v < ri->nValeurs; v++)
+    {
+        ri->valeurs[v].var = variableDe(ri, v);
+        ri->valeurs[v].version = -1;
+    }
+
+    int nb = ri->nBlocs;
+    Renommage r;
+    r.indice = malloc(RI_NB_VARS * sizeof(int));
+    r.vars = malloc(RI_NB_VARS * sizeof(int));
+    r.courante = malloc(RI_NB_VARS * sizeof(int));
+    r.enfants = calloc((size_t)nb, sizeof(int *));
+    r.nEnfants = calloc((size_t)nb, sizeof(int));
+    r.phisDe = calloc((size_t)nb, sizeof(int *));
+    r.nPhisDe = calloc((size_t)nb, sizeof(int));
+    int **frontiere = calloc((size_t)nb, sizeof(int *));
+    int *nFrontiere = calloc((size_t)nb, sizeof(int));
+    int *phiPlace = malloc((size_t)nb * sizeof(int));
+    int *travail = malloc((size_t)nb * sizeof(int));
+    int *dejaTravail = malloc((size_t)nb * sizeof(int));
+    int **defs = calloc((size_t)nb, sizeof(int *));  // Variables définies par chaque bloc
+    int *nDefs = calloc((size_t)nb, sizeof(int));
+    char *ecrase = calloc((size_t)nb, 1);           // Le bloc écrase-t-il les globales ?
+    int *pileV = malloc((size_t)(ri->nValeurs + 1) * sizeof(int));
+
+    // Arbre des dominateurs et frontières de dominance
+    for (int b = 0; b < nb; b++)
+    {
+        if (ri->blocs[b].rpo < 0)
+            continue;
+        if (ri->blocs[b].idom >= 0)
+            ajouterListe(&r.enfants[ri->blocs[b].idom], &r.nEnfants[ri->blocs[b].idom], b);
+        if (ri->blocs[b].nPreds < 2)
+            continue;
+        for (int k = 0; k < ri->blocs[b].nPreds; k++)
+        {
+            int cur = ri->blocs[b].preds[k];
+            while (cur >= 0 && cur != ri->blocs[b].idom)
+            {
+                int deja = 0;
+                for (int j = 0; j < nFrontiere[cur]; j++)
+                    deja |= (frontiere[cur][j] == b);
+                if (!deja)
+                    ajouterListe(&frontiere[cur], &nFrontiere[cur], b);
+                cur = ri->blocs[cur].idom;
+            }
+        }
+    }
+
+    for (int p = 0; p < ri->nProcs; p++)
+    {
+        int entree = ri->procs[p].entree;
+        if (entree < 0 || ri->blocs[entree].rpo < 0 || ri->blocs[entree].proc != p)
+            continue;
+
+        // Variables suivies : celles lues ou écrites dans la procédure.
+        // On note aussi, pour chaque bloc, les variables qu'il définit
+        // et s'il écrase les globales (appel, écriture indirecte).
+        for (int i = 0; i < RI_NB_VARS; i++)
+            r.indice[i] = -1;
+        r.nVars = 0;
+        for (int b = 0; b < nb; b++)
+        {
+            nDefs[b] = 0;
+            ecrase[b] = 0;
+            if (ri->blocs[b].proc != p || ri->blocs[b].rpo < 0)
+                continue;
+            int nPile = 0;
+            for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+                pileV[nPile++] = ri->blocs[b].instrs[k];
+            while (nPile > 0)
+            {
+                int v = pileV[--nPile];
+                int var = ri->valeurs[v].var;
+                if (var >= 0 && r.indice[var] < 0)
+                {
+                    r.indice[var] = r.nVars;
+                    r.vars[r.nVars++] = var;
+                }
+                if (definitVariable(ri, v))
+                    ajouterListe(&defs[b], &nDefs[b], var);
+                if (ri->valeurs[v].op == CALL)
+                {
+                    // Cases du cadre passées par adresse
+                    for (int k = 0; k < ri->valeurs[v].nOps; k++)
+                    {
+                        const RI_Valeur *a = &ri->valeurs[RI_Op(ri, v, k)];
+                        if (a->op == LLA && RI_CASE_SUIVIE(a->arg))
+                            ajouterListe(&defs[b], &nDefs[b], RI_VAR_LOCALE(a->arg));
+                    }
+                }
+                if (ri->valeurs[v].op == CALL && !ri->ecritTout[ri->valeurs[v].arg])
+                {
+                    // Appel : seules les globales que la procédure peut écrire changent
+                    const char *ecrit = &ri->ecrit[ri->valeurs[v].arg * TAILLEMEM];
+                    for (int a = 0; a < TAILLEMEM; a++)
+                    {
+                        if (ecrit[a])
+                            ajouterListe(&defs[b], &nDefs[b], a);
+                    }
+                }
+                else
+                {
+                    ecrase[b] |= ecraseGlobales(ri, v);
+                }
+                for (int k = 0; k < ri->valeurs[v].nOps; k++)
+                    pileV[nPile++] = RI_Op(ri, v, k);
+            }
+        }
+
+        // Placement des phi : frontière de dominance itérée des blocs de définition
+        for (int i = 0; i < r.nVars; i++)
+        {
+            int var = r.vars[i];
+            int nTravail = 0;
+            for (int b = 0; b < nb; b++)
+            {
+                phiPlace[b] = 0;
+                dejaTravail[b] = 0;
+                if (ri->blocs[b].proc != p || ri->blocs[b].rpo < 0)
+                    continue;
+                int definit = (var < TAILLEMEM && ecrase[b]);
+                for (int k = 0; k < nDefs[b] && !definit; k++)
+                    definit = (defs[b][k] == var);
+                if (definit)
+                {
+                    travail[nTravail++] = b;
+                    dejaTravail[b] = 1;
+                }
+            }
+            while (nTravail > 0)
+            {
+                int b = travail[--nTravail];
+                for (int j = 0; j < nFrontiere[b]; j++)
+                {
+                    int f = frontiere[b][j];
+                    if (phiPlace[f])
+                        continue;
+                    phiPlace[f] = 1;
+                    ri->phis = agrandir(ri->phis, &ri->capPhis, ri->nPhis + 1, sizeof(RI_Phi));
+                    RI_Phi *phi = &ri->phis[ri->nPhis];
+                    phi->var = var;
+                    phi->bloc = f;
+                    phi->args = malloc((size_t)(ri->blocs[f].nPreds + 1) * sizeof(int));
+                    for (int k = 0; k < ri->blocs[f].nPreds; k++)
+                        phi->args[k] = -1;
+                    phi->version = nouvelleVersion(ri, var, -1, ri->nPhis, f);
+                    ajouterListe(&r.phisDe[f], &r.nPhisDe[f], ri->nPhis);
+                    ri->nPhis++;
+                    if (!dejaTravail[f])
+                    {
+                        dejaTravail[f] = 1;
+                        travail[nTravail++] = f;
+                    }
+                }
+            }
+        }
+
+        // Versions d'entrée puis renommage le long de l'arbre des dominateurs
+        for (int i = 0; i < r.nVars; i++)
+            r.courante[i] = nouvelleVersion(ri, r.vars[i], -1, -1, entree);
+        renommerBloc(ri, &r, entree);
+    }
+
+    for (int b = 0; b < nb; b++)
+    {
+        free(r.enfants[b]);
+        free(r.phisDe[b]);
+        free(frontiere[b]);
+        free(defs[b]);
+    }
+    free(defs);
+    free(nDefs);
+    free(ecrase);
+    free(pileV);
+    free(r.indice);
+    free(r.vars);
+    free(r.courante);
+    free(r.enfants);
+    free(r.nEnfants);
+    free(r.phisDe);
+    free(r.nPhisDe);
+    free(frontiere);
+    free(nFrontiere);
+    free(phiPlace);
+    free(travail);
+    free(dejaTravail);
+    ri->ssaValide = 1;
+}
+
+// ---------------------------------------------------------------------
+// Effets des procédures sur les globales
+// ---------------------------------------------------------------------
+
+// Note les écritures d'un arbre de la procédure p et les procédures qu'il appelle
+static void effetsArbre(RI *ri, int p, int v, char *appelle)
+{
+    const RI_Valeur *val = &ri->valeurs[v];
+    for (int k = 0; k < val->nOps; k++)
+        effetsArbre(ri, p, RI_Op(ri, v, k), appelle);
+    if (definitVariable(ri, v) && val->var < TAILLEMEM)
+        ri->ecrit[p * TAILLEMEM + val->var] = 1;
+    else if (val->op == CALL)
+        appelle[p * ri->nProcs + val->arg] = 1;
+    else if (ecraseGlobales(ri, v))
+        ri->ecritTout[p] = 1;
+    if (val->op == LDV && val->var >= 0 && val->var < TAILLEMEM)
+        ri->lit[p * TAILLEMEM + val->var] = 1;
+    else if (val->op == LDV)
+        ri->litTout[p] = 1;
+}
+
+void RI_CalculerEffets(RI *ri)
+{
+    int np = ri->nProcs;
+    ri->ecrit = realloc(ri->ecrit, (size_t)np * TAILLEMEM);
+    memset(ri->ecrit, 0, (size_t)np * TAILLEMEM);
+    memset(ri->ecritTout, 0, sizeof(ri->ecritTout));
+    ri->lit = realloc(ri->lit, (size_t)np * TAILLEMEM);
+    memset(ri->lit, 0, (size_t)np * TAILLEMEM);
+    memset(ri->litTout, 0, sizeof(ri->litTout));
+    ri->appelle = realloc(ri->appelle, (size_t)np * np);
+    memset(ri->appelle, 0, (size_t)np * np);
+    char *appelle = ri->appelle;
+
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        if (ri->blocs[b].proc < 0)
+            continue;
+        for (int k = 0; k < ri->blocs[b].nInstrs; k++)
+            effetsArbre(ri, ri->blocs[b].proc, ri->blocs[b].instrs[k], appelle);
+    }
+
+    // Propage les lectures et écritures des appelées vers les appelantes jusqu'au point fixe
+    int change = 1;
+    while (change)
+    {
+        change = 0;
+        for (int p = 0; p < np; p++)
+        {
+            for (int q = 0; q < np; q++)
+            {
+                if (!appelle[p * np + q] || p == q)
+                    continue;
+                if ((ri->ecritTout[q] && !ri->ecritTout[p]) || (ri->litTout[q] && !ri->litTout[p]))
+                {
+                    ri->ecritTout[p] |= ri->ecritTout[q];
+                    ri->litTout[p] |= ri->litTout[q];
+                    change = 1;
+                }
+                for (int a = 0; a < TAILLEMEM; a++)
+                {
+                    if ((ri->ecrit[q * TAILLEMEM + a] && !ri->ecrit[p * TAILLEMEM + a]) ||
+                        (ri->lit[q * TAILLEMEM + a] && !ri->lit[p * TAILLEMEM + a]))
+                    {
+                        ri->ecrit[p * TAILLEMEM + a] |= ri->ecrit[q * TAILLEMEM + a];
+                        ri->lit[p * TAILLEMEM + a] |= ri->lit[q * TAILLEMEM + a];
+                        change = 1;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------
+// Boucles naturelles
+// ---------------------------------------------------------------------
+
+int RI_DansBoucle(const RI_Boucle *l, int b)
+{
+    return b >= 0 && b < l->taille && l->dans[b];
+}
+
+int RI_TrouverBoucles(RI *ri, RI_Boucle **boucles)
+{
+    RI_CalculerDominateurs(ri);
+    int n = 0;
+    RI_Boucle *tab = NULL;
+    int *aVoir = malloc((size_t)ri->nBlocs * sizeof(int));
+
+    for (int b = 0; b < ri->nBlocs; b++)
+    {
+        if (ri->blocs[b].rpo < 0)
+            continue;
+        for (int k = 0; k < ri->blocs[b].nSucc; k++)
+        {
+            int h = ri->blocs[b].succ[k];
+            if (!RI_Domine(ri, h, b))
+                continue;
+            // Arc retour b -> h : les boucles de même en-tête sont fusionnées
+            int i;
+            for (i = 0; i < n && tab[i].entete != h; i++)
+                ;
+            if (i == n)
+            {
+                tab = realloc(tab, (size_t)(n + 1) * sizeof(RI_Boucle));
+                tab[n].entete = h;
+                tab[n].proc = ri->blocs[h].proc;
+                // Place pour les pré-en-têtes créés plus tard
+                tab[n].taille = 2 * ri->nBlocs + 1;
+                tab[n].dans = calloc((size_t)tab[n].taille, 1);
+                tab[n].dans[h] = 1;
+                tab[n].nBlocs = 1;
+                n++;
+            }
+            // Remonte les prédécesseurs depuis la source de l'arc retour
+            int nAVoir = 0;
+            if (!tab[i].dans[b])
+            {
+                tab[i].dans[b] = 1;
+                tab[i].nBlocs++;
+                aVoir[nAVoir++] = b;
+            }
+            while (nAVoir > 0)
+            {
+                int x = aVoir[--nAVoir];
+                for (int j = 0; j < ri->blocs[x].nPreds; j++)
+                {
+                    int pr = ri->blocs[x].preds[j];
+                    if (ri->blocs[pr].rpo < 0 || tab[i].dans[pr])
+                        continue;
+                    tab[i].dans[pr] = 1;
+                    tab[i].nBlocs++;
+                    aVoir[nAVoir++] = pr;
+                }
+            }
+        }
+    }
+    free(aVoir);
+
+    // Les boucles intérieures d'abord
+    for (int i = 1; i < n; i++)
+    {
+        RI_Boucle l = tab[i];
+        int j = i - 1;
+        while (j >= 0 && tab[j].nBlocs > l.nBlocs)
+        {
+            tab[j + 1] = tab[j];
+            j--;
+        }
+        tab[j + 1] = l;
+    }
+    *boucles = tab;
+    return n;
+}
+
+int RI_PreEntete(RI *ri, RI_Boucle *boucles, int nBoucles, int i)
+{
+    int h = boucles[i].entete;
+    int proc = ri->blocs[h].proc;
+
+    // Un seul prédécesseur extérieur qui ne mène qu'à l'en-tête : il sert de pré-en-tête
+    int ext = -1, nExt = 0;
+    for (int k = 0; k < ri->blocs[h].nPreds; k++)
+    {
+        int pr = ri->blocs[h].preds[k];
+        if (!RI_DansBoucle(&boucles[i], pr))
+        {
+            ext = pr;
+            nExt++;
+        }
+    }
+    if (nExt == 1 && ri->blocs[ext].nSucc == 1 && RI_Terminateur(ri, ext) < 0 &&
+        ri->procs[proc].entree != h)
+        return ext;
+
+    int pre = RI_NouveauBloc(ri, proc, h);
+    ri->blocs[pre].succ[0] = h;
+    ri->blocs[pre].nSucc = 1;
+    for (int k = 0; k < ri->blocs[h].nPreds; k++)
+    {
+        int pr = ri->blocs[h].preds[k];
+        if (RI_DansBoucle(&boucles[i], pr))
+            continue;
+        for (int j = 0; j < ri->blocs[pr].nSucc; j++)
+        {
+            if (ri->blocs[pr].succ[j] != h)
+                continue;
+            ri->blocs[pr].succ[j] = pre;
+            int t = RI_Terminateur(ri, pr);
+            if (j == 0 && t >= 0 && RI_EstBranchement(ri->valeurs[t].op))
+                ri->valeurs[t].arg = pre;
+        }
+    }
+    if (ri->procs[proc].entree == h)
+        ri->procs[proc].entree = pre;
+
+    // Le pré-en-tête appartient aux boucles qui contiennent l'en-tête
+    for (int j = 0; j < nBoucles; j++)
+    {
+        if (j != i && RI_DansBoucle(&boucles[j], h) && pre < boucles[j].taille)
+        {
+            boucles[j].dans[pre] = 1;
+            boucles[j].nBlocs++;
+        }
+    }
+    RI_CalculerPreds(ri);
+    RI_Invalider(ri);
+    return pre;
+}
+
+void RI_LibererBoucles(RI_Boucle *boucles, int nBoucles)
+{
+    for (int i = 0; i < nBoucles; i++)
+        free(boucles[i].dans);
+    free(boucles);
+}
+
+// ---------------------------------------------------------------------
+// Affichage
+// ---------------------------------------------------------------------
+
+// Affiche un arbre en notation préfixe
+static void afficherArbre(const RI *ri, int v)
+{
+    const RI_Valeur *val = &ri->valeurs[v];
+    printf("%s", NomMnemonique(val->op));
+    if (val->op == CALL)
+        printf(" P%d", val->arg);
+    else if (RI_EstBranchement(val->op))
+        printf(" B%d", val->arg);
+    else if (val->op == LDF)
+    {
+        float f;
+        memcpy(&f, &val->arg, sizeof(float));
+        printf(" %g", f);
+    }
+    else if (val->op != LDV && val->op != INN)
+        printf(" %d", val->arg);
+    if (val->version >= 0)
+        printf(".v%d", val->version);
+    for (int k = 0; k < val->nOps; k++)
+    {
+        printf(" (");
+        afficherArbre(ri, RI_Op(ri, v, k));
+        printf(")");
+    }
+}
+
+void RI_Afficher(const RI *ri)
+{
+    for (int p = 0; p < ri->nProcs; p++)
+    {
+        if (ri->procs[p].entree < 0)
+            continue;
+        printf("P%d %s\n", p, (ri->procs[p].idf >= 0) ? TAB_IDFS[ri->procs[p].idf].Nom : "(programme)");
+        for (int i = 0; i < ri->nOrdre; i++)
+        {
+            int b = ri->ordre[i];
+            const RI_Bloc *bl = &ri->blocs[b];
+            if (bl->proc != p)
+                continue;
+            printf("  B%d", b);
+            if (bl->nSucc > 0)
+            {
+                printf(" ->");
+                for (int k = 0; k < bl->nSucc; k++)
+                    printf(" B%d", bl->succ[k]);
+            }
+            printf("\n");
+            for (int f = 0; ri->ssaValide && f < ri->nPhis; f++)
+            {
+                if (ri->phis[f].bloc != b)
+                    continue;
+                printf("    v%d = phi[%d](", ri->phis[f].version, ri->phis[f].var);
+                for (int k = 0; k < bl->nPreds; k++)
+                    printf("%sv%d", k ? ", " : "", ri->phis[f].args[k]);
+                printf(")\n");
+            }
+            for (int k = 0; k < bl->nInstrs; k++)
+            {
+                printf("    ");
+                afficherArbre(ri, bl->instrs[k]);
+                printf("\n");
+            }
+        }
+    }
+}
@@ -0,0 +1,204 @@
+#ifndef REPRESENTATION_INTERMEDIAIRE_H
+#define REPRESENTATION_INTERMEDIAIRE_H
+
+#include "global.h"  // Définitions globales (Mnemoniques, PCODE, PC, etc.)
+
+// ---------------------------------------------------------------------
+// Représentation intermédiaire (RI) entre l'analyse et le P-code final
+// ---------------------------------------------------------------------
+// Le P-code produit par l'analyse syntaxique est découpé en blocs de base
+// reliés par un graphe de flot de contrôle (CFG). Dans chaque bloc, la pile
+// est simulée : chaque instruction qui empile devient une "valeur" définie
+// une seule fois (forme SSA), dont les opérandes sont les valeurs dépilées.
+// Un bloc est donc une suite d'arbres d'expressions (les "instructions").
+// Les variables en mémoire (globales et cases du cadre LDL/STL) reçoivent
+// des versions SSA, avec des phi aux points de jonction.
+// L'abaissement (RI_Abaisser) réécrit ensuite PCODE à partir de la RI.
+
+#define RI_MAX_PROCS   (TAILLEIDFS + 1)   // Programme principal + procédures/fonctions
+#define RI_MAX_LOCAUX  64                 // Cases du cadre suivies (LDL/STL k)
+#define RI_CASE_MIN    (-(RI_MAX_LOCAUX / 2)) // Première case suivie (les arguments sont sous BP)
+#define RI_NB_VARS     (TAILLEMEM + RI_MAX_LOCAUX) // Globales puis cases du cadre
+
+// Indique si la case k du cadre (relative à BP) est suivie
+#define RI_CASE_SUIVIE(k) ((k) >= RI_CASE_MIN && (k) < RI_CASE_MIN + RI_MAX_LOCAUX)
+
+// Numéro de variable d'une case du cadre (les globales utilisent leur adresse)
+#define RI_VAR_LOCALE(k) (TAILLEMEM + (k) - RI_CASE_MIN)
+
+// Case du cadre correspondant à un numéro de variable >= TAILLEMEM
+#define RI_CASE_DE(var)  ((var) - TAILLEMEM + RI_CASE_MIN)
+
+// Valeur SSA : noeud d'arbre produit par une instruction P-code
+typedef struct {
+    Mnemoniques op;   // Instruction P-code
+    int  arg;         // Argument (SUITE). Branchement : bloc cible ; CALL : procédure appelée ; RET : cases dépilées
+    int  premierOp;   // Indice du premier opérande dans RI.operandes
+    int  nOps;        // Nombre d'opérandes (valeurs dépilées), dans l'ordre d'empilement
+    int  var;         // Variable lue (LDV, LDL) ou écrite (STO, STL, INN), -1 sinon
+    int  version;     // Version SSA de cette variable (lue ou définie), -1 sinon
+} RI_Valeur;
+
+// Bloc de base
+typedef struct {
+    int *instrs;      // Racines des arbres, dans l'ordre d'exécution
+    int  nInstrs;
+    int  capInstrs;
+    int  succ[2];     // [0] : cible du branchement ou bloc suivant ; [1] : suite d'un branchement conditionnel
+    int  nSucc;
+    int *preds;       // Prédécesseurs (calculés par RI_CalculerPreds)
+    int  nPreds;
+    int  capPreds;
+    int  proc;        // Procédure d'appartenance (-1 si inaccessible)
+    int  adresse;     // Adresse d'origine dans PCODE (-1 pour un bloc créé par une passe)
+    int  idom;        // Dominateur immédiat (-1 pour l'entrée)
+    int  rpo;         // Rang dans l'ordre postfixe inverse de sa procédure
+    int  deroule;     // La boucle dont ce bloc est l'en-tête a déjà été déroulée
+} RI_Bloc;
+
+// Procédure, fonction ou programme principal
+typedef struct {
+    int entree;       // Bloc d'entrée
+    int idf;          // Index dans TAB_IDFS (-1 pour le programme principal)
+} RI_Proc;
+
+// Phi : fusion des versions d'une variable à l'entrée d'un bloc
+typedef struct {
+    int  var;         // Variable concernée
+    int  version;     // Version définie par le phi
+    int  bloc;        // Bloc où il est placé
+    int *args;        // Version reçue de chaque prédécesseur (même ordre que preds)
+} RI_Phi;
+
+// Origine d'une version SSA
+typedef struct {
+    int var;          // Variable
+    int valeur;       // Valeur qui la définit (STO, STL, INN, CALL...), -1 sinon
+    int phi;          // Phi qui la définit, -1 sinon
+    int bloc;         // Bloc de définition
+} RI_Version;
+
+typedef struct {
+    RI_Valeur  *valeurs;    int nValeurs;   int capValeurs;
+    int        *operandes;  int nOperandes; int capOperandes;
+    RI_Bloc    *blocs;      int nBlocs;     int capBlocs;
+    int        *ordre;      int nOrdre;     // Disposition des blocs pour l'abaissement
+    RI_Proc     procs[RI_MAX_PROCS];        int nProcs;
+    RI_Phi     *phis;       int nPhis;      int capPhis;
+    RI_Version *versions;   int nVersions;  int capVersions;
+    int         ssaValide;  // 1 si dominateurs et versions SSA sont à jour
+    char       *ecrit;      // ecrit[p * TAILLEMEM + a] : la procédure p peut écrire la globale a
+    char        ecritTout[RI_MAX_PROCS]; // La procédure p peut écrire n'importe quelle globale
+    char       *lit;        // lit[p * TAILLEMEM + a] : la procédure p peut lire la globale a
+    char        litTout[RI_MAX_PROCS];   // La procédure p peut lire n'importe quelle globale
+    int         premierTemp; // Première adresse des temporaires créés par les passes
+    char       *appelle;    // Graphe d'appels : appelle[p * nProcs + q] si p contient un appel à q
+} RI;
+
+// Boucle naturelle : en-tête et blocs qui atteignent un arc retour sans repasser par l'en-tête
+typedef struct {
+    int   entete;     // Bloc d'en-tête (cible des arcs retour)
+    int   proc;       // Procédure de la boucle
+    char *dans;       // dans[b] non nul si le bloc b appartient à la boucle
+    int   taille;     // Taille du tableau dans
+    int   nBlocs;     // Nombre de blocs de la boucle
+} RI_Boucle;
+
+// Construit la RI à partir de PCODE[0..PC]. Retourne NULL si le P-code
+// n'a pas une forme reconnue (la pile doit être vide entre deux blocs).
+RI *RI_Construire(void);
+
+// Réécrit PCODE à partir de la RI et met à jour les adresses des procédures
+void RI_Abaisser(RI *ri);
+
+// Libère la RI
+void RI_Liberer(RI *ri);
+
+// Affiche la RI (blocs, arbres et versions SSA) pour le débogage
+void RI_Afficher(const RI *ri);
+
+// ----------------------
+// Manipulation des valeurs et des blocs
+// ----------------------
+
+// Crée une valeur avec ses opérandes
+int  RI_NouvelleValeur(RI *ri, Mnemoniques op, int arg, const int *ops, int nOps);
+
+// Retourne le k-ième opérande de la valeur v
+int  RI_Op(const RI *ri, int v, int k);
+
+// Remplace le k-ième opérande de la valeur v
+void RI_ChangerOp(RI *ri, int v, int k, int nouv);
+
+// Transforme la valeur v en constante entière (LDI) ou réelle (LDF, bits en argument)
+void RI_DevenirConstante(RI *ri, int v, Mnemoniques op, int arg);
+
+// Transforme la valeur v en copie de la valeur x : mêmes opérandes, rangés à
+// une place à elle dans RI.operandes (changer un opérande de l'une ne change
+// pas l'autre)
+void RI_DevenirCopie(RI *ri, int v, int x);
+
+// Crée un bloc vide ; il est placé dans la disposition juste avant le bloc 'avant'
+// (ou à la fin si avant < 0)
+int  RI_NouveauBloc(RI *ri, int proc, int avant);
+
+// Insère la valeur v comme instruction à la position pos du bloc b
+void RI_InsererInstr(RI *ri, int b, int pos, int v);
+
+// Retire l'instruction à la position pos du bloc b
+void RI_RetirerInstr(RI *ri, int b, int pos);
+
+// Retourne l'instruction terminale du bloc b (branchement, RET, HLT) ou -1
+int  RI_Terminateur(const RI *ri, int b);
+
+// Indique si une instruction est un branchement (BRN, BZE, BEQ..BGE)
+int  RI_EstBranchement(Mnemoniques op);
+
+// Indique si une instruction est un branchement conditionnel (BZE, BEQ..BGE)
+int  RI_EstConditionnel(Mnemoniques op);
+
+// ----------------------
+// Analyses
+// ----------------------
+
+// Recalcule les prédécesseurs de chaque bloc
+void RI_CalculerPreds(RI *ri);
+
+// Calcule les dominateurs immédiats et l'ordre postfixe inverse de chaque procédure
+void RI_CalculerDominateurs(RI *ri);
+
+// Indique si le bloc a domine le bloc b (dominateurs à jour)
+int  RI_Domine(const RI *ri, int a, int b);
+
+// Construit les versions SSA des variables (phi, lectures et définitions)
+void RI_ConstruireSSA(RI *ri);
+
+// Signale qu'une passe a modifié la RI : les analyses devront être recalculées
+void RI_Invalider(RI *ri);
+
+// Calcule le graphe d'appels et les globales que chaque procédure peut lire
+// et écrire, appels compris
+void RI_CalculerEffets(RI *ri);
+
+// Indique si la valeur v (appel, écriture indirecte, INN) peut écrire la variable var
+// (effets à jour). Une case du cadre n'est écrite que par un appel qui reçoit son adresse.
+int  RI_PeutEcrire(const RI *ri, int v, int var);
+
+// Indique si la valeur v (appel, lecture indirecte) peut lire la variable var sans la nommer
+// (effets à jour)
+int  RI_PeutLire(const RI *ri, int v, int var);
+
+// Trouve les boucles naturelles, les plus petites d'abord. Retourne leur nombre.
+int  RI_TrouverBoucles(RI *ri, RI_Boucle **boucles);
+
+// Indique si le bloc b appartient à la boucle
+int  RI_DansBoucle(const RI_Boucle *l, int b);
+
+// Crée (ou retrouve) le bloc de pré-en-tête de la boucle i : les arcs entrant dans
+// l'en-tête depuis l'extérieur y sont redirigés. Il est ajouté aux boucles englobantes.
+int  RI_PreEntete(RI *ri, RI_Boucle *boucles, int nBoucles, int i);
+
+// Libère les boucles
+void RI_LibererBoucles(RI_Boucle *boucles, int nBoucles);
+
+#endif
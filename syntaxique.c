@@ -1,881 +1,1588 @@
-#include "syntaxique.h"
-#include "analyse_lexical.h"
-#include "semantique.h"
-#include "generation_pcode.h"
-
-// Structure pour gérer les paramètres locaux d'une procédure/fonction
-typedef struct
-{
-    char name[32];     // Nom du paramètre
-    DataType type;     // Type du paramètre (int, real, etc.)
-    int index;         // Index local où ce paramètre est placé
-} LocalParam;
-
-// Tableau pour stocker les paramètres locaux (taille max 50)
-static LocalParam localParams[50];
-// Compteur indiquant le nombre de paramètres locaux enregistrés
-static int localCount = 0;
-
-// Initialise le compteur de paramètres locaux à 0
-static void initLocalParams()
-{
-    localCount = 0; // Remise à zéro des paramètres locaux
-}
-
-// Ajoute un paramètre local dans le tableau et retourne son index
-static int addLocalParam(const char *nom, DataType t)
-{
-    strcpy(localParams[localCount].name, nom); // Copie le nom du paramètre
-    localParams[localCount].type = t;            // Enregistre le type du paramètre
-    localParams[localCount].index = localCount;    // L'index correspond au compteur actuel
-    localCount++;                                // Incrémente le compteur
-    return localCount - 1;                       // Retourne l'index du paramètre ajouté
-}
-
-// Cherche et retourne l'index d'un paramètre local à partir de son nom
-static int findLocalParamIndex(const char *nom)
-{
-    for (int i = 0; i < localCount; i++)
-    {
-        if (!strcmp(localParams[i].name, nom))   // Compare le nom recherché avec ceux existants
-            return localParams[i].index;         // Retourne l'index si trouvé
-    }
-    return -1; // Retourne -1 si aucun paramètre local n'est trouvé
-}
-
-// Vérifie si l'identifiant correspond au mot-clé "result" dans une fonction
-static int isResultKeyword(const char *nm)
-{
-    // Si on est dans une fonction et que le nom est "result" (en minuscules)
-    return (insideAFunction && strcmp(nm, "result") == 0);
-}
-
-// ==============================
-// Déclarations anticipées
-// ==============================
-
-// Analyse la liste de paramètres d'une procédure ou fonction
-static void parseParamList(int indexProcFunc);
-// Analyse la liste des arguments dans un appel de proc/fonction
-static void parseArguments(int indexProcFunc);
-
-// ---------------------------------------------------------------------
-// Fonction principale du programme
-// ---------------------------------------------------------------------
-void Program()
-{
-    testSym(PROGRAM_TOKEN); // Doit commencer par le token "program"
-    testSym(ID_TOKEN);      // Ensuite, un identifiant (le nom du programme)
-    testSym(PV_TOKEN);      // Puis un point-virgule
-
-    // Boucle pour traiter plusieurs sections const/type/var
-    while (symCour.cls == CONST_TOKEN ||
-           symCour.cls == TYPE_TOKEN ||
-           symCour.cls == VAR_TOKEN)
-    {
-        switch (symCour.cls)
-        {
-        case CONST_TOKEN:
-            testSym(CONST_TOKEN);
-            ConstDecl(); // Déclaration des constantes
-            break;
-        case TYPE_TOKEN:
-            testSym(TYPE_TOKEN);
-            TypeDecl();  // Déclaration des types
-            break;
-        case VAR_TOKEN:
-            testSym(VAR_TOKEN);
-            VarDecl();   // Déclaration des variables
-            break;
-        default:
-            break;
-        }
-    }
-
-    // Génère un branchement (BRN) provisoire vers le code principal
-    Ecrire2(BRN, 0);
-    int jumpOverProcsIndex = PC; // Sauvegarde de l'adresse du saut
-
-    // Génère le code pour les procédures et fonctions
-    ProcFuncPart();
-
-    // Fixe la cible du saut pour pointer après le code des proc/fonctions
-    int afterProcs = PC + 1;
-    PCODE[jumpOverProcsIndex].SUITE = afterProcs;
-
-    // Analyse le bloc principal du programme
-    Bloc();
-    testSym(PT_TOKEN); // Doit terminer par un point
-    Ecrire1(HLT);     // Génère l'instruction d'arrêt (halt)
-}
-
-// ---------------------------------------------------------------------
-// Analyse un bloc : const/type/var locaux + instructions
-// ---------------------------------------------------------------------
-void Bloc()
-{
-    // Gestion des déclarations locales (const, type, var)
-    while (symCour.cls == CONST_TOKEN ||
-           symCour.cls == TYPE_TOKEN ||
-           symCour.cls == VAR_TOKEN)
-    {
-        switch (symCour.cls)
-        {
-        case CONST_TOKEN:
-            testSym(CONST_TOKEN);
-            ConstDecl(); // Déclaration locale de constantes
-            break;
-        case TYPE_TOKEN:
-            testSym(TYPE_TOKEN);
-            TypeDecl();  // Déclaration locale de types
-            break;
-        case VAR_TOKEN:
-            testSym(VAR_TOKEN);
-            VarDecl();   // Déclaration locale de variables
-            break;
-        default:
-            break;
-        }
-    }
-
-    testSym(BEGIN_TOKEN); // Début du bloc d'instructions (mot-clé 'begin')
-    Insts();            // Analyse la séquence d'instructions
-    testSym(END_TOKEN); // Fin du bloc (mot-clé 'end')
-}
-
-// ---------------------------------------------------------------------
-// Analyse une séquence d'instructions séparées par des ';'
-// ---------------------------------------------------------------------
-void Insts()
-{
-    Inst(); // Analyse la première instruction
-    while (symCour.cls == PV_TOKEN) // Tant qu'il y a un point-virgule
-    {
-        testSym(PV_TOKEN); // Consomme le point-virgule
-        if (symCour.cls == END_TOKEN || symCour.cls == UNTIL_TOKEN || symCour.cls == ELSE_TOKEN)
-        {
-            break; // Arrête si fin du bloc ou condition d'arrêt d'une boucle/structure
-        }
-        Inst(); // Analyse l'instruction suivante
-    }
-}
-
-// ---------------------------------------------------------------------
-// Analyse une instruction selon son type
-// ---------------------------------------------------------------------
-void Inst()
-{
-    switch (symCour.cls)
-    {
-    // Si c'est un identifiant, cela peut être un appel de proc/fonction ou une affectation
-    case ID_TOKEN:
-        CallOrAssign();
-        break;
-
-    case IF_TOKEN:
-    {
-        testSym(IF_TOKEN); // Consomme le token "if"
-        Cond();            // Analyse la condition
-        testSym(THEN_TOKEN); // Attend le token "then"
-        int jumpIf = PC + 1; // Adresse pour le saut conditionnel
-        Ecrire2(BZE, 0);     // Génère un branchement si la condition est fausse
-        Inst();            // Analyse l'instruction du bloc "then"
-        if (symCour.cls == ELSE_TOKEN)
-        {
-            int jumpElse = PC + 1; // Prépare un saut pour le bloc "else"
-            Ecrire2(BRN, 0);       // Génère un branchement non conditionnel
-            PCODE[jumpIf].SUITE = PC + 1; // Fixe la cible du saut du "then"
-            testSym(ELSE_TOKEN);   // Consomme le token "else"
-            Inst();              // Analyse le bloc "else"
-            PCODE[jumpElse].SUITE = PC + 1; // Fixe la cible du saut après "else"
-        }
-        else
-        {
-            PCODE[jumpIf].SUITE = PC + 1; // Fixe le saut de fin du "if"
-        }
-    }
-    break;
-
-    case WHILE_TOKEN:
-    {
-        testSym(WHILE_TOKEN); // Consomme le token "while"
-        int condAddr = PC + 1; // Adresse du début de la condition
-        Cond();              // Analyse la condition de la boucle
-        testSym(DO_TOKEN);   // Attend le token "do"
-        int jumpOut = PC + 1; // Adresse pour sortir de la boucle
-        Ecrire2(BZE, 0);     // Génère le branchement de sortie si la condition est fausse
-        Inst();              // Analyse l'instruction à répéter
-        Ecrire2(BRN, condAddr); // Retourne à l'évaluation de la condition
-        PCODE[jumpOut].SUITE = PC + 1; // Fixe la cible du saut de sortie
-    }
-    break;
-
-    case REPEAT_TOKEN:
-        RepeatInst(); // Analyse l'instruction "repeat...until"
-        break;
-
-    case FOR_TOKEN:
-        ForInst(); // Analyse la boucle "for"
-        break;
-
-    case CASE_TOKEN:
-        CaseInst(); // Analyse la structure "case"
-        break;
-
-    case BEGIN_TOKEN:
-        testSym(BEGIN_TOKEN); // Consomme le token "begin"
-        Insts();            // Analyse la séquence d'instructions du bloc
-        testSym(END_TOKEN);   // Consomme le token "end"
-        break;
-
-    case WRITE_TOKEN:
-    {
-        testSym(WRITE_TOKEN); // Consomme "write"
-        testSym(PRG_TOKEN);   // Consomme '('
-        do
-        {
-            Exp();        // Analyse une expression à écrire
-            Ecrire1(PRN); // Génère l'instruction d'impression
-            if (symCour.cls == VIR_TOKEN)
-                testSym(VIR_TOKEN); // Consomme la virgule s'il y a plusieurs arguments
-            else
-                break;
-        } while (1);
-        testSym(PRD_TOKEN); // Consomme ')'
-    }
-    break;
-
-    case READ_TOKEN:
-    {
-        testSym(READ_TOKEN); // Consomme "read"
-        testSym(PRG_TOKEN);  // Consomme '('
-        do
-        {
-            char nm[32];
-            strcpy(nm, symCour.nom); // Sauvegarde le nom de la variable
-            testSym(ID_TOKEN);       // Consomme l'identifiant
-            int ad = getAdresse(nm); // Récupère l'adresse de la variable
-            Ecrire2(LDI, ad);        // Charge l'adresse en immédiat
-            Ecrire1(INN);            // Génère l'instruction de lecture (input)
-            if (symCour.cls == VIR_TOKEN)
-                testSym(VIR_TOKEN);  // Gère la virgule entre plusieurs variables
-            else
-                break;
-        } while (1);
-        testSym(PRD_TOKEN); // Consomme ')'
-    }
-    break;
-
-    default:
-        Error("Unknown instruction"); // Affiche une erreur pour instruction inconnue
-    }
-}
-
-// ---------------------------------------------------------------------
-// Analyse une condition booléenne (opérations relationnelles)
-// ---------------------------------------------------------------------
-void Cond()
-{
-    Exp(); // Analyse une expression
-    TokenType t = symCour.cls; // Sauvegarde l'opérateur relationnel
-    if (t == EGAL_TOKEN || t == DIFF_TOKEN ||
-        t == INF_TOKEN || t == INFEG_TOKEN ||
-        t == SUP_TOKEN || t == SUPEG_TOKEN)
-    {
-        testSym(t); // Consomme l'opérateur
-        Exp();      // Analyse l'expression après l'opérateur
-        switch (t)
-        {
-        case EGAL_TOKEN:
-            Ecrire1(EQL); // Génère l'instruction d'égalité
-            break;
-        case DIFF_TOKEN:
-            Ecrire1(NEQ); // Génère l'instruction de différence
-            break;
-        case INF_TOKEN:
-            Ecrire1(LSS); // Génère l'instruction de "plus petit que"
-            break;
-        case INFEG_TOKEN:
-            Ecrire1(LEQ); // Génère l'instruction de "inférieur ou égal"
-            break;
-        case SUP_TOKEN:
-            Ecrire1(GTR); // Génère l'instruction de "plus grand que"
-            break;
-        case SUPEG_TOKEN:
-            Ecrire1(GEQ); // Génère l'instruction de "supérieur ou égal"
-            break;
-        default:
-            break;
-        }
-    }
-    else
-    {
-        Error("Relational operator expected"); // Erreur si opérateur non trouvé
-    }
-}
-
-// ---------------------------------------------------------------------
-// Analyse une expression arithmétique (addition/soustraction)
-// ---------------------------------------------------------------------
-void Exp()
-{
-    Term(); // Analyse un terme
-    while (symCour.cls == PLUS_TOKEN || symCour.cls == MOINS_TOKEN)
-    {
-        TokenType t = symCour.cls;
-        testSym(t); // Consomme l'opérateur + ou -
-        Term();     // Analyse le terme suivant
-        if (t == PLUS_TOKEN)
-            Ecrire1(ADD); // Génère l'instruction d'addition
-        else
-            Ecrire1(SUB); // Génère l'instruction de soustraction
-    }
-}
-
-// ---------------------------------------------------------------------
-// Analyse un terme dans une expression (multiplication/division)
-// ---------------------------------------------------------------------
-void Term()
-{
-    Fact(); // Analyse un facteur
-    while (symCour.cls == MULTI_TOKEN || symCour.cls == DIV_TOKEN)
-    {
-        TokenType t = symCour.cls;
-        testSym(t); // Consomme * ou /
-        Fact();     // Analyse le facteur suivant
-        if (t == MULTI_TOKEN)
-            Ecrire1(MUL); // Génère l'instruction de multiplication
-        else
-            Ecrire1(DIVI); // Génère l'instruction de division entière
-    }
-}
-
-// ---------------------------------------------------------------------
-// Analyse un facteur (identifiant, nombre, expression entre parenthèses, etc.)
-// ---------------------------------------------------------------------
-void Fact()
-{
-    switch (symCour.cls)
-    {
-    case ID_TOKEN:
-    {
-        char nm[32];
-        strcpy(nm, symCour.nom); // Sauvegarde le nom de l'identifiant
-        testSym(ID_TOKEN);       // Consomme l'identifiant
-
-        if (isFunction(nm))
-        {
-            // Si c'est une fonction, il peut y avoir des arguments entre parenthèses
-            int idxF = getProcFuncIndex(nm);
-            if (symCour.cls == PRG_TOKEN) // Si '(' est présent
-            {
-                testSym(PRG_TOKEN);
-                parseArguments(idxF); // Analyse les arguments
-                testSym(PRD_TOKEN);
-            }
-            else
-            {
-                // Appel de fonction sans argument
-                Ecrire2(PUSH_PARAMS_COUNT, 0);
-            }
-            // Génère l'instruction CALL pour appeler la fonction
-            Ecrire2(CALL, TAB_IDFS[idxF].Adresse);
-            // Le résultat de la fonction reste sur la pile pour être utilisé dans l'expression
-        }
-        else if (isProcedure(nm))
-        {
-            // En Pascal, on ne peut pas appeler une procédure dans une expression
-            Error("Cannot call a procedure in an expression context");
-        }
-        else
-        {
-            // Sinon, c'est une variable, constante, ou paramètre local
-            int localIdx = findLocalParamIndex(nm);
-            if (insideAFunction && localIdx == 0 && !strcmp(nm, currentFunctionName))
-            {
-                // Si c'est la variable résultat de la fonction (local #0)
-                Ecrire2(LDL, 0);
-            }
-            else if (localIdx >= 0)
-            {
-                // Si c'est un paramètre local (pass-by-ref)
-                Ecrire2(LDL, localIdx);
-                Ecrire1(LDV);
-            }
-            else if (isVar(nm))
-            {
-                // Si c'est une variable globale
-                int adr = getAdresse(nm);
-                Ecrire2(LDA, adr);
-                Ecrire1(LDV);
-            }
-            else if (isConst(nm))
-            {
-                // Si c'est une constante, on charge sa valeur
-                DataType ctype = TYPE_UNDEF;
-                for (int i = 0; i < NBR_IDFS; i++)
-                {
-                    if (!strcmp(TAB_IDFS[i].Nom, nm) && TAB_IDFS[i].TIDF == TCONST)
-                    {
-                        ctype = TAB_IDFS[i].type;
-                        break;
-                    }
-                }
-                if (ctype == TYPE_INT)
-                {
-                    int c = getConstValue(nm);
-                    Ecrire2(LDI, c);
-                }
-                else if (ctype == TYPE_REAL)
-                {
-                    float c = getConstFValue(nm);
-                    int int_repr;
-                    memcpy(&int_repr, &c, sizeof(float));
-                    Ecrire2(LDF, int_repr);
-                }
-                else
-                {
-                    Error("Unsupported constant type in Fact()");
-                }
-            }
-            else
-            {
-                // Si l'identifiant est inconnu
-                Error("Unknown identifier in Fact()");
-            }
-        }
-    }
-    break;
-
-    case NUM_TOKEN:
-    {
-        // Nombre entier littéral
-        int v = atoi(symCour.nom);
-        testSym(NUM_TOKEN);
-        Ecrire2(LDI, v);
-    }
-    break;
-
-    case REAL_TOKEN:
-    {
-        // Nombre réel littéral
-        float vf = atof(symCour.nom);
-        testSym(REAL_TOKEN);
-        int int_repr;
-        memcpy(&int_repr, &vf, sizeof(float));
-        Ecrire2(LDF, int_repr);
-    }
-    break;
-
-    case PRG_TOKEN:
-        // Expression entre parenthèses
-        testSym(PRG_TOKEN);
-        Exp();
-        testSym(PRD_TOKEN);
-        break;
-
-    default:
-        Error("Invalid factor"); // Erreur si facteur invalide
-        break;
-    }
-}
-
-// ---------------------------------------------------------------------
-// Analyse une instruction "repeat ... until"
-// ---------------------------------------------------------------------
-void RepeatInst()
-{
-    testSym(REPEAT_TOKEN); // Consomme "repeat"
-    int start = PC + 1;    // Position de début du bloc répété
-    Insts();             // Analyse les instructions à répéter
-    testSym(UNTIL_TOKEN);  // Attend "until"
-    Cond();              // Analyse la condition de sortie
-    Ecrire2(BZE, start); // Si la condition est fausse, retourne au début du bloc
-}
-
-// ---------------------------------------------------------------------
-// Analyse une boucle "for"
-// ---------------------------------------------------------------------
-void ForInst()
-{
-    testSym(FOR_TOKEN); // Consomme "for"
-    if (symCour.cls != ID_TOKEN)
-        Error("Identifier expected after FOR");
-    char varFor[32];
-    strcpy(varFor, symCour.nom); // Sauvegarde le nom de la variable de boucle
-    testSym(ID_TOKEN);
-    testSym(AFFECT_TOKEN); // Consomme ":="
-    Exp();               // Analyse l'expression d'initialisation
-    int addrVar = getAdresse(varFor); // Récupère l'adresse de la variable de boucle
-    Ecrire2(STO, addrVar); // Stocke la valeur initiale dans la variable
-
-    int sens = 0;
-    if (symCour.cls == TO_TOKEN)
-    {
-        sens = 0;         // Boucle croissante
-        testSym(TO_TOKEN);  // Consomme "to"
-    }
-    else if (symCour.cls == DOWNTO_TOKEN)
-    {
-        sens = 1;         // Boucle décroissante
-        testSym(DOWNTO_TOKEN); // Consomme "downto"
-    }
-    else
-    {
-        Error("TO or DOWNTO expected"); // Erreur si ni "to" ni "downto"
-    }
-
-    Exp(); // Analyse l'expression de la limite
-    int slotFin = OFFSET++;  // Emplacement pour stocker la valeur de fin
-    Ecrire2(STO, slotFin);   // Stocke la limite dans le slot dédié
-    testSym(DO_TOKEN);       // Consomme "do"
-
-    int condAddr = PC + 1;   // Adresse de retour pour réévaluer la condition
-    Ecrire2(LDA, addrVar);   // Charge l'adresse de la variable de boucle
-    Ecrire1(LDV);          // Charge la valeur de la variable
-    Ecrire2(LDA, slotFin);  // Charge l'adresse du slot de fin
-    Ecrire1(LDV);          // Charge la limite
-    if (sens == 0)
-        Ecrire1(LEQ);      // Génère l'instruction de "inférieur ou égal" pour boucle croissante
-    else
-        Ecrire1(GEQ);      // Génère l'instruction de "supérieur ou égal" pour boucle décroissante
-
-    int jumpEnd = PC + 1;  // Adresse pour sortir de la boucle
-    Ecrire2(BZE, 0);       // Branche si la condition n'est pas satisfaite
-
-    Inst();              // Analyse le corps de la boucle
-
-    Ecrire2(LDA, addrVar); // Recharge l'adresse de la variable de boucle
-    Ecrire1(LDV);         // Recharge sa valeur
-    Ecrire2(LDI, 1);      // Charge la valeur 1 pour incrémenter/décrémenter
-    if (sens == 0)
-        Ecrire1(ADD);    // Additionne 1 pour boucle croissante
-    else
-        Ecrire1(SUB);    // Soustrait 1 pour boucle décroissante
-    Ecrire2(STO, addrVar); // Stocke la nouvelle valeur dans la variable
-    Ecrire2(BRN, condAddr); // Revient à la condition de boucle
-    PCODE[jumpEnd].SUITE = PC + 1; // Fixe le saut de sortie
-}
-
-// ---------------------------------------------------------------------
-// Analyse une structure "case"
-// ---------------------------------------------------------------------
-void CaseInst()
-{
-    testSym(CASE_TOKEN); // Consomme "case"
-    Exp();             // Analyse l'expression à comparer
-    int tmpSlot = OFFSET++; // Alloue un emplacement temporaire
-    Ecrire2(STO, tmpSlot);  // Stocke la valeur dans le slot temporaire
-    testSym(OF_TOKEN);   // Consomme "of"
-
-    int jumpEndLabels[50]; // Tableau pour stocker les labels de fin de chaque branche
-    int nEnd = 0;          // Compteur de labels de fin
-
-    // Traite chaque branche "valeur : instruction"
-    while (symCour.cls == NUM_TOKEN)
-    {
-        int labelVal = atoi(symCour.nom); // Convertit le numéro de label en entier
-        testSym(NUM_TOKEN);
-        testSym(COLON_TOKEN);
-
-        Ecrire2(LDA, tmpSlot); // Recharge la valeur stockée
-        Ecrire1(LDV);
-        Ecrire2(LDI, labelVal); // Charge le label courant
-        Ecrire1(EQL);          // Vérifie l'égalité
-
-        int jumpIfNot = PC + 1;  // Prépare un saut si la condition est fausse
-        Ecrire2(BZE, 0);
-        Inst();               // Analyse les instructions de la branche
-        int jumpAfter = PC + 1; // Prépare un saut pour sortir de la branche
-        Ecrire2(BRN, 0);
-        jumpEndLabels[nEnd++] = jumpAfter; // Enregistre le label de fin
-        PCODE[jumpIfNot].SUITE = PC + 1; // Fixe la cible du saut si égalité non satisfaite
-
-        if (symCour.cls == PV_TOKEN)
-            testSym(PV_TOKEN); // Consomme le point-virgule si présent
-        else
-            break;
-    }
-    if (symCour.cls == ELSE_TOKEN)
-    {
-        testSym(ELSE_TOKEN); // Consomme "else"
-        Inst();            // Analyse l'instruction pour la branche "else"
-        int jumpAfterElse = PC + 1;
-        Ecrire2(BRN, 0);
-        jumpEndLabels[nEnd++] = jumpAfterElse;
-        if (symCour.cls == PV_TOKEN)
-            testSym(PV_TOKEN); // Consomme le point-virgule
-    }
-    testSym(END_TOKEN); // Consomme "end"
-    int endOfCase = PC + 1; // Adresse de fin de la structure "case"
-    // Fixe tous les sauts enregistrés à la fin de la structure
-    for (int i = 0; i < nEnd; i++)
-    {
-        PCODE[jumpEndLabels[i]].SUITE = endOfCase;
-    }
-}
-
-// ---------------------------------------------------------------------
-// Analyse la partie des procédures et fonctions
-// ---------------------------------------------------------------------
-void ProcFuncPart()
-{
-    // Tant qu'on trouve "procedure" ou "function", on les traite
-    while (symCour.cls == PROCEDURE_TOKEN || symCour.cls == FUNCTION_TOKEN)
-    {
-        if (symCour.cls == PROCEDURE_TOKEN)
-            ProcDecl(); // Déclaration d'une procédure
-        else
-            FuncDecl(); // Déclaration d'une fonction
-    }
-}
-
-// ---------------------------------------------------------------------
-// Déclaration d'une procédure : procedure <id> (paramlist); Bloc; RET <n>
-// ---------------------------------------------------------------------
-void ProcDecl()
-{
-    initLocalParams(); // Initialise les paramètres locaux
-
-    testSym(PROCEDURE_TOKEN); // Consomme "procedure"
-    char procName[32];
-    strcpy(procName, symCour.nom); // Enregistre le nom de la procédure
-    testSym(ID_TOKEN);
-
-    if (IDexists(procName))
-        Error("Procedure name already used"); // Erreur si le nom existe déjà
-    int idx = NBR_IDFS; // Index pour enregistrer la procédure dans la table des identifiants
-
-    strcpy(TAB_IDFS[idx].Nom, procName); // Enregistre le nom dans la table
-    TAB_IDFS[idx].TIDF = TPROC;          // Marque comme procédure
-    TAB_IDFS[idx].type = TYPE_UNDEF;     // Type non défini (procédure n'a pas de type de retour)
-    TAB_IDFS[idx].Adresse = -1;          // Adresse initiale inconnue
-    TAB_IDFS[idx].Value = 0;             // Nombre de paramètres initialisé à 0
-    NBR_IDFS++;                          // Incrémente le nombre d'identifiants
-
-    parseParamList(idx); // Analyse la liste des paramètres
-    testSym(PV_TOKEN);   // Consomme le point-virgule
-
-    // Enregistre l'adresse de début du code de la procédure
-    int startPC = PC + 1;
-    TAB_IDFS[idx].Adresse = startPC;
-
-    // Charge chaque paramètre depuis le cadre d'appel et l'assigne au slot local correspondant
-    for (int p = 0; p < TAB_IDFS[idx].Value; p++)
-    {
-        Ecrire2(LDL, p); // Charge le paramètre depuis le cadre d'appel
-        Ecrire2(STL, p); // Stocke le paramètre dans le slot local
-    }
-
-    Bloc();         // Analyse le bloc de la procédure
-    testSym(PV_TOKEN); // Consomme le point-virgule final
-
-    // Génère l'instruction de retour avec le nombre de paramètres
-    Ecrire2(RET, TAB_IDFS[idx].Value);
-}
-
-// ---------------------------------------------------------------------
-// Déclaration d'une fonction : function <id> (paramlist) : <type>; Bloc; (push result) RET <n>
-// ---------------------------------------------------------------------
-void FuncDecl()
-{
-    initLocalParams(); // Initialise les paramètres locaux
-
-    testSym(FUNCTION_TOKEN); // Consomme "function"
-    char fnName[32];
-    strcpy(fnName, symCour.nom); // Enregistre le nom de la fonction
-    testSym(ID_TOKEN);
-
-    int idx = NBR_IDFS;      // Index pour la table des identifiants
-    strcpy(TAB_IDFS[idx].Nom, fnName); // Enregistre le nom
-    TAB_IDFS[idx].TIDF = TFUNC;        // Marque comme fonction
-    TAB_IDFS[idx].Adresse = -1;        // Adresse initiale inconnue
-    TAB_IDFS[idx].Value = 0;           // Nombre de paramètres initialisé à 0
-    TAB_IDFS[idx].type = TYPE_INT;     // Par défaut, le type de retour est entier
-    NBR_IDFS++;                        // Incrémente le nombre d'identifiants
-
-    parseParamList(idx);  // Analyse la liste de paramètres et met à jour TAB_IDFS[idx].Value
-    testSym(COLON_TOKEN); // Consomme ":"
-    DataType retType = parseBaseType(); // Analyse le type de retour
-    TAB_IDFS[idx].type = retType;       // Enregistre le type de retour
-    testSym(PV_TOKEN);    // Consomme le point-virgule
-
-    insideAFunction = 1; // Indique qu'on est dans une fonction
-    strcpy(currentFunctionName, fnName); // Enregistre le nom de la fonction courante
-    
-    int startPC = PC + 1; // Adresse de début du code de la fonction
-    TAB_IDFS[idx].Adresse = startPC;
-
-    // Charge chaque paramètre depuis le cadre d'appel vers le slot local correspondant
-    for (int p = 0; p < TAB_IDFS[idx].Value; p++) {
-        Ecrire2(LDL, p);
-        Ecrire2(STL, p);
-    }
-
-    Bloc();             // Analyse le bloc de la fonction
-    testSym(PV_TOKEN);  // Consomme le point-virgule final
-
-    // Pousse la valeur résultat de la fonction (stockée en local #0) sur la pile
-    Ecrire2(LDL, 0);
-    
-    // Génère l'instruction de retour avec le nombre de paramètres
-    Ecrire2(RET, TAB_IDFS[idx].Value);
-
-    insideAFunction = 0;    // Quitte le contexte de fonction
-    currentFunctionName[0] = '\0'; // Réinitialise le nom de la fonction courante
-}
-
-// ---------------------------------------------------------------------
-// Analyse un appel ou une affectation à partir d'un identifiant
-// ---------------------------------------------------------------------
-void CallOrAssign()
-{
-    char name[32];
-    strcpy(name, symCour.nom); // Sauvegarde le nom de l'identifiant
-    testSym(ID_TOKEN);         // Consomme l'identifiant
-
-    // Si on est dans une fonction et que l'identifiant correspond au nom de la fonction,
-    // il s'agit d'une affectation au résultat de la fonction (local #0)
-    if (insideAFunction && strcmp(name, currentFunctionName) == 0)
-    {
-        testSym(AFFECT_TOKEN); // Consomme ":="
-        Exp();                 // Analyse l'expression à assigner
-        Ecrire2(STL, 0);       // Stocke le résultat dans le slot local #0
-        return;
-    }
-
-    // Sinon, vérifie si l'identifiant correspond à une procédure ou fonction connue
-    int isProc = isProcedure(name);
-    int isFunc = isFunction(name);
-
-    if (isProc || isFunc)
-    {
-        // Appel de procédure ou fonction
-        int idxPF = getProcFuncIndex(name);
-
-        // Analyse les arguments optionnels : soit "(...)" soit zéro argument
-        if (symCour.cls == PRG_TOKEN)
-        {
-            testSym(PRG_TOKEN);
-            parseArguments(idxPF); // Analyse les arguments fournis
-            testSym(PRD_TOKEN);
-        }
-        else
-        {
-            // Cas d'appel avec zéro argument
-            Ecrire2(PUSH_PARAMS_COUNT, 0);
-        }
-        // Génère l'instruction CALL pour effectuer l'appel
-        Ecrire2(CALL, TAB_IDFS[idxPF].Adresse);
-
-        // Si l'appel de fonction est dans un contexte d'instruction, on doit jeter le résultat
-        if (isFunc)
-            Ecrire2(STO, -9999); // Pop le résultat de la pile (valeur jetée)
-    }
-    else
-    {
-        // Sinon, c'est une affectation de variable : "ID := exp"
-        testSym(AFFECT_TOKEN); // Consomme ":="
-        Exp();                 // Analyse l'expression de droite
-        // Détermine si l'identifiant est un paramètre local ou une variable globale
-        int localIdx = findLocalParamIndex(name);
-        if (localIdx >= 0)
-        {
-            Ecrire2(LDL, localIdx); // Charge l'adresse du paramètre local
-            Ecrire1(STO_IND);       // Stocke indirectement la valeur dans la mémoire locale
-        }
-        else
-        {
-            int adr = getAdresse(name); // Récupère l'adresse globale de la variable
-            Ecrire2(STO, adr);          // Stocke la valeur dans l'adresse globale
-        }
-    }
-}
-
-// ---------------------------------------------------------------------
-// Analyse la liste des paramètres dans une déclaration de proc/fonction
-// ---------------------------------------------------------------------
-static void parseParamList(int indexProcFunc)
-{
-    int total = 0; // Nombre total de paramètres
-    if (symCour.cls == PRG_TOKEN)
-    {
-        testSym(PRG_TOKEN); // Consomme '('
-        while (symCour.cls == ID_TOKEN)
-        {
-            char groupIDS[10][32]; // Groupe d'identifiants pour des paramètres partagés
-            int gCount = 0;        // Compteur pour le groupe
-            // Analyse une liste d'identifiants séparés par des virgules
-            while (symCour.cls == ID_TOKEN)
-            {
-                strcpy(groupIDS[gCount], symCour.nom); // Enregistre l'identifiant
-                gCount++;
-                testSym(ID_TOKEN); // Consomme l'identifiant
-                if (symCour.cls == VIR_TOKEN)
-                    testSym(VIR_TOKEN); // Consomme la virgule
-                else
-                    break;
-            }
-            testSym(COLON_TOKEN);   // Consomme ':'
-            DataType ptype = parseBaseType(); // Analyse le type de base du paramètre
-
-            // Enregistre chaque identifiant du groupe comme paramètre local
-            for (int i = 0; i < gCount; i++)
-            {
-                addLocalParam(groupIDS[i], ptype);
-                total++;
-            }
-
-            if (symCour.cls == PV_TOKEN)
-                testSym(PV_TOKEN); // Consomme le point-virgule séparant les groupes
-            else
-                break;
-        }
-        testSym(PRD_TOKEN); // Consomme ')'
-    }
-    TAB_IDFS[indexProcFunc].Value = total; // Stocke le nombre total de paramètres dans la table d'identifiants
-}
-
-// ---------------------------------------------------------------------
-// Analyse la liste des arguments dans un appel de proc/fonction
-// ---------------------------------------------------------------------
-static void parseArguments(int indexProcFunc)
-{
-    int nbParams = TAB_IDFS[indexProcFunc].Value; // Nombre de paramètres attendus
-    int count = 0; // Compteur d'arguments fournis
-
-    if (symCour.cls != PRD_TOKEN)
-    {
-        while (1)
-        {
-            if (symCour.cls == ID_TOKEN)
-            {
-                int addr = getAdresse(symCour.nom); // Récupère l'adresse d'un paramètre
-                Ecrire2(LDA, addr); // Charge l'adresse du paramètre
-                testSym(ID_TOKEN); // Consomme l'identifiant
-            }
-            else
-            {
-                Exp(); // Analyse l'expression de l'argument
-            }
-            count++; // Incrémente le nombre d'arguments fournis
-
-            if (symCour.cls == VIR_TOKEN)
-                testSym(VIR_TOKEN); // Consomme la virgule séparant les arguments
-            else
-                break; // Sort de la boucle s'il n'y a plus d'arguments
-        }
-    }
-
-    // Vérifie que le nombre d'arguments fournis est correct
-    if (count != nbParams)
-    {
-        char buf[128];
-        sprintf(buf, "Incorrect number of parameters. Expected %d, got %d",
-                nbParams, count);
-        Error(buf); // Affiche une erreur en cas de désaccord
-    }
-
-    // Pousse le nombre d'arguments sur la pile pour l'appel
-    Ecrire2(PUSH_PARAMS_COUNT, count);
-}
+#include "syntaxique.h"
+#include "analyse_lexical.h"
+#include "semantique.h"
+#include "generation_pcode.h"
+#include <pthread.h>  // pthread_create, pthread_join, pthread_mutex_t
+#include <unistd.h>   // sysconf
+
+// Structure pour gérer les paramètres locaux d'une procédure/fonction
+typedef struct
+{
+    char name[32];     // Nom du paramètre
+    DataType type;     // Type du paramètre (int, real, etc.)
+    int index;         // Index local où ce paramètre est placé
+} LocalParam;
+
+// Variable statique indiquant si on est dans une fonction ou non
+// 0 = pas dans une fonction, 1 = dans une fonction
+static ETAT_PAR_FIL int insideAFunction = 0;      
+
+// Variable statique pour stocker le nom de la fonction courante
+static ETAT_PAR_FIL char currentFunctionName[64]; // Nom de la fonction que l'on analyse actuellement
+
+// Tableau pour stocker les paramètres locaux (taille max 50)
+static ETAT_PAR_FIL LocalParam localParams[50];
+// Compteur indiquant le nombre de paramètres locaux enregistrés
+static ETAT_PAR_FIL int localCount = 0;
+
+// Initialise le compteur de paramètres locaux à 0
+static void initLocalParams()
+{
+    localCount = 0; // Remise à zéro des paramètres locaux
+}
+
+// Ajoute un paramètre local dans le tableau et retourne son index
+static int addLocalParam(const char *nom, DataType t)
+{
+    strcpy(localParams[localCount].name, nom); // Copie le nom du paramètre
+    localParams[localCount].type = t;            // Enregistre le type du paramètre
+    localParams[localCount].index = localCount;    // L'index correspond au compteur actuel
+    localCount++;                                // Incrémente le compteur
+    return localCount - 1;                       // Retourne l'index du paramètre ajouté
+}
+
+// Cases du cadre qui portent la valeur d'un argument qui n'est pas une variable
+// (expression, constante, résultat de fonction). Elles restent prises jusqu'à la
+// fin de l'instruction : deux appels d'une même expression n'utilisent jamais la
+// même case, quel que soit l'ordre dans lequel leurs arguments sont rangés.
+static ETAT_PAR_FIL int casesArguments[MAX_CASES_CADRE];
+static ETAT_PAR_FIL int nCasesArguments = 0;
+
+// Nombre d'arguments de la procédure ou fonction en cours d'analyse (case du résultat comprise)
+static ETAT_PAR_FIL int nbArgsCourant = 0;
+
+// Pendant la compilation d'un corps de procédure (ProcFuncPart), les CALL
+// portent l'entrée de l'appelée dans TAB_IDFS, son adresse n'étant pas encore
+// connue ; l'édition des liens la remplace par l'adresse
+static ETAT_PAR_FIL int appelsSymboliques = 0;
+
+// Écrit l'appel de la procédure ou fonction d'entrée idx
+static void EcrireAppel(int idx)
+{
+    Ecrire2(CALL, appelsSymboliques ? idx : TAB_IDFS[idx].Adresse);
+}
+
+// Case du cadre (décalage par rapport à BP) du paramètre local d'index p :
+// dans une fonction, l'argument 0 est la case du résultat
+static int caseParametre(int p)
+{
+    return CASE_ARGUMENT(p + (insideAFunction ? 1 : 0), nbArgsCourant);
+}
+
+// Empile la valeur d'une variable : case du cadre pour une variable locale,
+// adresse fixe pour une globale
+static void chargerVariable(const char *nom)
+{
+    if (isLocalVar(nom))
+    {
+        Ecrire2(LDL, getAdresse(nom));
+    }
+    else
+    {
+        Ecrire2(LDA, getAdresse(nom));
+        Ecrire1(LDV);
+    }
+}
+
+// Dépile le sommet dans une variable (locale ou globale)
+static void rangerVariable(const char *nom)
+{
+    if (isLocalVar(nom))
+        Ecrire2(STL, getAdresse(nom));
+    else
+        Ecrire2(STO, getAdresse(nom));
+}
+
+// Empile l'adresse d'une variable : LLA pour une variable locale,
+// opGlobale (LDA ou LDI) pour une globale
+static void adresseVariable(const char *nom, Mnemoniques opGlobale)
+{
+    if (isLocalVar(nom))
+        Ecrire2(LLA, getAdresse(nom));
+    else
+        Ecrire2(opGlobale, getAdresse(nom));
+}
+
+// Cherche et retourne l'index d'un paramètre local à partir de son nom
+static int findLocalParamIndex(const char *nom)
+{
+    for (int i = 0; i < localCount; i++)
+    {
+        if (!strcmp(localParams[i].name, nom))   // Compare le nom recherché avec ceux existants
+            return localParams[i].index;         // Retourne l'index si trouvé
+    }
+    return -1; // Retourne -1 si aucun paramètre local n'est trouvé
+}
+
+// Vérifie si l'identifiant correspond au mot-clé "result" dans une fonction
+static int isResultKeyword(const char *nm)
+{
+    // Si on est dans une fonction et que le nom est "result" (en minuscules)
+    return (insideAFunction && strcmp(nm, "result") == 0);
+}
+
+// Corrige la cible de tous les sauts enregistrés dans sauts[]
+static void corrigerSauts(const int sauts[], int nSauts, int cible)
+{
+    for (int i = 0; i < nSauts; i++)
+        PCODE[sauts[i]].SUITE = cible;
+}
+
+// Génère un branchement à corriger plus tard et enregistre son indice dans sauts[]
+static void ajouterSaut(int sauts[], int *nSauts, Mnemoniques br)
+{
+    if (*nSauts >= MAX_SAUTS)
+        Error("Condition too complex");
+    Ecrire2(br, 0);
+    sauts[(*nSauts)++] = PC;
+}
+
+// Ajoute à sauts[] les n sauts en attente de autres[], dans la limite de MAX_SAUTS
+static void reporterSauts(int sauts[], int *nSauts, const int autres[], int n)
+{
+    if (*nSauts + n > MAX_SAUTS)
+        Error("Condition too complex");
+    for (int i = 0; i < n; i++)
+        sauts[(*nSauts)++] = autres[i];
+}
+
+// Retourne l'instruction qui branche quand la relation 'rel' est vraie
+static Mnemoniques brancheSiVrai(TokenType rel)
+{
+    switch (rel)
+    {
+    case EGAL_TOKEN:  return BEQ;
+    case DIFF_TOKEN:  return BNE;
+    case INF_TOKEN:   return BLT;
+    case INFEG_TOKEN: return BLE;
+    case SUP_TOKEN:   return BGT;
+    default:          return BGE;
+    }
+}
+
+// Retourne le branchement de la relation contraire (BLT <-> BGE, BEQ <-> BNE...)
+static Mnemoniques inverserBranche(Mnemoniques br)
+{
+    switch (br)
+    {
+    case BEQ: return BNE;
+    case BNE: return BEQ;
+    case BLT: return BGE;
+    case BGE: return BLT;
+    case BGT: return BLE;
+    default:  return BGT; // BLE
+    }
+}
+
+// ==============================
+// Déclarations anticipées
+// ==============================
+
+// Analyse la liste de paramètres d'une procédure ou fonction
+static void parseParamList(int indexProcFunc);
+// Analyse la liste des arguments dans un appel de proc/fonction
+static void parseArguments(int indexProcFunc);
+// Vérifie le nombre d'arguments d'un appel
+static void verifierNbArguments(int indexProcFunc, int count);
+
+// Remet à zéro l'état de la compilation et lit le premier token
+void DebutAnalyse(FILE *source)
+{
+    fsource = source;
+    line_num = 1;
+    NBR_IDFS = 0;
+    OFFSET = VAR_BASE;
+    DANS_PROCEDURE = 0;
+    PC = -1;
+    memset(PCODE, 0, sizeof(PCODE));
+    insideAFunction = 0;
+    currentFunctionName[0] = '\0';
+    localCount = 0;
+    nCasesArguments = 0;
+    nbArgsCourant = 0;
+    appelsSymboliques = 0;
+    LireCar();   // Lit le premier caractère du fichier source
+    SymSuiv();   // Analyse et charge le premier symbole/token
+}
+
+// ---------------------------------------------------------------------
+// Fonction principale du programme
+// ---------------------------------------------------------------------
+void Program()
+{
+    testSym(PROGRAM_TOKEN); // Doit commencer par le token "program"
+    testSym(ID_TOKEN);      // Ensuite, un identifiant (le nom du programme)
+    testSym(PV_TOKEN);      // Puis un point-virgule
+
+    // Boucle pour traiter plusieurs sections const/type/var
+    while (symCour.cls == CONST_TOKEN ||
+           symCour.cls == TYPE_TOKEN ||
+           symCour.cls == VAR_TOKEN)
+    {
+        switch (symCour.cls)
+        {
+        case CONST_TOKEN:
+            testSym(CONST_TOKEN);
+            ConstDecl(); // Déclaration des constantes
+            break;
+        case TYPE_TOKEN:
+            testSym(TYPE_TOKEN);
+            TypeDecl();  // Déclaration des types
+            break;
+        case VAR_TOKEN:
+            testSym(VAR_TOKEN);
+            VarDecl();   // Déclaration des variables
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Génère un branchement (BRN) provisoire vers le code principal
+    Ecrire2(BRN, 0);
+    int jumpOverProcsIndex = PC; // Sauvegarde de l'adresse du saut
+
+    // Génère le code pour les procédures et fonctions
+    ProcFuncPart();
+
+    // Fixe la cible du saut pour pointer après le code des proc/fonctions
+    int afterProcs = PC + 1;
+    PCODE[jumpOverProcsIndex].SUITE = afterProcs;
+
+    // Analyse le bloc principal du programme ; ses temporaires sont dans son cadre
+    DebutCadre();
+    Bloc();
+    testSym(PT_TOKEN); // Doit terminer par un point
+    Ecrire1(HLT);     // Génère l'instruction d'arrêt (halt)
+    FinCadre();
+}
+
+// ---------------------------------------------------------------------
+// Analyse un bloc : const/type/var locaux + instructions
+// ---------------------------------------------------------------------
+void Bloc()
+{
+    // Gestion des déclarations locales (const, type, var)
+    while (symCour.cls == CONST_TOKEN ||
+           symCour.cls == TYPE_TOKEN ||
+           symCour.cls == VAR_TOKEN)
+    {
+        switch (symCour.cls)
+        {
+        case CONST_TOKEN:
+            testSym(CONST_TOKEN);
+            ConstDecl(); // Déclaration locale de constantes
+            break;
+        case TYPE_TOKEN:
+            testSym(TYPE_TOKEN);
+            TypeDecl();  // Déclaration locale de types
+            break;
+        case VAR_TOKEN:
+            testSym(VAR_TOKEN);
+            VarDecl();   // Déclaration locale de variables
+            break;
+        default:
+            break;
+        }
+    }
+
+    testSym(BEGIN_TOKEN); // Début du bloc d'instructions (mot-clé 'begin')
+    Insts();            // Analyse la séquence d'instructions
+    testSym(END_TOKEN); // Fin du bloc (mot-clé 'end')
+}
+
+// ---------------------------------------------------------------------
+// Analyse une séquence d'instructions séparées par des ';'
+// ---------------------------------------------------------------------
+void Insts()
+{
+    Inst(); // Analyse la première instruction
+    while (symCour.cls == PV_TOKEN) // Tant qu'il y a un point-virgule
+    {
+        testSym(PV_TOKEN); // Consomme le point-virgule
+        if (symCour.cls == END_TOKEN || symCour.cls == UNTIL_TOKEN || symCour.cls == ELSE_TOKEN)
+        {
+            break; // Arrête si fin du bloc ou condition d'arrêt d'une boucle/structure
+        }
+        Inst(); // Analyse l'instruction suivante
+    }
+}
+
+// ---------------------------------------------------------------------
+// Analyse une instruction selon son type
+// ---------------------------------------------------------------------
+void Inst()
+{
+    int casesAvant = nCasesArguments; // Cases d'arguments prises avant cette instruction
+    switch (symCour.cls)
+    {
+    // Si c'est un identifiant, cela peut être un appel de proc/fonction ou une affectation
+    case ID_TOKEN:
+        CallOrAssign();
+        break;
+
+    case IF_TOKEN:
+    {
+        testSym(IF_TOKEN); // Consomme le token "if"
+        int sautsFaux[MAX_SAUTS]; // Sauts pris quand la condition est fausse
+        int nFaux = 0;
+        Cond(0, sautsFaux, &nFaux); // Analyse la condition (saute si elle est fausse)
+        testSym(THEN_TOKEN); // Attend le token "then"
+        Inst();            // Analyse l'instruction du bloc "then"
+        if (symCour.cls == ELSE_TOKEN)
+        {
+            int jumpElse = PC + 1; // Prépare un saut pour le bloc "else"
+            Ecrire2(BRN, 0);       // Génère un branchement non conditionnel
+            corrigerSauts(sautsFaux, nFaux, PC + 1); // Fixe la cible des sauts du "then"
+            testSym(ELSE_TOKEN);   // Consomme le token "else"
+            Inst();              // Analyse le bloc "else"
+            PCODE[jumpElse].SUITE = PC + 1; // Fixe la cible du saut après "else"
+        }
+        else
+        {
+            corrigerSauts(sautsFaux, nFaux, PC + 1); // Fixe les sauts de fin du "if"
+        }
+    }
+    break;
+
+    case WHILE_TOKEN:
+    {
+        // Boucle inversée : la condition est testée une fois à l'entrée (garde),
+        // puis en bas de boucle avec un seul branchement arrière par itération.
+        testSym(WHILE_TOKEN); // Consomme le token "while"
+        PositionLex posCond;
+        SauverPosition(&posCond); // Mémorise le début de la condition pour la relire
+        int sautsSortie[MAX_SAUTS]; // Sauts de sortie (condition fausse)
+        int nSortie = 0;
+        Cond(0, sautsSortie, &nSortie); // Garde : sort si la condition est fausse
+        testSym(DO_TOKEN);   // Attend le token "do"
+        int debutCorps = PC + 1; // Adresse du début du corps
+        Inst();              // Analyse l'instruction à répéter
+
+        // Relit la condition pour la générer une seconde fois en bas de boucle
+        PositionLex posFin;
+        SauverPosition(&posFin);
+        RestaurerPosition(&posCond);
+        int sautsRetour[MAX_SAUTS]; // Sauts de retour au corps (condition vraie)
+        int nRetour = 0;
+        Cond(1, sautsRetour, &nRetour);
+        RestaurerPosition(&posFin);
+
+        corrigerSauts(sautsRetour, nRetour, debutCorps); // Reboucle tant que la condition est vraie
+        corrigerSauts(sautsSortie, nSortie, PC + 1); // Fixe la cible des sauts de sortie
+    }
+    break;
+
+    case REPEAT_TOKEN:
+        RepeatInst(); // Analyse l'instruction "repeat...until"
+        break;
+
+    case FOR_TOKEN:
+        ForInst(); // Analyse la boucle "for"
+        break;
+
+    case CASE_TOKEN:
+        CaseInst(); // Analyse la structure "case"
+        break;
+
+    case BEGIN_TOKEN:
+        testSym(BEGIN_TOKEN); // Consomme le token "begin"
+        Insts();            // Analyse la séquence d'instructions du bloc
+        testSym(END_TOKEN);   // Consomme le token "end"
+        break;
+
+    case WRITE_TOKEN:
+    {
+        testSym(WRITE_TOKEN); // Consomme "write"
+        testSym(PRG_TOKEN);   // Consomme '('
+        do
+        {
+            Exp();        // Analyse une expression à écrire
+            Ecrire1(PRN); // Génère l'instruction d'impression
+            if (symCour.cls == VIR_TOKEN)
+                testSym(VIR_TOKEN); // Consomme la virgule s'il y a plusieurs arguments
+            else
+                break;
+        } while (1);
+        testSym(PRD_TOKEN); // Consomme ')'
+    }
+    break;
+
+    case READ_TOKEN:
+    {
+        testSym(READ_TOKEN); // Consomme "read"
+        testSym(PRG_TOKEN);  // Consomme '('
+        do
+        {
+            char nm[32];
+            strcpy(nm, symCour.nom); // Sauvegarde le nom de la variable
+            testSym(ID_TOKEN);       // Consomme l'identifiant
+            adresseVariable(nm, LDI); // Charge l'adresse de la variable
+            Ecrire1(INN);            // Génère l'instruction de lecture (input)
+            if (symCour.cls == VIR_TOKEN)
+                testSym(VIR_TOKEN);  // Gère la virgule entre plusieurs variables
+            else
+                break;
+        } while (1);
+        testSym(PRD_TOKEN); // Consomme ')'
+    }
+    break;
+
+    default:
+        Error("Unknown instruction"); // Affiche une erreur pour instruction inconnue
+    }
+    // Les cases des arguments passés par valeur sont rendues à la fin de l'instruction
+    while (nCasesArguments > casesAvant)
+        LibererCase(casesArguments[--nCasesArguments]);
+}
+
+// ---------------------------------------------------------------------
+// Analyse une condition booléenne : relations combinées par not/and/or
+// ---------------------------------------------------------------------
+// COND -> COND_TERM { "or" COND_TERM }, COND_TERM -> COND_FACT { "and" COND_FACT }
+// COND_FACT -> { "not" } ( EXP RELOP EXP | "(" COND ")" )
+// Aucune valeur booléenne n'est empilée : chaque relation génère directement une
+// instruction de comparaison-branchement (BEQ..BGE) et l'évaluation est court-circuitée.
+// Une condition analysée laisse des sauts en attente (vers "vraie" et vers
+// "fausse") et sa dernière relation, pas encore écrite : c'est le symbole qui
+// suit qui indique où doit aller son saut :
+//  - "and" : relation fausse => le terme "or" courant est faux, on passe au suivant ;
+//  - "or"  : relation vraie => toute la condition est vraie ;
+//  - sinon : dernière relation, elle décide du saut demandé par l'appelant.
+typedef struct
+{
+    int vrais[MAX_SAUTS]; // Sauts vers "condition vraie"
+    int nVrais;
+    int faux[MAX_SAUTS];  // Sauts vers "condition fausse"
+    int nFaux;
+    Mnemoniques br;       // Dernière relation : condition vraie si ce branchement est pris
+} Condition;
+
+static void condOu(Condition *c);
+
+// Un "(" en tête de COND_FACT ouvre-t-il une condition, ou une expression
+// ("(a + 1) * 2 > b") ? On lit jusqu'à la ")" correspondante puis on revient :
+// une expression entre parenthèses est suivie d'un opérateur.
+static int conditionEntreParentheses(void)
+{
+    PositionLex debut;
+    SauverPosition(&debut);
+    int profondeur = 0;
+    do
+    {
+        if (symCour.cls == PRG_TOKEN)
+            profondeur++;
+        else if (symCour.cls == PRD_TOKEN)
+            profondeur--;
+        else if (symCour.cls == DIEZE_TOKEN || symCour.cls == PV_TOKEN)
+            break;
+        SymSuiv();
+    } while (profondeur > 0);
+    TokenType t = symCour.cls;
+    RestaurerPosition(&debut);
+    return t != PLUS_TOKEN && t != MOINS_TOKEN && t != MULTI_TOKEN && t != DIV_TOKEN &&
+           t != EGAL_TOKEN && t != DIFF_TOKEN && t != INF_TOKEN && t != INFEG_TOKEN &&
+           t != SUP_TOKEN && t != SUPEG_TOKEN;
+}
+
+// COND_FACT : une relation, ou une condition entre parenthèses
+static void condFacteur(Condition *c)
+{
+    int negation = 0;
+    while (symCour.cls == NOT_TOKEN)
+    {
+        testSym(NOT_TOKEN); // Consomme "not"
+        negation = !negation;
+    }
+
+    if (symCour.cls == PRG_TOKEN && conditionEntreParentheses())
+    {
+        testSym(PRG_TOKEN);
+        condOu(c);
+        testSym(PRD_TOKEN);
+    }
+    else
+    {
+        Exp(); // Analyse une expression
+        TokenType t = symCour.cls; // Sauvegarde l'opérateur relationnel
+        if (t != EGAL_TOKEN && t != DIFF_TOKEN &&
+            t != INF_TOKEN && t != INFEG_TOKEN &&
+            t != SUP_TOKEN && t != SUPEG_TOKEN)
+        {
+            Error("Relational operator expected"); // Erreur si opérateur non trouvé
+        }
+        testSym(t); // Consomme l'opérateur
+        Exp();      // Analyse l'expression après l'opérateur
+        c->nVrais = 0;
+        c->nFaux = 0;
+        c->br = brancheSiVrai(t); // Branchement pris quand la relation est vraie
+    }
+
+    if (negation)
+    {
+        // Les sauts en attente échangent leur cible
+        Condition n = *c;
+        memcpy(c->vrais, n.faux, (size_t)n.nFaux * sizeof(int));
+        c->nVrais = n.nFaux;
+        memcpy(c->faux, n.vrais, (size_t)n.nVrais * sizeof(int));
+        c->nFaux = n.nVrais;
+        c->br = inverserBranche(n.br);
+    }
+}
+
+// COND_TERM : le facteur suivant n'est évalué que si le précédent est vrai
+static void condEt(Condition *c)
+{
+    condFacteur(c);
+    while (symCour.cls == AND_TOKEN)
+    {
+        testSym(AND_TOKEN);
+        ajouterSaut(c->faux, &c->nFaux, inverserBranche(c->br));
+        corrigerSauts(c->vrais, c->nVrais, PC + 1); // Le facteur suivant commence ici
+        Condition f;
+        condFacteur(&f);
+        memcpy(c->vrais, f.vrais, (size_t)f.nVrais * sizeof(int));
+        c->nVrais = f.nVrais;
+        reporterSauts(c->faux, &c->nFaux, f.faux, f.nFaux);
+        c->br = f.br;
+    }
+}
+
+// COND : le terme suivant n'est évalué que si le précédent est faux
+static void condOu(Condition *c)
+{
+    condEt(c);
+    while (symCour.cls == OR_TOKEN)
+    {
+        testSym(OR_TOKEN);
+        ajouterSaut(c->vrais, &c->nVrais, c->br);
+        corrigerSauts(c->faux, c->nFaux, PC + 1); // Le terme suivant commence ici
+        Condition t;
+        condEt(&t);
+        reporterSauts(c->vrais, &c->nVrais, t.vrais, t.nVrais);
+        memcpy(c->faux, t.faux, (size_t)t.nFaux * sizeof(int));
+        c->nFaux = t.nFaux;
+        c->br = t.br;
+    }
+}
+
+// Génère une condition qui saute (sauts[]) quand elle vaut sautSi, et
+// continue en séquence sinon
+void Cond(int sautSi, int sauts[], int *nSauts)
+{
+    Condition c;
+    condOu(&c);
+    if (sautSi)
+    {
+        ajouterSaut(sauts, nSauts, c.br);
+        reporterSauts(sauts, nSauts, c.vrais, c.nVrais);
+        corrigerSauts(c.faux, c.nFaux, PC + 1);
+    }
+    else
+    {
+        ajouterSaut(sauts, nSauts, inverserBranche(c.br));
+        reporterSauts(sauts, nSauts, c.faux, c.nFaux);
+        corrigerSauts(c.vrais, c.nVrais, PC + 1);
+    }
+}
+
+// ---------------------------------------------------------------------
+// Analyse une expression arithmétique (addition/soustraction)
+// ---------------------------------------------------------------------
+void Exp()
+{
+    Term(); // Analyse un terme
+    while (symCour.cls == PLUS_TOKEN || symCour.cls == MOINS_TOKEN)
+    {
+        TokenType t = symCour.cls;
+        testSym(t); // Consomme l'opérateur + ou -
+        Term();     // Analyse le terme suivant
+        if (t == PLUS_TOKEN)
+            Ecrire1(ADD); // Génère l'instruction d'addition
+        else
+            Ecrire1(SUB); // Génère l'instruction de soustraction
+    }
+}
+
+// ---------------------------------------------------------------------
+// Analyse un terme dans une expression (multiplication/division)
+// ---------------------------------------------------------------------
+void Term()
+{
+    Fact(); // Analyse un facteur
+    while (symCour.cls == MULTI_TOKEN || symCour.cls == DIV_TOKEN)
+    {
+        TokenType t = symCour.cls;
+        testSym(t); // Consomme * ou /
+        Fact();     // Analyse le facteur suivant
+        if (t == MULTI_TOKEN)
+            Ecrire1(MUL); // Génère l'instruction de multiplication
+        else
+            Ecrire1(DIVI); // Génère l'instruction de division entière
+    }
+}
+
+// ---------------------------------------------------------------------
+// Analyse un facteur (identifiant, nombre, expression entre parenthèses, etc.)
+// ---------------------------------------------------------------------
+void Fact()
+{
+    switch (symCour.cls)
+    {
+    case ID_TOKEN:
+    {
+        char nm[32];
+        strcpy(nm, symCour.nom); // Sauvegarde le nom de l'identifiant
+        testSym(ID_TOKEN);       // Consomme l'identifiant
+
+        if (isFunction(nm))
+        {
+            // Si c'est une fonction, il peut y avoir des arguments entre parenthèses
+            int idxF = getProcFuncIndex(nm);
+            Ecrire2(LDI, 0); // Case du résultat (argument 0), initialisée à 0
+            if (symCour.cls == PRG_TOKEN) // Si '(' est présent
+            {
+                testSym(PRG_TOKEN);
+                parseArguments(idxF); // Analyse les arguments
+                testSym(PRD_TOKEN);
+            }
+            else
+            {
+                verifierNbArguments(idxF, 0); // Appel de fonction sans argument
+            }
+            // Génère l'instruction CALL pour appeler la fonction
+            EcrireAppel(idxF);
+            // Le résultat de la fonction reste sur la pile pour être utilisé dans l'expression
+        }
+        else if (isProcedure(nm))
+        {
+            // En Pascal, on ne peut pas appeler une procédure dans une expression
+            Error("Cannot call a procedure in an expression context");
+        }
+        else
+        {
+            // Sinon, c'est une variable, constante, ou paramètre local
+            int localIdx = findLocalParamIndex(nm);
+            if (insideAFunction && localIdx == 0 && !strcmp(nm, currentFunctionName))
+            {
+                // Si c'est la variable résultat de la fonction (argument 0)
+                Ecrire2(LDL, CASE_ARGUMENT(0, nbArgsCourant));
+            }
+            else if (localIdx >= 0)
+            {
+                // Si c'est un paramètre local (pass-by-ref)
+                Ecrire2(LDL, caseParametre(localIdx));
+                Ecrire1(LDV);
+            }
+            else if (isVar(nm))
+            {
+                // Si c'est une variable (globale ou locale)
+                chargerVariable(nm);
+            }
+            else if (isConst(nm))
+            {
+                // Si c'est une constante, on charge sa valeur
+                DataType ctype = TYPE_UNDEF;
+                for (int i = 0; i < NBR_IDFS; i++)
+                {
+                    if (!strcmp(TAB_IDFS[i].Nom, nm) && TAB_IDFS[i].TIDF == TCONST)
+                    {
+                        ctype = TAB_IDFS[i].type;
+                        break;
+                    }
+                }
+                if (ctype == TYPE_INT)
+                {
+                    int c = getConstValue(nm);
+                    Ecrire2(LDI, c);
+                }
+                else if (ctype == TYPE_REAL)
+                {
+                    float c = getConstFValue(nm);
+                    int int_repr;
+                    memcpy(&int_repr, &c, sizeof(float));
+                    Ecrire2(LDF, int_repr);
+                }
+                else
+                {
+                    Error("Unsupported constant type in Fact()");
+                }
+            }
+            else
+            {
+                // Si l'identifiant est inconnu
+                Error("Unknown identifier in Fact()");
+            }
+        }
+    }
+    break;
+
+    case NUM_TOKEN:
+    {
+        // Nombre entier littéral
+        int v = atoi(symCour.nom);
+        testSym(NUM_TOKEN);
+        Ecrire2(LDI, v);
+    }
+    break;
+
+    case REAL_TOKEN:
+    {
+        // Nombre réel littéral
+        float vf = atof(symCour.nom);
+        testSym(REAL_TOKEN);
+        int int_repr;
+        memcpy(&int_repr, &vf, sizeof(float));
+        Ecrire2(LDF, int_repr);
+    }
+    break;
+
+    case PRG_TOKEN:
+        // Expression entre parenthèses
+        testSym(PRG_TOKEN);
+        Exp();
+        testSym(PRD_TOKEN);
+        break;
+
+    default:
+        Error("Invalid factor"); // Erreur si facteur invalide
+        break;
+    }
+}
+
+// ---------------------------------------------------------------------
+// Analyse une instruction "repeat ... until"
+// ---------------------------------------------------------------------
+void RepeatInst()
+{
+    testSym(REPEAT_TOKEN); // Consomme "repeat"
+    int start = PC + 1;    // Position de début du bloc répété
+    Insts();             // Analyse les instructions à répéter
+    testSym(UNTIL_TOKEN);  // Attend "until"
+    int sautsRetour[MAX_SAUTS]; // Sauts de retour (condition de sortie fausse)
+    int nRetour = 0;
+    Cond(0, sautsRetour, &nRetour); // Analyse la condition de sortie
+    corrigerSauts(sautsRetour, nRetour, start); // Si la condition est fausse, retourne au début du bloc
+}
+
+// ---------------------------------------------------------------------
+// Génère le test d'une boucle "for" : compare la variable à la limite
+// stockée dans la case slotFin du cadre et branche vers 'cible' avec 'br'
+// ---------------------------------------------------------------------
+static void testFor(const char *varFor, int slotFin, Mnemoniques br, int cible)
+{
+    chargerVariable(varFor); // Charge la valeur de la variable de boucle
+    Ecrire2(LDL, slotFin);   // Charge la limite
+    Ecrire2(br, cible);      // Compare et branche
+}
+
+// ---------------------------------------------------------------------
+// Analyse une boucle "for"
+// ---------------------------------------------------------------------
+void ForInst()
+{
+    testSym(FOR_TOKEN); // Consomme "for"
+    if (symCour.cls != ID_TOKEN)
+        Error("Identifier expected after FOR");
+    char varFor[32];
+    strcpy(varFor, symCour.nom); // Sauvegarde le nom de la variable de boucle
+    testSym(ID_TOKEN);
+    testSym(AFFECT_TOKEN); // Consomme ":="
+    Exp();               // Analyse l'expression d'initialisation
+    rangerVariable(varFor); // Stocke la valeur initiale dans la variable
+
+    int sens = 0;
+    if (symCour.cls == TO_TOKEN)
+    {
+        sens = 0;         // Boucle croissante
+        testSym(TO_TOKEN);  // Consomme "to"
+    }
+    else if (symCour.cls == DOWNTO_TOKEN)
+    {
+        sens = 1;         // Boucle décroissante
+        testSym(DOWNTO_TOKEN); // Consomme "downto"
+    }
+    else
+    {
+        Error("TO or DOWNTO expected"); // Erreur si ni "to" ni "downto"
+    }
+
+    Exp(); // Analyse l'expression de la limite
+    int slotFin = AllouerCase(); // Case temporaire du cadre pour la valeur de fin
+    Ecrire2(STL, slotFin);       // Stocke la limite dans la case dédiée
+    testSym(DO_TOKEN);       // Consomme "do"
+
+    // Garde d'entrée : la boucle est inversée, la condition est ensuite testée en bas
+    if (sens == 0)
+        testFor(varFor, slotFin, BGT, 0); // Sort si la variable dépasse la limite (boucle croissante)
+    else
+        testFor(varFor, slotFin, BLT, 0); // Sort si la variable passe sous la limite (boucle décroissante)
+    int jumpEnd = PC;      // Adresse du saut de sortie de la garde
+
+    int debutCorps = PC + 1; // Adresse du début du corps
+    Inst();              // Analyse le corps de la boucle
+
+    chargerVariable(varFor); // Recharge la valeur de la variable de boucle
+    Ecrire2(LDI, 1);      // Charge la valeur 1 pour incrémenter/décrémenter
+    if (sens == 0)
+        Ecrire1(ADD);    // Additionne 1 pour boucle croissante
+    else
+        Ecrire1(SUB);    // Soustrait 1 pour boucle décroissante
+    rangerVariable(varFor); // Stocke la nouvelle valeur dans la variable
+    if (sens == 0)
+        testFor(varFor, slotFin, BLE, debutCorps); // Reboucle tant que variable <= limite
+    else
+        testFor(varFor, slotFin, BGE, debutCorps); // Reboucle tant que variable >= limite
+    PCODE[jumpEnd].SUITE = PC + 1; // Fixe le saut de sortie de la garde
+    LibererCase(slotFin);          // La limite n'est plus utile après la boucle
+}
+
+// ---------------------------------------------------------------------
+// Analyse une structure "case"
+// ---------------------------------------------------------------------
+void CaseInst()
+{
+    testSym(CASE_TOKEN); // Consomme "case"
+    Exp();             // Analyse l'expression à comparer
+    int tmpSlot = AllouerCase(); // Alloue une case temporaire du cadre
+    Ecrire2(STL, tmpSlot);       // Stocke la valeur dans la case temporaire
+    testSym(OF_TOKEN);   // Consomme "of"
+
+    int jumpEndLabels[50]; // Tableau pour stocker les labels de fin de chaque branche
+    int nEnd = 0;          // Compteur de labels de fin
+
+    // Traite chaque branche "valeur : instruction"
+    while (symCour.cls == NUM_TOKEN)
+    {
+        int labelVal = atoi(symCour.nom); // Convertit le numéro de label en entier
+        testSym(NUM_TOKEN);
+        testSym(COLON_TOKEN);
+
+        Ecrire2(LDL, tmpSlot);  // Recharge la valeur stockée
+        Ecrire2(LDI, labelVal); // Charge le label courant
+
+        int jumpIfNot = PC + 1;  // Prépare un saut si la valeur est différente du label
+        Ecrire2(BNE, 0);
+        Inst();               // Analyse les instructions de la branche
+        int jumpAfter = PC + 1; // Prépare un saut pour sortir de la branche
+        Ecrire2(BRN, 0);
+        jumpEndLabels[nEnd++] = jumpAfter; // Enregistre le label de fin
+        PCODE[jumpIfNot].SUITE = PC + 1; // Fixe la cible du saut si égalité non satisfaite
+
+        if (symCour.cls == PV_TOKEN)
+            testSym(PV_TOKEN); // Consomme le point-virgule si présent
+        else
+            break;
+    }
+    if (symCour.cls == ELSE_TOKEN)
+    {
+        testSym(ELSE_TOKEN); // Consomme "else"
+        Inst();            // Analyse l'instruction pour la branche "else"
+        int jumpAfterElse = PC + 1;
+        Ecrire2(BRN, 0);
+        jumpEndLabels[nEnd++] = jumpAfterElse;
+        if (symCour.cls == PV_TOKEN)
+            testSym(PV_TOKEN); // Consomme le point-virgule
+    }
+    testSym(END_TOKEN); // Consomme "end"
+    int endOfCase = PC + 1; // Adresse de fin de la structure "case"
+    // Fixe tous les sauts enregistrés à la fin de la structure
+    for (int i = 0; i < nEnd; i++)
+    {
+        PCODE[jumpEndLabels[i]].SUITE = endOfCase;
+    }
+    LibererCase(tmpSlot); // La case sert aux "case" suivants
+}
+
+// ---------------------------------------------------------------------
+// Compilation en deux phases de la partie des procédures et fonctions
+// ---------------------------------------------------------------------
+// 1. Pré-examen (fil principal) : chaque en-tête est analysé et enregistré
+//    dans TAB_IDFS, la position du premier token de son Bloc est mémorisée
+//    et le corps est sauté en équilibrant begin/case et end. Toutes les
+//    procédures et fonctions sont ainsi connues avant qu'un corps ne soit
+//    compilé : un corps peut appeler une procédure déclarée plus loin.
+// 2. Les corps sont analysés et compilés par un groupe de FILS_CORPS fils.
+//    Chaque fil a son propre compilateur (ETAT_PAR_FIL) : il part d'une copie
+//    de la table des symboles et relit le source dans un flux à lui. Le code
+//    d'un corps commence à l'adresse 0 ; ses CALL portent l'entrée de
+//    l'appelée dans TAB_IDFS, son adresse n'étant pas encore connue.
+//    Avec un seul fil (FILS_CORPS = 1, un seul corps, ou aucun fil créé), le
+//    fil appelant compile les corps lui-même dans le source déjà ouvert, son
+//    propre état étant mis de côté le temps des corps.
+// 3. Édition des liens (fil principal) : les corps sont mis bout à bout dans
+//    l'ordre du source, les sauts sont décalés de l'adresse du corps et les
+//    CALL reçoivent l'adresse de l'appelée. Les appels terminaux sont marqués
+//    ensuite. Le P-code est celui d'une compilation séquentielle.
+// Les messages d'information et les erreurs sont rendus dans l'ordre du
+// source : la première erreur signalée est celle qu'aurait trouvée une
+// compilation séquentielle, sauf qu'un appel en avant n'en est plus une.
+
+ETAT_PAR_FIL int FILS_CORPS = 0;
+
+// Corps d'une procédure ou fonction, repéré par le pré-examen
+typedef struct
+{
+    int          idx;                // Entrée de la procédure ou fonction dans TAB_IDFS
+    PositionLex  debut;              // Premier token de son Bloc
+    LocalParam   params[50];         // Paramètres de l'en-tête
+    int          nParams;
+    INSTRUCTION *code;               // Code du corps (adresses à partir de 0, RET en dernier)
+    int          taille;             // Nombre d'instructions
+    char        *informations;       // Messages d'information de sa compilation
+    size_t       tailleInformations;
+    int          echec;              // 1 : erreur, message dans 'message'
+    char         message[256];
+    int          ligneFin;           // Ligne et token à la fin du corps
+    TSym_Cour    symFin;             // (erreur de l'édition des liens)
+} Corps;
+
+// Partie des procédures et fonctions, partagée par les fils ; 'prochain' est protégé par 'verrou'
+typedef struct
+{
+    Corps          *corps;
+    int             nCorps;
+    int             prochain;
+    pthread_mutex_t verrou;
+    char           *texte;           // Source entier, relu par chaque fil
+    size_t          taille;
+    T_IDF          *idfs;            // Table des symboles après le pré-examen (lue seulement)
+    int             nIdfs;
+    int             offset;
+    int             informations;    // INFORMATIONS du fil principal
+} PartieProcs;
+
+// Saute un Bloc et le point-virgule qui le suit sans générer de code : les
+// déclarations jusqu'au begin, puis jusqu'au end qui le ferme (seuls begin
+// et case sont fermés par un end)
+static void SauterBloc(void)
+{
+    int profondeur = 0;
+    while (symCour.cls != BEGIN_TOKEN)
+    {
+        if (symCour.cls == DIEZE_TOKEN)
+            testSym(BEGIN_TOKEN); // Fin du fichier dans les déclarations
+        SymSuiv();
+    }
+    do
+    {
+        if (symCour.cls == DIEZE_TOKEN)
+            testSym(END_TOKEN); // Fin du fichier dans le corps
+        if (symCour.cls == BEGIN_TOKEN || symCour.cls == CASE_TOKEN)
+            profondeur++;
+        else if (symCour.cls == END_TOKEN)
+            profondeur--;
+        SymSuiv();
+    } while (profondeur > 0);
+    testSym(PV_TOKEN);
+}
+
+// Pré-examen : enregistre chaque en-tête et saute son corps. Une erreur
+// arrête l'examen ; le corps en cours reste dans la liste, sa compilation
+// trouvant une éventuelle erreur antérieure
+static void PreExaminer(PartieProcs *p)
+{
+    while (symCour.cls == PROCEDURE_TOKEN || symCour.cls == FUNCTION_TOKEN)
+    {
+        int idx = symCour.cls == PROCEDURE_TOKEN ? ProcDecl() : FuncDecl();
+        Corps *c = realloc(p->corps, (size_t)(p->nCorps + 1) * sizeof(Corps));
+        if (!c)
+            Error("Out of memory");
+        p->corps = c;
+        c = &p->corps[p->nCorps];
+        memset(c, 0, sizeof(Corps));
+        c->idx = idx;
+        SauverPosition(&c->debut);
+        memcpy(c->params, localParams, sizeof(localParams));
+        c->nParams = localCount;
+        initLocalParams();
+        p->nCorps++;
+        SauterBloc();
+    }
+}
+
+// Compile un corps lu dans 'source' avec l'état du fil appelant ; le code et
+// les messages d'information sont gardés dans c. Le lecteur, la reprise des
+// erreurs et le flux des messages du fil sont remis en place à la fin.
+static void CompilerCorps(Corps *c, const PartieProcs *p, FILE *source)
+{
+    jmp_buf reprise;
+    jmp_buf *englobante = REPRISE_ERREUR;
+    FILE *lecteur = fsource;
+    FILE *flux = FLUX_INFORMATIONS;
+    FILE *informations = open_memstream(&c->informations, &c->tailleInformations);
+    if (!source || !informations)
+    {
+        c->echec = 1;
+        snprintf(c->message, sizeof(c->message), "Error line %d: Out of memory", c->debut.ligne);
+        if (informations)
+            fclose(informations);
+        return;
+    }
+    memcpy(TAB_IDFS, p->idfs, (size_t)p->nIdfs * sizeof(T_IDF));
+    NBR_IDFS = p->nIdfs;
+    OFFSET = p->offset;
+    fsource = source;
+    FLUX_INFORMATIONS = informations;
+    PC = -1;
+    appelsSymboliques = 1;
+    REPRISE_ERREUR = &reprise;
+    if (setjmp(reprise) == 0)
+    {
+        RestaurerPosition(&c->debut);
+        memcpy(localParams, c->params, sizeof(localParams));
+        localCount = c->nParams;
+        nCasesArguments = 0;
+        insideAFunction = TAB_IDFS[c->idx].TIDF == TFUNC;
+        strcpy(currentFunctionName, insideAFunction ? TAB_IDFS[c->idx].Nom : "");
+        nbArgsCourant = getArgCount(c->idx);
+        DANS_PROCEDURE = 1;
+        DebutCadre();
+
+        Bloc();            // Analyse le bloc de la procédure ou fonction
+        testSym(PV_TOKEN); // Consomme le point-virgule final
+
+        // Une fonction pousse sa valeur résultat (argument 0) sur la pile
+        if (insideAFunction)
+            Ecrire2(LDL, CASE_ARGUMENT(0, nbArgsCourant));
+        // Instruction de retour avec le nombre d'arguments à dépiler
+        Ecrire2(RET, nbArgsCourant);
+        FinCadre();
+
+        c->taille = PC + 1;
+        c->code = malloc((size_t)c->taille * sizeof(INSTRUCTION));
+        if (!c->code)
+            Error("Out of memory");
+        memcpy(c->code, PCODE, (size_t)c->taille * sizeof(INSTRUCTION));
+        c->ligneFin = line_num;
+        c->symFin = symCour;
+    }
+    else
+    {
+        c->echec = 1;
+        snprintf(c->message, sizeof(c->message), "%s", MESSAGE_ERREUR);
+    }
+    REPRISE_ERREUR = englobante;
+    FLUX_INFORMATIONS = flux;
+    appelsSymboliques = 0;
+    fsource = lecteur;
+    fclose(informations);
+}
+
+// Boucle d'un fil : prend le prochain corps jusqu'à épuisement
+static void *travaillerCorps(void *arg)
+{
+    PartieProcs *p = arg;
+    INFORMATIONS = p->informations;
+    for (;;)
+    {
+        pthread_mutex_lock(&p->verrou);
+        int i = p->prochain++;
+        pthread_mutex_unlock(&p->verrou);
+        if (i >= p->nCorps)
+            return NULL;
+        FILE *source = fmemopen(p->texte, p->taille, "r");
+        CompilerCorps(&p->corps[i], p, source);
+        if (source)
+            fclose(source);
+    }
+}
+
+// Lit tout le source : chaque fil le relit depuis la position d'un corps
+static void lireSource(PartieProcs *p)
+{
+    long ici = ftell(fsource);
+    size_t capacite = 4096, lus;
+    p->texte = malloc(capacite);
+    p->taille = 0;
+    if (ici < 0 || fseek(fsource, 0, SEEK_SET) != 0)
+        Error("Cannot seek in source file");
+    while (p->texte && (lus = fread(p->texte + p->taille, 1, capacite - p->taille, fsource)) > 0)
+    {
+        p->taille += lus;
+        if (p->taille == capacite)
+        {
+            capacite *= 2;
+            char *plus = realloc(p->texte, capacite);
+            if (!plus)
+                free(p->texte);
+            p->texte = plus;
+        }
+    }
+    if (!p->texte)
+        Error("Out of memory");
+    if (fseek(fsource, ici, SEEK_SET) != 0)
+        Error("Cannot seek in source file");
+}
+
+// Compile tous les corps sur le fil appelant, dans le source ouvert. Le
+// P-code, la table des symboles, le lecteur et l'état de l'analyse sont ceux
+// du programme : ils sont mis de côté puis remis comme après le pré-examen.
+static void compilerSurPlace(PartieProcs *p)
+{
+    PositionLex ici;
+    int pc = PC, nIdfs = NBR_IDFS, offset = OFFSET;
+    INSTRUCTION *code = malloc((size_t)(pc + 1) * sizeof(INSTRUCTION));
+    T_IDF *idfs = malloc((size_t)nIdfs * sizeof(T_IDF));
+    if (!code || !idfs)
+    {
+        free(code);
+        free(idfs);
+        Error("Out of memory");
+    }
+    memcpy(code, PCODE, (size_t)(pc + 1) * sizeof(INSTRUCTION));
+    memcpy(idfs, TAB_IDFS, (size_t)nIdfs * sizeof(T_IDF));
+    SauverPosition(&ici);
+    p->idfs = idfs;
+    p->nIdfs = nIdfs;
+    p->offset = offset;
+
+    for (int k = 0; k < p->nCorps; k++)
+        CompilerCorps(&p->corps[k], p, fsource);
+
+    memcpy(PCODE, code, (size_t)(pc + 1) * sizeof(INSTRUCTION));
+    PC = pc;
+    memcpy(TAB_IDFS, idfs, (size_t)nIdfs * sizeof(T_IDF));
+    NBR_IDFS = nIdfs;
+    OFFSET = offset;
+    DANS_PROCEDURE = 0;
+    insideAFunction = 0;
+    currentFunctionName[0] = '\0';
+    initLocalParams();
+    nCasesArguments = 0;
+    nbArgsCourant = 0;
+    p->idfs = NULL;
+    free(code);
+    free(idfs);
+    RestaurerPosition(&ici);
+}
+
+// Compile les corps avec un groupe de fils (FILS_CORPS, 0 : un par cœur),
+// ou sur le fil appelant s'il n'en faut qu'un
+static void compilerLesCorps(PartieProcs *p)
+{
+    int nbFils = FILS_CORPS > 0 ? FILS_CORPS : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (nbFils > p->nCorps)
+        nbFils = p->nCorps;
+    int lances = 0;
+
+    if (nbFils > 1)
+    {
+        lireSource(p);
+        p->idfs = TAB_IDFS;
+        p->nIdfs = NBR_IDFS;
+        p->offset = OFFSET;
+        p->informations = INFORMATIONS;
+        p->prochain = 0;
+        pthread_mutex_init(&p->verrou, NULL);
+
+        pthread_t *fils = malloc((size_t)nbFils * sizeof(pthread_t));
+        for (int t = 0; fils && t < nbFils; t++)
+            if (pthread_create(&fils[t], NULL, travaillerCorps, p) == 0)
+                lances++;
+        for (int t = 0; t < lances; t++)
+            pthread_join(fils[t], NULL);
+        free(fils);
+        pthread_mutex_destroy(&p->verrou);
+        free(p->texte);
+        p->texte = NULL;
+        p->idfs = NULL;
+    }
+    // Aucun fil créé : aucun corps n'a été pris
+    if (lances == 0)
+        compilerSurPlace(p);
+}
+
+// Édition des liens : met les corps à la suite de PCODE[0..PC] dans l'ordre
+// du source, puis corrige les CALL et marque les appels terminaux. Les
+// messages d'information et la première erreur sont rendus dans cet ordre.
+static void lierCorps(PartieProcs *p)
+{
+    int premier = PC + 1;
+    // Une procédure de la partie appelée en position terminale reçoit ses
+    // cases de passage (celles des parties déjà liées n'en ont pas)
+    for (int k = 0; k < p->nCorps; k++)
+    {
+        Corps *c = &p->corps[k];
+        if (c->echec || c->taille == 0)
+            continue;
+        int i = AppelEnPositionTerminale(c->code, c->taille - 1, 0);
+        if (i < 0 || getArgCount(c->code[i].SUITE) != c->code[c->taille - 1].SUITE)
+            continue;
+        for (int j = 0; j < p->nCorps; j++)
+            if (p->corps[j].idx == c->code[i].SUITE)
+                TAB_IDFS[p->corps[j].idx].Passage = TAB_IDFS[p->corps[j].idx].Value;
+    }
+    for (int k = 0; k < p->nCorps; k++)
+    {
+        Corps *c = &p->corps[k];
+        if (c->echec || TAB_IDFS[c->idx].Passage == 0)
+            continue;
+        int cases = (c->taille > 0 && c->code[0].MNE == ALC) ? c->code[0].SUITE : 0;
+        if (cases + TAB_IDFS[c->idx].Passage > MAX_CASES_CADRE)
+        {
+            line_num = c->ligneFin;
+            symCour = c->symFin;
+            Error("Too many local variables");
+        }
+        INSTRUCTION *code = realloc(c->code, (size_t)(c->taille + 1) * sizeof(INSTRUCTION));
+        if (!code)
+            Error("Out of memory");
+        c->code = code;
+        c->taille = ReserverCasesDePassage(c->code, c->taille, TAB_IDFS[c->idx].Passage);
+    }
+    for (int k = 0; k < p->nCorps; k++)
+    {
+        Corps *c = &p->corps[k];
+        if (c->informations && c->tailleInformations > 0)
+            Informer("%s", c->informations);
+        if (c->echec)
+            RelayerErreur(c->message);
+        if (PC + c->taille >= TAILLECODE)
+        {
+            line_num = c->ligneFin;
+            symCour = c->symFin;
+            Error("Too many instructions");
+        }
+        int base = PC + 1;
+        TAB_IDFS[c->idx].Adresse = base;
+        for (int i = 0; i < c->taille; i++)
+        {
+            INSTRUCTION ins = c->code[i];
+            if (ins.MNE == BRN || ins.MNE == BZE || (ins.MNE >= BEQ && ins.MNE <= BGE))
+                ins.SUITE += base;
+            PCODE[++PC] = ins;
+        }
+    }
+    for (int i = premier; i <= PC; i++)
+        if (PCODE[i].MNE == CALL)
+            PCODE[i].SUITE = TAB_IDFS[PCODE[i].SUITE].Adresse;
+    // Un appel en dernière instruction réutilise le cadre (TAILCALL)
+    for (int k = 0; k < p->nCorps; k++)
+    {
+        int debut = TAB_IDFS[p->corps[k].idx].Adresse;
+        MarquerAppelTerminal(debut + p->corps[k].taille - 1, debut);
+    }
+}
+
+static void libererCorps(PartieProcs *p)
+{
+    free(p->texte);
+    p->texte = NULL;
+    for (int k = 0; k < p->nCorps; k++)
+    {
+        free(p->corps[k].code);
+        free(p->corps[k].informations);
+    }
+    free(p->corps);
+    p->corps = NULL;
+    p->nCorps = 0;
+}
+
+// ---------------------------------------------------------------------
+// Analyse la partie des procédures et fonctions (compilation en deux phases)
+// ---------------------------------------------------------------------
+void ProcFuncPart()
+{
+    jmp_buf reprise;
+    jmp_buf *englobante = REPRISE_ERREUR;
+    PartieProcs p;
+    volatile int erreurExamen = 0; // Erreur du pré-examen ou de l'édition des liens, dans message
+    char message[256];
+
+    memset(&p, 0, sizeof(p));
+    REPRISE_ERREUR = &reprise;
+    if (setjmp(reprise) == 0)
+    {
+        PreExaminer(&p);
+    }
+    else
+    {
+        erreurExamen = 1;
+        snprintf(message, sizeof(message), "%s", MESSAGE_ERREUR);
+    }
+    REPRISE_ERREUR = englobante;
+
+    if (p.nCorps > 0)
+    {
+        // Une erreur de la compilation ou de l'édition des liens laisse les corps à libérer
+        REPRISE_ERREUR = &reprise;
+        if (setjmp(reprise) == 0)
+        {
+            compilerLesCorps(&p);
+            lierCorps(&p);
+        }
+        else
+        {
+            erreurExamen = 1;
+            snprintf(message, sizeof(message), "%s", MESSAGE_ERREUR);
+        }
+        REPRISE_ERREUR = englobante;
+    }
+    libererCorps(&p);
+    if (erreurExamen)
+        RelayerErreur(message);
+}
+
+// ---------------------------------------------------------------------
+// Directives après l'en-tête d'une procédure ou fonction : [ noinline ; ]
+// "noinline" interdit à l'optimiseur d'intégrer son corps aux appels
+// ---------------------------------------------------------------------
+void Directives(int idx)
+{
+    TAB_IDFS[idx].SansInline = 0;
+    if (symCour.cls == NOINLINE_TOKEN)
+    {
+        testSym(NOINLINE_TOKEN); // Consomme "noinline"
+        testSym(PV_TOKEN);       // Consomme le point-virgule
+        TAB_IDFS[idx].SansInline = 1;
+    }
+}
+
+// ---------------------------------------------------------------------
+// En-tête d'une procédure : procedure <id> (paramlist); [noinline;]
+// Le corps (Bloc; RET <n>) est compilé par CompilerCorps
+// ---------------------------------------------------------------------
+int ProcDecl()
+{
+    initLocalParams(); // Initialise les paramètres locaux
+
+    testSym(PROCEDURE_TOKEN); // Consomme "procedure"
+    char procName[32];
+    strcpy(procName, symCour.nom); // Enregistre le nom de la procédure
+    testSym(ID_TOKEN);
+
+    if (IDexists(procName))
+        Error("Procedure name already used"); // Erreur si le nom existe déjà
+    int idx = NBR_IDFS; // Index pour enregistrer la procédure dans la table des identifiants
+
+    strcpy(TAB_IDFS[idx].Nom, procName); // Enregistre le nom dans la table
+    TAB_IDFS[idx].TIDF = TPROC;          // Marque comme procédure
+    TAB_IDFS[idx].type = TYPE_UNDEF;     // Type non défini (procédure n'a pas de type de retour)
+    TAB_IDFS[idx].Adresse = -1;          // Adresse inconnue jusqu'à l'édition des liens
+    TAB_IDFS[idx].Value = 0;             // Nombre de paramètres initialisé à 0
+    TAB_IDFS[idx].Passage = 0;           // Cases de passage fixées à l'édition des liens
+    NBR_IDFS++;                          // Incrémente le nombre d'identifiants
+
+    parseParamList(idx); // Analyse la liste des paramètres
+    testSym(PV_TOKEN);   // Consomme le point-virgule
+    Directives(idx);     // Directive optionnelle "noinline;"
+    return idx;
+}
+
+// ---------------------------------------------------------------------
+// En-tête d'une fonction : function <id> (paramlist) : <type>; [noinline;]
+// Le corps (Bloc; push result; RET <n>) est compilé par CompilerCorps
+// ---------------------------------------------------------------------
+int FuncDecl()
+{
+    initLocalParams(); // Initialise les paramètres locaux
+
+    testSym(FUNCTION_TOKEN); // Consomme "function"
+    char fnName[32];
+    strcpy(fnName, symCour.nom); // Enregistre le nom de la fonction
+    testSym(ID_TOKEN);
+
+    int idx = NBR_IDFS;      // Index pour la table des identifiants
+    strcpy(TAB_IDFS[idx].Nom, fnName); // Enregistre le nom
+    TAB_IDFS[idx].TIDF = TFUNC;        // Marque comme fonction
+    TAB_IDFS[idx].Adresse = -1;        // Adresse inconnue jusqu'à l'édition des liens
+    TAB_IDFS[idx].Value = 0;           // Nombre de paramètres initialisé à 0
+    TAB_IDFS[idx].Passage = 0;         // Cases de passage fixées à l'édition des liens
+    TAB_IDFS[idx].type = TYPE_INT;     // Par défaut, le type de retour est entier
+    NBR_IDFS++;                        // Incrémente le nombre d'identifiants
+
+    parseParamList(idx);  // Analyse la liste de paramètres et met à jour TAB_IDFS[idx].Value
+    testSym(COLON_TOKEN); // Consomme ":"
+    DataType retType = parseBaseType(); // Analyse le type de retour
+    TAB_IDFS[idx].type = retType;       // Enregistre le type de retour
+    testSym(PV_TOKEN);    // Consomme le point-virgule
+    Directives(idx);      // Directive optionnelle "noinline;"
+    return idx;
+}
+
+// ---------------------------------------------------------------------
+// Analyse un appel ou une affectation à partir d'un identifiant
+// ---------------------------------------------------------------------
+void CallOrAssign()
+{
+    char name[32];
+    strcpy(name, symCour.nom); // Sauvegarde le nom de l'identifiant
+    testSym(ID_TOKEN);         // Consomme l'identifiant
+
+    // Si on est dans une fonction et que l'identifiant correspond au nom de la fonction,
+    // il s'agit d'une affectation au résultat de la fonction (argument 0)
+    if (insideAFunction && strcmp(name, currentFunctionName) == 0)
+    {
+        testSym(AFFECT_TOKEN); // Consomme ":="
+        Exp();                 // Analyse l'expression à assigner
+        Ecrire2(STL, CASE_ARGUMENT(0, nbArgsCourant)); // Stocke le résultat dans sa case (argument 0)
+        return;
+    }
+
+    // Sinon, vérifie si l'identifiant correspond à une procédure ou fonction connue
+    int isProc = isProcedure(name);
+    int isFunc = isFunction(name);
+
+    if (isProc || isFunc)
+    {
+        // Appel de procédure ou fonction
+        int idxPF = getProcFuncIndex(name);
+
+        // Une fonction appelée comme une instruction a aussi sa case de résultat
+        if (isFunc)
+            Ecrire2(LDI, 0);
+
+        // Analyse les arguments optionnels : soit "(...)" soit zéro argument
+        if (symCour.cls == PRG_TOKEN)
+        {
+            testSym(PRG_TOKEN);
+            parseArguments(idxPF); // Analyse les arguments fournis
+            testSym(PRD_TOKEN);
+        }
+        else
+        {
+            verifierNbArguments(idxPF, 0); // Cas d'appel avec zéro argument
+        }
+        // Génère l'instruction CALL pour effectuer l'appel
+        EcrireAppel(idxPF);
+
+        // Dans un contexte d'instruction, on jette la valeur laissée par RET
+        // (résultat d'une fonction, ou sommet de pile pour une procédure) :
+        // la pile reste ainsi équilibrée d'une instruction à l'autre
+        Ecrire2(STO, -9999); // Pop le résultat de la pile (valeur jetée)
+    }
+    else
+    {
+        // Sinon, c'est une affectation de variable : "ID := exp"
+        testSym(AFFECT_TOKEN); // Consomme ":="
+        Exp();                 // Analyse l'expression de droite
+        // Détermine si l'identifiant est un paramètre local ou une variable globale
+        int localIdx = findLocalParamIndex(name);
+        if (localIdx >= 0)
+        {
+            Ecrire2(LDL, caseParametre(localIdx)); // Charge l'adresse du paramètre local
+            Ecrire1(STO_IND);       // Stocke indirectement la valeur dans la mémoire locale
+        }
+        else
+        {
+            rangerVariable(name); // Stocke la valeur dans la variable (globale ou locale)
+        }
+    }
+}
+
+// ---------------------------------------------------------------------
+// Analyse la liste des paramètres dans une déclaration de proc/fonction
+// ---------------------------------------------------------------------
+static void parseParamList(int indexProcFunc)
+{
+    int total = 0; // Nombre total de paramètres
+    if (symCour.cls == PRG_TOKEN)
+    {
+        testSym(PRG_TOKEN); // Consomme '('
+        while (symCour.cls == ID_TOKEN)
+        {
+            char groupIDS[10][32]; // Groupe d'identifiants pour des paramètres partagés
+            int gCount = 0;        // Compteur pour le groupe
+            // Analyse une liste d'identifiants séparés par des virgules
+            while (symCour.cls == ID_TOKEN)
+            {
+                strcpy(groupIDS[gCount], symCour.nom); // Enregistre l'identifiant
+                gCount++;
+                testSym(ID_TOKEN); // Consomme l'identifiant
+                if (symCour.cls == VIR_TOKEN)
+                    testSym(VIR_TOKEN); // Consomme la virgule
+                else
+                    break;
+            }
+            testSym(COLON_TOKEN);   // Consomme ':'
+            DataType ptype = parseBaseType(); // Analyse le type de base du paramètre
+
+            // Enregistre chaque identifiant du groupe comme paramètre local
+            for (int i = 0; i < gCount; i++)
+            {
+                addLocalParam(groupIDS[i], ptype);
+                total++;
+            }
+
+            if (symCour.cls == PV_TOKEN)
+                testSym(PV_TOKEN); // Consomme le point-virgule séparant les groupes
+            else
+                break;
+        }
+        testSym(PRD_TOKEN); // Consomme ')'
+    }
+    TAB_IDFS[indexProcFunc].Value = total; // Stocke le nombre total de paramètres dans la table d'identifiants
+}
+
+// ---------------------------------------------------------------------
+// Vérifie le nombre d'arguments d'un appel : l'appelée les trouve à des
+// cases fixes de son cadre, il doit donc être exact
+// ---------------------------------------------------------------------
+static void verifierNbArguments(int indexProcFunc, int count)
+{
+    int nbParams = TAB_IDFS[indexProcFunc].Value; // Nombre de paramètres attendus
+    if (count != nbParams)
+    {
+        char buf[128];
+        sprintf(buf, "Incorrect number of parameters. Expected %d, got %d",
+                nbParams, count);
+        Error(buf); // Affiche une erreur en cas de désaccord
+    }
+}
+
+// ---------------------------------------------------------------------
+// Les paramètres sont passés par référence. Le code PCODE[debut..PC] d'un
+// argument, qui empile sa valeur, est transformé pour empiler une adresse :
+//  - variable globale (LDA x ; LDV) : LDA x ;
+//  - paramètre reçu (LDL p ; LDV) : l'adresse reçue LDL p, transmise telle quelle ;
+//  - variable locale (LDL k, k >= 1) : LLA k ;
+//  - autre valeur : elle est rangée dans une case du cadre dont l'adresse est
+//    passée (passage par valeur), la case étant rendue à la fin de l'instruction.
+// ---------------------------------------------------------------------
+static void passerAdresse(int debut)
+{
+    int n = PC - debut + 1;
+    if (n == 2 && PCODE[PC].MNE == LDV &&
+        (PCODE[debut].MNE == LDA || (PCODE[debut].MNE == LDL && PCODE[debut].SUITE < 0)))
+    {
+        PC--; // L'adresse reste au sommet, la lecture disparaît
+        return;
+    }
+    if (n == 1 && PCODE[PC].MNE == LDL && PCODE[PC].SUITE >= 1)
+    {
+        PCODE[PC].MNE = LLA;
+        return;
+    }
+    int k = AllouerCase();
+    casesArguments[nCasesArguments++] = k;
+    Ecrire2(STL, k);
+    Ecrire2(LLA, k);
+}
+
+// ---------------------------------------------------------------------
+// Analyse la liste des arguments dans un appel de proc/fonction
+// ---------------------------------------------------------------------
+static void parseArguments(int indexProcFunc)
+{
+    int count = 0; // Compteur d'arguments fournis
+
+    if (symCour.cls != PRD_TOKEN)
+    {
+        while (1)
+        {
+            int debut = PC + 1;
+            Exp();               // Analyse l'argument comme une expression
+            passerAdresse(debut); // Puis empile son adresse à la place de sa valeur
+            count++; // Incrémente le nombre d'arguments fournis
+
+            if (symCour.cls == VIR_TOKEN)
+                testSym(VIR_TOKEN); // Consomme la virgule séparant les arguments
+            else
+                break; // Sort de la boucle s'il n'y a plus d'arguments
+        }
+    }
+
+    // Vérifie que le nombre d'arguments fournis est correct
+    verifierNbArguments(indexProcFunc, count);
+}
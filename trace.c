@@ -0,0 +1,970 @@
+#include "trace.h"
+#include "interpreteur.h"  // Interpréteur : exécution et enregistrement hors des traces
+
+ETAT_PAR_FIL int SEUIL_TRACE = 50;
+
+// ---------------------------------------------------------------------
+// JIT de traces pour Linux x86-64
+// ---------------------------------------------------------------------
+// Enregistrement : quand le compteur d'un branchement arrière atteint
+// SEUIL_TRACE, l'interpréteur continue instruction par instruction depuis
+// la cible du branchement (la tête de boucle, "ancre") en notant chaque
+// instruction exécutée, l'adresse de la suivante et le type des valeurs
+// lues, jusqu'au retour à l'ancre. CALL, RET, INN... arrêtent
+// l'enregistrement : la boucle reste interprétée (après TRACE_ESSAIS
+// tentatives, elle n'est plus comptée).
+//
+// Compilation : la pile d'évaluation est simulée. Une case de pile est une
+// constante, un registre ou sa case de MEM (au-dessus du SP d'entrée) ; son
+// type est connu à la compilation, puisque toute valeur vient d'une
+// constante ou d'une lecture gardée. Pendant la trace :
+//   r12 = SP à l'entrée de la trace, r13 = BP, r14 = MEM, r15 = MEM_TYPE,
+//   cases 1 à 7 de la pile dans ecx, esi, edi, r8d, r9d, r10d, ebx,
+//   eax, edx, r11d et xmm0-xmm2 pour les calculs.
+// Une garde qui échoue saute à un stub qui range dans MEM les cases de la
+// pile (valeur et type), met SP à jour et rend l'adresse où l'interpréteur
+// reprend : l'état est exactement celui qu'aurait l'interpréteur à cette
+// instruction (les divisions par zéro et les adresses invalides sont aussi
+// des gardes, l'interpréteur produit l'erreur). Quand une sortie a servi
+// SEUIL_TRACE fois, l'enregistrement reprend depuis elle jusqu'à l'ancre ;
+// la trace annexe obtenue part de l'état de la pile simulée à la sortie et
+// le saut de la garde est redirigé vers elle.
+// ---------------------------------------------------------------------
+
+#if defined(__x86_64__) && defined(__linux__)
+
+#include <sys/mman.h>  // mmap, mprotect, munmap
+#include <stdint.h>    // uint64_t, uintptr_t
+#include <string.h>    // memset, memcpy
+
+#define TRACE_MAX_PAS      256          // Instructions enregistrées au plus par trace
+#define TRACE_MAX_PILE     24           // Hauteur de la pile simulée au plus
+#define TRACE_MAX_TRACES   256          // Traces de boucle au plus
+#define TRACE_MAX_SORTIES  2048         // Gardes au plus, toutes traces comprises
+#define TRACE_ESSAIS       3            // Enregistrements ratés avant d'abandonner une boucle ou une sortie
+#define TRACE_TAILLE_ZONE  (1 << 20)    // Taille de la zone de code machine
+#define TRACE_CADRE        32           // Types suivis pour les cases BP-32 à BP+31
+
+// Registres x86-64 (numéros du codage)
+enum { RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI, R8, R9, R10, R11, R12, R13, R14, R15 };
+
+// Registres des cases 1 à NB_REGISTRES de la pile simulée
+static const int REGISTRES[] = {RCX, RSI, RDI, R8, R9, R10, RBX};
+#define NB_REGISTRES 7
+
+// Conditions des sauts et de setcc (la condition inverse est cc ^ 1)
+enum { CC_B = 2, CC_AE = 3, CC_E = 4, CC_NE = 5, CC_A = 7, CC_S = 8, CC_P = 10, CC_NP = 11,
+       CC_L = 12, CC_GE = 13, CC_LE = 14, CC_G = 15 };
+
+// Opérations arithmétiques et logiques (extension du code 0x81)
+enum { ALU_ADD = 0, ALU_OR = 1, ALU_AND = 4, ALU_SUB = 5, ALU_XOR = 6, ALU_CMP = 7 };
+
+// Où se trouve la valeur d'une case de la pile simulée
+typedef enum { LIEU_CONST, LIEU_REG, LIEU_MEM } Lieu;
+
+typedef struct {
+    Lieu lieu;
+    int  type;       // TYPE_INT ou TYPE_REAL
+    int  constante;  // Valeur (bits du réel) si lieu == LIEU_CONST
+} Emplacement;
+
+// Garde d'une trace : état de la pile simulée au moment du saut
+typedef struct {
+    int pc;                                 // Adresse où l'interpréteur reprend
+    int hauteur;                            // Cases au-dessus du SP d'entrée
+    Emplacement pile[TRACE_MAX_PILE + 1];   // Cases 1..hauteur
+    int racine;                             // Trace de boucle à laquelle la garde appartient
+    int saut;                               // Position du déplacement du saut dans la zone
+    int compteur;                           // Passages par la sortie (-1 : pas de trace annexe)
+    int echecs;                             // Enregistrements ratés depuis cette sortie
+} Sortie;
+
+// Trace de boucle
+typedef struct {
+    int ancre;    // Tête de la boucle
+    int cadre;    // SP - BP à l'ancre
+    int entree;   // Position du prologue dans la zone
+    int boucle;   // Position du début d'une itération
+} Trace;
+
+// Instruction enregistrée
+typedef struct {
+    int pc;
+    int suivant;  // Adresse de l'instruction exécutée ensuite
+    int type;     // Type de la case lue par LDV ou LDL
+} Pas;
+
+static ETAT_PAR_FIL unsigned char *zone;   // Code machine (lecture/exécution hors des compilations)
+static ETAT_PAR_FIL int pos;               // Position d'écriture dans la zone
+static ETAT_PAR_FIL int pleine;            // La zone a débordé pendant la compilation
+static ETAT_PAR_FIL int horsService;       // La zone n'a pas pu redevenir exécutable
+
+static ETAT_PAR_FIL Trace traces[TRACE_MAX_TRACES];
+static ETAT_PAR_FIL int nTraces;
+static ETAT_PAR_FIL int nAnnexes;
+static ETAT_PAR_FIL Sortie *sorties;      // TRACE_MAX_SORTIES, alloué avec la zone
+static ETAT_PAR_FIL int nSorties;
+static ETAT_PAR_FIL int sortieCourante;    // Écrite par le stub de la garde qui a échoué
+
+static ETAT_PAR_FIL int racineDe[TAILLECODE];         // Trace dont l'instruction est l'ancre (-1 : aucune)
+static ETAT_PAR_FIL int compteurs[TAILLECODE];        // Passages par un branchement arrière (-1 : abandonné)
+static ETAT_PAR_FIL int echecsBoucle[TAILLECODE];
+static ETAT_PAR_FIL Pas pas[TRACE_MAX_PAS];
+static ETAT_PAR_FIL long nEntrees;
+static ETAT_PAR_FIL int nAbandons;
+
+// Pile simulée pendant la compilation
+static ETAT_PAR_FIL Emplacement pile[TRACE_MAX_PILE + 1];
+static ETAT_PAR_FIL int hauteur;
+static ETAT_PAR_FIL int echec;                        // La compilation ne peut pas aboutir
+static ETAT_PAR_FIL int typeGlobal[TAILLEMEM];        // Type connu d'une case de MEM (-1 : à garder)
+static ETAT_PAR_FIL int typeCadre[2 * TRACE_CADRE];   // Type connu de la case BP+k
+
+// ---------------------------------------------------------------------
+// Codage des instructions x86-64
+// ---------------------------------------------------------------------
+
+// Adresse mémoire [base + index*4 + depl] (index = -1 : sans index)
+typedef struct { int base, index, depl; } Adresse;
+
+static void octet(int b)
+{
+    if (pos < TRACE_TAILLE_ZONE) zone[pos++] = (unsigned char)b;
+    else pleine = 1;
+}
+
+static void mot(int v)
+{
+    for (int k = 0; k < 4; k++) octet((v >> (8 * k)) & 0xff);
+}
+
+static void rex(int w, int r, int x, int b)
+{
+    int o = 0x40 | (w << 3) | ((r >> 3) << 2) | ((x >> 3) << 1) | (b >> 3);
+    if (o != 0x40) octet(o);
+}
+
+// Préfixe éventuel, REX, code (1 ou 2 octets) et ModRM registre-registre
+static void instrRR(int prefixe, int w, int code, int reg, int rm)
+{
+    if (prefixe) octet(prefixe);
+    rex(w, reg, 0, rm);
+    if (code > 0xff) octet(code >> 8);
+    octet(code & 0xff);
+    octet(0xc0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+// Même chose avec un opérande mémoire (toujours SIB et déplacement 32 bits)
+static void instrRM(int prefixe, int w, int code, int reg, Adresse a)
+{
+    if (prefixe) octet(prefixe);
+    rex(w, reg, a.index >= 0 ? a.index : 0, a.base);
+    if (code > 0xff) octet(code >> 8);
+    octet(code & 0xff);
+    octet(0x84 | ((reg & 7) << 3));
+    octet(a.index >= 0 ? (0x80 | ((a.index & 7) << 3) | (a.base & 7)) : (0x20 | (a.base & 7)));
+    mot(a.depl);
+}
+
+static void movRI(int r, int v)          { rex(0, 0, 0, r); octet(0xb8 + (r & 7)); mot(v); }
+static void movRR(int d, int s)          { if (d != s) instrRR(0, 0, 0x89, s, d); }
+static void charger(int d, Adresse a)    { instrRM(0, 0, 0x8b, d, a); }
+static void ranger(Adresse a, int s)     { instrRM(0, 0, 0x89, s, a); }
+static void rangerI(Adresse a, int v)    { instrRM(0, 0, 0xc7, 0, a); mot(v); }
+static void aluRR(int op, int d, int s)  { instrRR(0, 0, op * 8 + 1, s, d); }
+static void aluRM(int op, int d, Adresse a) { instrRM(0, 0, op * 8 + 3, d, a); }
+static void aluRI(int op, int d, int v)  { instrRR(0, 0, 0x81, op, d); mot(v); }
+static void aluMI(int op, Adresse a, int v) { instrRM(0, 0, 0x81, op, a); mot(v); }
+static void testRR(int a, int b)         { instrRR(0, 0, 0x85, b, a); }
+static void lea32(int d, Adresse a)      { instrRM(0, 0, 0x8d, d, a); }
+static void decaler(int ext, int r, int k) { instrRR(0, 0, 0xc1, ext, r); octet(k); }
+static void setcc(int cc, int r)         { instrRR(0, 0, 0x0f90 + cc, 0, r); }
+static void movdXR(int x, int r)         { instrRR(0x66, 0, 0x0f6e, x, r); }
+static void movdRX(int r, int x)         { instrRR(0x66, 0, 0x0f7e, x, r); }
+static void cvtsi2ss(int x, int r)       { instrRR(0xf3, 0, 0x0f2a, x, r); }
+static void operationSS(int code, int a, int b) { instrRR(0xf3, 0, 0x0f00 + code, a, b); }
+static void ucomiss(int a, int b)        { instrRR(0, 0, 0x0f2e, a, b); }
+static void empilerR(int r)              { rex(0, 0, 0, r); octet(0x50 + (r & 7)); }
+static void depilerR(int r)              { rex(0, 0, 0, r); octet(0x58 + (r & 7)); }
+
+static void movabs(int r, const void *p)
+{
+    rex(1, 0, 0, r);
+    octet(0xb8 + (r & 7));
+    uint64_t v = (uint64_t)(uintptr_t)p;
+    for (int k = 0; k < 8; k++) octet((int)((v >> (8 * k)) & 0xff));
+}
+
+// Saut (conditionnel si cc >= 0) ; retourne la position de son déplacement
+static int sauter(int cc)
+{
+    if (cc >= 0) { octet(0x0f); octet(0x80 + cc); }
+    else octet(0xe9);
+    int p = pos;
+    mot(0);
+    return p;
+}
+
+static void relier(int saut, int cible)
+{
+    int d = cible - (saut + 4);
+    memcpy(zone + saut, &d, 4);
+}
+
+static Adresse caseDePile(int s)  { return (Adresse){R14, R12, 4 * s}; }
+static Adresse typeDePile(int s)  { return (Adresse){R15, R12, 4 * s}; }
+static Adresse caseDeCadre(int k) { return (Adresse){R14, R13, 4 * k}; }
+static Adresse typeDeCadre(int k) { return (Adresse){R15, R13, 4 * k}; }
+static Adresse caseGlobale(int a) { return (Adresse){R14, -1, 4 * a}; }
+static Adresse typeGlobale(int a) { return (Adresse){R15, -1, 4 * a}; }
+
+// ---------------------------------------------------------------------
+// Pile simulée
+// ---------------------------------------------------------------------
+
+static int registreDe(int s) { return s <= NB_REGISTRES ? REGISTRES[s - 1] : -1; }
+
+// Registre où calculer le nouveau contenu de la case s
+static int registreDeCalcul(int s) { int r = registreDe(s); return r >= 0 ? r : RAX; }
+
+// Registre contenant la valeur de la case s (chargée dans r si besoin)
+static int valeur(int s, int r)
+{
+    switch (pile[s].lieu)
+    {
+    case LIEU_REG:   return registreDe(s);
+    case LIEU_CONST: movRI(r, pile[s].constante); return r;
+    default:         charger(r, caseDePile(s)); return r;
+    }
+}
+
+// La case s reçoit la valeur du registre r
+static void poser(int s, int r, int type)
+{
+    int d = registreDe(s);
+    pile[s].type = type;
+    if (d >= 0) { movRR(d, r); pile[s].lieu = LIEU_REG; }
+    else { ranger(caseDePile(s), r); pile[s].lieu = LIEU_MEM; }
+}
+
+static void empilerConstante(int type, int v)
+{
+    hauteur++;
+    pile[hauteur].lieu = LIEU_CONST;
+    pile[hauteur].type = type;
+    pile[hauteur].constante = v;
+}
+
+// Range la valeur de la case s dans sa case de MEM (le type est rangé par les stubs)
+static void vider(int s)
+{
+    if (pile[s].lieu == LIEU_CONST) rangerI(caseDePile(s), pile[s].constante);
+    else if (pile[s].lieu == LIEU_REG) ranger(caseDePile(s), registreDe(s));
+    pile[s].lieu = LIEU_MEM;
+}
+
+// op registre, case s
+static void aluPile(int op, int r, int s)
+{
+    if (pile[s].lieu == LIEU_CONST) aluRI(op, r, pile[s].constante);
+    else if (pile[s].lieu == LIEU_REG) aluRR(op, r, registreDe(s));
+    else aluRM(op, r, caseDePile(s));
+}
+
+static void imulPile(int r, int s)
+{
+    if (pile[s].lieu == LIEU_CONST) { instrRR(0, 0, 0x69, r, r); mot(pile[s].constante); }
+    else if (pile[s].lieu == LIEU_REG) instrRR(0, 0, 0x0faf, r, registreDe(s));
+    else instrRM(0, 0, 0x0faf, r, caseDePile(s));
+}
+
+// Charge la case s en float dans le registre xmm x
+static void chargerReel(int x, int s)
+{
+    int r = valeur(s, RAX);
+    if (pile[s].type == TYPE_REAL) movdXR(x, r);
+    else cvtsi2ss(x, r);
+}
+
+static void oublierTypes(void)
+{
+    memset(typeGlobal, -1, sizeof typeGlobal);
+    memset(typeCadre, -1, sizeof typeCadre);
+}
+
+static int *typeConnuDuCadre(int k)
+{
+    return (k >= -TRACE_CADRE && k < TRACE_CADRE) ? &typeCadre[k + TRACE_CADRE] : NULL;
+}
+
+// Garde : si la condition cc est vraie, sortie vers l'interpréteur en pc avec
+// l'état actuel de la pile simulée
+static Sortie *garde(int cc, int pc, int racine)
+{
+    if (nSorties >= TRACE_MAX_SORTIES) { echec = 1; return NULL; }
+    Sortie *s = &sorties[nSorties++];
+    s->pc = pc;
+    s->hauteur = hauteur;
+    memcpy(s->pile, pile, sizeof pile);
+    s->racine = racine;
+    s->saut = sauter(cc);
+    s->compteur = 0;
+    s->echecs = 0;
+    return s;
+}
+
+// Code du stub d'une sortie : range la pile, met SP à jour, rend l'adresse de reprise
+static void ecrireStub(int e, int epilogue)
+{
+    Sortie *s = &sorties[e];
+    relier(s->saut, pos);
+    for (int k = 1; k <= s->hauteur; k++)
+    {
+        if (s->pile[k].lieu == LIEU_CONST) rangerI(caseDePile(k), s->pile[k].constante);
+        else if (s->pile[k].lieu == LIEU_REG) ranger(caseDePile(k), registreDe(k));
+        rangerI(typeDePile(k), s->pile[k].type);
+    }
+    instrRM(0, 1, 0x8d, RAX, (Adresse){R12, -1, s->hauteur});  // lea rax,[r12+hauteur]
+    movabs(RCX, &SP);
+    ranger((Adresse){RCX, -1, 0}, RAX);
+    movabs(RCX, &sortieCourante);
+    rangerI((Adresse){RCX, -1, 0}, e);
+    movRI(RAX, s->pc);
+    relier(sauter(-1), epilogue);
+}
+
+// PRN dans une trace : même affichage que l'interpréteur
+static void traceEcrire(int bits, int type)
+{
+    DataValue v;
+    v.i = bits;
+    INTER_AFFICHER(v, type);
+}
+
+// ---------------------------------------------------------------------
+// Compilation d'une trace
+// ---------------------------------------------------------------------
+
+// Cases dépilées et empilées par une instruction (-1 : pas admise dans une trace)
+static int effetPile(Mnemoniques m, int *empile)
+{
+    *empile = 0;
+    switch (m)
+    {
+    case LDI: case LDA: case LDF: case LLA: case LDL:
+        *empile = 1; return 0;
+    case LDV: case SHL: case SHR: case STO_KEEP:
+        *empile = 1; return 1;
+    case STO: case STL: case BZE: case PRN:
+        return 1;
+    case STO_IND: case BEQ: case BNE: case BLT: case BLE: case BGT: case BGE:
+        return 2;
+    case ADD: case SUB: case MUL: case DIVI: case SUBR: case DIVR:
+    case EQL: case NEQ: case GTR: case LSS: case GEQ: case LEQ:
+        *empile = 1; return 2;
+    case BRN:
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+static int conditionDe(Mnemoniques rel)
+{
+    switch (rel)
+    {
+    case EQL: case BEQ: return CC_E;
+    case NEQ: case BNE: return CC_NE;
+    case GTR: case BGT: return CC_G;
+    case LSS: case BLT: return CC_L;
+    case GEQ: case BGE: return CC_GE;
+    default:            return CC_LE;
+    }
+}
+
+// Compare les cases h-1 et h et laisse 0 ou 1 dans eax
+static void comparer(int cc, int h)
+{
+    int ra = valeur(h - 1, RAX);
+    aluPile(ALU_CMP, ra, h);
+    setcc(cc, RAX);
+    instrRR(0, 0, 0x0fb6, RAX, RAX);  // movzx eax,al
+}
+
+// Même chose avec au moins un réel (une comparaison avec NaN est fausse)
+static void comparerReels(int cc, int h)
+{
+    chargerReel(0, h - 1);
+    chargerReel(1, h);
+    switch (cc)
+    {
+    case CC_G:  ucomiss(0, 1); setcc(CC_A, RAX); break;
+    case CC_GE: ucomiss(0, 1); setcc(CC_AE, RAX); break;
+    case CC_L:  ucomiss(1, 0); setcc(CC_A, RAX); break;
+    case CC_LE: ucomiss(1, 0); setcc(CC_AE, RAX); break;
+    case CC_E:
+        ucomiss(0, 1); setcc(CC_E, RAX); setcc(CC_NP, RDX);
+        instrRR(0, 0, 0x20, RDX, RAX);  // and al,dl
+        break;
+    default:
+        ucomiss(0, 1); setcc(CC_NE, RAX); setcc(CC_P, RDX);
+        instrRR(0, 0, 0x08, RDX, RAX);  // or al,dl
+        break;
+    }
+    instrRR(0, 0, 0x0fb6, RAX, RAX);
+}
+
+static void arithmetique(Mnemoniques op, int pc, int racine)
+{
+    int h = hauteur;
+    // x op y, le résultat remplace la case h-1
+    int x = h - 1, y = h;
+    if (op == SUBR || op == DIVR) { x = h; y = h - 1; op = (op == SUBR) ? SUB : DIVI; }
+    if (pile[x].type == TYPE_INT && pile[y].type == TYPE_INT)
+    {
+        if (op != DIVI && pile[x].lieu == LIEU_CONST && pile[y].lieu == LIEU_CONST)
+        {
+            unsigned a = (unsigned)pile[x].constante, b = (unsigned)pile[y].constante;
+            unsigned r = (op == ADD) ? a + b : (op == SUB) ? a - b : a * b;
+            hauteur -= 2;
+            empilerConstante(TYPE_INT, (int)r);
+            return;
+        }
+        if (op == DIVI)
+        {
+            // Diviseur nul (erreur) ou -1 (INT_MIN / -1) : l'interpréteur s'en charge
+            int d = valeur(y, R11);
+            testRR(d, d);
+            garde(CC_E, pc, racine);
+            aluRI(ALU_CMP, d, -1);
+            garde(CC_E, pc, racine);
+            movRR(RAX, valeur(x, RAX));
+            octet(0x99);                  // cdq
+            instrRR(0, 0, 0xf7, 7, d);    // idiv d
+            hauteur -= 2;
+            hauteur++;
+            poser(hauteur, RAX, TYPE_INT);
+            return;
+        }
+        // Calcul en place dans le registre de la case h-1 si x y est déjà
+        int r = (x == h - 1 && pile[x].lieu == LIEU_REG) ? registreDe(x) : RAX;
+        if (r == RAX) movRR(RAX, valeur(x, RAX));
+        if (op == MUL) imulPile(r, y);
+        else aluPile(op == ADD ? ALU_ADD : ALU_SUB, r, y);
+        hauteur -= 2;
+        hauteur++;
+        poser(hauteur, r, TYPE_INT);
+        return;
+    }
+    chargerReel(0, x);
+    chargerReel(1, y);
+    if (op == DIVI)
+    {
+        // Diviseur nul (ou NaN) : l'interpréteur s'en charge
+        instrRR(0, 0, 0x0f57, 2, 2);  // xorps xmm2,xmm2
+        ucomiss(1, 2);
+        garde(CC_E, pc, racine);
+    }
+    operationSS(op == ADD ? 0x58 : op == SUB ? 0x5c : op == MUL ? 0x59 : 0x5e, 0, 1);
+    movdRX(RAX, 0);
+    hauteur -= 2;
+    hauteur++;
+    poser(hauteur, RAX, TYPE_REAL);
+}
+
+// Compile une instruction enregistrée ; retourne 0 si elle ne peut pas l'être
+static int compilerPas(const Pas *p, int racine)
+{
+    int pc = p->pc;
+    INSTRUCTION inst = PCODE[pc];
+    int h = hauteur;
+    switch (inst.MNE)
+    {
+    case LDI:
+    case LDA:
+        empilerConstante(TYPE_INT, inst.SUITE);
+        break;
+
+    case LDF:
+        empilerConstante(TYPE_REAL, inst.SUITE);
+        break;
+
+    case LLA:
+        hauteur++;
+        lea32(registreDeCalcul(hauteur), (Adresse){R13, -1, inst.SUITE});
+        poser(hauteur, registreDeCalcul(hauteur), TYPE_INT);
+        break;
+
+    case LDL:
+    {
+        int *connu = typeConnuDuCadre(inst.SUITE);
+        if (!connu || *connu != p->type)
+        {
+            aluMI(ALU_CMP, typeDeCadre(inst.SUITE), p->type);
+            garde(CC_NE, pc, racine);
+        }
+        if (connu) *connu = p->type;
+        hauteur++;
+        charger(registreDeCalcul(hauteur), caseDeCadre(inst.SUITE));
+        poser(hauteur, registreDeCalcul(hauteur), p->type);
+        break;
+    }
+
+    case STL:
+    {
+        if (pile[h].lieu == LIEU_CONST) rangerI(caseDeCadre(inst.SUITE), pile[h].constante);
+        else ranger(caseDeCadre(inst.SUITE), valeur(h, RAX));
+        rangerI(typeDeCadre(inst.SUITE), pile[h].type);
+        // La case du cadre peut être une case de MEM dont le type est suivi
+        memset(typeGlobal, -1, sizeof(int) * VAR_BASE);
+        int *connu = typeConnuDuCadre(inst.SUITE);
+        if (connu) *connu = pile[h].type;
+        hauteur--;
+        break;
+    }
+
+    case LDV:
+        if (pile[h].lieu == LIEU_CONST)
+        {
+            int a = pile[h].constante;
+            if (a < 0 || a >= TAILLEMEM) return 0;
+            if (typeGlobal[a] != p->type)
+            {
+                aluMI(ALU_CMP, typeGlobale(a), p->type);
+                garde(CC_NE, pc, racine);
+                typeGlobal[a] = p->type;
+            }
+            charger(registreDeCalcul(h), caseGlobale(a));
+        }
+        else
+        {
+            int r = valeur(h, RAX);
+            aluRI(ALU_CMP, r, TAILLEMEM - 1);
+            garde(CC_A, pc, racine);
+            aluMI(ALU_CMP, (Adresse){R15, r, 0}, p->type);
+            garde(CC_NE, pc, racine);
+            charger(registreDeCalcul(h), (Adresse){R14, r, 0});
+        }
+        poser(h, registreDeCalcul(h), p->type);
+        break;
+
+    case STO:
+    case STO_KEEP:
+    {
+        if (inst.SUITE == -9999 && inst.MNE == STO) { hauteur--; break; }
+        int a = inst.SUITE;
+        if (a < 0 || a >= TAILLEMEM) return 0;
+        if (pile[h].lieu == LIEU_CONST) rangerI(caseGlobale(a), pile[h].constante);
+        else ranger(caseGlobale(a), valeur(h, RAX));
+        rangerI(typeGlobale(a), pile[h].type);
+        typeGlobal[a] = pile[h].type;
+        if (a < VAR_BASE) memset(typeCadre, -1, sizeof typeCadre);
+        if (inst.MNE == STO) hauteur--;
+        break;
+    }
+
+    case STO_IND:
+        if (pile[h].lieu == LIEU_CONST)
+        {
+            int a = pile[h].constante;
+            if (a < 0 || a >= TAILLEMEM) return 0;
+            if (pile[h - 1].lieu == LIEU_CONST) rangerI(caseGlobale(a), pile[h - 1].constante);
+            else ranger(caseGlobale(a), valeur(h - 1, RAX));
+            rangerI(typeGlobale(a), pile[h - 1].type);
+            typeGlobal[a] = pile[h - 1].type;
+            if (a < VAR_BASE) memset(typeCadre, -1, sizeof typeCadre);
+        }
+        else
+        {
+            int r = valeur(h, RAX);
+            aluRI(ALU_CMP, r, TAILLEMEM - 1);
+            garde(CC_A, pc, racine);
+            if (pile[h - 1].lieu == LIEU_CONST) rangerI((Adresse){R14, r, 0}, pile[h - 1].constante);
+            else ranger((Adresse){R14, r, 0}, valeur(h - 1, RDX));
+            rangerI((Adresse){R15, r, 0}, pile[h - 1].type);
+            oublierTypes();
+        }
+        hauteur -= 2;
+        break;
+
+    case ADD:
+    case SUB:
+    case MUL:
+    case DIVI:
+    case SUBR:
+    case DIVR:
+        arithmetique(inst.MNE, pc, racine);
+        break;
+
+    case SHL:
+    case SHR:
+        if (pile[h].type == TYPE_REAL)
+        {
+            float puissance = (float)(1 << inst.SUITE);
+            int bits;
+            memcpy(&bits, &puissance, 4);
+            chargerReel(0, h);
+            movRI(RAX, bits);
+            movdXR(1, RAX);
+            operationSS(inst.MNE == SHL ? 0x59 : 0x5e, 0, 1);
+            movdRX(RAX, 0);
+            poser(h, RAX, TYPE_REAL);
+        }
+        else if (inst.MNE == SHL)
+        {
+            int r = (pile[h].lieu == LIEU_REG) ? registreDe(h) : valeur(h, RAX);
+            decaler(4, r, inst.SUITE);
+            poser(h, r, TYPE_INT);
+        }
+        else
+        {
+            // Un négatif est d'abord augmenté de 2^k - 1 pour arrondir vers zéro
+            int r = valeur(h, RAX);
+            movRR(RAX, r);
+            movRR(RDX, RAX);
+            decaler(7, RDX, 31);
+            aluRI(ALU_AND, RDX, (1 << inst.SUITE) - 1);
+            aluRR(ALU_ADD, RAX, RDX);
+            decaler(7, RAX, inst.SUITE);
+            poser(h, RAX, TYPE_INT);
+        }
+        break;
+
+    case EQL:
+    case NEQ:
+    case GTR:
+    case LSS:
+    case GEQ:
+    case LEQ:
+        if (pile[h - 1].type == TYPE_REAL || pile[h].type == TYPE_REAL)
+            comparerReels(conditionDe(inst.MNE), h);
+        else
+            comparer(conditionDe(inst.MNE), h);
+        hauteur--;
+        poser(hauteur, RAX, TYPE_INT);
+        break;
+
+    case BEQ:
+    case BNE:
+    case BLT:
+    case BLE:
+    case BGT:
+    case BGE:
+    {
+        int pris = (p->suivant == inst.SUITE);
+        int cc = conditionDe(inst.MNE);
+        if (pile[h - 1].type == TYPE_REAL || pile[h].type == TYPE_REAL)
+        {
+            comparerReels(cc, h);
+            testRR(RAX, RAX);
+            cc = CC_NE;
+        }
+        else
+        {
+            aluPile(ALU_CMP, valeur(h - 1, RAX), h);
+        }
+        hauteur -= 2;
+        // Sortie si la relation ne donne pas la direction enregistrée
+        if (inst.SUITE != pc + 1)
+            garde(pris ? (cc ^ 1) : cc, pris ? pc + 1 : inst.SUITE, racine);
+        break;
+    }
+
+    case BZE:
+    {
+        int pris = (p->suivant == inst.SUITE);
+        if (pile[h].lieu != LIEU_CONST && inst.SUITE != pc + 1)
+        {
+            int r = valeur(h, RAX);
+            testRR(r, r);
+            hauteur--;
+            garde(pris ? CC_NE : CC_E, pris ? pc + 1 : inst.SUITE, racine);
+        }
+        else
+            hauteur--;
+        break;
+    }
+
+    case BRN:
+        break;
+
+    case PRN:
+    {
+        // Les registres des cases ne survivent pas à l'appel : tout est rangé
+        for (int s = 1; s < h; s++) vider(s);
+        int r = valeur(h, RDI);
+        movRR(RDI, r);
+        movRI(RSI, pile[h].type);
+        movabs(RAX, (const void *)traceEcrire);
+        instrRR(0, 0, 0xff, 2, RAX);  // call rax
+        hauteur--;
+        break;
+    }
+
+    default:
+        return 0;
+    }
+    return 1;
+}
+
+// Compile les n pas enregistrés. parent == NULL : trace de la boucle d'ancre
+// pas[0].pc ; sinon trace annexe partant de la sortie parent.
+// Retourne 1 si le code a été produit.
+static int compiler(int n, Sortie *parent)
+{
+    int racine = parent ? parent->racine : nTraces;
+    if (!parent && nTraces >= TRACE_MAX_TRACES) return 0;
+
+    // Hauteur maximale de la pile et cases du cadre utilisées
+    int h = parent ? parent->hauteur : 0, hMax = h;
+    int kMin = 1, kMax = 0;
+    for (int i = 0; i < n; i++)
+    {
+        INSTRUCTION inst = PCODE[pas[i].pc];
+        int empile, depile = effetPile(inst.MNE, &empile);
+        if (depile < 0 || h < depile) return 0;
+        h += empile - depile;
+        if (h > hMax) hMax = h;
+        if (inst.MNE == LDL || inst.MNE == STL)
+        {
+            if (kMin > kMax) kMin = kMax = inst.SUITE;
+            if (inst.SUITE < kMin) kMin = inst.SUITE;
+            if (inst.SUITE > kMax) kMax = inst.SUITE;
+        }
+    }
+    if (h != 0 || hMax > TRACE_MAX_PILE) return 0;
+
+    if (mprotect(zone, TRACE_TAILLE_ZONE, PROT_READ | PROT_WRITE) != 0) return 0;
+    int debut = pos, premiere = nSorties;
+    echec = 0;
+    pleine = 0;
+    oublierTypes();
+    int pcDebut = parent ? parent->pc : pas[0].pc;
+    if (parent)
+    {
+        hauteur = parent->hauteur;
+        memcpy(pile, parent->pile, sizeof pile);
+    }
+    else
+    {
+        hauteur = 0;
+        // Prologue : registres préservés, état de la machine dans r12-r15
+        empilerR(RBX); empilerR(RBP); empilerR(R12); empilerR(R13); empilerR(R14); empilerR(R15);
+        instrRR(0, 1, 0x81, 5, RSP); mot(8);  // sub rsp,8 : pile alignée pour PRN
+        movabs(R14, MEM);
+        movabs(R15, MEM_TYPE);
+        movabs(RCX, &SP);
+        instrRM(0, 1, 0x63, R12, (Adresse){RCX, -1, 0});  // movsxd r12,[rcx]
+        movabs(RCX, &BP);
+        instrRM(0, 1, 0x63, R13, (Adresse){RCX, -1, 0});
+    }
+
+    // Vérifications faites une fois pour toute la trace : la pile et les
+    // cases du cadre restent dans MEM (sinon l'interpréteur produit l'erreur)
+    Sortie *s;
+    if (hMax > hauteur)
+    {
+        lea32(RAX, (Adresse){R12, -1, hMax});
+        aluRI(ALU_CMP, RAX, TAILLEMEM - 1);
+        if ((s = garde(CC_G, pcDebut, racine))) s->compteur = -1;
+    }
+    if (kMin <= kMax)
+    {
+        lea32(RAX, (Adresse){R13, -1, kMin});
+        testRR(RAX, RAX);
+        if ((s = garde(CC_S, pcDebut, racine))) s->compteur = -1;
+        lea32(RAX, (Adresse){R13, -1, kMax});
+        aluRI(ALU_CMP, RAX, TAILLEMEM - 1);
+        if ((s = garde(CC_G, pcDebut, racine))) s->compteur = -1;
+    }
+
+    int boucle = pos;
+    for (int i = 0; i < n && !echec; i++)
+        if (!compilerPas(&pas[i], racine)) echec = 1;
+
+    // Fin d'une itération : retour au début de la trace de boucle
+    if (!echec)
+        relier(sauter(-1), parent ? traces[racine].boucle : boucle);
+    for (int e = premiere; e < nSorties && !echec && !pleine; e++)
+        ecrireStub(e, 0);
+
+    int ok = !echec && !pleine;
+    if (ok && parent)
+    {
+        relier(parent->saut, debut);
+        parent->compteur = -1;
+        nAnnexes++;
+    }
+    else if (ok)
+    {
+        traces[nTraces].ancre = pcDebut;
+        traces[nTraces].cadre = SP - BP;
+        traces[nTraces].entree = debut;
+        traces[nTraces].boucle = boucle;
+        racineDe[pcDebut] = nTraces++;
+    }
+    else
+    {
+        pos = debut;
+        nSorties = premiere;
+    }
+    // Sinon aucune trace ne peut plus être exécutée : la suite est interprétée
+    if (mprotect(zone, TRACE_TAILLE_ZONE, PROT_READ | PROT_EXEC) != 0)
+        horsService = 1;
+    return ok;
+}
+
+// ---------------------------------------------------------------------
+// Enregistrement
+// ---------------------------------------------------------------------
+
+// Interprète à partir de pc en enregistrant chaque instruction, jusqu'au
+// retour à l'ancre avec la pile de départ, puis compile la trace.
+// parent == NULL : nouvelle trace de boucle ; sinon trace annexe de la sortie.
+// Retourne 1 si une trace a été compilée ; *suite reçoit l'adresse où
+// l'interpréteur continue.
+static int enregistrer(int pc, int ancre, Sortie *parent, int *suite)
+{
+    int base = SP - (parent ? parent->hauteur : 0);
+    int n = 0, ferme = 0;
+    while (pc >= 0 && pc < TAILLECODE && n < TRACE_MAX_PAS)
+    {
+        INSTRUCTION inst = PCODE[pc];
+        int empile;
+        // Instruction non admise, ou tête d'une autre boucle déjà compilée
+        if (effetPile(inst.MNE, &empile) < 0 || (racineDe[pc] >= 0 && pc != ancre)) break;
+        pas[n].pc = pc;
+        pas[n].type = TYPE_INT;
+        if (inst.MNE == LDV && SP >= 0 && MEM[SP].i >= 0 && MEM[SP].i < TAILLEMEM)
+            pas[n].type = MEM_TYPE[MEM[SP].i];
+        if (inst.MNE == LDL && BP + inst.SUITE >= 0 && BP + inst.SUITE < TAILLEMEM)
+            pas[n].type = MEM_TYPE[BP + inst.SUITE];
+        pc = INTER_UNE(pc);
+        pas[n++].suivant = pc;
+        if (SP < base) break;
+        if (pc == ancre)
+        {
+            ferme = (SP == base);
+            break;
+        }
+    }
+    *suite = pc;
+    if (ferme && compiler(n, parent)) return 1;
+    nAbandons++;
+    return 0;
+}
+
+static int estBranchement(Mnemoniques m)
+{
+    return m == BRN || m == BZE || m == BEQ || m == BNE || m == BLT || m == BLE || m == BGT || m == BGE;
+}
+
+void TRACE_PCODE(void)
+{
+    INTER_INITIALISER();
+    zone = mmap(NULL, TRACE_TAILLE_ZONE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    sorties = zone == MAP_FAILED ? NULL : malloc(TRACE_MAX_SORTIES * sizeof(Sortie));
+    if (!sorties)
+    {
+        if (zone != MAP_FAILED)
+            munmap(zone, TRACE_TAILLE_ZONE);
+        zone = NULL;
+        Informer("Trace: no executable memory, interpreting\n");
+        INTER_DEPUIS(0);
+        INTER_TERMINER();
+        return;
+    }
+
+    // Épilogue commun aux stubs, au début de la zone
+    pos = 0;
+    instrRR(0, 1, 0x81, 0, RSP); mot(8);  // add rsp,8
+    depilerR(R15); depilerR(R14); depilerR(R13); depilerR(R12); depilerR(RBP); depilerR(RBX);
+    octet(0xc3);
+    if (mprotect(zone, TRACE_TAILLE_ZONE, PROT_READ | PROT_EXEC) != 0)
+    {
+        TRACE_LIBERER();
+        Informer("Trace: no executable memory, interpreting\n");
+        INTER_DEPUIS(0);
+        INTER_TERMINER();
+        return;
+    }
+
+    nTraces = nAnnexes = nSorties = nAbandons = 0;
+    nEntrees = 0;
+    horsService = 0;
+    for (int i = 0; i < TAILLECODE; i++)
+    {
+        racineDe[i] = -1;
+        compteurs[i] = 0;
+        echecsBoucle[i] = 0;
+    }
+
+    int pc = 0;
+    int apresSortie = 0;  // Au retour d'une trace, une instruction au moins est interprétée
+    while (pc >= 0 && pc < TAILLECODE && PCODE[pc].MNE != HLT && !horsService)
+    {
+        int t = racineDe[pc];
+        if (t >= 0 && !apresSortie && SP - BP == traces[t].cadre)
+        {
+            // Entrée dans la boucle compilée, avec la pile et le cadre en cours
+            int (*executer)(void) = (int (*)(void))(zone + traces[t].entree);
+            pc = executer();
+            nEntrees++;
+            apresSortie = 1;
+            Sortie *s = &sorties[sortieCourante];
+            if (s->compteur >= 0 && ++s->compteur >= SEUIL_TRACE)
+            {
+                if (!enregistrer(pc, traces[s->racine].ancre, s, &pc))
+                {
+                    s->compteur = 0;
+                    if (++s->echecs >= TRACE_ESSAIS) s->compteur = -1;
+                }
+            }
+            continue;
+        }
+        apresSortie = 0;
+        int suivant = INTER_UNE(pc);
+        // Branchement arrière pris : la cible est la tête d'une boucle
+        if (suivant <= pc && estBranchement(PCODE[pc].MNE) && compteurs[pc] >= 0 &&
+            racineDe[suivant] < 0 && ++compteurs[pc] >= SEUIL_TRACE)
+        {
+            int b = pc;
+            if (!enregistrer(suivant, suivant, NULL, &suivant))
+            {
+                compteurs[b] = 0;
+                if (++echecsBoucle[b] >= TRACE_ESSAIS) compteurs[b] = -1;
+            }
+        }
+        pc = suivant;
+    }
+    if (horsService)
+        Informer("Trace: no executable memory, interpreting\n");
+    INTER_DEPUIS(pc);
+    Informer("Trace: %d loop traces, %d side traces, %ld entries, %d aborted recordings\n",
+           nTraces, nAnnexes, nEntrees, nAbandons);
+    TRACE_LIBERER();
+    INTER_TERMINER();
+}
+
+void TRACE_LIBERER(void)
+{
+    if (zone)
+        munmap(zone, TRACE_TAILLE_ZONE);
+    zone = NULL;
+    free(sorties);
+    sorties = NULL;
+}
+
+#else
+
+// Plateforme sans JIT : le P-code est interprété
+void TRACE_PCODE(void)
+{
+    INTER_PCODE();
+}
+
+void TRACE_LIBERER(void)
+{
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "global.h"  // Définitions globales (PCODE, PC, MEM, SP, BP, etc.)
+
+// ---------------------------------------------------------------------
+// TRACE_PCODE : interpréteur avec JIT de traces (option -trace[=<n>])
+// ---------------------------------------------------------------------
+// Le programme est interprété ; chaque branchement arrière (boucles while,
+// repeat et for) a un compteur. Quand une boucle devient chaude, le chemin
+// suivi par une itération est enregistré puis compilé en code machine
+// linéaire, spécialisé sur les types observés : chaque lecture d'une case
+// est précédée d'une garde sur MEM_TYPE, chaque branchement d'une garde
+// sur la direction enregistrée. Une garde qui échoue rend la main à
+// l'interpréteur ; si elle échoue souvent, le chemin qui la suit est
+// enregistré à son tour et greffé sur la trace. Le code d'une boucle est
+// entré depuis l'interpréteur à chaque passage en tête de boucle, donc
+// aussi au milieu d'une boucle déjà en cours. Sur une autre plateforme
+// que Linux x86-64, tout le programme est interprété.
+void TRACE_PCODE(void);
+
+// Libère la zone de code d'une exécution interrompue par une erreur
+// rattrapée (REPRISE_ERREUR) ; sans effet si aucune n'est en cours
+void TRACE_LIBERER(void);
+
+// Passages d'un branchement arrière (ou d'une sortie de trace) avant
+// l'enregistrement de sa trace (option -trace=<n>, 50 par défaut)
+extern ETAT_PAR_FIL int SEUIL_TRACE;
+
+#endif